@@ -27,36 +27,29 @@
 #include "egolib/Script/script.h"  // for waypoint list control
 #include "game/mesh.h"
 
-AStar::AStar() : 
-    final_node(nullptr), 
-    start_node(nullptr)
+AStar::AStar() :
+    _finder(),
+    _width(0),
+    _startX(0),
+    _startY(0),
+    _path()
 {}
 
 void AStar::reset()
 {
     /// @author ZF
     /// @details Reset AStar memory.
-    final_node = nullptr;
-    start_node = nullptr;
+    _path.clear();
 }
 
-/// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
-struct Distance {
-    float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
-        int distanceX = targetX - sourceX,
-            distanceY = targetY - sourceY;
-        float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
-        return distance;
-    }
-};
-
 bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
 {
     /// @author ZF
-    /// @details Explores up to MAX_ASTAR_NODES number of nodes to find a path between the source coordinates and destination coordinates.
-    //              The result is stored in a node list and can be accessed through AStar_get_path(). Returns false if no path was found.
+    /// @details Finds a path between the source coordinates and destination coordinates.
+    //              The result is stored and can be accessed through get_path(). Returns false if no path was found.
 
-    float weight;
+    // restart the algorithm
+    reset();
 
     // do not start if the initial point is off the mesh
     if (Index1D::Invalid == mesh->getTileIndex(Index2D(src_ix, src_iy)))
@@ -76,112 +69,29 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         return false;
     }
 
-
-    struct Offset
+    //Pits and tiles with any of the stoppedby bits can not be walked through
+    //@todo: might need to check tile Z level here instead
+    //@todo  I need to check for collisions with static objects, like trees
+    const int width = mesh->_info.getTileCountX(), height = mesh->_info.getTileCountY();
+    const std::shared_ptr<const Ego::AI::PathGraph> graph = mesh->_pathGraphs.get(width, height, stoppedby,
+        [&mesh](int x, int y, uint32_t stoppedby) {
+            const Index1D itile = mesh->getTileIndex(Index2D(x, y));
+            return Index1D::Invalid != itile && !mesh->getTileInfo(itile).isFanOff() && !mesh->tile_has_bits(Index2D(x, y), stoppedby);
+        });
+
+    if (!_finder.find(*graph, src_ix, src_iy, dst_ix, dst_iy, _path) || _path.empty())
     {
-        Offset(int setX, int setY) : x(setX), y(setY) {}
-        int x;
-        int y;
-    };
-
-    //Explore all nearby nodes, not including diagonal ones
-    static const std::array<Offset, 4> EXPLORE_NODES = {
-        Offset(-1, 0), Offset(0, -1),
-        Offset(1, 0), Offset(0, 1)
-    };
-
-    //Node sorting algorithm (lowest weight first)
-    auto comparator = [](const std::shared_ptr<Node> &first, const std::shared_ptr<Node> &second){
-        return first->weight < second->weight;
-    };
-
-    //Set of closed nodes
-    std::unordered_set<int> closedNodes;
-    std::priority_queue<std::shared_ptr<Node>, 
-                        std::vector<std::shared_ptr<Node>>,
-                        decltype(comparator)> openNodes(comparator);
-
-    // restart the algorithm
-    reset();
-
-    // initialize the starting node
-    weight = Distance()(src_ix, src_iy, dst_ix, dst_iy);
-    start_node = std::make_shared<AStar::Node>(src_ix, src_iy, weight, nullptr);
-    openNodes.push(start_node);
-
-    // do the algorithm
-    while (!openNodes.empty())
-    {
-        // list is completely full... we failed
-        if (closedNodes.size() >= MAX_ASTAR_NODES) {
 #ifdef DEBUG_ASTAR
-            Log::get().debug("AStar failed because maximum number of nodes were explored (%lu)\n", MAX_ASTAR_NODES);
+        Log::get().debug("AStar failed because there is no path.\n");
 #endif
-            break;
-        }
-
-        //Get the cheapest open node
-        std::shared_ptr<Node> currentNode = openNodes.top();
-        openNodes.pop();
-
-        // find some child nodes
-        for(const auto& offset: EXPLORE_NODES) {
-
-            // do not check diagonals
-            if (offset.x != 0 && offset.y != 0) continue;
-
-            //The node to explore
-            int tmp_x = currentNode->ix + offset.x;
-            int tmp_y = currentNode->iy + offset.y;
-
-            //Do not explore any node more than once
-            if(closedNodes.find(tmp_x | tmp_y << 16) != closedNodes.end()) {
-                continue;
-            }
-            closedNodes.insert(tmp_x | tmp_y << 16);
-
-            // check for the simplest case, is this the destination node?
-            if (tmp_x == dst_ix && tmp_y == dst_iy)
-            {
-                weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy);
-                final_node = std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode);
-                return true;
-            }
-
-            // is the test node on the mesh?
-            Index1D itile = mesh->getTileIndex(Index2D(tmp_x, tmp_y));
-            if (Index1D::Invalid == itile)
-            {
-                continue;
-            }
-
-            //Dont walk into pits
-            //@todo: might need to check tile Z level here instead
-            const ego_tile_info_t& ptile = mesh->getTileInfo(itile);
-            if (ptile.isFanOff())
-            {
-                // add the invalid tile to the list as a closed tile
-                continue;
-            }
-
-            // is this a wall or impassable?
-            if (mesh->tile_has_bits(Index2D(tmp_x, tmp_y), stoppedby))
-            {
-                // add the invalid tile to the list as a closed tile
-                continue;
-            }
-
-            ///
-            /// @todo  I need to check for collisions with static objects, like trees
-
-            // OK. determine the weight (F + H)
-            weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy)
-                   + Distance()(tmp_x, tmp_y, dst_ix, dst_iy);
-            openNodes.push(std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode));
-        }
+        _path.clear();
+        return false;
     }
 
-    return false;
+    _width = width;
+    _startX = src_ix;
+    _startY = src_iy;
+    return true;
 }
 
 bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
@@ -192,43 +102,47 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
     //              creates a corner. The function automatically prunes away all non-critical nodes. The final waypoint will always be
     //              the destination coordinates.
 
+    struct Node
+    {
+        int ix, iy;
+    };
+
     int i;
     size_t path_length, waypoint_num;
     //bool diagonal_movement = false;
 
-    Node *current_node, *last_waypoint, *safe_waypoint;
-    Node *node_path[MAX_ASTAR_PATH];
+    Node current_node, last_waypoint, safe_waypoint;
+    bool has_safe_waypoint;
 
     //Fill the waypoint list as much as we can, the final waypoint will always be the destination waypoint
     waypoint_num = 0;
-    current_node = final_node.get();
-    last_waypoint = start_node.get();
+    last_waypoint = Node{ _startX, _startY };
 
-    //Build the local node path tree
-    path_length = 0;
-    while (path_length < MAX_ASTAR_PATH && current_node != start_node.get())
-    {
-        // add the node to the end of the path
-        node_path[path_length++] = current_node;
-
-        // get next node
-        current_node = current_node->parent.get();
-    }
+    //The path runs from the first step to the destination, index 0 is the destination
+    path_length = _path.size();
+    const auto node_path = [this, path_length](int i) {
+        const int tile = _path[path_length - 1 - i];
+        return Node{ tile % _width, tile / _width };
+    };
 
     //Begin at the end of the list, which contains the starting node
-    safe_waypoint = nullptr;
+    has_safe_waypoint = false;
     for (i = path_length - 1; i >= 0 && waypoint_num < MAXWAY; i--)
     {
         bool change_direction;
 
         //get current node
-        current_node = node_path[i];
+        current_node = node_path(i);
 
         //the first node should be safe
-        if (nullptr == safe_waypoint) safe_waypoint = current_node;
+        if (!has_safe_waypoint)
+        {
+            safe_waypoint = current_node;
+            has_safe_waypoint = true;
+        }
 
         //is there a change in direction?
-        change_direction = (last_waypoint->ix != current_node->ix && last_waypoint->iy != current_node->iy);
+        change_direction = (last_waypoint.ix != current_node.ix && last_waypoint.iy != current_node.iy);
 
         //are we moving diagonally? if so, then don't fill the waypoint list with unessecary waypoints
         /*if( i != 0 )
@@ -258,8 +172,8 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
             else
             {
                 // translate to raw coordinates
-                way_x = safe_waypoint->ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
-                way_y = safe_waypoint->iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_x = safe_waypoint.ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_y = safe_waypoint.iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
             }
 
 #ifdef DEBUG_ASTAR
@@ -268,7 +182,7 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
             Log::get().debug("Waypoint %lu: X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / Info<int>::Grid::Size()), static_cast<int>(way_y / Info<int>::Grid::Size()));
             Renderer3D::pointList.add(Vector3f(way_x, way_y, 100.0f), 800);
             Renderer3D::lineSegmentList.add(
-                Vector3f(last_waypoint->ix*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), last_waypoint->iy*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 200.0f),
+                Vector3f(last_waypoint.ix*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), last_waypoint.iy*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 200.0f),
                 Vector3f(way_x, way_y, 100.0f),
                 800
             );
@@ -292,11 +206,10 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
 
 #ifdef DEBUG_ASTAR
     if (waypoint_num > 0) {
-        Renderer3D::pointList.add(Vector3f(start_node->ix*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), start_node->iy*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 100.0f), 800);
+        Renderer3D::pointList.add(Vector3f(_startX*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), _startY*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 100.0f), 800);
     }
 #endif
 
     return waypoint_num > 0;
 }
 
-AStar g_astar;
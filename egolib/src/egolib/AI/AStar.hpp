@@ -19,12 +19,12 @@
 
 /// @file egolib/AI/AStar.h
 /// @brief A* pathfinding.
-/// @details A very ugly implementation of the A* pathfinding agorithm.
-///          There is lots of room for improvement.
+/// @details Finds paths on the tiles of a mesh, see Ego::AI::PathFinder.
 
 #pragma once
 
 #include "egolib/AI/WaypointList.h"
+#include "egolib/AI/PathFinder.hpp"
 
 // Forward declarations.
 class ego_mesh_t;
@@ -33,38 +33,20 @@ struct waypoint_list_t;
 #undef DEBUG_ASTAR     //< Macro for enabling extra debugging info to the A* algorithm
 
 /// Implementation of A* pathfinding algorithm.
+/// @remark An instance keeps its memory from one search to the next. Instances are independent,
+///          each thread finding paths should have its own.
 class AStar {
-
-public:
-    struct Node {
-        Node(int x, int y, float setWeight, const std::shared_ptr<Node>& setParent) :
-            ix(x),
-            iy(y),
-            weight(setWeight),
-            parent(setParent)
-        {
-            //ctor
-        }
-
-        float weight;
-        int ix, iy;
-        std::shared_ptr<Node> parent;
-    };
-
 public:
     AStar();
     bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
     bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
 
 private:
-    static constexpr size_t MAX_ASTAR_NODES = 512;   ///< Maximum number of nodes to explore
-    static constexpr size_t MAX_ASTAR_PATH = 128;    ///< Maximum length of the final path (before pruning)
-
-    std::shared_ptr<Node> final_node;
-    std::shared_ptr<Node> start_node;
+    Ego::AI::PathFinder _finder;
+    int _width;                 ///< The width, in tiles, of the mesh of the last path found
+    int _startX, _startY;       ///< The start of the last path found
+    std::vector<int> _path;     ///< The tiles along the last path found, excluding the start
 
 private:
     void reset();
 };
-
-extern AStar g_astar;
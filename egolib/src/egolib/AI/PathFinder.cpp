@@ -0,0 +1,284 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/PathFinder.cpp
+/// @brief  A* path finding on a path graph.
+
+#include "egolib/AI/PathFinder.hpp"
+
+namespace Ego {
+namespace AI {
+
+namespace {
+
+/// The length of a shortest path between two tiles if nothing is in the way.
+float distance(const PathGraph& graph, int first, int second) {
+    const int width = graph.getWidth();
+    return static_cast<float>(std::abs(first % width - second % width) + std::abs(first / width - second / width));
+}
+
+} // namespace
+
+PathFinder::PathFinder() :
+    _cost(), _parent(), _stamp(), _closed(), _open(), _generation(0),
+    _nodeCost(), _nodeParent(), _nodeClosed(), _sourceCost(), _targetCost(), _nodes(),
+    _expandedCount(0) {
+    //ctor
+}
+
+PathFinder::Bounds PathFinder::getRegionBounds(const PathGraph& graph, int tile) {
+    const int x = (tile % graph.getWidth()) / PathGraph::REGION_SIZE * PathGraph::REGION_SIZE;
+    const int y = (tile / graph.getWidth()) / PathGraph::REGION_SIZE * PathGraph::REGION_SIZE;
+    return Bounds{ x, y, std::min(x + PathGraph::REGION_SIZE, graph.getWidth()), std::min(y + PathGraph::REGION_SIZE, graph.getHeight()) };
+}
+
+void PathFinder::beginSearch(size_t size) {
+    if (_stamp.size() < size) {
+        _cost.resize(size);
+        _parent.resize(size);
+        _stamp.resize(size, 0);
+        _closed.resize(size);
+    }
+    // On wrap around, old stamps could be mistaken for current ones.
+    if (0 == ++_generation) {
+        std::fill(_stamp.begin(), _stamp.end(), 0);
+        _generation = 1;
+    }
+    _open.clear();
+}
+
+float PathFinder::getCost(int tile) const {
+    if (tile < 0 || static_cast<size_t>(tile) >= _stamp.size() || _generation != _stamp[tile]) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return _cost[tile];
+}
+
+bool PathFinder::search(const PathGraph& graph, int source, int target, const Bounds& bounds, std::vector<int> *path, size_t maxExpanded) {
+    static const int OFFSETS[4][2] = { { -1, 0 }, { 0, -1 }, { 1, 0 }, { 0, 1 } };
+    const int width = graph.getWidth();
+
+    beginSearch(graph.getTileCount());
+
+    _stamp[source] = _generation;
+    _cost[source] = 0.0f;
+    _parent[source] = -1;
+    _closed[source] = 0;
+    _open.push_back(OpenEntry{ target < 0 ? 0.0f : distance(graph, source, target), source });
+
+    size_t expanded = 0;
+    while (!_open.empty()) {
+        std::pop_heap(_open.begin(), _open.end());
+        const int current = _open.back().index;
+        _open.pop_back();
+
+        // Stale entry of a tile reached on a shorter path later on.
+        if (0 != _closed[current]) {
+            continue;
+        }
+        if (expanded++ == maxExpanded) {
+            return false;
+        }
+        _closed[current] = 1;
+        _expandedCount++;
+
+        if (current == target) {
+            if (nullptr != path) {
+                const size_t first = path->size();
+                for (int tile = current; tile != source; tile = _parent[tile]) {
+                    path->push_back(tile);
+                }
+                std::reverse(path->begin() + first, path->end());
+            }
+            return true;
+        }
+
+        const int x = current % width, y = current / width;
+        for (const auto& offset : OFFSETS) {
+            const int nx = x + offset[0], ny = y + offset[1];
+            if (nx < bounds.minX || ny < bounds.minY || nx >= bounds.maxX || ny >= bounds.maxY) {
+                continue;
+            }
+            const int next = ny * width + nx;
+            if (next != target && !graph.isPassable(next)) {
+                continue;
+            }
+            const float cost = _cost[current] + 1.0f;
+            if (_generation == _stamp[next]) {
+                if (0 != _closed[next] || cost >= _cost[next]) {
+                    continue;
+                }
+            } else {
+                _stamp[next] = _generation;
+                _closed[next] = 0;
+            }
+            _cost[next] = cost;
+            _parent[next] = current;
+            _open.push_back(OpenEntry{ cost + (target < 0 ? 0.0f : distance(graph, next, target)), next });
+            std::push_heap(_open.begin(), _open.end());
+        }
+    }
+    return target < 0;
+}
+
+bool PathFinder::searchNodes(const PathGraph& graph, int source, int target, std::vector<uint32_t>& nodes) {
+    const auto& graphNodes = graph.getNodes();
+    const auto& sourceNodes = graph.getRegionNodes(graph.getRegion(source % graph.getWidth(), source / graph.getWidth()));
+    const auto& targetNodes = graph.getRegionNodes(graph.getRegion(target % graph.getWidth(), target / graph.getWidth()));
+    const size_t count = graphNodes.size();
+
+    // The lengths of the paths from the source to the nodes in its region ...
+    _sourceCost.assign(count, std::numeric_limits<float>::infinity());
+    search(graph, source, -1, getRegionBounds(graph, source), nullptr);
+    for (uint32_t node : sourceNodes) {
+        _sourceCost[node] = getCost(graphNodes[node].tile);
+    }
+    // ... and from the nodes in the region of the target to the target.
+    _targetCost.assign(count, std::numeric_limits<float>::infinity());
+    search(graph, target, -1, getRegionBounds(graph, target), nullptr);
+    for (uint32_t node : targetNodes) {
+        _targetCost[node] = getCost(graphNodes[node].tile);
+    }
+
+    // A* on the nodes, the index count stands for the target.
+    const int32_t TARGET = static_cast<int32_t>(count);
+    _nodeCost.assign(count + 1, std::numeric_limits<float>::infinity());
+    _nodeParent.assign(count + 1, -1);
+    _nodeClosed.assign(count + 1, 0);
+    _open.clear();
+    for (uint32_t node : sourceNodes) {
+        if (_sourceCost[node] < std::numeric_limits<float>::infinity()) {
+            _nodeCost[node] = _sourceCost[node];
+            _open.push_back(OpenEntry{ _nodeCost[node] + distance(graph, graphNodes[node].tile, target), static_cast<int32_t>(node) });
+            std::push_heap(_open.begin(), _open.end());
+        }
+    }
+
+    while (!_open.empty()) {
+        std::pop_heap(_open.begin(), _open.end());
+        const int32_t current = _open.back().index;
+        _open.pop_back();
+        if (0 != _nodeClosed[current]) {
+            continue;
+        }
+        _nodeClosed[current] = 1;
+
+        if (TARGET == current) {
+            nodes.clear();
+            for (int32_t node = _nodeParent[TARGET]; node >= 0; node = _nodeParent[node]) {
+                nodes.push_back(static_cast<uint32_t>(node));
+            }
+            std::reverse(nodes.begin(), nodes.end());
+            return true;
+        }
+
+        const auto relax = [this, &graph, &graphNodes, target, TARGET](int32_t from, int32_t to, float cost) {
+            if (0 != _nodeClosed[to] || cost >= _nodeCost[to]) {
+                return;
+            }
+            _nodeCost[to] = cost;
+            _nodeParent[to] = from;
+            const float estimate = cost + (TARGET == to ? 0.0f : distance(graph, graphNodes[to].tile, target));
+            _open.push_back(OpenEntry{ estimate, to });
+            std::push_heap(_open.begin(), _open.end());
+        };
+        for (const auto& edge : graphNodes[current].edges) {
+            relax(current, static_cast<int32_t>(edge.target), _nodeCost[current] + edge.cost);
+        }
+        if (_targetCost[current] < std::numeric_limits<float>::infinity()) {
+            relax(current, TARGET, _nodeCost[current] + _targetCost[current]);
+        }
+    }
+    return false;
+}
+
+bool PathFinder::refine(const PathGraph& graph, int source, int target, const std::vector<uint32_t>& nodes, std::vector<int>& path) {
+    const auto& graphNodes = graph.getNodes();
+    const int width = graph.getWidth();
+    const auto region = [&graph, width](int tile) { return graph.getRegion(tile % width, tile / width); };
+
+    path.clear();
+    int current = source;
+    for (size_t i = 0; i <= nodes.size(); ++i) {
+        const int next = (i < nodes.size()) ? graphNodes[nodes[i]].tile : target;
+        if (next == current) {
+            continue;
+        }
+        if (region(next) == region(current)) {
+            if (!search(graph, current, next, getRegionBounds(graph, current), &path)) {
+                return false;
+            }
+        } else if (distance(graph, current, next) == 1.0f) {
+            // The two sides of a portal.
+            path.push_back(next);
+        } else {
+            return false;
+        }
+        current = next;
+    }
+    return true;
+}
+
+bool PathFinder::find(const PathGraph& graph, int sourceX, int sourceY, int targetX, int targetY, std::vector<int>& path) {
+    const int width = graph.getWidth();
+    path.clear();
+    if (sourceX < 0 || sourceY < 0 || sourceX >= width || sourceY >= graph.getHeight() ||
+        targetX < 0 || targetY < 0 || targetX >= width || targetY >= graph.getHeight()) {
+        return false;
+    }
+    const int source = sourceY * width + sourceX;
+    const int target = targetY * width + targetX;
+    if (source == target) {
+        return true;
+    }
+
+    // Regions next to each other: search the tiles of the two regions, then, with a limit, of the whole mesh.
+    if (std::abs(sourceX / PathGraph::REGION_SIZE - targetX / PathGraph::REGION_SIZE) <= 1 &&
+        std::abs(sourceY / PathGraph::REGION_SIZE - targetY / PathGraph::REGION_SIZE) <= 1) {
+        const Bounds sourceBounds = getRegionBounds(graph, source), targetBounds = getRegionBounds(graph, target);
+        const Bounds bounds{ std::min(sourceBounds.minX, targetBounds.minX), std::min(sourceBounds.minY, targetBounds.minY),
+                             std::max(sourceBounds.maxX, targetBounds.maxX), std::max(sourceBounds.maxY, targetBounds.maxY) };
+        if (search(graph, source, target, bounds, &path)) {
+            return true;
+        }
+        path.clear();
+        if (search(graph, source, target, Bounds{ 0, 0, width, graph.getHeight() }, &path, MAX_FALLBACK_EXPANDED)) {
+            return true;
+        }
+        path.clear();
+        return false;
+    }
+
+    // Try the path cached for the two regions. It might not fit if a region is split by walls.
+    const int sourceRegion = graph.getRegion(sourceX, sourceY);
+    const int targetRegion = graph.getRegion(targetX, targetY);
+    if (graph.getCachedPath(sourceRegion, targetRegion, _nodes) && refine(graph, source, target, _nodes, path)) {
+        return true;
+    }
+
+    if (!searchNodes(graph, source, target, _nodes)) {
+        path.clear();
+        return false;
+    }
+    graph.setCachedPath(sourceRegion, targetRegion, _nodes);
+    return refine(graph, source, target, _nodes, path);
+}
+
+} // namespace AI
+} // namespace Ego
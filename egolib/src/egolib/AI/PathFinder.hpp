@@ -0,0 +1,133 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/PathFinder.hpp
+/// @brief  A* path finding on a path graph.
+
+#pragma once
+
+#include "egolib/AI/PathGraph.hpp"
+
+namespace Ego {
+namespace AI {
+
+/**
+ * @brief
+ *  A* path finding on the tiles and the portals of a path graph.
+ * @remark
+ *  A path finder keeps its nodes and its open and closed sets in flat arrays which grow to the
+ *  size of the largest graph searched and are reused by later searches, a search does not
+ *  allocate once they have grown. A path finder must not be used by more than one thread at a
+ *  time, but any number of path finders may search the same graph concurrently.
+ * @remark
+ *  Movement is along the four axes, every step costs 1.
+ */
+class PathFinder {
+public:
+    /// @brief An area of tiles, the maximum is exclusive.
+    struct Bounds {
+        int minX, minY, maxX, maxY;
+    };
+
+    /// @brief The maximum number of tiles expanded by the search on the whole mesh which is done if
+    ///        no path between regions next to each other is found within the two regions.
+    static const size_t MAX_FALLBACK_EXPANDED = 16 * PathGraph::REGION_SIZE * PathGraph::REGION_SIZE;
+
+    PathFinder();
+
+    /**
+     * @brief
+     *  Find a path between two tiles.
+     * @param graph
+     *  the path graph
+     * @param sourceX, sourceY
+     *  the source tile
+     * @param targetX, targetY
+     *  the target tile, it is reached even if it is not passable
+     * @param [out] path
+     *  receives the tiles along the path, excluding the source tile and including the target tile
+     * @return
+     *  @a true if a path was found, @a false otherwise
+     * @remark
+     *  If the tiles are in regions which are not next to each other, the path is searched for
+     *  on the portals first and then refined on the tiles. The result is near optimal.
+     *  Otherwise the path is searched for on the tiles of the two regions and, if there is none,
+     *  on the tiles of the whole mesh, expanding at most MAX_FALLBACK_EXPANDED tiles.
+     */
+    bool find(const PathGraph& graph, int sourceX, int sourceY, int targetX, int targetY, std::vector<int>& path);
+
+    /**
+     * @brief
+     *  Find a shortest path between two tiles within an area.
+     * @param target
+     *  the target tile or @a -1 to find the shortest paths to all tiles in the area, see getCost()
+     * @param [out] path
+     *  if not @a nullptr, receives the tiles along the path, excluding the source tile and including the target tile
+     * @param maxExpanded
+     *  the search gives up after expanding this many tiles
+     * @return
+     *  @a true if the target was reached, @a false otherwise
+     */
+    bool search(const PathGraph& graph, int source, int target, const Bounds& bounds, std::vector<int> *path,
+                size_t maxExpanded = std::numeric_limits<size_t>::max());
+
+    /// @brief Get the length of the shortest path to a tile found by the last search, or infinity.
+    float getCost(int tile) const;
+
+    /// @brief Get the number of tiles expanded by all searches so far.
+    size_t getExpandedCount() const { return _expandedCount; }
+
+    /// @brief Get the bounds of the region of a tile.
+    static Bounds getRegionBounds(const PathGraph& graph, int tile);
+
+private:
+    struct OpenEntry {
+        float estimate;
+        int32_t index;
+        bool operator<(const OpenEntry& other) const {
+            // std::push_heap builds a max heap, the lowest estimate must come first.
+            return estimate > other.estimate;
+        }
+    };
+
+    bool searchNodes(const PathGraph& graph, int source, int target, std::vector<uint32_t>& nodes);
+    bool refine(const PathGraph& graph, int source, int target, const std::vector<uint32_t>& nodes, std::vector<int>& path);
+    void beginSearch(size_t size);
+
+    // Tile searches. An entry is valid if its stamp equals the generation of the search.
+    std::vector<float> _cost;
+    std::vector<int32_t> _parent;
+    std::vector<uint32_t> _stamp;
+    std::vector<uint8_t> _closed;
+    std::vector<OpenEntry> _open;
+    uint32_t _generation;
+
+    // Searches on the portals.
+    std::vector<float> _nodeCost;
+    std::vector<int32_t> _nodeParent;
+    std::vector<uint8_t> _nodeClosed;
+    std::vector<float> _sourceCost;
+    std::vector<float> _targetCost;
+    std::vector<uint32_t> _nodes;
+
+    size_t _expandedCount;
+};
+
+} // namespace AI
+} // namespace Ego
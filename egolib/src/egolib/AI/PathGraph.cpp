@@ -0,0 +1,155 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/PathGraph.cpp
+/// @brief  The tiles of a mesh as seen by path finding: passability, regions and portals.
+
+#include "egolib/AI/PathGraph.hpp"
+#include "egolib/AI/PathFinder.hpp"
+
+namespace Ego {
+namespace AI {
+
+const int PathGraph::REGION_SIZE;
+
+PathGraph::PathGraph(int width, int height, std::vector<uint8_t> passable) :
+    _width(width),
+    _height(height),
+    _regionsX((width + REGION_SIZE - 1) / REGION_SIZE),
+    _regionsY((height + REGION_SIZE - 1) / REGION_SIZE),
+    _passable(std::move(passable)),
+    _nodes(),
+    _regionNodes(),
+    _cacheMutex(),
+    _cache() {
+    _passable.resize(_width * _height, 0);
+    _regionNodes.resize(getRegionCount());
+
+    // Portals across the vertical region borders ...
+    for (int x = REGION_SIZE; x < _width; x += REGION_SIZE) {
+        for (int y0 = 0; y0 < _height; y0 += REGION_SIZE) {
+            const int y1 = std::min(y0 + REGION_SIZE, _height);
+            int first = -1;
+            for (int y = y0; y <= y1; ++y) {
+                const bool open = y < y1 && isPassable(x - 1, y) && isPassable(x, y);
+                if (open && first < 0) {
+                    first = y;
+                } else if (!open && first >= 0) {
+                    const int middle = (first + y - 1) / 2;
+                    addPortal(middle * _width + x - 1, middle * _width + x);
+                    first = -1;
+                }
+            }
+        }
+    }
+    // ... and across the horizontal region borders.
+    for (int y = REGION_SIZE; y < _height; y += REGION_SIZE) {
+        for (int x0 = 0; x0 < _width; x0 += REGION_SIZE) {
+            const int x1 = std::min(x0 + REGION_SIZE, _width);
+            int first = -1;
+            for (int x = x0; x <= x1; ++x) {
+                const bool open = x < x1 && isPassable(x, y - 1) && isPassable(x, y);
+                if (open && first < 0) {
+                    first = x;
+                } else if (!open && first >= 0) {
+                    const int middle = (first + x - 1) / 2;
+                    addPortal((y - 1) * _width + middle, y * _width + middle);
+                    first = -1;
+                }
+            }
+        }
+    }
+
+    for (int region = 0; region < getRegionCount(); ++region) {
+        connectRegion(region);
+    }
+}
+
+void PathGraph::addPortal(int first, int second) {
+    const uint32_t firstNode = static_cast<uint32_t>(_nodes.size());
+    const uint32_t secondNode = firstNode + 1;
+    _nodes.push_back(Node{ first, getRegion(first % _width, first / _width), { Edge{ secondNode, 1.0f } } });
+    _nodes.push_back(Node{ second, getRegion(second % _width, second / _width), { Edge{ firstNode, 1.0f } } });
+    _regionNodes[_nodes[firstNode].region].push_back(firstNode);
+    _regionNodes[_nodes[secondNode].region].push_back(secondNode);
+}
+
+void PathGraph::connectRegion(int region) {
+    const auto& nodes = _regionNodes[region];
+    if (nodes.size() < 2) {
+        return;
+    }
+    PathFinder finder;
+    for (uint32_t source : nodes) {
+        finder.search(*this, _nodes[source].tile, -1, PathFinder::getRegionBounds(*this, _nodes[source].tile), nullptr);
+        for (uint32_t target : nodes) {
+            const float cost = finder.getCost(_nodes[target].tile);
+            if (source != target && cost < std::numeric_limits<float>::infinity()) {
+                _nodes[source].edges.push_back(Edge{ target, cost });
+            }
+        }
+    }
+}
+
+bool PathGraph::getCachedPath(int sourceRegion, int targetRegion, std::vector<uint32_t>& path) const {
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    const auto it = _cache.find((static_cast<uint64_t>(sourceRegion) << 32) | static_cast<uint32_t>(targetRegion));
+    if (_cache.cend() == it) {
+        return false;
+    }
+    path = it->second;
+    return true;
+}
+
+void PathGraph::setCachedPath(int sourceRegion, int targetRegion, const std::vector<uint32_t>& path) const {
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    _cache[(static_cast<uint64_t>(sourceRegion) << 32) | static_cast<uint32_t>(targetRegion)] = path;
+}
+
+PathGraphCache::PathGraphCache() :
+    _mutex(), _version(0), _builtVersion(0), _graphs() {
+    //ctor
+}
+
+std::shared_ptr<const PathGraph> PathGraphCache::get(int width, int height, uint32_t stoppedBy, const Passable& passable) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint32_t version = _version.load();
+    if (version != _builtVersion) {
+        _graphs.clear();
+        _builtVersion = version;
+    }
+    auto it = _graphs.find(stoppedBy);
+    if (_graphs.end() == it) {
+        std::vector<uint8_t> tiles(width * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                tiles[y * width + x] = passable(x, y, stoppedBy) ? 1 : 0;
+            }
+        }
+        it = _graphs.emplace(stoppedBy, std::make_shared<const PathGraph>(width, height, std::move(tiles))).first;
+    }
+    return it->second;
+}
+
+void PathGraphCache::invalidate() {
+    _version++;
+}
+
+} // namespace AI
+} // namespace Ego
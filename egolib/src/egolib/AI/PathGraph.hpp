@@ -0,0 +1,171 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/PathGraph.hpp
+/// @brief  The tiles of a mesh as seen by path finding: passability, regions and portals.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+namespace AI {
+
+/**
+ * @brief
+ *  The tiles of a mesh as seen by path finding for one set of blocking tile FX.
+ * @remark
+ *  Tiles are identified by their index <tt>y * width + x</tt>. The tiles are grouped into
+ *  square regions of REGION_SIZE x REGION_SIZE tiles. Wherever passable tiles on both sides
+ *  of a region border meet, there is a portal: one node on each side, connected by an edge.
+ *  Nodes in the same region are connected by an edge if there is a path between them within
+ *  the region, weighted by the length of that path. Long paths are searched for on these
+ *  nodes first and only then on the tiles, see PathFinder.
+ * @remark
+ *  A path graph does not change once built. Searches in it may run concurrently, the cache
+ *  of region to region paths is guarded by a mutex.
+ */
+class PathGraph {
+public:
+    /// @brief The width and the height, in tiles, of a region.
+    static const int REGION_SIZE = 16;
+
+    /// @brief An edge to a node.
+    struct Edge {
+        /// @brief The index of the node.
+        uint32_t target;
+        /// @brief The length of the path along this edge.
+        float cost;
+    };
+
+    /// @brief A node i.e. one side of a portal.
+    struct Node {
+        /// @brief The tile of this node.
+        int tile;
+        /// @brief The region of this node.
+        int region;
+        /// @brief The edges to other nodes.
+        std::vector<Edge> edges;
+    };
+
+    /**
+     * @brief
+     *  Build a path graph.
+     * @param width, height
+     *  the size, in tiles, of the mesh
+     * @param passable
+     *  the passability of the tiles indexed by tile index, non-zero if a tile is passable
+     */
+    PathGraph(int width, int height, std::vector<uint8_t> passable);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    int getTileCount() const { return _width * _height; }
+
+    /// @brief Get if a tile is passable. Tiles outside of the mesh are not passable.
+    bool isPassable(int x, int y) const {
+        return x >= 0 && y >= 0 && x < _width && y < _height && 0 != _passable[y * _width + x];
+    }
+
+    /// @brief Get if a tile is passable.
+    bool isPassable(int tile) const {
+        return 0 != _passable[tile];
+    }
+
+    /// @brief Get the region of a tile.
+    int getRegion(int x, int y) const {
+        return (y / REGION_SIZE) * _regionsX + (x / REGION_SIZE);
+    }
+
+    /// @brief Get the number of regions.
+    int getRegionCount() const { return _regionsX * _regionsY; }
+
+    /// @brief Get the nodes.
+    const std::vector<Node>& getNodes() const { return _nodes; }
+
+    /// @brief Get the indices of the nodes in a region.
+    const std::vector<uint32_t>& getRegionNodes(int region) const { return _regionNodes[region]; }
+
+    /**
+     * @brief
+     *  Get a cached path between two regions.
+     * @param path
+     *  receives the nodes along the path
+     * @return
+     *  @a true if a path is cached, @a false otherwise
+     */
+    bool getCachedPath(int sourceRegion, int targetRegion, std::vector<uint32_t>& path) const;
+
+    /// @brief Cache a path between two regions.
+    void setCachedPath(int sourceRegion, int targetRegion, const std::vector<uint32_t>& path) const;
+
+private:
+    void addPortal(int first, int second);
+    void connectRegion(int region);
+
+    int _width;
+    int _height;
+    int _regionsX;
+    int _regionsY;
+    std::vector<uint8_t> _passable;
+    std::vector<Node> _nodes;
+    std::vector<std::vector<uint32_t>> _regionNodes;
+
+    mutable std::mutex _cacheMutex;
+    mutable std::unordered_map<uint64_t, std::vector<uint32_t>> _cache;
+};
+
+/**
+ * @brief
+ *  The path graphs of a mesh, one per set of blocking tile FX, built when first needed.
+ * @remark
+ *  Call invalidate() whenever the FX of a tile change, the graphs are then rebuilt the next
+ *  time they are needed. Graphs already handed out stay valid until released.
+ */
+class PathGraphCache {
+public:
+    /// @brief Get if a tile is passable for a set of blocking tile FX.
+    using Passable = std::function<bool(int x, int y, uint32_t stoppedBy)>;
+
+    PathGraphCache();
+
+    /**
+     * @brief
+     *  Get the path graph for a set of blocking tile FX.
+     * @param width, height
+     *  the size, in tiles, of the mesh
+     * @param stoppedBy
+     *  the blocking tile FX
+     * @param passable
+     *  used to build the graph if it is not cached
+     */
+    std::shared_ptr<const PathGraph> get(int width, int height, uint32_t stoppedBy, const Passable& passable);
+
+    /// @brief Throw away all graphs.
+    void invalidate();
+
+private:
+    std::mutex _mutex;
+    std::atomic<uint32_t> _version;
+    uint32_t _builtVersion;
+    std::unordered_map<uint32_t, std::shared_ptr<const PathGraph>> _graphs;
+};
+
+} // namespace AI
+} // namespace Ego
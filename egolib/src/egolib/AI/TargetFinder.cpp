@@ -0,0 +1,102 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/TargetFinder.cpp
+/// @brief  Selection of the nearest target in a facing cone using a spatial index.
+
+#include "egolib/AI/TargetFinder.hpp"
+
+namespace Ego {
+namespace AI {
+
+TargetFinder::Cone::Cone(const Facing& facing, const FACING_T coneAngle) :
+    empty(0 == coneAngle), all(false), axisX(0.0f), axisY(0.0f), cosine(-1.0f) {
+    // Widen the cone a little so that rounding can not cull a target the exact test accepts.
+    static const int32_t MARGIN = 16;
+    const int32_t angle = static_cast<int32_t>(coneAngle) + MARGIN;
+    if (angle >= 0x8000) {
+        all = true;
+        return;
+    }
+    // vec_to_facing() is offset by half a turn.
+    const float direction = static_cast<float>(static_cast<int32_t>(facing)) / 65536.0f * Ego::Math::twoPi<float>();
+    axisX = -std::cos(direction);
+    axisY = -std::sin(direction);
+    cosine = std::cos(static_cast<float>(angle) / 65536.0f * Ego::Math::twoPi<float>());
+}
+
+TargetFinder::TargetFinder(const float cellSize) :
+    _slots(), _grid(cellSize), _entries(), _nextOrder(0), _searchBuffer() {
+    //ctor
+}
+
+void TargetFinder::reset(const float minX, const float minY, const float maxX, const float maxY) {
+    std::vector<Index> slots;
+    for (Index slot = 0; slot < _slots.capacity(); ++slot) {
+        if (_grid.contains(slot)) {
+            slots.push_back(slot);
+        }
+    }
+    _grid.reset(minX, minY, maxX, maxY);
+    for (const Index slot : slots) {
+        const Vector3f& position = _entries[slot].position;
+        _grid.update(slot, AxisAlignedBox2f(Point2f(position[kX], position[kY]), Point2f(position[kX], position[kY])));
+    }
+}
+
+void TargetFinder::clear() {
+    _slots.clear();
+    _grid.clear();
+    _entries.clear();
+    _nextOrder = 0;
+}
+
+void TargetFinder::insert(const Index index, const Vector3f& position) {
+    bool inserted;
+    const DenseIndex::Slot slot = _slots.insert(index, &inserted);
+    if (!inserted) {
+        move(index, position);
+        return;
+    }
+    if (slot >= _entries.size()) {
+        _entries.resize(slot + 1);
+    }
+    _entries[slot].order = _nextOrder++;
+    _entries[slot].position = position;
+    _grid.update(slot, AxisAlignedBox2f(Point2f(position[kX], position[kY]), Point2f(position[kX], position[kY])));
+}
+
+void TargetFinder::move(const Index index, const Vector3f& position) {
+    const DenseIndex::Slot slot = _slots.find(index);
+    if (DenseIndex::NONE == slot) {
+        return;
+    }
+    _entries[slot].position = position;
+    _grid.update(slot, AxisAlignedBox2f(Point2f(position[kX], position[kY]), Point2f(position[kX], position[kY])));
+}
+
+void TargetFinder::remove(const Index index) {
+    const DenseIndex::Slot slot = _slots.erase(index);
+    if (DenseIndex::NONE != slot) {
+        _grid.remove(slot);
+    }
+}
+
+} // namespace AI
+} // namespace Ego
@@ -0,0 +1,203 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/AI/TargetFinder.hpp
+/// @brief  Selection of the nearest target in a facing cone using a spatial index.
+
+#pragma once
+
+#include "egolib/Core/SpatialGrid.hpp"
+#include "egolib/Core/DenseIndex.hpp"
+#include "egolib/_math.h"
+
+namespace Ego {
+namespace AI {
+
+/**
+ * @brief
+ *  Finds the nearest target within a radius and a facing cone, e.g. for homing particles.
+ * @remark
+ *  The positions of the targets are kept in a SpatialGrid and must be kept up to date with
+ *  move() whenever a target moves. The indices of the targets may be sparse, the grid and the
+ *  entries use dense slots instead. Every target is given a sequence number when it is inserted.
+ *  If several targets are at the same distance, the one inserted first is selected. This gives
+ *  the same result as a linear search over the targets in the order they were inserted.
+ * @remark
+ *  A search first culls the targets outside of the facing cone with a cheap, conservative
+ *  test, then those too far away or farther away than the best target so far. Only for the
+ *  remaining targets the filter of the caller is invoked and the exact facing is computed.
+ *  find() is not thread-safe even though it is const, see SpatialGrid::find().
+ */
+class TargetFinder {
+public:
+    using Index = SpatialGrid::Index;
+
+    /// @brief A search for a target.
+    struct Query {
+        /// @brief The position to search from.
+        Vector3f position;
+        /// @brief The direction to search in, canonicalized.
+        Facing facing;
+        /// @brief Targets are accepted if they are less than this many facing units left or right of the facing.
+        FACING_T coneAngle;
+        /// @brief Targets are accepted if they are closer than this.
+        float radius;
+    };
+
+    /**
+     * @brief
+     *  Construct an empty target finder.
+     * @param cellSize
+     *  the edge length of a grid cell, usually the size of a mesh tile
+     */
+    TargetFinder(const float cellSize = 128.0f);
+
+    /// @brief Set new bounds for the grid. The targets and their sequence numbers are kept.
+    void reset(const float minX, const float minY, const float maxX, const float maxY);
+
+    /// @brief Remove all targets.
+    void clear();
+
+    /// @brief Get if a target is contained.
+    bool contains(const Index index) const {
+        return DenseIndex::NONE != _slots.find(index);
+    }
+
+    /// @brief Get the number of targets.
+    size_t size() const {
+        return _slots.size();
+    }
+
+    /// @brief Insert a target after all other targets. If it is already contained, it is only moved.
+    void insert(const Index index, const Vector3f& position);
+
+    /// @brief Move a target. Does nothing if the target is not contained.
+    void move(const Index index, const Vector3f& position);
+
+    /// @brief Remove a target.
+    void remove(const Index index);
+
+    /**
+     * @brief
+     *  Get the facing of a point relative to a position and a facing.
+     * @remark
+     *  Angles below @a 0 wrap around to below @a 0xFFFF.
+     */
+    static Facing getRelativeFacing(const Vector3f& position, const Facing& facing, const Vector3f& point) {
+        return Facing(FACING_T(-facing + vec_to_facing(point[kX] - position[kX], point[kY] - position[kY])));
+    }
+
+    /// @brief Get if a relative facing is within a facing cone.
+    static bool isInCone(const Facing& relativeFacing, const FACING_T coneAngle) {
+        return relativeFacing < Facing(coneAngle) || relativeFacing > Facing(0xFFFF - coneAngle);
+    }
+
+    /**
+     * @brief
+     *  Find the nearest target.
+     * @param query
+     *  the query
+     * @param accept
+     *  a predicate <tt>bool(Index)</tt> which tells if a target may be selected
+     * @param [out] target
+     *  receives the index of the target if one was found
+     * @param [out] relativeFacing
+     *  receives the facing of the target relative to the query if one was found
+     * @return
+     *  @a true if a target was found, @a false otherwise
+     */
+    template <typename Accept>
+    bool find(const Query& query, Accept accept, Index& target, Facing& relativeFacing) const {
+        const Cone cone(query.facing, query.coneAngle);
+        if (cone.empty) {
+            return false;
+        }
+        const float radius = query.radius;
+        const float maximum = radius * radius;
+
+        _searchBuffer.clear();
+        _grid.find(AxisAlignedBox2f(Point2f(query.position[kX] - radius, query.position[kY] - radius),
+                                    Point2f(query.position[kX] + radius, query.position[kY] + radius)),
+                   _searchBuffer);
+
+        bool found = false;
+        float bestDistance2 = maximum;
+        uint64_t bestOrder = 0;
+        for (const Index slot : _searchBuffer) {
+            const Entry& entry = _entries[slot];
+            const Vector3f difference = entry.position - query.position;
+            if (!cone.mayContain(difference[kX], difference[kY])) {
+                continue;
+            }
+            const float distance2 = difference.length_2();
+            if (distance2 > bestDistance2 || (distance2 == bestDistance2 && (!found || entry.order > bestOrder))) {
+                continue;
+            }
+            const Index index = _slots.getKey(static_cast<DenseIndex::Slot>(slot));
+            if (!accept(index)) {
+                continue;
+            }
+            const Facing facing = getRelativeFacing(query.position, query.facing, entry.position);
+            if (!isInCone(facing, query.coneAngle)) {
+                continue;
+            }
+            found = true;
+            target = index;
+            relativeFacing = facing;
+            bestDistance2 = distance2;
+            bestOrder = entry.order;
+        }
+        return found;
+    }
+
+private:
+    /// @brief A conservative test for a point being inside of a facing cone.
+    struct Cone {
+        Cone(const Facing& facing, const FACING_T coneAngle);
+        bool mayContain(const float x, const float y) const {
+            if (all) {
+                return true;
+            }
+            const float dot = x * axisX + y * axisY;
+            const float bound = cosine * cosine * (x * x + y * y);
+            return (cosine >= 0.0f) ? (dot >= 0.0f && dot * dot >= bound) : (dot >= 0.0f || dot * dot <= bound);
+        }
+        bool empty;
+        bool all;
+        float axisX, axisY;
+        float cosine;
+    };
+
+    struct Entry {
+        Vector3f position;
+        uint64_t order;
+    };
+
+    /// @brief The slot of each target.
+    DenseIndex _slots;
+    /// @brief The targets by slot.
+    SpatialGrid _grid;
+    /// @brief The entries by slot.
+    std::vector<Entry> _entries;
+    uint64_t _nextOrder;
+    mutable std::vector<Index> _searchBuffer;
+};
+
+} // namespace AI
+} // namespace Ego
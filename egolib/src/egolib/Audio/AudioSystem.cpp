@@ -206,12 +206,17 @@ void AudioSystem::stopMusic()
 }
 
 SoundID AudioSystem::loadSound(const std::string &fileName)
+{
+    return addSound(readSound(fileName));
+}
+
+Mix_Chunk *AudioSystem::readSound(const std::string &fileName)
 {
     // Valid filename?
     if (fileName.empty())
     {
 		Log::get().warn("trying to load empty string sound");
-        return INVALID_SOUND_ID;
+        return nullptr;
     }
 
     // blank out the data
@@ -238,18 +243,24 @@ SoundID AudioSystem::loadSound(const std::string &fileName)
         }
     }
 
-    if (nullptr == loadedSound)
+    // there is an error only if the file exists and can't be loaded
+    if (nullptr == loadedSound && fileExists)
     {
-        // there is an error only if the file exists and can't be loaded
-        if (fileExists) {
-			Log::get().warn("Sound file not found/loaded %s.\n", fileName.c_str());
-        }
+		Log::get().warn("Sound file not found/loaded %s.\n", fileName.c_str());
+    }
+
+    return loadedSound;
+}
 
+SoundID AudioSystem::addSound(Mix_Chunk *sound)
+{
+    if (nullptr == sound)
+    {
         return INVALID_SOUND_ID;
     }
 
     //Sound loaded!
-    _soundsLoaded.push_back(loadedSound);
+    _soundsLoaded.push_back(sound);
     return _soundsLoaded.size() - 1;
 }
 
@@ -150,6 +150,29 @@ public:
 
     SoundID loadSound(const std::string &fileName);
 
+    /**
+     * @brief
+     *  Decode a sound file (.ogg or .wav) without adding it to the loaded sounds.
+     * @param fileName
+     *  the file name of the sound <em>without</em> extension
+     * @return
+     *  the sound or a null pointer if no sound could be loaded. It is added by addSound() or
+     *  freed by @a Mix_FreeChunk.
+     * @remark
+     *  This does not use the audio system and can be called from any thread.
+     */
+    static Mix_Chunk *readSound(const std::string &fileName);
+
+    /**
+     * @brief
+     *  Add a sound decoded by readSound() to the loaded sounds.
+     * @param sound
+     *  the sound, may be a null pointer
+     * @return
+     *  the sound ID of the sound or INVALID_SOUND_ID if @a sound is a null pointer
+     */
+    SoundID addSound(Mix_Chunk *sound);
+
     /// @author ZF
     /// @details This function loads all of the music sounds
     void loadAllMusic();
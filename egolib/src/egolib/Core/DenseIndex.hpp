@@ -0,0 +1,163 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file   egolib/Core/DenseIndex.hpp
+/// @brief  Mapping of sparse keys to dense, reused slots
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   Maps sparse keys (e.g. ObjectRef::get(), which grows for the whole game) to dense slots.
+* @remark
+*   Slots of erased keys are reused, so arrays indexed by slot only grow up to the largest
+*   number of keys that were mapped at the same time.
+**/
+class DenseIndex
+{
+public:
+    typedef size_t Key;
+    typedef uint32_t Slot;
+
+    static const Slot NONE = 0xFFFFFFFFu;   //< No slot
+
+    DenseIndex() :
+        _slots(),
+        _keys(),
+        _freeSlots()
+    {
+        //ctor
+    }
+
+    /**
+    * @return
+    *   the slot of the key or NONE if the key is not mapped
+    **/
+    Slot find(const Key key) const
+    {
+        const auto it = _slots.find(key);
+        return it == _slots.end() ? NONE : it->second;
+    }
+
+    /**
+    * @brief
+    *   Map a key to a slot
+    * @param key
+    *   the key
+    * @param inserted
+    *   if not null, set to true if the key was not mapped before
+    * @return
+    *   the slot of the key, a new key gets the most recently freed slot or a new one
+    * @throw std::length_error
+    *   if all slots are used
+    **/
+    Slot insert(const Key key, bool *inserted = nullptr)
+    {
+        const auto it = _slots.find(key);
+        if (it != _slots.end()) {
+            if (inserted) *inserted = false;
+            return it->second;
+        }
+        Slot slot;
+        if (!_freeSlots.empty()) {
+            slot = _freeSlots.back();
+            _freeSlots.pop_back();
+            _keys[slot] = key;
+        }
+        else {
+            if (_keys.size() >= NONE) {
+                throw std::length_error("DenseIndex::insert() - too many keys");
+            }
+            slot = static_cast<Slot>(_keys.size());
+            _keys.push_back(key);
+        }
+        _slots.emplace(key, slot);
+        if (inserted) *inserted = true;
+        return slot;
+    }
+
+    /**
+    * @brief
+    *   Unmap a key, its slot may be handed out again by insert()
+    * @return
+    *   the slot the key had or NONE if the key was not mapped
+    **/
+    Slot erase(const Key key)
+    {
+        const auto it = _slots.find(key);
+        if (it == _slots.end()) {
+            return NONE;
+        }
+        const Slot slot = it->second;
+        _slots.erase(it);
+        _freeSlots.push_back(slot);
+        return slot;
+    }
+
+    /**
+    * @return
+    *   the key a slot is mapped to, undefined for a free slot
+    **/
+    Key getKey(const Slot slot) const
+    {
+        return _keys[slot];
+    }
+
+    /**
+    * @return
+    *   the number of mapped keys
+    **/
+    size_t size() const
+    {
+        return _slots.size();
+    }
+
+    /**
+    * @return
+    *   the number of slots handed out so far, all slots are below this
+    **/
+    size_t capacity() const
+    {
+        return _keys.size();
+    }
+
+    /**
+    * @brief
+    *   Unmap all keys
+    **/
+    void clear()
+    {
+        _slots.clear();
+        _keys.clear();
+        _freeSlots.clear();
+    }
+
+private:
+    std::unordered_map<Key, Slot> _slots;   //< Slot of each mapped key
+    std::vector<Key> _keys;                 //< Key of each slot
+    std::vector<Slot> _freeSlots;           //< Slots of erased keys
+};
+
+} // namespace Ego
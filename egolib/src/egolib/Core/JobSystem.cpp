@@ -0,0 +1,205 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "egolib/Core/JobSystem.hpp"
+
+namespace Ego {
+namespace Core {
+
+static_assert(0 == (JobSystem::DEQUE_CAPACITY & (JobSystem::DEQUE_CAPACITY - 1)), "deque capacity must be a power of two");
+
+namespace {
+// The job system and deque the current thread works for, if it is a worker.
+thread_local const JobSystem *t_jobSystem = nullptr;
+thread_local size_t t_dequeIndex = 0;
+}
+
+JobSystem::JobSystem(size_t workerCount) :
+    _workers(),
+    _deques(),
+    _queued(0),
+    _sleeping(0),
+    _terminateRequested(false),
+    _sleepMutex(),
+    _wakeUp() {
+    for (size_t i = 0; i < workerCount + 1; ++i) {
+        _deques.push_back(std::make_unique<Deque>());
+    }
+    for (size_t i = 0; i < workerCount; ++i) {
+        _workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _terminateRequested = true;
+    }
+    _wakeUp.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+    // Without workers, nobody else will run what is left.
+    size_t self = currentDeque();
+    while (tryRunOne(self)) {}
+}
+
+size_t JobSystem::currentDeque() const {
+    return (t_jobSystem == this) ? t_dequeIndex : _workers.size();
+}
+
+void JobSystem::push(const Job& job) {
+    // The job has not run yet, so it must still be pending.
+    assert(!job._counter || !job._counter->isDone());
+
+    Deque& deque = *_deques[currentDeque()];
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(deque.lock);
+        if (deque.bottom - deque.top < DEQUE_CAPACITY) {
+            deque.jobs[deque.bottom & (DEQUE_CAPACITY - 1)] = job;
+            deque.bottom++;
+            queued = true;
+        }
+    }
+    if (!queued) {
+        // Full, run it right here.
+        if (job._dependency) {
+            wait(*job._dependency);
+        }
+        job.run();
+        if (job._counter) {
+            job._counter->_pending.fetch_sub(1, std::memory_order_release);
+        }
+        return;
+    }
+
+    _queued.fetch_add(1);
+    if (_sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _wakeUp.notify_one();
+    }
+}
+
+bool JobSystem::pop(size_t self, Job& job) {
+    Deque& deque = *_deques[self];
+    std::lock_guard<std::mutex> lock(deque.lock);
+    if (deque.bottom == deque.top) {
+        return false;
+    }
+    deque.bottom--;
+    job = deque.jobs[deque.bottom & (DEQUE_CAPACITY - 1)];
+    _queued.fetch_sub(1);
+    return true;
+}
+
+bool JobSystem::steal(size_t victim, Job& job) {
+    Deque& deque = *_deques[victim];
+    std::lock_guard<std::mutex> lock(deque.lock);
+    if (deque.bottom == deque.top) {
+        return false;
+    }
+    job = deque.jobs[deque.top & (DEQUE_CAPACITY - 1)];
+    deque.top++;
+    _queued.fetch_sub(1);
+    return true;
+}
+
+void JobSystem::execute(size_t self, const Job& job) {
+    if (job._dependency && !job._dependency->isDone()) {
+        // Not ready yet, put it back at the top of our deque so everything else goes first.
+        // A stolen job did not make room in our deque, so it may be full.
+        Deque& deque = *_deques[self];
+        bool requeued = false;
+        {
+            std::lock_guard<std::mutex> lock(deque.lock);
+            if (deque.bottom - deque.top < DEQUE_CAPACITY) {
+                deque.top--;
+                deque.jobs[deque.top & (DEQUE_CAPACITY - 1)] = job;
+                requeued = true;
+            }
+        }
+        if (requeued) {
+            _queued.fetch_add(1);
+            std::this_thread::yield();
+            return;
+        }
+        // Full, run it right here once its dependency is done.
+        wait(*job._dependency);
+    }
+    job.run();
+    if (job._counter) {
+        job._counter->_pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool JobSystem::tryRunOne(size_t self) {
+    Job job;
+    if (pop(self, job)) {
+        execute(self, job);
+        return true;
+    }
+    for (size_t i = 1; i < _deques.size(); ++i) {
+        if (steal((self + i) % _deques.size(), job)) {
+            execute(self, job);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const size_t self = currentDeque();
+    while (!counter.isDone()) {
+        if (!tryRunOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t self) {
+    t_jobSystem = this;
+    t_dequeIndex = self;
+
+    static const size_t SPIN_COUNT = 64;
+    size_t idle = 0;
+    while (true) {
+        if (tryRunOne(self)) {
+            idle = 0;
+            continue;
+        }
+        if (_terminateRequested.load() && 0 == _queued.load()) {
+            return;
+        }
+        // Spin a little before going to sleep, new work tends to come in bursts.
+        if (++idle < SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleeping.fetch_add(1);
+        _wakeUp.wait(lock, [this]() { return _terminateRequested.load() || _queued.load() > 0; });
+        _sleeping.fetch_sub(1);
+    }
+}
+
+} // namespace Core
+} // namespace Ego
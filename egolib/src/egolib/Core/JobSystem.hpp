@@ -0,0 +1,219 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/JobSystem.hpp
+/// @brief  A work-stealing job system for fine-grained parallel work
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  Counts the unfinished jobs of a group. A counter is armed with the number of jobs of
+ *  the group before they are submitted, each job decrements it once it has run.
+ *  A counter at zero means the group is done.
+ * @remark
+ *  Counters are how a frame is expressed as a task graph: a job may name a counter it
+ *  depends on and will only start once that counter reached zero. As a counter which
+ *  was not armed yet is done, arm the counter of the prerequisites before submitting
+ *  the jobs depending on it.
+ */
+class JobCounter : public Id::NonCopyable {
+public:
+    JobCounter() : _pending(0) {}
+
+    /// @brief Add jobs to this group. Call this before submitting them.
+    void add(size_t count) {
+        _pending.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /// @brief Get if all jobs of this group have finished.
+    bool isDone() const {
+        return 0 == _pending.load(std::memory_order_acquire);
+    }
+
+private:
+    friend class JobSystem;
+    std::atomic<size_t> _pending;
+};
+
+/**
+ * @brief
+ *  A unit of work. The callable is stored inline, so submitting a job does not allocate.
+ * @remark
+ *  Callables must be trivially copyable and small (e.g. a lambda capturing a few
+ *  references and indices), jobs are copied around with memcpy semantics.
+ */
+class Job {
+public:
+    /// @brief Bytes available for the callable.
+    static const size_t STORAGE_SIZE = 48;
+
+    Job() : _invoke(nullptr), _counter(nullptr), _dependency(nullptr), _storage() {}
+
+    template <typename Function>
+    Job(const Function& function, JobCounter *counter, const JobCounter *dependency) :
+        _invoke(&invokeFunction<Function>), _counter(counter), _dependency(dependency), _storage() {
+        static_assert(sizeof(Function) <= STORAGE_SIZE, "job callable too large, capture by reference instead");
+        static_assert(alignof(Function) <= alignof(Storage), "job callable over-aligned");
+        static_assert(std::is_trivially_copyable<Function>::value, "job callable must be trivially copyable");
+        new (&_storage) Function(function);
+    }
+
+private:
+    friend class JobSystem;
+
+    typedef typename std::aligned_storage<STORAGE_SIZE, alignof(std::max_align_t)>::type Storage;
+
+    template <typename Function>
+    static void invokeFunction(const void *storage) {
+        (*reinterpret_cast<const Function *>(storage))();
+    }
+
+    void run() const {
+        _invoke(&_storage);
+    }
+
+    void (*_invoke)(const void *);      ///< Calls the stored callable
+    JobCounter *_counter;               ///< Decremented once this job has run, may be null
+    const JobCounter *_dependency;      ///< This job may not start before this counter is done, may be null
+    Storage _storage;                   ///< The callable
+};
+
+/**
+ * @brief
+ *  A job system with one deque per worker thread.
+ * @remark
+ *  A worker pushes and pops jobs at the bottom of its own deque (LIFO, cache friendly)
+ *  and steals from the top of the other deques (FIFO) when it runs out of work.
+ *  Threads that are not workers submit into an extra shared deque.
+ *  Waiting on a counter never blocks: the waiting thread runs jobs until the counter is done.
+ * @remark
+ *  Deques have a fixed capacity. If a deque is full, the job is run immediately on the
+ *  submitting thread instead. A job that is not ready and cannot be put back into a full
+ *  deque is run as soon as its dependency is done.
+ */
+class JobSystem : public Id::NonCopyable {
+public:
+    /// @brief Capacity of each deque.
+    static const size_t DEQUE_CAPACITY = 4096;
+
+    /**
+     * @brief
+     *  Construct this job system.
+     * @param workerCount
+     *  the number of worker threads. The thread calling wait() helps out,
+     *  so <tt>hardware_concurrency() - 1</tt> workers use all cores.
+     */
+    explicit JobSystem(size_t workerCount);
+
+    /**
+     * @brief
+     *  Destruct this job system. Jobs not yet run are run before the workers are joined.
+     */
+    ~JobSystem();
+
+    /// @brief Get the number of worker threads.
+    size_t getWorkerCount() const {
+        return _workers.size();
+    }
+
+    /**
+     * @brief
+     *  Submit a job.
+     * @param function
+     *  the callable, see Job
+     * @param counter
+     *  decremented when the job has run, may be null. The job must have been added to it.
+     * @param dependency
+     *  the job does not start before this counter is done, may be null
+     */
+    template <typename Function>
+    void submit(const Function& function, JobCounter *counter = nullptr, const JobCounter *dependency = nullptr) {
+        push(Job(function, counter, dependency));
+    }
+
+    /**
+     * @brief
+     *  Run jobs on the calling thread until the counter is done.
+     */
+    void wait(const JobCounter& counter);
+
+    /**
+     * @brief
+     *  Run <tt>function(first, last)</tt> over <tt>[begin, end)</tt> split into chunks of at most
+     *  @a grainSize indices and wait until all chunks are done.
+     * @remark
+     *  The calling thread takes part. If the range fits into one chunk, it runs inline.
+     */
+    template <typename Function>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const Function& function) {
+        if (begin >= end) {
+            return;
+        }
+        grainSize = std::max<size_t>(1, grainSize);
+        if (end - begin <= grainSize) {
+            function(begin, end);
+            return;
+        }
+
+        JobCounter counter;
+        counter.add((end - begin + grainSize - 1) / grainSize);
+        const Function *f = &function;
+        for (size_t first = begin; first < end; first += grainSize) {
+            const size_t last = std::min(end, first + grainSize);
+            submit([f, first, last]() { (*f)(first, last); }, &counter);
+        }
+        wait(counter);
+    }
+
+private:
+    /// A bounded deque guarded by a lock. Owners use the bottom, thieves the top.
+    struct Deque {
+        Deque() : lock(), top(0), bottom(0), jobs(DEQUE_CAPACITY) {}
+        std::mutex lock;
+        size_t top;
+        size_t bottom;
+        std::vector<Job> jobs;
+    };
+
+    void push(const Job& job);
+    bool tryRunOne(size_t self);
+    bool pop(size_t self, Job& job);
+    bool steal(size_t victim, Job& job);
+    void execute(size_t self, const Job& job);
+    void workerLoop(size_t self);
+    size_t currentDeque() const;
+
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<Deque>> _deques;    ///< One per worker plus one for external threads (the last)
+
+    std::atomic<size_t> _queued;                    ///< Jobs currently sitting in any deque
+    std::atomic<size_t> _sleeping;                  ///< Workers waiting on _wakeUp
+    std::atomic<bool> _terminateRequested;
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+};
+
+} // namespace Core
+} // namespace Ego
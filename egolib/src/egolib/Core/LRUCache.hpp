@@ -0,0 +1,245 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/LRUCache.hpp
+/// @brief  A hashed least-recently-used cache with a budget in bytes
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   The counters of an LRUCache.
+**/
+struct LRUCacheStatistics
+{
+    size_t hits;        ///< The number of find() calls that found an entry
+    size_t misses;      ///< The number of find() calls that found no entry
+    size_t evictions;   ///< The number of entries removed to stay within the budget
+    size_t entries;     ///< The number of entries in the cache
+    size_t bytes;       ///< The number of bytes used by the entries in the cache
+
+    LRUCacheStatistics() :
+        hits(0), misses(0), evictions(0), entries(0), bytes(0)
+    {
+        //ctor
+    }
+};
+
+/**
+* @brief
+*   A cache of values by key which evicts the least recently used entries when the sum of
+*   the sizes of its entries exceeds a budget.
+* @remark
+*   The entries are found by hashing the key. They are linked into a list in the order of
+*   their last use, the links live in the entries themselves so that finding, inserting and
+*   evicting an entry are all O(1) and using an entry does not allocate.
+* @remark
+*   The size of an entry is supplied by the caller, e.g. the size of a vertex buffer.
+**/
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache : Id::NonCopyable
+{
+public:
+    /**
+    * @brief
+    *   Construct an empty cache
+    * @param capacity
+    *   the budget of this cache in bytes
+    **/
+    LRUCache(size_t capacity) :
+        _capacity(capacity),
+        _entries(),
+        _lru(),
+        _statistics()
+    {
+        _lru.previous = _lru.next = &_lru;
+    }
+
+    /**
+    * @brief
+    *   Find the value of a key and mark it as the most recently used one
+    * @return
+    *   a pointer to the value or @a nullptr if the key is not in this cache. The pointer is
+    *   valid until the entry is evicted.
+    **/
+    Value *find(const Key& key)
+    {
+        auto it = _entries.find(key);
+        if (it == _entries.end())
+        {
+            _statistics.misses++;
+            return nullptr;
+        }
+        _statistics.hits++;
+        Entry& entry = it->second;
+        unlink(entry);
+        linkFront(entry);
+        return &entry.value;
+    }
+
+    /**
+    * @brief
+    *   Insert or replace the value of a key as the most recently used one and evict the least
+    *   recently used entries until this cache is within its budget again
+    * @param bytes
+    *   the size of the entry in bytes
+    * @return
+    *   a reference to the inserted value. The most recently used entry is never evicted, even
+    *   if it alone exceeds the budget.
+    **/
+    Value& insert(const Key& key, Value value, size_t bytes)
+    {
+        auto it = _entries.find(key);
+        if (it != _entries.end())
+        {
+            Entry& entry = it->second;
+            unlink(entry);
+            _statistics.bytes -= entry.bytes;
+            entry.value = std::move(value);
+            entry.bytes = bytes;
+            linkFront(entry);
+        }
+        else
+        {
+            it = _entries.emplace(key, Entry(std::move(value), bytes)).first;
+            it->second.key = &it->first;
+            linkFront(it->second);
+            _statistics.entries++;
+        }
+        _statistics.bytes += bytes;
+        while (_statistics.bytes > _capacity && _lru.previous != &it->second)
+        {
+            evict();
+        }
+        return it->second.value;
+    }
+
+    /**
+    * @brief
+    *   Remove all entries, the counters of hits, misses and evictions are kept
+    **/
+    void clear()
+    {
+        _entries.clear();
+        _lru.previous = _lru.next = &_lru;
+        _statistics.entries = 0;
+        _statistics.bytes = 0;
+    }
+
+    size_t getCapacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+    * @brief
+    *   Set the budget of this cache in bytes, evicting entries if necessary
+    **/
+    void setCapacity(size_t capacity)
+    {
+        _capacity = capacity;
+        while (_statistics.bytes > _capacity && !_entries.empty())
+        {
+            evict();
+        }
+    }
+
+    const LRUCacheStatistics& getStatistics() const
+    {
+        return _statistics;
+    }
+
+    /**
+    * @brief
+    *   Reset the counters of hits, misses and evictions
+    **/
+    void resetStatistics()
+    {
+        _statistics.hits = 0;
+        _statistics.misses = 0;
+        _statistics.evictions = 0;
+    }
+
+private:
+    struct Link
+    {
+        Link *previous;
+        Link *next;
+
+        Link() :
+            previous(nullptr), next(nullptr)
+        {
+            //ctor
+        }
+    };
+
+    struct Entry : Link
+    {
+        Value value;
+        size_t bytes;
+        const Key *key;     ///< The key of this entry in the map
+
+        Entry(Value value, size_t bytes) :
+            Link(), value(std::move(value)), bytes(bytes), key(nullptr)
+        {
+            //ctor
+        }
+    };
+
+    void unlink(Link& link)
+    {
+        link.previous->next = link.next;
+        link.next->previous = link.previous;
+    }
+
+    void linkFront(Link& link)
+    {
+        link.previous = &_lru;
+        link.next = _lru.next;
+        _lru.next->previous = &link;
+        _lru.next = &link;
+    }
+
+    void evict()
+    {
+        Entry *entry = static_cast<Entry *>(_lru.previous);
+        unlink(*entry);
+        _statistics.bytes -= entry->bytes;
+        _statistics.entries--;
+        _statistics.evictions++;
+        _entries.erase(_entries.find(*entry->key));
+    }
+
+    size_t _capacity;
+
+    /// The entries by key, the nodes of an unordered_map do not move when it rehashes.
+    std::unordered_map<Key, Entry, Hash> _entries;
+
+    /// The sentinel of the list of entries, the most recently used one first.
+    Link _lru;
+
+    LRUCacheStatistics _statistics;
+};
+
+} // namespace Ego
@@ -0,0 +1,172 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file   egolib/Core/SlotPool.hpp
+/// @brief  Slots of a pool with generation-checked references
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   Hands out the slots of a pool of objects and references to them.
+* @remark
+*   A reference holds the slot in its low SLOT_BITS bits and the generation of the slot above them.
+*   The generation of a slot is incremented every time the slot is handed out, hence references to
+*   earlier users of a slot do not match the current one. Released slots are reused last in, first out.
+**/
+class SlotPool
+{
+public:
+    static constexpr size_t SLOT_BITS = 16;                                 ///< Low bits of a reference holding the slot
+    static constexpr size_t SLOT_MASK = (size_t(1) << SLOT_BITS) - 1;
+    static constexpr size_t MAX_SLOTS = SLOT_MASK;                          ///< SLOT_MASK itself is never a slot
+
+    SlotPool() :
+        _generations(),
+        _used(),
+        _freeSlots()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Get the slot of a reference
+    **/
+    static size_t getSlot(const size_t reference)
+    {
+        return reference & SLOT_MASK;
+    }
+
+    /**
+    * @brief
+    *   Get the number of slots ever added
+    **/
+    size_t getSlotCount() const
+    {
+        return _generations.size();
+    }
+
+    /**
+    * @brief
+    *   Get if a released slot is waiting to be reused
+    **/
+    bool hasFreeSlot() const
+    {
+        return !_freeSlots.empty();
+    }
+
+    /**
+    * @brief
+    *   Add a new slot to the pool and hand it out
+    * @return
+    *   the slot, it is one past the previous last slot
+    * @throw std::length_error
+    *   if the pool already has MAX_SLOTS slots
+    **/
+    size_t addSlot()
+    {
+        if (_generations.size() >= MAX_SLOTS) {
+            throw std::length_error("SlotPool::addSlot() - too many slots");
+        }
+        _generations.push_back(0);
+        _used.push_back(true);
+        return _generations.size() - 1;
+    }
+
+    /**
+    * @brief
+    *   Hand out the most recently released slot
+    * @return
+    *   the slot
+    * @throw std::logic_error
+    *   if no slot is free
+    **/
+    size_t takeFreeSlot()
+    {
+        if (_freeSlots.empty()) {
+            throw std::logic_error("SlotPool::takeFreeSlot() - no free slot");
+        }
+        const size_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _used[slot] = true;
+        return slot;
+    }
+
+    /**
+    * @brief
+    *   Start a new generation of a slot that was handed out
+    * @return
+    *   the reference to the new user of the slot
+    **/
+    size_t makeReference(const size_t slot)
+    {
+        return (++_generations[slot] << SLOT_BITS) | slot;
+    }
+
+    /**
+    * @brief
+    *   Get if a reference refers to the current user of its slot
+    **/
+    bool isCurrent(const size_t reference) const
+    {
+        const size_t slot = getSlot(reference);
+        return slot < _generations.size() && _used[slot] && (_generations[slot] << SLOT_BITS | slot) == reference;
+    }
+
+    /**
+    * @brief
+    *   Give the slot of a reference back to the pool
+    * @throw Id::InvalidArgumentException
+    *   if the reference does not refer to the current user of its slot
+    **/
+    void release(const size_t reference)
+    {
+        if (!isCurrent(reference)) {
+            throw Id::InvalidArgumentException(__FILE__, __LINE__, "reference to a free slot or an earlier generation");
+        }
+        const size_t slot = getSlot(reference);
+        _used[slot] = false;
+        _freeSlots.push_back(slot);
+    }
+
+    /**
+    * @brief
+    *   Remove all slots
+    **/
+    void clear()
+    {
+        _generations.clear();
+        _used.clear();
+        _freeSlots.clear();
+    }
+
+private:
+    std::vector<size_t> _generations;   ///< Number of times each slot has been handed out
+    std::vector<bool> _used;            ///< If each slot is handed out
+    std::vector<size_t> _freeSlots;     ///< Released slots
+};
+
+} // namespace Ego
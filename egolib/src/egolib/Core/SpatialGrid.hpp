@@ -0,0 +1,363 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SpatialGrid.hpp
+/// @brief  Incrementally maintained uniform grid for fast element lookup based on bounding boxes
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Math/Standard.hpp"
+#include "egolib/Core/DenseIndex.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A uniform grid spatial index over plain element indices.
+* @remark
+*   Unlike QuadTree, the grid is not rebuilt every frame. Elements are inserted once
+*   and relocated with update() when they move; an element that stays within the same
+*   cells only has its bounds refreshed. All cell links live in one contiguous pool
+*   with a free list, so steady state operation does not allocate.
+* @remark
+*   Elements are identified by a caller supplied index (e.g. ObjectRef::get()).
+*   The index space may be sparse: each contained element is given a dense slot, the
+*   per-element records live in vectors indexed by that slot and slots of removed
+*   elements are reused.
+* @remark
+*   find() deduplicates elements that span several cells with a per-element query
+*   stamp, hence it is not thread-safe even though it is const.
+**/
+class SpatialGrid
+{
+public:
+    typedef size_t Index;
+
+    /**
+    * @brief
+    *   Construct an empty grid without bounds
+    * @param cellSize
+    *   the edge length of a grid cell, usually the size of a mesh tile
+    **/
+    SpatialGrid(const float cellSize = 128.0f) :
+        _cellSize(cellSize),
+        _invCellSize(1.0f / cellSize),
+        _minX(0.0f),
+        _minY(0.0f),
+        _maxX(0.0f),
+        _maxY(0.0f),
+        _cellsX(1),
+        _cellsY(1),
+        _cellHeads(1, NIL),
+        _links(),
+        _freeLink(NIL),
+        _slots(),
+        _elements(),
+        _queryStamps(),
+        _currentStamp(0)
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Removes all elements and sets new bounds for this grid
+    * @remark
+    *   Elements outside of the bounds are clamped into the border cells
+    **/
+    void reset(const float minX, const float minY, const float maxX, const float maxY)
+    {
+        _minX = minX;
+        _minY = minY;
+        _maxX = maxX;
+        _maxY = maxY;
+        _cellsX = std::max<int>(1, static_cast<int>(std::ceil((maxX - minX) * _invCellSize)));
+        _cellsY = std::max<int>(1, static_cast<int>(std::ceil((maxY - minY) * _invCellSize)));
+        _cellHeads.assign(static_cast<size_t>(_cellsX) * _cellsY, NIL);
+        _links.clear();
+        _freeLink = NIL;
+        _slots.clear();
+        _elements.clear();
+        _queryStamps.clear();
+        _currentStamp = 0;
+    }
+
+    /**
+    * @brief
+    *   Removes all elements but keeps the bounds and the allocated memory
+    **/
+    void clear()
+    {
+        reset(_minX, _minY, _maxX, _maxY);
+    }
+
+    /**
+    * @return
+    *   true if this grid was set up with exactly these bounds
+    **/
+    bool hasBounds(const float minX, const float minY, const float maxX, const float maxY) const
+    {
+        return _minX == minX && _minY == minY && _maxX == maxX && _maxY == maxY;
+    }
+
+    /**
+    * @return
+    *   true if the element is currently stored in this grid
+    **/
+    bool contains(const Index index) const
+    {
+        return _slots.find(index) != DenseIndex::NONE;
+    }
+
+    /**
+    * @return
+    *   number of elements currently stored in this grid
+    **/
+    size_t size() const
+    {
+        return _slots.size();
+    }
+
+    /**
+    * @brief
+    *   Inserts an element or relocates it if it is already contained in this grid.
+    * @param index
+    *   the index of the element
+    * @param bounds
+    *   the current 2D bounding box of the element
+    **/
+    void update(const Index index, const AxisAlignedBox2f &bounds)
+    {
+        bool inserted;
+        const DenseIndex::Slot slot = _slots.insert(index, &inserted);
+        if (slot >= _elements.size()) {
+            _elements.resize(slot + 1);
+            _queryStamps.resize(slot + 1, 0);
+        }
+
+        Element &element = _elements[slot];
+        element.minX = bounds.getMin()[kX];
+        element.minY = bounds.getMin()[kY];
+        element.maxX = bounds.getMax()[kX];
+        element.maxY = bounds.getMax()[kY];
+
+        const int cellMinX = toCellX(element.minX), cellMaxX = toCellX(element.maxX);
+        const int cellMinY = toCellY(element.minY), cellMaxY = toCellY(element.maxY);
+
+        if (!inserted) {
+            //Still covering the same cells? Then only the bounds changed
+            if (cellMinX == element.cellMinX && cellMaxX == element.cellMaxX &&
+                cellMinY == element.cellMinY && cellMaxY == element.cellMaxY) {
+                return;
+            }
+            unlinkElement(element);
+        }
+
+        element.cellMinX = cellMinX;
+        element.cellMaxX = cellMaxX;
+        element.cellMinY = cellMinY;
+        element.cellMaxY = cellMaxY;
+
+        for (int y = cellMinY; y <= cellMaxY; ++y) {
+            for (int x = cellMinX; x <= cellMaxX; ++x) {
+                const uint32_t cell = static_cast<uint32_t>(y * _cellsX + x);
+                const uint32_t link = allocateLink();
+                Link &l = _links[link];
+                l.element = slot;
+                l.cell = cell;
+                l.prev = NIL;
+                l.next = _cellHeads[cell];
+                if (l.next != NIL) {
+                    _links[l.next].prev = link;
+                }
+                _cellHeads[cell] = link;
+                l.nextOfElement = element.firstLink;
+                element.firstLink = link;
+            }
+        }
+    }
+
+    /**
+    * @brief
+    *   Removes an element from this grid
+    * @return
+    *   true if the element was contained in this grid
+    **/
+    bool remove(const Index index)
+    {
+        const DenseIndex::Slot slot = _slots.erase(index);
+        if (slot == DenseIndex::NONE) {
+            return false;
+        }
+        unlinkElement(_elements[slot]);
+        return true;
+    }
+
+    /**
+    * @brief
+    *   Find all elements whose bounding box intersects the search area.
+    *   Each element is reported at most once.
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param result
+    *   Element indices are appended to this vector
+    **/
+    void find(const AxisAlignedBox2f &searchArea, std::vector<Index> &result) const
+    {
+        const float searchMinX = searchArea.getMin()[kX], searchMaxX = searchArea.getMax()[kX];
+        const float searchMinY = searchArea.getMin()[kY], searchMaxY = searchArea.getMax()[kY];
+
+        const uint32_t stamp = nextStamp();
+
+        const int cellMinX = toCellX(searchMinX), cellMaxX = toCellX(searchMaxX);
+        const int cellMinY = toCellY(searchMinY), cellMaxY = toCellY(searchMaxY);
+        for (int y = cellMinY; y <= cellMaxY; ++y) {
+            for (int x = cellMinX; x <= cellMaxX; ++x) {
+                for (uint32_t link = _cellHeads[y * _cellsX + x]; link != NIL; link = _links[link].next) {
+                    const DenseIndex::Slot slot = _links[link].element;
+
+                    //Already visited in this query?
+                    if (_queryStamps[slot] == stamp) {
+                        continue;
+                    }
+                    _queryStamps[slot] = stamp;
+
+                    //Same semantics as Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f>
+                    const Element &element = _elements[slot];
+                    if (element.minX > searchMaxX || element.maxX < searchMinX ||
+                        element.minY > searchMaxY || element.maxY < searchMinY) {
+                        continue;
+                    }
+                    result.push_back(_slots.getKey(slot));
+                }
+            }
+        }
+    }
+
+private:
+    enum : uint32_t { NIL = 0xFFFFFFFFu };  //< End of a link chain
+
+    /// A membership of one element in one cell. Doubly linked within the cell for O(1) removal.
+    struct Link
+    {
+        DenseIndex::Slot element;
+        uint32_t cell;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t nextOfElement;
+    };
+
+    struct Element
+    {
+        Element() :
+            minX(0.0f), minY(0.0f), maxX(0.0f), maxY(0.0f),
+            cellMinX(0), cellMinY(0), cellMaxX(0), cellMaxY(0),
+            firstLink(NIL)
+        {
+            //ctor
+        }
+
+        float minX, minY, maxX, maxY;
+        int cellMinX, cellMinY, cellMaxX, cellMaxY;
+        uint32_t firstLink;
+    };
+
+    static int toCell(const float offset, const float invCellSize, const int cells)
+    {
+        //Clamp in float space first, infinite search areas would overflow the int conversion
+        const float cell = offset * invCellSize;
+        if (cell < 1.0f) return 0;
+        if (cell >= static_cast<float>(cells)) return cells - 1;
+        return static_cast<int>(cell);
+    }
+
+    int toCellX(const float x) const
+    {
+        return toCell(x - _minX, _invCellSize, _cellsX);
+    }
+
+    int toCellY(const float y) const
+    {
+        return toCell(y - _minY, _invCellSize, _cellsY);
+    }
+
+    uint32_t allocateLink()
+    {
+        if (_freeLink != NIL) {
+            const uint32_t link = _freeLink;
+            _freeLink = _links[link].next;
+            return link;
+        }
+        _links.emplace_back();
+        return static_cast<uint32_t>(_links.size() - 1);
+    }
+
+    void unlinkElement(Element &element)
+    {
+        uint32_t link = element.firstLink;
+        while (link != NIL) {
+            Link &l = _links[link];
+            if (l.prev != NIL) {
+                _links[l.prev].next = l.next;
+            }
+            else {
+                _cellHeads[l.cell] = l.next;
+            }
+            if (l.next != NIL) {
+                _links[l.next].prev = l.prev;
+            }
+
+            const uint32_t nextOfElement = l.nextOfElement;
+            l.next = _freeLink;
+            _freeLink = link;
+            link = nextOfElement;
+        }
+        element.firstLink = NIL;
+    }
+
+    uint32_t nextStamp() const
+    {
+        //On wrap-around, forget all old stamps
+        if (++_currentStamp == 0) {
+            std::fill(_queryStamps.begin(), _queryStamps.end(), 0);
+            _currentStamp = 1;
+        }
+        return _currentStamp;
+    }
+
+private:
+    float _cellSize;                                    //< Edge length of a cell
+    float _invCellSize;                                 //< 1 / _cellSize
+    float _minX, _minY, _maxX, _maxY;                   //< Bounds of the grid
+    int _cellsX, _cellsY;                               //< Number of cells along each axis
+
+    std::vector<uint32_t> _cellHeads;                   //< First link of each cell or NIL
+    std::vector<Link> _links;                           //< Pool of all cell memberships
+    uint32_t _freeLink;                                 //< Head of the free list in _links
+
+    DenseIndex _slots;                                  //< Slot of each contained element
+    std::vector<Element> _elements;                     //< Per-element records, indexed by slot
+
+    mutable std::vector<uint32_t> _queryStamps;         //< Last query that visited each slot
+    mutable uint32_t _currentStamp;                     //< Stamp of the current query
+};
+
+} //namespace Ego
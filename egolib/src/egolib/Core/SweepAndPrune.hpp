@@ -0,0 +1,272 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SweepAndPrune.hpp
+/// @brief  Frame coherent sort-and-sweep broad phase producing unique candidate pairs
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Math/Standard.hpp"
+#include "egolib/Core/DenseIndex.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A sort-and-sweep broad phase along the x-axis.
+* @remark
+*   Every frame, the caller adds one 2D box per proxy and then asks for all pairs of
+*   overlapping boxes. Each pair is reported exactly once. The x-order of the proxies
+*   is remembered between frames by a stable key (e.g. ObjectRef::get()) so that the
+*   sort is an almost linear insertion sort when things move only a little. Keys may be
+*   sparse, only the keys of the current and the previous frame are kept.
+* @remark
+*   Pairs are reported as slots, i.e. the positions in which the proxies were added
+*   this frame, with <tt>first < second</tt> and sorted lexicographically. If the
+*   proxies are added in a deterministic order, the pair list is deterministic too.
+**/
+class SweepAndPrune
+{
+public:
+    typedef size_t Key;
+
+    struct Pair
+    {
+        uint32_t first;     //< Slot of the proxy that was added first
+        uint32_t second;    //< Slot of the proxy that was added last
+
+        bool operator<(const Pair &other) const
+        {
+            return first < other.first || (first == other.first && second < other.second);
+        }
+
+        bool operator==(const Pair &other) const
+        {
+            return first == other.first && second == other.second;
+        }
+    };
+
+    SweepAndPrune() :
+        _proxies(),
+        _order(),
+        _previousKeys(),
+        _keys(),
+        _keySlots(),
+        _frame(0),
+        _sorted(true)
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Forget all proxies and the order remembered from the previous frame
+    **/
+    void clear()
+    {
+        _proxies.clear();
+        _order.clear();
+        _previousKeys.clear();
+        _keys.clear();
+        _keySlots.clear();
+        _frame = 0;
+        _sorted = true;
+    }
+
+    /**
+    * @brief
+    *   Start a new frame. All proxies of the previous frame are removed.
+    **/
+    void begin()
+    {
+        //Without findPairs(), the keys of the last frame were never remembered and would not be forgotten either
+        if (!_sorted) {
+            for (const Proxy &proxy : _proxies) {
+                _keys.erase(proxy.key);
+            }
+        }
+        _sorted = false;
+        _proxies.clear();
+
+        //On wrap-around, forget all old frames
+        if (++_frame == 0) {
+            std::fill(_keySlots.begin(), _keySlots.end(), KeySlot());
+            _frame = 1;
+        }
+    }
+
+    /**
+    * @brief
+    *   Add a proxy for this frame
+    * @param key
+    *   stable identity of the proxy across frames, must be unique within a frame
+    * @param bounds
+    *   the 2D box of the proxy
+    * @return
+    *   the slot of the proxy, used to report pairs
+    **/
+    uint32_t add(const Key key, const AxisAlignedBox2f &bounds)
+    {
+        const uint32_t slot = static_cast<uint32_t>(_proxies.size());
+        Proxy proxy;
+        proxy.minX = bounds.getMin()[kX];
+        proxy.minY = bounds.getMin()[kY];
+        proxy.maxX = bounds.getMax()[kX];
+        proxy.maxY = bounds.getMax()[kY];
+        proxy.key = key;
+        proxy.placed = false;
+        _proxies.push_back(proxy);
+
+        const DenseIndex::Slot keySlot = _keys.insert(key);
+        if (keySlot >= _keySlots.size()) {
+            _keySlots.resize(keySlot + 1);
+        }
+        _keySlots[keySlot].frame = _frame;
+        _keySlots[keySlot].slot = slot;
+        return slot;
+    }
+
+    /**
+    * @return
+    *   the number of proxies added this frame
+    **/
+    size_t size() const
+    {
+        return _proxies.size();
+    }
+
+    /**
+    * @brief
+    *   Find all pairs of proxies whose boxes overlap
+    * @param pairs
+    *   receives the pairs, it is cleared first
+    **/
+    void findPairs(std::vector<Pair> &pairs)
+    {
+        pairs.clear();
+        sortCoherent();
+
+        //Sweep along x, only proxies starting before the current one ends can overlap it
+        for (size_t i = 0; i < _order.size(); ++i) {
+            const Proxy &a = _proxies[_order[i]];
+            for (size_t j = i + 1; j < _order.size(); ++j) {
+                const Proxy &b = _proxies[_order[j]];
+                if (b.minX > a.maxX) {
+                    break;
+                }
+                if (b.minY > a.maxY || b.maxY < a.minY) {
+                    continue;
+                }
+
+                Pair pair;
+                pair.first = std::min(_order[i], _order[j]);
+                pair.second = std::max(_order[i], _order[j]);
+                pairs.push_back(pair);
+            }
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+private:
+    struct Proxy
+    {
+        float minX, minY, maxX, maxY;
+        Key key;
+        bool placed;
+    };
+
+    struct KeySlot
+    {
+        KeySlot() : frame(0), slot(0) {}
+        uint32_t frame;     //< Frame in which the key was added last
+        uint32_t slot;      //< Slot of the key in that frame
+    };
+
+    /**
+    * @brief
+    *   Sort the proxies of this frame along x, starting from the order of the previous frame
+    **/
+    void sortCoherent()
+    {
+        _order.clear();
+        _sorted = true;
+
+        //Proxies that existed in the previous frame keep their old position in the order
+        for (const Key key : _previousKeys) {
+            const DenseIndex::Slot keySlot = _keys.find(key);
+            if (keySlot == DenseIndex::NONE) {
+                continue;
+            }
+            const KeySlot &keyFrame = _keySlots[keySlot];
+            if (keyFrame.frame != _frame) {
+                //Gone since the previous frame
+                _keys.erase(key);
+                continue;
+            }
+            Proxy &proxy = _proxies[keyFrame.slot];
+            if (!proxy.placed) {
+                proxy.placed = true;
+                _order.push_back(keyFrame.slot);
+            }
+        }
+        const size_t coherent = _order.size();
+
+        //Nearly sorted already, so insertion sort is almost linear
+        for (size_t i = 1; i < coherent; ++i) {
+            const uint32_t slot = _order[i];
+            const float minX = _proxies[slot].minX;
+            size_t j = i;
+            while (j > 0 && _proxies[_order[j - 1]].minX > minX) {
+                _order[j] = _order[j - 1];
+                --j;
+            }
+            _order[j] = slot;
+        }
+
+        //New proxies are sorted separately and merged in
+        for (uint32_t slot = 0; slot < _proxies.size(); ++slot) {
+            if (!_proxies[slot].placed) {
+                _order.push_back(slot);
+            }
+        }
+        auto lessX = [this](const uint32_t a, const uint32_t b) { return _proxies[a].minX < _proxies[b].minX; };
+        std::sort(_order.begin() + coherent, _order.end(), lessX);
+        std::inplace_merge(_order.begin(), _order.begin() + coherent, _order.end(), lessX);
+
+        //Remember the order for the next frame
+        _previousKeys.resize(_order.size());
+        for (size_t i = 0; i < _order.size(); ++i) {
+            _previousKeys[i] = _proxies[_order[i]].key;
+        }
+    }
+
+private:
+    std::vector<Proxy> _proxies;            //< Proxies of this frame, indexed by slot
+    std::vector<uint32_t> _order;           //< Slots sorted by minX
+    std::vector<Key> _previousKeys;         //< Keys sorted by minX in the previous frame
+    DenseIndex _keys;                       //< Dense slot of each key of the current and the previous frame
+    std::vector<KeySlot> _keySlots;         //< Slot of each key in its last frame, indexed by dense slot
+    uint32_t _frame;                        //< Current frame number
+    bool _sorted;                           //< If findPairs() ran for the current frame
+};
+
+} //namespace Ego
@@ -26,16 +26,22 @@
 #include "egolib/Log/_Include.hpp"
 #include "egolib/strutil.h"
 
-bool map_read_v1(vfs_FILE& file, map_t& map)
+bool map_read_v1(map_buffer_t& buffer, map_t& map)
 {
     // Alias.
     auto& mem = map._mem;
 
+    const char *bytes = buffer.take(mem.tiles.size() * sizeof(Uint32));
+    if (!bytes)
+    {
+        return false;
+    }
+
     // Load tile data.
     for (auto& tile : mem.tiles)
     {
-        Uint32 ui32_tmp;
-        vfs_read_Uint32(file, &ui32_tmp);
+        Uint32 ui32_tmp = map_buffer_t::toUint32(bytes);
+        bytes += sizeof(Uint32);
 
         tile.type = Ego::Math::clipBits<8>( ui32_tmp >> 24 );
         tile.fx   = Ego::Math::clipBits<8>( ui32_tmp >> 16 );
@@ -26,6 +26,6 @@
 #include "egolib/FileFormats/map_file.h"
 
 /// Load a map.
-bool map_read_v1(vfs_FILE& file, map_t& map);
+bool map_read_v1(map_buffer_t& buffer, map_t& map);
 /// Save a map.
 bool map_write_v1(vfs_FILE& file, const map_t& map);
@@ -26,15 +26,21 @@
 #include "egolib/Log/_Include.hpp"
 #include "egolib/strutil.h"
 
-bool map_read_v2(vfs_FILE& file, map_t& map)
+bool map_read_v2(map_buffer_t& buffer, map_t& map)
 {
     // Alias.
     auto& mem = map._mem;
 
+    const char *bytes = buffer.take(mem.tiles.size() * sizeof(Uint8));
+    if (!bytes)
+    {
+        return false;
+    }
+
     // Load twist data.
     for (auto& tile : mem.tiles)
     {
-        vfs_read_Uint8(file, &tile.twist);
+        tile.twist = static_cast<Uint8>(*bytes++);
     }
 
     return true;
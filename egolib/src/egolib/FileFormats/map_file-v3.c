@@ -28,34 +28,29 @@
 #include "egolib/Log/_Include.hpp"
 #include "egolib/strutil.h"
 
-bool map_read_v3(vfs_FILE& file, map_t& map)
+bool map_read_v3(map_buffer_t& buffer, map_t& map)
 {
     // Alias.
     auto& mem = map._mem;
 
-    // Load the x-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
+    // The x-, y- and z-coordinates are stored one after another.
+    const size_t count = mem.vertices.size();
+    const char *bytes = buffer.take(3 * count * sizeof(float));
+    if (!bytes)
     {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
-        vertex.pos[kX] = ieee32_tmp;
+        return false;
     }
+    const char *xs = bytes,
+               *ys = bytes + count * sizeof(float),
+               *zs = bytes + 2 * count * sizeof(float);
 
-    // Load the y-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
+    for (size_t i = 0; i < count; ++i)
     {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
-        vertex.pos[kY] = ieee32_tmp;
-    }
-
-    // Load the z-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
-    {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
+        auto& vertex = mem.vertices[i];
+        vertex.pos[kX] = map_buffer_t::toFloat(xs + i * sizeof(float));
+        vertex.pos[kY] = map_buffer_t::toFloat(ys + i * sizeof(float));
         // Cartman scales the z-axis based off of a 4 bit fixed precision number.
-        vertex.pos[kZ] = ieee32_tmp / 16.0f;
+        vertex.pos[kZ] = map_buffer_t::toFloat(zs + i * sizeof(float)) / 16.0f;
     }
 
     return true;
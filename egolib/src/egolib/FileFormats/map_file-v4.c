@@ -26,15 +26,21 @@
 #include "egolib/Log/_Include.hpp"
 #include "egolib/strutil.h"
 
-bool map_read_v4(vfs_FILE& file, map_t& map)
+bool map_read_v4(map_buffer_t& buffer, map_t& map)
 {
     // Alias.
     auto& mem = map._mem;
 
+    const char *bytes = buffer.take(mem.vertices.size() * sizeof(Uint8));
+    if (!bytes)
+    {
+        return false;
+    }
+
     // Load vertex a data
     for (map_vertex_t& vertex : mem.vertices)
     {
-        vfs_read_Uint8(file, &vertex.a);
+        vertex.a = static_cast<Uint8>(*bytes++);
     }
 
     return true;
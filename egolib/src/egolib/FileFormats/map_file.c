@@ -76,16 +76,24 @@ void map_info_t::reset()
     _tileCountY = 0;
 }
 
-void map_info_t::load(vfs_FILE& file)
+bool map_info_t::load(map_buffer_t& buffer)
 {
+    const char *bytes = buffer.take(3 * sizeof(Uint32));
+    if (!bytes)
+    {
+        return false;
+    }
+
     // Read the vertex count.
-    vfs_read_Uint32(file, &_vertexCount);
+    _vertexCount = map_buffer_t::toUint32(bytes + 0 * sizeof(Uint32));
 
     // Read the tile count in the x direction.
-    vfs_read_Uint32(file, &_tileCountX);
+    _tileCountX = map_buffer_t::toUint32(bytes + 1 * sizeof(Uint32));
 
     // Read the tile count in the y direction.
-    vfs_read_Uint32(file, &_tileCountY);
+    _tileCountY = map_buffer_t::toUint32(bytes + 2 * sizeof(Uint32));
+
+    return true;
 }
 
 void map_info_t::save(vfs_FILE& file) const
@@ -182,9 +190,35 @@ const tile_info_t& map_mem_t::operator()(size_t i) const {
 
 bool map_t::load(vfs_FILE& file)
 {
+    // Read the remainder of the file and decode it from memory.
+    std::vector<char> data;
+    size_t size = 0;
+    while (!vfs_eof(&file))
+    {
+        data.resize(size + 64 * 1024);
+        size += vfs_read(data.data() + size, 1, data.size() - size, &file);
+        if (vfs_error(&file))
+        {
+            setInfo();
+            return false;
+        }
+    }
+    return load(data.data(), size);
+}
+
+bool map_t::load(const char *data, size_t size)
+{
+    map_buffer_t buffer(data, size);
+
     // Read the file version.
-    Uint32 version;
-    vfs_read_Uint32(file, &version);
+    const char *bytes = buffer.take(sizeof(Uint32));
+    if (!bytes)
+    {
+        Log::get().warn("%s - unknown map type!!\n", __FUNCTION__);
+        setInfo();
+        return false;
+    }
+    Uint32 version = map_buffer_t::toUint32(bytes);
     version = SDL_Swap32(version); // This number is backwards for our purpose.
     int mapVersion = GET_MAP_VERSION_NUMBER(version);
 
@@ -204,7 +238,10 @@ bool map_t::load(vfs_FILE& file)
 
         // Read the header.
         map_info_t loc_info;
-        loc_info.load(file);
+        if (!loc_info.load(buffer))
+        {
+            goto Fail;
+        }
 
         // Validate the header if rerquired.
         if (validate && !loc_info.validate())
@@ -222,7 +259,7 @@ bool map_t::load(vfs_FILE& file)
         // version 1 data is required
         if (mapVersion > 0)
         {
-            if (!map_read_v1(file, *this))
+            if (!map_read_v1(buffer, *this))
             {
                 goto Fail;
             }
@@ -231,7 +268,7 @@ bool map_t::load(vfs_FILE& file)
         // version 2 data is optional-ish
         if (mapVersion > 1)
         {
-            if (!map_read_v2(file, *this))
+            if (!map_read_v2(buffer, *this))
             {
                 goto Fail;
             }
@@ -251,7 +288,7 @@ bool map_t::load(vfs_FILE& file)
         // version 3 data is optional-ish
         if (mapVersion > 2)
         {
-            if (!map_read_v3(file, *this))
+            if (!map_read_v3(buffer, *this))
             {
                 goto Fail;
             }
@@ -271,7 +308,7 @@ bool map_t::load(vfs_FILE& file)
         // version 4 data is completely optional
         if (mapVersion > 3)
         {
-            if (!map_read_v4(file, *this))
+            if (!map_read_v4(buffer, *this))
             {
                 goto Fail;
             }
@@ -289,33 +326,20 @@ Fail:
 
 bool map_t::load(const std::string& name)
 {
-    vfs_FILE *file = vfs_openRead(name.c_str());
-    if (!file)
+    // Read the whole file at once.
+    char *data = nullptr;
+    size_t size = 0;
+    if (!vfs_readEntireFile(name, &data, &size))
     {
 		Log::get().warn("%s:%d: cannot find \"%s\"!!\n", __FILE__, __LINE__, name.c_str());
-        goto Fail;
-    }
-
-    if (!load(*file))
-    {
-        goto Fail;
+        setInfo();
+        return false;
     }
 
-    vfs_close(file);
+    bool result = load(data, size);
+    free(data);
 
-    return true;
-
-Fail:
-
-    setInfo();
-
-    if (file)
-    {
-        vfs_close(file);
-        file = nullptr;
-    }
-
-    return false;
+    return result;
 }
 
 bool map_t::save(vfs_FILE& file) const
@@ -21,6 +21,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/vfs.h"
+#include "egolib/endian.h"
 #include "egolib/_math.h"
 #include "egolib/Math/_Include.hpp"
 #include "egolib/FileFormats/map_tile_dictionary.h"
@@ -124,6 +125,70 @@ constexpr uint32_t MAP_VERTICES_MAX = MAP_TILE_MAX*MAP_FAN_VERTICES_MAX;
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
+/**
+ * @brief
+ *  The bytes of an MPD file in memory, read front to back.
+ * @remark
+ *  The whole file is read at once and the sections are decoded from memory
+ *  instead of calling vfs_read_Uint32() or vfs_read_float() for every field.
+ */
+struct map_buffer_t
+{
+private:
+    const char *_data;
+    size_t _size;
+    size_t _position;
+public:
+    /**
+     * @brief
+     *  Construct this buffer.
+     * @param data
+     *  a pointer to the bytes. The bytes must remain valid as long as this buffer is used.
+     * @param size
+     *  the number of bytes
+     */
+    map_buffer_t(const char *data, size_t size)
+        : _data(data), _size(size), _position(0)
+    {}
+
+    /**
+     * @brief
+     *  Take bytes from the front of this buffer.
+     * @param count
+     *  the number of bytes
+     * @return
+     *  a pointer to the bytes, a null pointer if there are less than @a count bytes left
+     */
+    const char *take(size_t count)
+    {
+        if (count > _size - _position)
+        {
+            return nullptr;
+        }
+        const char *bytes = _data + _position;
+        _position += count;
+        return bytes;
+    }
+
+    /// @brief Decode a little-endian Uint32 in an MPD file.
+    static Uint32 toUint32(const char *bytes)
+    {
+        Uint32 value;
+        std::memcpy(&value, bytes, sizeof(Uint32));
+        return ENDIAN_TO_SYS_INT32(value);
+    }
+
+    /// @brief Decode a little-endian IEEE 754 float in an MPD file.
+    static float toFloat(const char *bytes)
+    {
+        float value;
+        std::memcpy(&value, bytes, sizeof(float));
+        return ENDIAN_TO_SYS_IEEE32(value);
+    }
+};
+
+//--------------------------------------------------------------------------------------------
+
 /**
  * @brief
  *  Temporary structure for reading and writing MPD files.
@@ -217,11 +282,13 @@ public:
 public:
     /**
      * @brief
-     *  Load creation parameters from a file.
-     * @param file
-     *  the source file
+     *  Load creation parameters from a buffer.
+     * @param buffer
+     *  the source buffer
+     * @return
+     *  @a true on success, @a false if the buffer ends prematurely
      */
-    void load(vfs_FILE& file);
+    bool load(map_buffer_t& buffer);
 
     /**
      * @brief
@@ -353,9 +420,21 @@ public:
      *  Load a map from a file.
      * @param name
      *  the name to load the map from
+     * @remark
+     *  The file is read with a single bulk read and decoded from memory.
      */
     bool load(const std::string& name);
 
+    /**
+     * @brief
+     *  Load a map from the bytes of an MPD file in memory.
+     * @param data
+     *  a pointer to the bytes
+     * @param size
+     *  the number of bytes
+     */
+    bool load(const char *data, size_t size);
+
     /**
      * @brief
      *  Save a map to a file.
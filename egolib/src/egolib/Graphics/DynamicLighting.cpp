@@ -0,0 +1,330 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/DynamicLighting.cpp
+/// @brief  Lighting vectors, dynamic lights and the binning of dynamic lights into a grid
+
+#include "egolib/Graphics/DynamicLighting.hpp"
+
+//--------------------------------------------------------------------------------------------
+
+void lighting_vector_evaluate(const LightingVector& lvec, const Vector3f& nrm, float& dir, float& amb)
+{
+    dir = 0.0f;
+    amb = 0.0f;
+
+    if ( nrm[kX] > 0.0f )
+    {
+        dir += nrm[kX] * lvec[LVEC_PX];
+    }
+    else if ( nrm[kX] < 0.0f )
+    {
+        dir -= nrm[kX] * lvec[LVEC_MX];
+    }
+
+    if ( nrm[kY] > 0.0f )
+    {
+        dir += nrm[kY] * lvec[LVEC_PY];
+    }
+    else if ( nrm[kY] < 0.0f )
+    {
+        dir -= nrm[kY] * lvec[LVEC_MY];
+    }
+
+    if ( nrm[kZ] > 0.0f )
+    {
+        dir += nrm[kZ] * lvec[LVEC_PZ];
+    }
+    else if ( nrm[kZ] < 0.0f )
+    {
+        dir -= nrm[kZ] * lvec[LVEC_MZ];
+    }
+
+    // the ambient is not summed
+    amb += lvec[LVEC_AMB];
+}
+
+void lighting_vector_sum(LightingVector& lvec, const Vector3f& nrm, const float direct, const float ambient)
+{
+    if ( nrm.x() > 0.0f )
+    {
+        lvec[LVEC_PX] += nrm.x() * direct;
+    }
+    else if ( nrm.x() < 0.0f )
+    {
+        lvec[LVEC_MX] -= nrm.x() * direct;
+    }
+
+    if ( nrm.y() > 0.0f )
+    {
+        lvec[LVEC_PY] += nrm.y() * direct;
+    }
+    else if ( nrm.y() < 0.0f )
+    {
+        lvec[LVEC_MY] -= nrm.y() * direct;
+    }
+
+    if ( nrm.z() > 0.0f )
+    {
+        lvec[LVEC_PZ] += nrm.z() * direct;
+    }
+    else if ( nrm.z() < 0.0f )
+    {
+        lvec[LVEC_MZ] -= nrm.z() * direct;
+    }
+
+    // the ambient is not summed
+    lvec[LVEC_AMB] += ambient;
+}
+
+//--------------------------------------------------------------------------------------------
+float dyna_lighting_intensity( const dynalight_data_t * pdyna, const Vector3f& diff )
+{
+    if ( NULL == pdyna || 0.0f == pdyna->level ) return 0.0f;
+
+    float rho_sqr  = diff[kX] * diff[kX] + diff[kY] * diff[kY];
+    float y2 = rho_sqr * 2.0f / 765.0f / pdyna->falloff;
+
+    if ( y2 > 1.0f ) return false;
+
+    float level = 1.0f - 0.5f * y2 * ( 3.0f - y2 * y2 );
+    level *= pdyna->level;
+
+    return level;
+}
+
+//--------------------------------------------------------------------------------------------
+bool sum_dyna_lighting( const dynalight_data_t * pdyna, LightingVector& lighting, const Vector3f& nrm )
+{
+    if ( NULL == pdyna ) return false;
+
+    float level = 255.0f * dyna_lighting_intensity( pdyna, nrm );
+    if ( 0.0f == level ) return true;
+
+    // allow negative lighting, or blind spots will not work properly
+	float rad_sqr = nrm.length_2();
+
+    // make a local copy of the normal so we do not normalize the data in the calling function
+	Vector3f local_nrm = nrm;
+
+    // do the normalization
+    if ( 1.0f != rad_sqr && 0.0f != rad_sqr )
+    {
+        float rad = std::sqrt( rad_sqr );
+        local_nrm.x() /= rad;
+        local_nrm.y() /= rad;
+        local_nrm.z() /= rad;
+    }
+
+    // sum the lighting
+    lighting_vector_sum(lighting, local_nrm, level, 0.0f);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------
+void dynalight_data_t::init(dynalight_data_t& self)
+{
+	self.distance = 1000.0f;
+	self.falloff = 255.0f;
+	self.level = 0.0f;
+	self.pos = Vector3f::zero();
+}
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+
+namespace Ego
+{
+namespace Graphics
+{
+
+void select_dynalights(std::vector<dynalight_data_t>& lights, size_t count)
+{
+    count = std::min(count, lights.size());
+    std::partial_sort(lights.begin(), lights.begin() + count, lights.end(),
+                      [](const dynalight_data_t& x, const dynalight_data_t& y) { return x.distance < y.distance; });
+    lights.erase(lights.begin() + count, lights.end());
+}
+
+DynamicLightGrid::DynamicLightGrid(const float cellSize, const float tileSize) :
+    _cellSize(cellSize),
+    _invCellSize(1.0f / cellSize),
+    _tileSize(tileSize),
+    _minX(0.0f),
+    _minY(0.0f),
+    _cellsX(1),
+    _cellsY(1),
+    _bound(),
+    _lights(),
+    _cellStarts(2, 0),
+    _cellLights()
+{
+    //ctor
+}
+
+int DynamicLightGrid::toCell(const float offset, const float invCellSize, const int cells)
+{
+    // Clamp in float space first, the offset of a far away light would overflow the int conversion.
+    const float cell = offset * invCellSize;
+    if (cell < 1.0f) return 0;
+    if (cell >= static_cast<float>(cells)) return cells - 1;
+    return static_cast<int>(cell);
+}
+
+float DynamicLightGrid::getRadius(const dynalight_data_t& light)
+{
+    return std::sqrt(light.falloff * 765.0f * 0.5f);
+}
+
+void DynamicLightGrid::clear()
+{
+    _lights.clear();
+    _cellsX = 1;
+    _cellsY = 1;
+    _cellStarts.assign(2, 0);
+    _cellLights.clear();
+}
+
+size_t DynamicLightGrid::getLightCount() const
+{
+    return _lights.size();
+}
+
+void DynamicLightGrid::reset(const ego_frect_t& bound, const std::vector<dynalight_data_t>& lights)
+{
+    clear();
+
+    // The grid points up to a tile outside of the rectangle may be reached. The cells of a light
+    // are found with a margin of a whole tile as well, so no rounding error can drop a light.
+    _minX = bound.xmin - _tileSize;
+    _minY = bound.ymin - _tileSize;
+    _cellsX = std::max(1, static_cast<int>(std::ceil((bound.xmax - bound.xmin + 2.0f * _tileSize) * _invCellSize)));
+    _cellsY = std::max(1, static_cast<int>(std::ceil((bound.ymax - bound.ymin + 2.0f * _tileSize) * _invCellSize)));
+
+    _bound.xmin = bound.xmax;
+    _bound.xmax = bound.xmin;
+    _bound.ymin = bound.ymax;
+    _bound.ymax = bound.ymin;
+
+    for (const dynalight_data_t& light : lights)
+    {
+        if (light.falloff <= 0.0f || 0.0f == light.level) continue;
+
+        const float radius = getRadius(light);
+
+        // find the intersection with the rectangle
+        Light entry;
+        entry.bound.xmin = std::max(light.pos[kX] - radius, bound.xmin);
+        entry.bound.xmax = std::min(light.pos[kX] + radius, bound.xmax);
+        entry.bound.ymin = std::max(light.pos[kY] - radius, bound.ymin);
+        entry.bound.ymax = std::min(light.pos[kY] + radius, bound.ymax);
+        if (entry.bound.xmin >= entry.bound.xmax || entry.bound.ymin >= entry.bound.ymax) continue;
+
+        entry.data = light;
+        entry.cellMinX = toCell(entry.bound.xmin - _tileSize - _minX, _invCellSize, _cellsX);
+        entry.cellMaxX = toCell(entry.bound.xmax + _tileSize - _minX, _invCellSize, _cellsX);
+        entry.cellMinY = toCell(entry.bound.ymin - _tileSize - _minY, _invCellSize, _cellsY);
+        entry.cellMaxY = toCell(entry.bound.ymax + _tileSize - _minY, _invCellSize, _cellsY);
+        _lights.push_back(entry);
+
+        _bound.xmin = std::min(_bound.xmin, entry.bound.xmin);
+        _bound.xmax = std::max(_bound.xmax, entry.bound.xmax);
+        _bound.ymin = std::min(_bound.ymin, entry.bound.ymin);
+        _bound.ymax = std::max(_bound.ymax, entry.bound.ymax);
+    }
+
+    // Count the lights of each cell, _cellStarts[cell + 1] is the count of cell.
+    _cellStarts.assign(static_cast<size_t>(_cellsX) * _cellsY + 1, 0);
+    for (const Light& light : _lights)
+    {
+        for (int y = light.cellMinY; y <= light.cellMaxY; ++y)
+        {
+            for (int x = light.cellMinX; x <= light.cellMaxX; ++x)
+            {
+                _cellStarts[y * _cellsX + x + 1]++;
+            }
+        }
+    }
+    for (size_t cell = 1; cell < _cellStarts.size(); ++cell)
+    {
+        _cellStarts[cell] += _cellStarts[cell - 1];
+    }
+
+    // Fill the cells in the order of the lights. Each start is advanced past its cell
+    // and then shifted back into place.
+    _cellLights.resize(_cellStarts.back());
+    for (size_t index = 0; index < _lights.size(); ++index)
+    {
+        const Light& light = _lights[index];
+        for (int y = light.cellMinY; y <= light.cellMaxY; ++y)
+        {
+            for (int x = light.cellMinX; x <= light.cellMaxX; ++x)
+            {
+                _cellLights[_cellStarts[y * _cellsX + x]++] = static_cast<uint32_t>(index);
+            }
+        }
+    }
+    for (size_t cell = _cellStarts.size() - 1; cell > 0; --cell)
+    {
+        _cellStarts[cell] = _cellStarts[cell - 1];
+    }
+    _cellStarts[0] = 0;
+}
+
+size_t DynamicLightGrid::illuminate(const float x, const float y, const float zLow, const float zHigh, LightingVector& low, LightingVector& high) const
+{
+    if (_lights.empty()) return 0;
+
+    ego_frect_t tile;
+    tile.xmin = x - _tileSize * 0.5f;
+    tile.xmax = x + _tileSize * 0.5f;
+    tile.ymin = y - _tileSize * 0.5f;
+    tile.ymax = y + _tileSize * 0.5f;
+
+    // check the bounding box of this grid point vs. the bounding box of all lights
+    if (tile.xmin > _bound.xmax || tile.xmax < _bound.xmin) return 0;
+    if (tile.ymin > _bound.ymax || tile.ymax < _bound.ymin) return 0;
+
+    const size_t cell = toCell(y - _minY, _invCellSize, _cellsY) * _cellsX + toCell(x - _minX, _invCellSize, _cellsX);
+    size_t count = 0;
+    for (uint32_t entry = _cellStarts[cell]; entry < _cellStarts[cell + 1]; ++entry)
+    {
+        const Light& light = _lights[_cellLights[entry]];
+
+        // does this dynamic light intersect this grid point?
+        if (tile.xmin > light.bound.xmax || tile.xmax < light.bound.xmin) continue;
+        if (tile.ymin > light.bound.ymax || tile.ymax < light.bound.ymin) continue;
+
+        Vector3f nrm;
+        nrm[kX] = light.data.pos[kX] - x;
+        nrm[kY] = light.data.pos[kY] - y;
+        nrm[kZ] = light.data.pos[kZ] - zLow;
+        sum_dyna_lighting(&light.data, low, nrm);
+
+        nrm[kZ] = light.data.pos[kZ] - zHigh;
+        sum_dyna_lighting(&light.data, high, nrm);
+
+        count++;
+    }
+    return count;
+}
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,221 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/DynamicLighting.hpp
+/// @brief  Lighting vectors, dynamic lights and the binning of dynamic lights into a grid
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+
+enum
+{
+    LVEC_PX,               ///< light from +x
+    LVEC_MX,               ///< light from -x
+
+    LVEC_PY,               ///< light from +y
+    LVEC_MY,               ///< light from -y
+
+    LVEC_PZ,               ///< light from +z
+    LVEC_MZ,               ///< light from -z
+
+    LVEC_AMB,             ///< light from ambient
+
+    LIGHTING_VEC_SIZE
+};
+
+/**
+ * @brief A lighting vector. Its components denote the directed and undirected (aka ambient) light
+ * @todo Egoboo's lighting vectors do not denote the color of the light (yet).
+ */
+typedef std::array<float, LIGHTING_VEC_SIZE> LightingVector;
+
+/**
+ * @brief Evaluate a lighting vector w.r.t. to a given surface normal.
+ * @param lvec the lighting vector
+ * @param nrm the surface normal
+ * @param [out] direct the resulting directed lighting
+ * @param [out] amb the resulting undirected (aka ambient) lighting
+ * @todo Properly describe what the resulting directed and undirected lighting are.
+ */
+void lighting_vector_evaluate( const LightingVector& lvec, const Vector3f& nrm, float& direct, float& amb);
+void lighting_vector_sum(LightingVector& lvec, const Vector3f& nrm, const float direct, const float ambient);
+
+//--------------------------------------------------------------------------------------------
+
+/// A definition of a single in-game dynamic light
+struct dynalight_data_t
+{
+    float    distance;      ///< The distance from the center of the camera view
+	Vector3f pos;           ///< Light position
+    float    level;         ///< Light intensity
+    float    falloff;       ///< Light radius
+
+	static void init(dynalight_data_t& self);
+};
+
+bool sum_dyna_lighting( const dynalight_data_t * pdyna, LightingVector& lighting, const Vector3f& nrm );
+
+/// @author BB
+/// @details In the Aaron's lighting, the falloff function was
+///                  light = (255 - r^2 / falloff) / 255.0f
+///              this has a definite max radius for the light, rmax = sqrt(falloff*255),
+///              which was good because we could have a definite range for a given light
+///
+///              This is not ideal because the light cuts off too abruptly. The new form of the
+///              function is (in semi-maple notation)
+///
+///              f(n,r) = integral( (1+y)^n * y * (1-y)^n, y = -1 .. r )
+///
+///              this has the advantage that it forms a bell-shaped curve that approaches 0 smoothly
+///              at r = -1 and r = 1. The lowest order term will always be quadratic in r, just like
+///              Aaron's function. To eliminate terms like r^4 and higher order even terms, you can
+///              various f(n,r) with different n's. But combining terms with larger and larger
+///              n means that the left-over terms that make the function approach zero smoothly
+///              will have higher and higher powers of r (more expensive) and the cutoff will
+///              be sharper and sharper (which is against the whole point of this type of function).
+///
+///              Eliminating just the r^4 term gives the function
+///                  f(y) = 1 - y^2 * ( 3.0f - y^4 ) / 2
+///              to make it match Aaron's function best, you have to scale the function by
+///                  y^2 = r^2 * 2 / 765 / falloff
+///
+///              I have previously tried rational polynomial functions like
+///                  f(r) = k0 / (1 + k1 * r^2 ) + k2 / (1 + k3 * r^4 )
+///              where the second term is to cancel make the function behave like Aaron's
+///              at small r, and to make the function approximate same "size" of lighting area
+///              as Aarons. An added benefit is that this function automatically has the right
+///              "physics" behavior at large distances (falls off like 1/r^2). But that is the
+///              exact problem because the infinite range means that it can potentally affect
+///              the entire mesh, causing problems with computing a large number of lights
+float  dyna_lighting_intensity( const dynalight_data_t * pdyna, const Vector3f& diff );
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+
+namespace Ego
+{
+namespace Graphics
+{
+
+/**
+ * @brief
+ *  Keep the @a count lights closest to the camera.
+ * @param lights
+ *  the lights, afterwards the closest lights sorted by their distance
+ */
+void select_dynalights(std::vector<dynalight_data_t>& lights, size_t count);
+
+/**
+ * @brief
+ *  The dynamic lights reaching a rectangle of the mesh, binned into a uniform grid.
+ * @remark
+ *  A light reaches the square of the size of a tile around a grid point if its bounding square
+ *  (see getRadius()) clipped to the rectangle intersects that square. Each cell lists the lights
+ *  which reach any grid point within it, hence illuminate() only visits the lights of one cell.
+ *  The lists of all cells are stored back to back and are rebuilt by reset() without allocating
+ *  once the grid has grown to its working size.
+ * @remark
+ *  Each cell lists its lights in the order they were passed to reset(), so a grid point gets
+ *  exactly the lighting it would get from testing every light.
+ */
+class DynamicLightGrid
+{
+public:
+    /**
+     * @brief
+     *  Construct an empty grid.
+     * @param cellSize
+     *  the edge length of a cell, e.g. the size of a block
+     * @param tileSize
+     *  the edge length of a tile
+     */
+    DynamicLightGrid(const float cellSize = 512.0f, const float tileSize = 128.0f);
+
+    /**
+     * @brief
+     *  Bin the lights reaching a rectangle.
+     * @param bound
+     *  the rectangle, usually the visible part of the mesh
+     * @remark
+     *  Lights without level or falloff and lights not reaching the rectangle are left out.
+     */
+    void reset(const ego_frect_t& bound, const std::vector<dynalight_data_t>& lights);
+
+    /**
+     * @brief
+     *  Remove all lights.
+     */
+    void clear();
+
+    /**
+     * @return
+     *  the number of lights reaching the rectangle
+     */
+    size_t getLightCount() const;
+
+    /**
+     * @brief
+     *  Add the lighting of the lights reaching a grid point at two heights.
+     * @param x, y
+     *  the grid point
+     * @param zLow, zHigh
+     *  the low and the high height
+     * @param low, high
+     *  the lighting at the low and at the high height
+     * @return
+     *  the number of lights which were added
+     */
+    size_t illuminate(const float x, const float y, const float zLow, const float zHigh, LightingVector& low, LightingVector& high) const;
+
+    /**
+     * @return
+     *  half of the edge length of the bounding square of a light
+     */
+    static float getRadius(const dynalight_data_t& light);
+
+private:
+    /// A light reaching the rectangle.
+    struct Light
+    {
+        dynalight_data_t data;
+        ego_frect_t bound;      ///< The bounding square of the light clipped to the rectangle.
+        int cellMinX, cellMinY; ///< The cells the light is listed in.
+        int cellMaxX, cellMaxY;
+    };
+
+    static int toCell(const float offset, const float invCellSize, const int cells);
+
+    float _cellSize;                    ///< Edge length of a cell.
+    float _invCellSize;                 ///< 1 / _cellSize.
+    float _tileSize;                    ///< Edge length of a tile.
+    float _minX, _minY;                 ///< The lower corner of the grid.
+    int _cellsX, _cellsY;               ///< Number of cells along each axis.
+    ego_frect_t _bound;                 ///< The union of the bounds of the lights.
+
+    std::vector<Light> _lights;         ///< The lights reaching the rectangle.
+    std::vector<uint32_t> _cellStarts;  ///< The first entry of each cell in _cellLights, followed by the entry count.
+    std::vector<uint32_t> _cellLights;  ///< The indices of the lights of all cells, cell by cell.
+};
+
+} // namespace Graphics
+} // namespace Ego
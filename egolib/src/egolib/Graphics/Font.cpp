@@ -26,7 +26,6 @@
 
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/Graphics/FontManager.hpp"
-#include "egolib/Core/System.hpp"
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/TextureUnit.hpp"
 #include "egolib/Log/_Include.hpp"
@@ -36,38 +35,21 @@
 //--------------------------------------------------------------------------------------------
 namespace Ego {
 
-struct Font::RenderedTextCache : Id::NonCopyable {
-    std::shared_ptr<Font::LaidTextRenderer> cache;
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
+Font::TextCacheKey::TextCacheKey(const std::string &text, int width, int height, int spacing, bool box) :
+    text(text), width(width), height(height), spacing(spacing), box(box) {}
 
-    bool isEquivalent(const std::string &t, int w, int h, int s) {
-        return w == width && h == height && s == spacing && t == text;
-    }
-
-    static bool isLessThan(const std::shared_ptr<RenderedTextCache> &a, const std::shared_ptr<RenderedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-};
-
-struct Font::SizedTextCache : Id::NonCopyable {
-    uint32_t lastUseInTicks;
-    std::string text;
-    int width;
-    int height;
-    int spacing;
-
-    bool isEquivalent(const std::string &t, int s) {
-        return s == spacing && t == text;
-    }
+bool Font::TextCacheKey::operator==(const TextCacheKey &other) const {
+    return width == other.width && height == other.height && spacing == other.spacing && box == other.box
+        && text == other.text;
+}
 
-    static bool isLessThan(const std::shared_ptr<SizedTextCache> &a, const std::shared_ptr<SizedTextCache> &b) {
-        return a->lastUseInTicks < b->lastUseInTicks;
+size_t Font::TextCacheKeyHash::operator()(const TextCacheKey &key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    for (int value : { key.width, key.height, key.spacing, key.box ? 1 : 0 }) {
+        hash ^= std::hash<int>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
     }
-};
+    return hash;
+}
 
 struct Font::FontAtlas {
     std::shared_ptr<Ego::Texture> texture;
@@ -120,8 +102,8 @@ void Font::LaidTextRenderer::render(int x, int y, const Ego::Math::Colour4f &col
 
 Font::Font(const std::string &fileName, int pointSize) :
     _ttfFont(),
-    _renderedCache(),
-    _sizedCache() {
+    _renderedCache(MAX_RENDERED_CACHE_BYTES),
+    _sizedCache(MAX_SIZED_CACHE_BYTES) {
     _ttfFont = TTF_OpenFontRW(vfs_openRWopsRead(fileName), 1, pointSize);
 
     if (_ttfFont == nullptr) {
@@ -140,56 +122,44 @@ Font::~Font() {
 }
 
 void Font::getTextSize(const std::string &text, int *width, int *height) {
-    bool updateCache = true;
-    std::shared_ptr<SizedTextCache> cache = findInSizedCache(text, 0, &updateCache);
+    const TextCacheKey key(text, 0, 0, 0, false);
+    TextSize *size = _sizedCache.find(key);
 
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
+    if (!size) {
+        TextSize ourSize = {0, 0};
 
         LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
+        options.textWidth = &ourSize.width;
+        options.textHeight = &ourSize.height;
         options.interpretNewlines = false;
 
         layout(text, options);
 
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = 0;
+        size = &_sizedCache.insert(key, ourSize, sizeof(TextCacheKey) + sizeof(TextSize) + text.size());
     }
 
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Ego::Core::System::get().getSystemService().getTicks();
+    if (width) *width = size->width;
+    if (height) *height = size->height;
 }
 
 void Font::getTextBoxSize(const std::string &text, int spacing, int *width, int *height) {
-    bool updateCache = true;
-    auto cache = findInSizedCache(text, spacing, &updateCache);
+    const TextCacheKey key(text, 0, 0, spacing, true);
+    TextSize *size = _sizedCache.find(key);
 
-    if (updateCache) {
-        int ourWidth = 0;
-        int ourHeight = 0;
+    if (!size) {
+        TextSize ourSize = {0, 0};
 
         LayoutOptions options;
-        options.textWidth = &ourWidth;
-        options.textHeight = &ourHeight;
+        options.textWidth = &ourSize.width;
+        options.textHeight = &ourSize.height;
 
         layout(text, options);
 
-        cache->text = text;
-        cache->width = ourWidth;
-        cache->height = ourHeight;
-        cache->spacing = spacing;
+        size = &_sizedCache.insert(key, ourSize, sizeof(TextCacheKey) + sizeof(TextSize) + text.size());
     }
 
-    if (width) *width = cache->width;
-    if (height) *height = cache->height;
-
-    cache->lastUseInTicks = Ego::Core::System::get().getSystemService().getTicks();
+    if (width) *width = size->width;
+    if (height) *height = size->height;
 }
 
 void Font::drawTextToTexture(Ego::Texture *tex, const std::string &text, const Ego::Math::Colour3f &colour) {
@@ -221,39 +191,29 @@ void Font::drawTextBoxToTexture(Ego::Texture *tex, const std::string &text, int
 void Font::drawText(const std::string &text, int x, int y, const Ego::Math::Colour4f &colour) {
     if (text.empty()) return;
 
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, 0, 0, 0, &updateCache);
+    const TextCacheKey key(text, 0, 0, 0, false);
+    std::shared_ptr<LaidTextRenderer> *cache = _renderedCache.find(key);
 
-    if (updateCache) {
-        cache->cache = layoutText(text, nullptr, nullptr);
-        cache->text = text;
-        cache->width = 0;
-        cache->height = 0;
-        cache->spacing = 0;
+    if (!cache) {
+        auto renderer = layoutText(text, nullptr, nullptr);
+        cache = &_renderedCache.insert(key, renderer, getCacheSize(key, *renderer));
     }
 
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Ego::Core::System::get().getSystemService().getTicks();
+    (*cache)->render(x, y, colour);
 }
 
 void Font::drawTextBox(const std::string &text, int x, int y, int width, int height, int spacing, const Ego::Math::Colour4f &colour) {
     if (text.empty()) return;
 
-    bool updateCache = true;
-    auto cache = findInRenderedCache(text, width, height, spacing, &updateCache);
+    const TextCacheKey key(text, width, height, spacing, true);
+    std::shared_ptr<LaidTextRenderer> *cache = _renderedCache.find(key);
 
-    if (updateCache) {
-        cache->cache = layoutTextBox(text, width, height, spacing, nullptr, nullptr);
-        cache->text = text;
-        cache->width = width;
-        cache->height = height;
-        cache->spacing = spacing;
+    if (!cache) {
+        auto renderer = layoutTextBox(text, width, height, spacing, nullptr, nullptr);
+        cache = &_renderedCache.insert(key, renderer, getCacheSize(key, *renderer));
     }
 
-    cache->cache->render(x, y, colour);
-
-    cache->lastUseInTicks = Ego::Core::System::get().getSystemService().getTicks();
+    (*cache)->render(x, y, colour);
 }
 
 std::shared_ptr<Font::LaidTextRenderer> Font::layoutText(const std::string &text, int *textWidth, int *textHeight) {
@@ -285,6 +245,20 @@ int Font::getFontHeight() const {
     return TTF_FontHeight(_ttfFont);
 }
 
+const LRUCacheStatistics& Font::getRenderedCacheStatistics() const {
+    return _renderedCache.getStatistics();
+}
+
+const LRUCacheStatistics& Font::getSizedCacheStatistics() const {
+    return _sizedCache.getStatistics();
+}
+
+size_t Font::getCacheSize(const TextCacheKey &key, const LaidTextRenderer &renderer) {
+    const VertexBuffer &vertexBuffer = *renderer._vertexBuffer;
+    return sizeof(TextCacheKey) + key.text.size() + sizeof(LaidTextRenderer)
+         + vertexBuffer.getNumberOfVertices() * vertexBuffer.getVertexDescriptor().getVertexSize();
+}
+
 void Font::layoutLine(const std::vector<uint16_t> &codepoints, size_t pos, int maxWidth, bool useNewlines,
                       const FontAtlas &atlas, size_t *endPos, std::vector<uint16_t> &usedChars,
                       std::vector<SDL_Rect> &positions, int *lineWidth, int *lineHeight) {
@@ -638,79 +612,6 @@ Font::FontAtlas Font::createFontAtlas(const std::vector<uint16_t> &codepoints) c
     return retval;
 }
 
-std::shared_ptr<Font::RenderedTextCache> Font::findInRenderedCache(const std::string &text, int width, int height,
-                                                                   int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<RenderedTextCache>();
-    }
-
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_renderedCache.empty())
-            _renderedCache.emplace_back(std::make_shared<RenderedTextCache>());
-        return _renderedCache[0];
-    }
-
-    std::shared_ptr<Font::RenderedTextCache> cache;
-    bool updateCache = true;
-
-    auto cacheIterator = std::find_if(_renderedCache.begin(), _renderedCache.end(),
-                                      [&](const std::shared_ptr<Font::RenderedTextCache> &ptr) {
-        return ptr->isEquivalent(text, width, height, spacing);
-    });
-
-    if (cacheIterator != _renderedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_renderedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<RenderedTextCache>();
-        _renderedCache.push_back(cache);
-    } else {
-        std::sort(_renderedCache.begin(), _renderedCache.end(), RenderedTextCache::isLessThan);
-        cache = _renderedCache.at(0);
-    }
-
-    if (update) *update = updateCache;
-    return cache;
-}
-
-std::shared_ptr<Font::SizedTextCache> Font::findInSizedCache(const std::string &text, int spacing, bool *update) {
-    if (MAX_CACHE_SIZE == 0) {
-        *update = true;
-        return std::make_shared<SizedTextCache>();
-    }
-
-    if (MAX_CACHE_SIZE == 1) {
-        *update = true;
-        if (_sizedCache.empty())
-            _sizedCache.emplace_back(std::make_shared<SizedTextCache>());
-        return _sizedCache[0];
-    }
-
-    std::shared_ptr<Font::SizedTextCache> cache;
-    bool updateCache = true;
-
-    auto cacheIterator = std::find_if(_sizedCache.begin(), _sizedCache.end(),
-                                      [&](const std::shared_ptr<Font::SizedTextCache> &ptr) {
-        return ptr->isEquivalent(text, spacing);
-    });
-
-    if (cacheIterator != _sizedCache.end()) {
-        cache = *cacheIterator;
-        updateCache = false;
-    } else if (_sizedCache.size() < MAX_CACHE_SIZE) {
-        cache = std::make_shared<SizedTextCache>();
-        _sizedCache.push_back(cache);
-    } else {
-        std::sort(_sizedCache.begin(), _sizedCache.end(), SizedTextCache::isLessThan);
-        cache = _sizedCache.at(0);
-    }
-
-    if (update) *update = updateCache;
-    return cache;
-}
-
 uint16_t Font::convertUTF8ToCodepoint(const std::string &string, size_t *pos) {
     size_t tmpPos = 0;
     if (pos == nullptr) pos = &tmpPos;
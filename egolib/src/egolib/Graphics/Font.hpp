@@ -26,6 +26,7 @@
 #include "egolib/typedef.h"
 #include "egolib/Math/_Include.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Core/LRUCache.hpp"
 
 namespace Ego {
 class Texture;
@@ -66,9 +67,10 @@ public:
     };
 
 private:
-    /// This is the maximum size for the two caches as used by
-    /// drawText and getTextSize, set this to 0 for no caching
-    constexpr static size_t MAX_CACHE_SIZE = 20;
+    /// The budget in bytes of the cache of laid out text as used by drawText and drawTextBox
+    constexpr static size_t MAX_RENDERED_CACHE_BYTES = 256 * 1024;
+    /// The budget in bytes of the cache of text sizes as used by getTextSize and getTextBoxSize
+    constexpr static size_t MAX_SIZED_CACHE_BYTES = 64 * 1024;
 
 protected:
     Font(const std::string &fileName, int pointSize);
@@ -219,11 +221,40 @@ public:
     **/
     int getFontHeight() const;
 
+    /**
+     * @brief
+     *  Get the counters of the cache of laid out text as used by drawText and drawTextBox.
+     */
+    const LRUCacheStatistics& getRenderedCacheStatistics() const;
+
+    /**
+     * @brief
+     *  Get the counters of the cache of text sizes as used by getTextSize and getTextBoxSize.
+     */
+    const LRUCacheStatistics& getSizedCacheStatistics() const;
+
 private:
-    /// Struct for cached text that has been rendered
-    struct RenderedTextCache;
-    /// Struct for cached text that has been sized
-    struct SizedTextCache;
+    /// The key of cached text
+    struct TextCacheKey {
+        std::string text;
+        int width;
+        int height;
+        int spacing;
+        bool box;       ///< Newlines only start a new line in text boxes
+
+        TextCacheKey(const std::string &text, int width, int height, int spacing, bool box);
+        bool operator==(const TextCacheKey &other) const;
+    };
+
+    struct TextCacheKeyHash {
+        size_t operator()(const TextCacheKey &key) const;
+    };
+
+    /// The size of cached text
+    struct TextSize {
+        int width;
+        int height;
+    };
 
     struct FontAtlas;
 
@@ -234,28 +265,9 @@ private:
 
     /**
      * @brief
-     *  Find given values in the rendered text cache
-     * @param text,width,height,spacing
-     *  The values to look for in the cache
-     * @param update[out]
-     *  Is set to @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
-     * @return
-     *  A cached struct that may need to be updated per @a update
-     */
-    std::shared_ptr<RenderedTextCache> findInRenderedCache(const std::string &text, int width, int height,
-                                                           int spacing, bool *update);
-
-    /**
-     * @brief
-     *  Find given values in the sized text cache
-     * @param text,spacing
-     *  The values to look for in the cache
-     * @param update[out]
-     *  Is @c true when the returned cached struct needs to be updated with the given values, @c false otherwise
-     * @return
-     *  A cached struct that may need to be updated per @a update
+     *  Get the size in bytes of cached laid out text, most of it is the vertex buffer.
      */
-    std::shared_ptr<SizedTextCache> findInSizedCache(const std::string &text, int spacing, bool *update);
+    static size_t getCacheSize(const TextCacheKey &key, const LaidTextRenderer &renderer);
 
     /**
      * @brief
@@ -379,8 +391,8 @@ private:
 
     TTF_Font *_ttfFont;
 
-    std::vector<std::shared_ptr<RenderedTextCache>> _renderedCache;
-    std::vector<std::shared_ptr<SizedTextCache>> _sizedCache;
+    LRUCache<TextCacheKey, std::shared_ptr<LaidTextRenderer>, TextCacheKeyHash> _renderedCache;
+    LRUCache<TextCacheKey, TextSize, TextCacheKeyHash> _sizedCache;
     std::vector<FontAtlas> _atlases;
 };
 
@@ -0,0 +1,251 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/MD2Interpolation.cpp
+/// @brief  Interpolation of the vertices of MD2 frames with SSE2 and AVX2 kernels
+
+#include "egolib/Graphics/MD2Interpolation.hpp"
+
+// The SSE2 and AVX2 kernels are compiled for their instruction set regardless of the
+// compiler options and are only called if the processor supports it.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define EGO_MD2_X86 1
+    #define EGO_MD2_TARGET(TARGET) __attribute__((target(TARGET)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define EGO_MD2_X86 1
+    #define EGO_MD2_TARGET(TARGET)
+    #include <intrin.h>
+    #include <immintrin.h>
+#else
+    #define EGO_MD2_X86 0
+#endif
+
+namespace Ego {
+
+namespace {
+
+/// The offsets of the components of a destination vertex in floats.
+constexpr size_t POSITION = 0;
+constexpr size_t NORMAL = 4;         //< the normal and the x coordinate of the environment map
+constexpr size_t NORMAL_Z = 6;
+constexpr size_t ENVIRO_Y = 8;
+
+inline float getEnviroY(float normalZ) {
+    return 0.5f * (1.0f + normalZ);
+}
+
+void copyScalar(const float *positions, const float *normals, size_t vmin, size_t vmax, float *destination, size_t stride) {
+    for (size_t i = vmin; i <= vmax; ++i) {
+        float *vertex = destination + i * stride;
+        for (size_t j = 0; j < 4; ++j) {
+            vertex[POSITION + j] = positions[4 * i + j];
+            vertex[NORMAL + j] = normals[4 * i + j];
+        }
+        vertex[ENVIRO_Y] = getEnviroY(vertex[NORMAL_Z]);
+    }
+}
+
+void lerpScalar(const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip, float *destination, size_t stride) {
+    for (size_t i = vmin; i <= vmax; ++i) {
+        float *vertex = destination + i * stride;
+        for (size_t j = 0; j < 4; ++j) {
+            const float lastPosition = last.positions[4 * i + j], lastNormal = last.normals[4 * i + j];
+            vertex[POSITION + j] = lastPosition + (next.positions[4 * i + j] - lastPosition) * flip;
+            vertex[NORMAL + j] = lastNormal + (next.normals[4 * i + j] - lastNormal) * flip;
+        }
+        vertex[ENVIRO_Y] = getEnviroY(vertex[NORMAL_Z]);
+    }
+}
+
+#if EGO_MD2_X86
+
+bool cpuSupportsSSE2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return 0 != (info[3] & (1 << 26));
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuSupportsAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The operating system must save the AVX registers.
+    __cpuid(info, 1);
+    const bool osxsave = 0 != (info[2] & (1 << 27)), avx = 0 != (info[2] & (1 << 28));
+    if (!osxsave || !avx || 6 != (_xgetbv(0) & 6)) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return 0 != (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx2");
+#endif
+}
+
+EGO_MD2_TARGET("sse2")
+void copySSE2(const float *positions, const float *normals, size_t vmin, size_t vmax, float *destination, size_t stride) {
+    for (size_t i = vmin; i <= vmax; ++i) {
+        float *vertex = destination + i * stride;
+        _mm_storeu_ps(vertex + POSITION, _mm_loadu_ps(positions + 4 * i));
+        _mm_storeu_ps(vertex + NORMAL, _mm_loadu_ps(normals + 4 * i));
+        vertex[ENVIRO_Y] = getEnviroY(vertex[NORMAL_Z]);
+    }
+}
+
+EGO_MD2_TARGET("sse2")
+void lerpSSE2(const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip, float *destination, size_t stride) {
+    const float *lastPositions = last.positions.data(), *nextPositions = next.positions.data();
+    const float *lastNormals = last.normals.data(), *nextNormals = next.normals.data();
+    const __m128 t = _mm_set1_ps(flip);
+    for (size_t i = vmin; i <= vmax; ++i) {
+        float *vertex = destination + i * stride;
+        const __m128 lastPosition = _mm_loadu_ps(lastPositions + 4 * i), lastNormal = _mm_loadu_ps(lastNormals + 4 * i);
+        const __m128 position = _mm_add_ps(lastPosition, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nextPositions + 4 * i), lastPosition), t));
+        const __m128 normal = _mm_add_ps(lastNormal, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nextNormals + 4 * i), lastNormal), t));
+        _mm_storeu_ps(vertex + POSITION, position);
+        _mm_storeu_ps(vertex + NORMAL, normal);
+        vertex[ENVIRO_Y] = getEnviroY(vertex[NORMAL_Z]);
+    }
+}
+
+/// Interpolates two vertices at a time, the halves of a result go to different destination vertices.
+EGO_MD2_TARGET("avx2")
+void lerpAVX2(const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip, float *destination, size_t stride) {
+    const float *lastPositions = last.positions.data(), *nextPositions = next.positions.data();
+    const float *lastNormals = last.normals.data(), *nextNormals = next.normals.data();
+    const __m256 t = _mm256_set1_ps(flip);
+    size_t i = vmin;
+    for (; i + 1 <= vmax; i += 2) {
+        float *first = destination + i * stride, *second = first + stride;
+        const __m256 lastPosition = _mm256_loadu_ps(lastPositions + 4 * i), lastNormal = _mm256_loadu_ps(lastNormals + 4 * i);
+        const __m256 position = _mm256_add_ps(lastPosition, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nextPositions + 4 * i), lastPosition), t));
+        const __m256 normal = _mm256_add_ps(lastNormal, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nextNormals + 4 * i), lastNormal), t));
+        _mm_storeu_ps(first + POSITION, _mm256_castps256_ps128(position));
+        _mm_storeu_ps(first + NORMAL, _mm256_castps256_ps128(normal));
+        _mm_storeu_ps(second + POSITION, _mm256_extractf128_ps(position, 1));
+        _mm_storeu_ps(second + NORMAL, _mm256_extractf128_ps(normal, 1));
+        first[ENVIRO_Y] = getEnviroY(first[NORMAL_Z]);
+        second[ENVIRO_Y] = getEnviroY(second[NORMAL_Z]);
+    }
+    if (i == vmax) {
+        float *vertex = destination + i * stride;
+        const __m128 u = _mm256_castps256_ps128(t);
+        const __m128 lastPosition = _mm_loadu_ps(lastPositions + 4 * i), lastNormal = _mm_loadu_ps(lastNormals + 4 * i);
+        _mm_storeu_ps(vertex + POSITION, _mm_add_ps(lastPosition, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nextPositions + 4 * i), lastPosition), u)));
+        _mm_storeu_ps(vertex + NORMAL, _mm_add_ps(lastNormal, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nextNormals + 4 * i), lastNormal), u)));
+        vertex[ENVIRO_Y] = getEnviroY(vertex[NORMAL_Z]);
+    }
+}
+
+#endif
+
+MD2Interpolation::Kernel getFastestKernel() {
+#if EGO_MD2_X86
+    if (cpuSupportsAVX2()) {
+        return MD2Interpolation::Kernel::AVX2;
+    }
+    if (cpuSupportsSSE2()) {
+        return MD2Interpolation::Kernel::SSE2;
+    }
+#endif
+    return MD2Interpolation::Kernel::Scalar;
+}
+
+} // anonymous namespace
+
+MD2Interpolation::Kernel MD2Interpolation::_kernel = getFastestKernel();
+
+bool MD2Interpolation::isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if EGO_MD2_X86
+        case Kernel::SSE2:
+            return cpuSupportsSSE2();
+        case Kernel::AVX2:
+            return cpuSupportsAVX2();
+#endif
+        default:
+            return false;
+    }
+}
+
+MD2Interpolation::Kernel MD2Interpolation::getKernel() {
+    return _kernel;
+}
+
+bool MD2Interpolation::setKernel(Kernel kernel) {
+    if (!isSupported(kernel)) {
+        return false;
+    }
+    _kernel = kernel;
+    return true;
+}
+
+void MD2Interpolation::interpolate(const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip,
+                                   float *destination, size_t stride) {
+    interpolate(_kernel, last, next, vmin, vmax, flip, destination, stride);
+}
+
+void MD2Interpolation::interpolate(Kernel kernel, const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip,
+                                   float *destination, size_t stride) {
+    if (vmin > vmax) {
+        return;
+    }
+    // At the key frames the vertices are copied, interpolating would not be exact.
+    const MD2_Frame *source = (0.0f == flip) ? &last : ((1.0f == flip) ? &next : nullptr);
+    switch (kernel) {
+#if EGO_MD2_X86
+        case Kernel::AVX2:
+            // Copying is bound by memory, SSE2 does as well as AVX2.
+            if (source) {
+                copySSE2(source->positions.data(), source->normals.data(), vmin, vmax, destination, stride);
+            } else {
+                lerpAVX2(last, next, vmin, vmax, flip, destination, stride);
+            }
+            break;
+        case Kernel::SSE2:
+            if (source) {
+                copySSE2(source->positions.data(), source->normals.data(), vmin, vmax, destination, stride);
+            } else {
+                lerpSSE2(last, next, vmin, vmax, flip, destination, stride);
+            }
+            break;
+#endif
+        default:
+            if (source) {
+                copyScalar(source->positions.data(), source->normals.data(), vmin, vmax, destination, stride);
+            } else {
+                lerpScalar(last, next, vmin, vmax, flip, destination, stride);
+            }
+            break;
+    }
+}
+
+} // namespace Ego
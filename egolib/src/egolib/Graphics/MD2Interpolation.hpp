@@ -0,0 +1,96 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/MD2Interpolation.hpp
+/// @brief  Interpolation of the vertices of MD2 frames with SSE2 and AVX2 kernels
+
+#pragma once
+
+#include "egolib/Graphics/MD2Model.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  Interpolates the vertices between two frames of an MD2 model.
+ * @remark
+ *  A destination vertex starts with four floats for the position, three for the normal and two
+ *  for the environment map coordinates, in this order and without padding. Consecutive vertices
+ *  are @a stride floats apart. The position and the normal with the x coordinate of the
+ *  environment map are interpolated four floats at a time, the y coordinate of the environment
+ *  map is computed from the interpolated normal.
+ * @remark
+ *  All kernels compute the same values as the scalar kernel, they do not use fused
+ *  multiply-add instructions.
+ */
+class MD2Interpolation {
+public:
+    enum class Kernel {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    /**
+     * @brief
+     *  Get if the processor and the build support a kernel.
+     */
+    static bool isSupported(Kernel kernel);
+
+    /**
+     * @brief
+     *  Get the kernel used by interpolate(), by default the fastest supported one.
+     */
+    static Kernel getKernel();
+
+    /**
+     * @brief
+     *  Set the kernel used by interpolate().
+     * @return
+     *  @a false if the kernel is not supported, the kernel is not changed in that case
+     */
+    static bool setKernel(Kernel kernel);
+
+    /**
+     * @brief
+     *  Interpolate the vertices [vmin, vmax] with the current kernel.
+     * @param last, next
+     *  the frames to interpolate between
+     * @param flip
+     *  the progress from @a last to @a next, in [0, 1]
+     * @param destination
+     *  the first destination vertex, vertex @a vmin is written to <tt>destination + vmin * stride</tt>
+     * @param stride
+     *  the distance of consecutive destination vertices in floats
+     */
+    static void interpolate(const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip,
+                            float *destination, size_t stride);
+
+    /**
+     * @brief
+     *  Interpolate the vertices [vmin, vmax] with the given kernel, which must be supported.
+     */
+    static void interpolate(Kernel kernel, const MD2_Frame& last, const MD2_Frame& next, size_t vmin, size_t vmax, float flip,
+                            float *destination, size_t stride);
+
+private:
+    static Kernel _kernel;
+};
+
+} // namespace Ego
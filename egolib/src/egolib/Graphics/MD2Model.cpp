@@ -31,6 +31,37 @@ static const float MD2_NORMALS[EGO_NORMAL_COUNT][3] =
     , {0, 0, 0}                     ///< the "equal light" normal
 };
 
+void MD2_Frame::resize(size_t vertexCount)
+{
+    positions.resize(4 * vertexCount, 0.0f);
+    normals.resize(4 * vertexCount, 0.0f);
+    normalIndices.resize(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        positions[4 * i + 3] = 1.0f;
+    }
+}
+
+void MD2_Frame::setPosition(size_t i, const Vector3f& position)
+{
+    positions[4 * i + 0] = position[kX];
+    positions[4 * i + 1] = position[kY];
+    positions[4 * i + 2] = position[kZ];
+}
+
+void MD2_Frame::setNormal(size_t i, const Vector3f& normal)
+{
+    normals[4 * i + 0] = normal[kX];
+    normals[4 * i + 1] = normal[kY];
+    normals[4 * i + 2] = normal[kZ];
+}
+
+void MD2_Frame::setNormalIndex(size_t i, size_t normalIndex)
+{
+    normalIndices[i] = static_cast<uint8_t>(normalIndex);
+    normals[4 * i + 3] = MD2Model::getEnviroX(normalIndex);
+}
+
 MD2Model::MD2Model() :
 	_vertices(0),
 	_skins(),
@@ -47,27 +78,45 @@ float MD2Model::getMD2Normal(size_t normal, size_t index)
 	return MD2_NORMALS[normal][index];
 }
 
+float MD2Model::getEnviroX(size_t normal)
+{
+    static const std::array<float, EGO_NORMAL_COUNT> enviroX = []()
+    {
+        std::array<float, EGO_NORMAL_COUNT> table;
+        for (size_t i = 0; i < EGO_NORMAL_COUNT; ++i)
+        {
+            table[i] = std::atan2(MD2_NORMALS[i][1], MD2_NORMALS[i][0]) * Ego::Math::invTwoPi<float>();
+        }
+        return table;
+    }();
+    return enviroX[normal];
+}
+
 void MD2Model::scaleModel(const float scaleX, const float scaleY, const float scaleZ)
 {
     for(MD2_Frame &frame : _frames)
     {
         bool boundingBoxFound = false;
 
-        for(MD2_Vertex& vertex : frame.vertexList)
+        for(size_t i = 0; i < frame.getVertexCount(); ++i)
         {
             oct_vec_v2_t opos;
 
-            vertex.pos[kX] *= scaleX;
-            vertex.pos[kY] *= scaleY;
-            vertex.pos[kZ] *= scaleZ;
+            Vector3f pos = frame.getPosition(i);
+            pos[kX] *= scaleX;
+            pos[kY] *= scaleY;
+            pos[kZ] *= scaleZ;
+            frame.setPosition(i, pos);
 
-            std::copysign(vertex.nrm[kX], scaleX);
-            std::copysign(vertex.nrm[kY], scaleY);
-            std::copysign(vertex.nrm[kZ], scaleZ);
+            Vector3f nrm = frame.getNormal(i);
+            std::copysign(nrm[kX], scaleX);
+            std::copysign(nrm[kY], scaleY);
+            std::copysign(nrm[kZ], scaleZ);
 
-			vertex.nrm.normalize();
+			nrm.normalize();
+            frame.setNormal(i, nrm);
 
-            opos = oct_vec_v2_t(vertex.pos);
+            opos = oct_vec_v2_t(pos);
 
             // Re-calculate the bounding box for this frame
             if (!boundingBoxFound)
@@ -104,9 +153,9 @@ void MD2Model::makeEquallyLit()
 {
 	for(MD2_Frame &frame : _frames)
 	{
-	    for(MD2_Vertex &vertex : frame.vertexList)
+	    for(size_t i = 0; i < frame.getVertexCount(); ++i)
 	    {
-	        vertex.normal = EGO_NORMAL_COUNT-1;
+	        frame.setNormalIndex(i, EGO_NORMAL_COUNT-1);
 	    }
 	}
 }
@@ -168,7 +217,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 
     for(MD2_Frame &frame : model->_frames)
     {
-    	frame.vertexList.resize(md2Header.num_vertices);
+    	frame.resize(md2Header.num_vertices);
     }
 
     // Load the texture coordinates from the file, normalizing them as we go
@@ -227,7 +276,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 
         // unpack the md2 vertex_lst from this frame
         bool boundingBoxFound = false;
-        for(MD2_Vertex &vertex : frame.vertexList)
+        for(size_t i = 0; i < frame.getVertexCount(); ++i)
         {
             oct_vec_v2_t ovec;
             id_md2_vertex_t frame_vert;
@@ -236,23 +285,23 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
             vfs_read(&frame_vert, sizeof( id_md2_vertex_t ), 1, f);
 
             // grab the vertex position
-            vertex.pos[kX] = frame_vert.v[0] * frame_header.scale[0] + frame_header.translate[0];
-            vertex.pos[kY] = frame_vert.v[1] * frame_header.scale[1] + frame_header.translate[1];
-            vertex.pos[kZ] = frame_vert.v[2] * frame_header.scale[2] + frame_header.translate[2];
+            Vector3f pos(frame_vert.v[0] * frame_header.scale[0] + frame_header.translate[0],
+                         frame_vert.v[1] * frame_header.scale[1] + frame_header.translate[1],
+                         frame_vert.v[2] * frame_header.scale[2] + frame_header.translate[2]);
+            frame.setPosition(i, pos);
 
             // grab the normal index
-            vertex.normal = frame_vert.normalIndex;
-            if (vertex.normal > MD2_MAX_NORMALS) {
-            	vertex.normal = MD2_MAX_NORMALS;
+            size_t normal = frame_vert.normalIndex;
+            if (normal > MD2_MAX_NORMALS) {
+            	normal = MD2_MAX_NORMALS;
             }
+            frame.setNormalIndex(i, normal);
 
             // expand the normal index into an actual normal
-            vertex.nrm[kX] = MD2_NORMALS[frame_vert.normalIndex][0];
-            vertex.nrm[kY] = MD2_NORMALS[frame_vert.normalIndex][1];
-            vertex.nrm[kZ] = MD2_NORMALS[frame_vert.normalIndex][2];
+            frame.setNormal(i, Vector3f(MD2_NORMALS[normal][0], MD2_NORMALS[normal][1], MD2_NORMALS[normal][2]));
 
             // Calculate the bounding box for this frame
-            ovec = oct_vec_v2_t(vertex.pos);
+            ovec = oct_vec_v2_t(pos);
             if (!boundingBoxFound)
             {
                 frame.bb = oct_bb_t(ovec);
@@ -29,22 +29,6 @@ static constexpr size_t EGO_NORMAL_COUNT = MD2_MAX_NORMALS + 1;
 typedef id_md2_skin_t MD2_SkinName;
 typedef id_md2_triangle_t MD2_Triangle;
 
-class MD2_Vertex
-{
-public:
-	MD2_Vertex() :
-		pos(0.0f, 0.0f, 0.0f),
-		nrm(0.0f, 0.0f, 0.0f),
-		normal(0)
-	{
-		//ctor
-	}
-
-	Vector3f pos;
-	Vector3f nrm;
-    size_t   normal;  ///< index to id-normal array
-};
-
 class MD2_TexCoord
 {
 public:
@@ -73,6 +57,14 @@ public:
     std::vector<id_glcmd_packed_t> 	data;
 };
 
+/**
+* @brief
+*   A frame of an MD2 model.
+* @remark
+*   The vertices are kept as a structure of arrays so that they can be interpolated four floats
+*   at a time (see Ego::MD2Interpolation): a position is x, y, z and 1, a normal is x, y, z and
+*   the x coordinate of the environment map.
+**/
 class MD2_Frame
 {
 public:
@@ -80,7 +72,9 @@ public:
 #if 0
 		name(),
 #endif
-		vertexList(),
+		positions(),
+		normals(),
+		normalIndices(),
 		bb(),
 		framelip(0),
 		framefx(EMPTY_BIT_FIELD)
@@ -88,9 +82,32 @@ public:
 		name[0] = '\0';
 	}
 
+	inline size_t getVertexCount() const {return normalIndices.size();}
+
+	/**
+	* @brief set the number of vertices, new vertices are at the origin and have no normal
+	**/
+	void resize(size_t vertexCount);
+
+	inline Vector3f getPosition(size_t i) const {return Vector3f(positions[4*i+0], positions[4*i+1], positions[4*i+2]);}
+	void setPosition(size_t i, const Vector3f& position);
+
+	inline Vector3f getNormal(size_t i) const {return Vector3f(normals[4*i+0], normals[4*i+1], normals[4*i+2]);}
+	void setNormal(size_t i, const Vector3f& normal);
+
+	/// @return index to the id-normal array
+	inline size_t getNormalIndex(size_t i) const {return normalIndices[i];}
+
+	/**
+	* @brief set the index to the id-normal array, this also sets the environment map coordinate
+	**/
+	void setNormalIndex(size_t i, size_t normalIndex);
+
     char name[16];
 
-    std::vector<MD2_Vertex> vertexList;
+    std::vector<float>   positions;      ///< x, y, z and 1 of each vertex
+    std::vector<float>   normals;        ///< x, y, z and the environment map x coordinate of each vertex
+    std::vector<uint8_t> normalIndices;  ///< index to the id-normal array of each vertex
 
     oct_bb_t bb;        ///< axis-aligned octagonal bounding box limits
     int framelip;       ///< the position in the current animation
@@ -128,6 +145,11 @@ public:
 
 	static float getMD2Normal(size_t normal, size_t index);
 
+	/**
+	* @return the x coordinate of the environment map of a normal, its direction in turns
+	**/
+	static float getEnviroX(size_t normal);
+
 private:
 	size_t 					   	     _vertices;
     std::vector<MD2_SkinName>  	     _skins;
@@ -378,10 +378,11 @@ void ModelDescriptor::parseFrameDescriptors(const char * cFrameName, int frame)
     int name_count;
     int cnt;
 
-    static int token_count = -1;
     static const char * tokens[] = { "I", "S", "F", "P", "A", "G", "D", "C",          /* the normal command tokens */
                                      "LA", "LG", "LD", "LC", "RA", "RG", "RD", "RC", NULL
                                    }; /* the "bad" token aliases */
+    // count at compile time, models may be read by several threads at once
+    static const int token_count = sizeof(tokens) / sizeof(tokens[0]) - 1;
 
     // check for a valid frame number
     if(frame >= _md2Model->getFrames().size())
@@ -391,16 +392,6 @@ void ModelDescriptor::parseFrameDescriptors(const char * cFrameName, int frame)
 
     MD2_Frame &pframe = _md2Model->getFrames()[frame];
 
-    // this should only be initialized the first time through
-    if (token_count < 0)
-    {
-        token_count = 0;
-        for (cnt = 0; nullptr != tokens[token_count] && cnt < 256; cnt++)
-        {
-            token_count++;
-        }
-    }
-
     // set the default values
     BIT_FIELD fx = 0;
     pframe.framefx = fx;
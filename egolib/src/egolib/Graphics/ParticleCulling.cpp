@@ -0,0 +1,178 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/ParticleCulling.cpp
+/// @brief  Culling particles against a view frustum in bins and selecting their level of detail
+
+#include "egolib/Graphics/ParticleCulling.hpp"
+
+namespace Ego
+{
+namespace Graphics
+{
+
+ParticleCulling::ParticleCulling(const float cellSize) :
+    _cellSize(cellSize),
+    _fullDetailDistance(2048.0f),
+    _dropDistance(4096.0f),
+    _particles(),
+    _bounds(),
+    _particleCells(),
+    _cells(),
+    _statistics{0, 0, 0, 0, 0}
+{
+    //ctor
+}
+
+void ParticleCulling::setDistances(const float fullDetailDistance, const float dropDistance)
+{
+    _fullDetailDistance = fullDetailDistance;
+    _dropDistance = dropDistance;
+}
+
+void ParticleCulling::clear()
+{
+    _particles.clear();
+    _bounds.clear();
+}
+
+void ParticleCulling::add(const size_t index, const Sphere3f& sphere, const Sphere3f& reflectedSphere, const bool lowPriority)
+{
+    const Point3f& center = sphere.getCenter(), & reflectedCenter = reflectedSphere.getCenter();
+    const float radius = sphere.getRadius(), reflectedRadius = reflectedSphere.getRadius();
+    _particles.push_back(Particle{index, sphere, reflectedSphere, lowPriority});
+    _bounds.push_back(Bounds{center[kX], center[kY],
+                                  std::min(center[kX] - radius, reflectedCenter[kX] - reflectedRadius),
+                                  std::min(center[kY] - radius, reflectedCenter[kY] - reflectedRadius),
+                                  std::min(center[kZ] - radius, reflectedCenter[kZ] - reflectedRadius),
+                                  std::max(center[kX] + radius, reflectedCenter[kX] + reflectedRadius),
+                                  std::max(center[kY] + radius, reflectedCenter[kY] + reflectedRadius),
+                                  std::max(center[kZ] + radius, reflectedCenter[kZ] + reflectedRadius)});
+}
+
+void ParticleCulling::accept(const Particle& particle, const Point3f& viewpoint, std::vector<Visible>& visible)
+{
+    const float distance = (particle.sphere.getCenter() - viewpoint).length();
+    if (particle.lowPriority && distance > _dropDistance)
+    {
+        _statistics.dropped++;
+        return;
+    }
+    const unsigned updateInterval = distance <= _fullDetailDistance ? 1
+                                  : distance <= 2.0f * _fullDetailDistance ? 2 : 4;
+    visible.push_back(Visible{particle.index, distance, updateInterval});
+}
+
+void ParticleCulling::cull(const Frustum& frustum, const Point3f& viewpoint, const size_t maximum, std::vector<Visible>& visible)
+{
+    visible.clear();
+    _statistics = Statistics{_particles.size(), 0, 0, 0, 0};
+    if (_particles.empty())
+    {
+        return;
+    }
+
+    // Bin the particles by the centers of their bounding spheres.
+    float minX = _bounds[0].x, maxX = minX,
+          minY = _bounds[0].y, maxY = minY;
+    for (const auto& bounds : _bounds)
+    {
+        minX = std::min(minX, bounds.x);
+        maxX = std::max(maxX, bounds.x);
+        minY = std::min(minY, bounds.y);
+        maxY = std::max(maxY, bounds.y);
+    }
+    // Particles spread farther than the grid covers get larger cells.
+    const float cellSize = std::max(_cellSize, std::max(maxX - minX, maxY - minY) / MAX_CELLS);
+    const float invCellSize = 1.0f / cellSize;
+    const int cellsX = std::min(MAX_CELLS, static_cast<int>((maxX - minX) * invCellSize) + 1),
+              cellsY = std::min(MAX_CELLS, static_cast<int>((maxY - minY) * invCellSize) + 1);
+    // The bounds of the cells start empty.
+    const float infinity = std::numeric_limits<float>::infinity();
+    _cells.assign(static_cast<size_t>(cellsX) * cellsY, Cell{+infinity, +infinity, +infinity, -infinity, -infinity, -infinity, Math::Relation::outside});
+    _particleCells.resize(_bounds.size());
+    for (size_t i = 0; i < _bounds.size(); ++i)
+    {
+        const Bounds& bounds = _bounds[i];
+        const int x = std::min(cellsX - 1, static_cast<int>((bounds.x - minX) * invCellSize)),
+                  y = std::min(cellsY - 1, static_cast<int>((bounds.y - minY) * invCellSize));
+        _particleCells[i] = static_cast<uint32_t>(x + y * cellsX);
+        Cell& cell = _cells[_particleCells[i]];
+        cell.minX = std::min(cell.minX, bounds.minX); cell.minY = std::min(cell.minY, bounds.minY); cell.minZ = std::min(cell.minZ, bounds.minZ);
+        cell.maxX = std::max(cell.maxX, bounds.maxX); cell.maxY = std::max(cell.maxY, bounds.maxY); cell.maxZ = std::max(cell.maxZ, bounds.maxZ);
+    }
+
+    // Cull the cells which have particles.
+    for (auto& cell : _cells)
+    {
+        if (cell.minX <= cell.maxX)
+        {
+            cell.relation = frustum.intersects_aab(Point3f(cell.minX, cell.minY, cell.minZ), Point3f(cell.maxX, cell.maxY, cell.maxZ), false);
+        }
+    }
+
+    // Cull the particles of the cells partially overlapping the frustum.
+    for (size_t i = 0; i < _particles.size(); ++i)
+    {
+        const Particle& particle = _particles[i];
+        switch (_cells[_particleCells[i]].relation)
+        {
+            case Math::Relation::outside:
+                _statistics.culled++;
+                break;
+            case Math::Relation::inside:
+                accept(particle, viewpoint, visible);
+                break;
+            default:
+                if (Math::Relation::outside == frustum.intersects(particle.sphere, false) &&
+                    Math::Relation::outside == frustum.intersects(particle.reflectedSphere, false))
+                {
+                    _statistics.culled++;
+                }
+                else
+                {
+                    accept(particle, viewpoint, visible);
+                }
+                break;
+        }
+    }
+
+    // Keep the nearest particles if there are too many.
+    if (visible.size() > maximum)
+    {
+        std::nth_element(visible.begin(), visible.begin() + maximum, visible.end(),
+                         [](const Visible& x, const Visible& y) { return x.distance < y.distance; });
+        _statistics.dropped += visible.size() - maximum;
+        visible.resize(maximum);
+        // Restore the order of addition.
+        std::sort(visible.begin(), visible.end(), [](const Visible& x, const Visible& y) { return x.index < y.index; });
+    }
+
+    _statistics.submitted = visible.size();
+    for (const auto& particle : visible)
+    {
+        if (particle.updateInterval > 1)
+        {
+            _statistics.reduced++;
+        }
+    }
+}
+
+} // namespace Graphics
+} // namespace Ego
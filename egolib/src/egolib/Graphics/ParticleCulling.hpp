@@ -0,0 +1,184 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/ParticleCulling.hpp
+/// @brief  Culling particles against a view frustum in bins and selecting their level of detail
+
+#pragma once
+
+#include "egolib/frustum.h"
+
+namespace Ego
+{
+namespace Graphics
+{
+
+/**
+ * @brief
+ *  Culls the particles of a frame against a view frustum and selects their level of detail.
+ * @remark
+ *  The particles are binned into a uniform grid over their bounds and each cell is tested once.
+ *  A cell outside of the frustum culls all of its particles, a cell inside of the frustum accepts
+ *  all of its particles, only the particles of cells partially overlapping the frustum are tested
+ *  one by one. A particle
+ *  is culled if its bounding sphere and its reflected bounding sphere are outside of the frustum.
+ * @remark
+ *  The level of detail of a visible particle depends on its distance from the viewpoint:
+ *  Particles closer than the full detail distance update their instances in every update,
+ *  particles up to twice as far in every second update and farther particles in every fourth update.
+ *  Low priority particles farther than the drop distance are not drawn at all.
+ */
+class ParticleCulling
+{
+public:
+    /// A visible particle.
+    struct Visible
+    {
+        size_t index;               ///< The index of the particle.
+        float distance;             ///< The distance of the particle from the viewpoint.
+        unsigned updateInterval;    ///< The number of updates between two updates of the instance of the particle.
+    };
+
+    /// What happened to the particles in the last frame.
+    struct Statistics
+    {
+        size_t particles;   ///< The number of particles.
+        size_t culled;      ///< The number of particles outside of the frustum.
+        size_t dropped;     ///< The number of visible particles not drawn.
+        size_t submitted;   ///< The number of particles to be drawn.
+        size_t reduced;     ///< The number of particles to be drawn which do not update their instances in every update.
+    };
+
+    /**
+     * @brief
+     *  Construct an empty culling.
+     * @param cellSize
+     *  the edge length of a cell, e.g. the size of a block
+     */
+    ParticleCulling(const float cellSize = 512.0f);
+
+    /**
+     * @brief
+     *  Set the distances of the levels of detail.
+     * @param fullDetailDistance
+     *  the distance up to which particles update their instances in every update
+     * @param dropDistance
+     *  the distance beyond which low priority particles are not drawn
+     */
+    void setDistances(const float fullDetailDistance, const float dropDistance);
+
+    float getFullDetailDistance() const { return _fullDetailDistance; }
+    float getDropDistance() const { return _dropDistance; }
+
+    /**
+     * @brief
+     *  Remove all particles.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Add a particle.
+     * @param index
+     *  the index of the particle
+     * @param sphere, reflectedSphere
+     *  the bounding sphere and the reflected bounding sphere of the particle
+     * @param lowPriority
+     *  if the particle may be dropped if it is far away
+     */
+    void add(const size_t index, const Sphere3f& sphere, const Sphere3f& reflectedSphere, const bool lowPriority);
+
+    /**
+     * @brief
+     *  Get the visible particles.
+     * @param frustum
+     *  the view frustum. Its far and near planes are ignored.
+     * @param viewpoint
+     *  the point the frustum is viewed from
+     * @param maximum
+     *  the maximum number of particles to draw. If there are more visible particles, the farthest are dropped.
+     * @param [out] visible
+     *  receives the visible particles to draw in the order they were added
+     */
+    void cull(const Frustum& frustum, const Point3f& viewpoint, const size_t maximum, std::vector<Visible>& visible);
+
+    /**
+     * @return
+     *  what happened to the particles in the last call to cull()
+     */
+    const Statistics& getStatistics() const { return _statistics; }
+
+    /**
+     * @brief
+     *  Get if the instance of a particle is to be updated in an update.
+     * @param updateInterval
+     *  the update interval of the particle
+     * @param update
+     *  the number of the update
+     * @param index
+     *  the index of the particle, staggers the updates of different particles
+     */
+    static bool needsUpdate(const unsigned updateInterval, const uint32_t update, const size_t index)
+    {
+        return updateInterval <= 1 || 0 == (update + index) % updateInterval;
+    }
+
+private:
+    struct Particle
+    {
+        size_t index;
+        Sphere3f sphere;
+        Sphere3f reflectedSphere;
+        bool lowPriority;
+    };
+
+    /// The center of the sphere of a particle and the bounding box of both spheres, for binning.
+    struct Bounds
+    {
+        float x, y;
+        float minX, minY, minZ, maxX, maxY, maxZ;
+    };
+
+    /// The bounds of the spheres of the particles of a cell and their relation to the frustum.
+    struct Cell
+    {
+        float minX, minY, minZ, maxX, maxY, maxZ;
+        Math::Relation relation;
+    };
+
+    /// The maximum number of cells along an axis.
+    static const int MAX_CELLS = 32;
+
+    /// @brief Add a visible particle, or drop it.
+    void accept(const Particle& particle, const Point3f& viewpoint, std::vector<Visible>& visible);
+
+    float _cellSize;
+    float _fullDetailDistance;
+    float _dropDistance;
+    /// The particles in the order they were added.
+    std::vector<Particle> _particles;
+    std::vector<Bounds> _bounds;
+    /// The cells of the particles.
+    std::vector<uint32_t> _particleCells;
+    std::vector<Cell> _cells;
+    Statistics _statistics;
+};
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,220 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Log/AsyncTarget.cpp
+/// @brief Log target writing to another target on a background thread
+
+#include "egolib/Log/AsyncTarget.hpp"
+
+namespace Log {
+
+const size_t AsyncTarget::MAX_LOG_MESSAGE;
+const size_t AsyncTarget::NO_POSITION = std::numeric_limits<size_t>::max();
+
+static size_t roundUpToPowerOfTwo(size_t x) {
+    size_t y = 1;
+    while (y < x) {
+        y <<= 1;
+    }
+    return y;
+}
+
+AsyncTarget::AsyncTarget(std::unique_ptr<Target> sink, Level level, size_t capacity, size_t rateLimit) :
+    Target(level),
+    _sink(std::move(sink)),
+    _slots(roundUpToPowerOfTwo(std::max<size_t>(2, capacity))),
+    _mask(_slots.size() - 1),
+    _enqueuePosition(0),
+    _dequeuePosition(0),
+    _rateLimit(rateLimit),
+    _rateSecond(0),
+    _rateCount(0),
+    _dropped(0),
+    _reportedDropped(0),
+    _lastLevel(Level::Message),
+    _lastText(),
+    _repetitions(0),
+    _repetitionsReported(),
+    _startTime(std::chrono::steady_clock::now()),
+    _terminateRequested(false),
+    _flushRequested(0),
+    _flushedPosition(0),
+    _mutex(),
+    _wakeUp(),
+    _written(),
+    _writer() {
+    if (!_sink) {
+        throw std::invalid_argument("sink must not be null");
+    }
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _writer = std::thread([this]() { writerLoop(); });
+}
+
+AsyncTarget::~AsyncTarget() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminateRequested = true;
+    }
+    _wakeUp.notify_all();
+    _writer.join();
+}
+
+void AsyncTarget::writev(Level level, const char *format, va_list args) {
+    const bool mayDrop = Level::Message != level && Level::Error != level;
+    if (mayDrop && !acquireRate()) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    size_t position = tryPush(level, format, args);
+    if (NO_POSITION == position) {
+        if (mayDrop) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Wait for the writer thread to make room.
+        do {
+            _wakeUp.notify_one();
+            std::this_thread::yield();
+            position = tryPush(level, format, args);
+        } while (NO_POSITION == position);
+    }
+    if (Level::Error == level) {
+        waitFor(position + 1);
+    }
+}
+
+void AsyncTarget::flush() {
+    waitFor(_enqueuePosition.load());
+}
+
+size_t AsyncTarget::tryPush(Level level, const char *format, va_list args) {
+    size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+        slot = &_slots[position & _mask];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (0 == difference) {
+            if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The writer thread has not taken the log message out of this slot yet.
+            return NO_POSITION;
+        } else {
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    slot->level = level;
+    vsnprintf(slot->text, MAX_LOG_MESSAGE, format, args);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return position;
+}
+
+bool AsyncTarget::tryPop(Level& level, std::string& text) {
+    Slot& slot = _slots[_dequeuePosition & _mask];
+    if (slot.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1) {
+        return false;
+    }
+    level = slot.level;
+    text = slot.text;
+    slot.sequence.store(_dequeuePosition + _mask + 1, std::memory_order_release);
+    _dequeuePosition++;
+    return true;
+}
+
+bool AsyncTarget::acquireRate() {
+    const uint64_t second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - _startTime).count();
+    uint64_t current = _rateSecond.load(std::memory_order_relaxed);
+    if (second != current && _rateSecond.compare_exchange_strong(current, second)) {
+        _rateCount.store(0, std::memory_order_relaxed);
+    }
+    return _rateCount.fetch_add(1, std::memory_order_relaxed) < _rateLimit;
+}
+
+void AsyncTarget::write(Level level, const std::string& text) {
+    if (level == _lastLevel && text == _lastText) {
+        _repetitions++;
+        return;
+    }
+    writeRepetitions();
+    _sink->log(level, "%s", text.c_str());
+    _lastLevel = level;
+    _lastText = text;
+    _repetitionsReported = std::chrono::steady_clock::now();
+}
+
+void AsyncTarget::writeRepetitions() {
+    if (_repetitions > 0) {
+        _sink->log(_lastLevel, "last message repeated %" PRIuZ " times\n", _repetitions);
+        _repetitions = 0;
+        _repetitionsReported = std::chrono::steady_clock::now();
+    }
+}
+
+void AsyncTarget::waitFor(size_t position) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _flushRequested = std::max(_flushRequested, position);
+    _wakeUp.notify_one();
+    _written.wait(lock, [this, position]() { return _flushedPosition >= position; });
+}
+
+void AsyncTarget::writerLoop() {
+    static const std::chrono::milliseconds INTERVAL(10);
+    static const std::chrono::seconds REPETITIONS_INTERVAL(1);
+    Level level;
+    std::string text;
+    while (true) {
+        bool idle = true;
+        while (tryPop(level, text)) {
+            write(level, text);
+            idle = false;
+        }
+        const size_t dropped = _dropped.load(std::memory_order_relaxed);
+        if (dropped != _reportedDropped) {
+            writeRepetitions();
+            _sink->log(Level::Warning, "%" PRIuZ " log messages dropped\n", dropped - _reportedDropped);
+            _reportedDropped = dropped;
+        }
+        // Report a long run of repetitions every now and then.
+        if (_repetitions > 0 && std::chrono::steady_clock::now() - _repetitionsReported >= REPETITIONS_INTERVAL) {
+            writeRepetitions();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        const bool terminate = _terminateRequested && _dequeuePosition == _enqueuePosition.load();
+        if (terminate || (_flushRequested > _flushedPosition && _dequeuePosition >= _flushRequested)) {
+            writeRepetitions();
+            _sink->flush();
+            _flushedPosition = _dequeuePosition;
+            _written.notify_all();
+        }
+        if (terminate) {
+            return;
+        }
+        // Producers do not wake up the writer thread, it looks for new log messages periodically.
+        if (idle) {
+            _wakeUp.wait_for(lock, INTERVAL);
+        }
+    }
+}
+
+} // namespace Log
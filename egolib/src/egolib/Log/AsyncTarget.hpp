@@ -0,0 +1,141 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Log/AsyncTarget.hpp
+/// @brief Log target writing to another target on a background thread
+
+#pragma once
+
+#include "egolib/Log/Target.hpp"
+
+namespace Log {
+
+/**
+ * @brief
+ *  A log target which hands its log messages to another log target on a background thread.
+ * @remark
+ *  A log message is formatted on the calling thread into a slot of a bounded ring buffer, which
+ *  is lock-free for any number of producers. The writer thread takes them out in order and writes
+ *  them to the sink. Log messages below the log level are discarded before they are formatted.
+ * @remark
+ *  If the ring buffer is full or more than the rate limit of log messages was written in the
+ *  current second, log messages on the levels "warning", "info" and "debug" are dropped. The
+ *  writer thread reports the number of dropped log messages. Runs of identical log messages are
+ *  written once, followed by the number of repetitions at the end of the run or once per second.
+ * @remark
+ *  Log messages on the levels "message" and "error" are never dropped. A log message on the level
+ *  "error" blocks until it is written to the sink and the sink is flushed, so that it is not lost
+ *  if the program terminates right after.
+ */
+struct AsyncTarget : Target {
+public:
+    /// @brief The maximum length of a log message, longer log messages are truncated.
+    static constexpr size_t MAX_LOG_MESSAGE = 1024;
+
+    /**
+     * @brief
+     *  Construct this log target.
+     * @param sink
+     *  the log target to write to
+     * @param level
+     *  the log level
+     * @param capacity
+     *  the number of log messages the ring buffer can hold, rounded up to a power of two
+     * @param rateLimit
+     *  the number of log messages per second after which log messages are dropped
+     */
+    AsyncTarget(std::unique_ptr<Target> sink, Level level = Level::Warning, size_t capacity = 1024, size_t rateLimit = 1000);
+
+    /**
+     * @brief
+     *  Destruct this log target.
+     *  All log messages are written before the writer thread is stopped.
+     */
+    virtual ~AsyncTarget();
+
+    /**
+     * @brief
+     *  Wait until all log messages written so far are written to the sink and flush the sink.
+     */
+    void flush() override;
+
+    /**
+     * @brief
+     *  Get the number of dropped log messages.
+     */
+    size_t getDropped() const {
+        return _dropped.load();
+    }
+
+protected:
+    void writev(Level level, const char *format, va_list args) override;
+
+private:
+    struct Slot {
+        Slot() : sequence(0), level(Level::Message), text() {}
+        std::atomic<size_t> sequence;   ///< The position of the log message in it, plus one once it is written
+        Level level;
+        char text[MAX_LOG_MESSAGE];
+    };
+
+    /// Claim a slot and format the log message into it, returns its position or NO_POSITION if the ring buffer is full.
+    size_t tryPush(Level level, const char *format, va_list args);
+    /// Take the next log message out of the ring buffer, writer thread only.
+    bool tryPop(Level& level, std::string& text);
+    /// Get if the log message is within the rate limit.
+    bool acquireRate();
+    /// Write a log message to the sink, coalescing repeated log messages, writer thread only.
+    void write(Level level, const std::string& text);
+    /// Write the number of repetitions of the last log message if there are any, writer thread only.
+    void writeRepetitions();
+    /// Wait until the log messages up to a position are written to the sink.
+    void waitFor(size_t position);
+    void writerLoop();
+
+    static const size_t NO_POSITION;
+
+    std::unique_ptr<Target> _sink;
+
+    std::vector<Slot> _slots;
+    size_t _mask;
+    std::atomic<size_t> _enqueuePosition;
+    size_t _dequeuePosition;                ///< Writer thread only
+
+    const size_t _rateLimit;
+    std::atomic<uint64_t> _rateSecond;      ///< The current second since the construction
+    std::atomic<size_t> _rateCount;         ///< Log messages written in the current second
+    std::atomic<size_t> _dropped;
+    size_t _reportedDropped;                ///< Writer thread only
+
+    Level _lastLevel;                       ///< Writer thread only
+    std::string _lastText;                  ///< Writer thread only
+    size_t _repetitions;                    ///< Writer thread only
+    std::chrono::steady_clock::time_point _repetitionsReported; ///< Writer thread only
+
+    std::chrono::steady_clock::time_point _startTime;
+    std::atomic<bool> _terminateRequested;
+    size_t _flushRequested;                 ///< Guarded by _mutex: the sink is flushed once the writer thread gets there
+    size_t _flushedPosition;                ///< Guarded by _mutex: the log messages before it are written and flushed
+    std::mutex _mutex;
+    std::condition_variable _wakeUp;
+    std::condition_variable _written;
+    std::thread _writer;
+};
+
+} // namespace Log
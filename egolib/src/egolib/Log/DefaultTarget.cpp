@@ -95,4 +95,11 @@ void DefaultTarget::writev(Level level, const char *format, va_list args) {
 	setConsoleColor(ConsoleColor::Default);
 }
 
+void DefaultTarget::flush() {
+	if (nullptr != _file) {
+		vfs_flush(_file);
+	}
+	fflush(stdout);
+}
+
 } // namespace Log
@@ -38,6 +38,7 @@ public:
 	DefaultTarget(const std::string& filename, Level level = Level::Warning);
 	virtual ~DefaultTarget();
 	void writev(Level level, const char *format, va_list args) override;
+	void flush() override;
 };
 
 } // namespace Log
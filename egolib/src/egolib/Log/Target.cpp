@@ -34,13 +34,18 @@ Level Target::getLevel() const {
     return _level;
 }
 
+void Target::flush() {}
+
 void Target::logv(Level level, const char *format, va_list args) {
-    if (getLevel() >= level) {
+    if (isEnabled(level)) {
         writev(level, format, args);
     }
 }
 
 void Target::log(Level level, const char *format, ...) {
+    if (!isEnabled(level)) {
+        return;
+    }
     va_list args;
     va_start(args, format);
     writev(level, format, args);
@@ -60,6 +60,24 @@ public:
      *  the log level
      */
     Level getLevel() const;
+    /**
+     * @brief
+     *  Get if log messages on a log level are written.
+     * @param level
+     *  the log level
+     * @return
+     *  @a true if log messages on the log level are written, @a false otherwise
+     * @remark
+     *  Check this before building expensive arguments for a log message.
+     */
+    bool isEnabled(Level level) const {
+        return _level >= level;
+    }
+    /**
+     * @brief
+     *  Write all log messages which have not been written yet.
+     */
+    virtual void flush();
     /**
      * @brief
      *  Write a log message on the specified log level.
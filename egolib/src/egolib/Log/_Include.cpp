@@ -22,6 +22,7 @@
 
 #include "egolib/Log/_Include.hpp"
 
+#include "egolib/Log/AsyncTarget.hpp"
 #include "egolib/Log/DefaultTarget.hpp"
 #include "egolib/Log/ConsoleColor.hpp"
 
@@ -36,7 +37,8 @@ static bool _atexit_registered = false;
 
 void initialize(const std::string& filename, Log::Level level) {
 	if (!g_target) {
-		g_target = std::make_unique<DefaultTarget>(filename, level);
+		// Writing to the file and the console is done on a background thread.
+		g_target = std::make_unique<AsyncTarget>(std::make_unique<DefaultTarget>(filename, level), level);
 	}
 	if (!_atexit_registered) {
 		if (atexit(Log::uninitialize)) {
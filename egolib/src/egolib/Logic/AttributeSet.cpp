@@ -0,0 +1,163 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Logic/AttributeSet.cpp
+/// @brief The attributes of an Object: base values, enchant modifiers and the final values
+
+#include "egolib/Logic/AttributeSet.hpp"
+
+namespace Ego
+{
+
+constexpr float AttributeSet::JUMP_POWER_FLYING;
+
+AttributeSet::AttributeSet() :
+    _base(),
+    _modifiers(),
+    _hasModifier(),
+    _values(),
+    _dirty(true)
+{
+    _base.fill(0.0f);
+    _modifiers.fill(0.0f);
+    _values.fill(0.0f);
+}
+
+float AttributeSet::getBase(const Attribute::AttributeType type) const
+{
+    EGOBOO_ASSERT(type < _base.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    return _base[type];
+}
+
+void AttributeSet::setBase(const Attribute::AttributeType type, float value)
+{
+    EGOBOO_ASSERT(type < _base.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    _base[type] = value;
+    _dirty = true;
+}
+
+bool AttributeSet::hasModifier(const Attribute::AttributeType type) const
+{
+    return _hasModifier[type];
+}
+
+float AttributeSet::getModifier(const Attribute::AttributeType type) const
+{
+    return _modifiers[type];
+}
+
+void AttributeSet::setModifier(const Attribute::AttributeType type, float value)
+{
+    _modifiers[type] = value;
+    _hasModifier[type] = true;
+    _dirty = true;
+}
+
+void AttributeSet::addModifier(const Attribute::AttributeType type, float value)
+{
+    _modifiers[type] += value;
+    _hasModifier[type] = true;
+    _dirty = true;
+}
+
+void AttributeSet::removeModifier(const Attribute::AttributeType type)
+{
+    _modifiers[type] = 0.0f;
+    _hasModifier[type] = false;
+    _dirty = true;
+}
+
+float AttributeSet::compute(const Attribute::AttributeType type, const Context& context) const
+{
+    EGOBOO_ASSERT(type < _base.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+
+    float attributeValue = _base[type];
+
+    if(_hasModifier[type]) {
+
+        //Is this a SET type attribute or a cumulative ADD type attribute?
+        if(Attribute::isOverrideSetAttribute(type)) {
+            return _modifiers[type];
+        }
+        else {
+            //Total value is base plus temp bonuses from enchants
+            attributeValue += _modifiers[type];
+        }
+    }
+
+    switch(type) {
+
+        //Wolverine perk gives +0.25 Life Regeneration while holding a Claw weapon
+        case Attribute::LIFE_REGEN:
+            if(context.wolverine) {
+                attributeValue += 0.25f;
+            }
+        break;
+
+        case Attribute::JUMP_POWER:
+            //Special value for flying Objects
+            if(compute(Attribute::FLY_TO_HEIGHT, context) > 0.0f) {
+                return JUMP_POWER_FLYING;
+            }
+
+            //Athletics Perks gives +25% jump power
+            if(context.athletics) {
+                attributeValue *= 1.25f;
+            }
+
+            //Every point of Might increases jump power by 1%
+            attributeValue *= 1.0f + (compute(Attribute::MIGHT, context) / 100.0f);
+        break;
+
+        //Limit lowest acceleration to zero
+        case Attribute::ACCELERATION:
+        {
+            if(attributeValue < 0.0f) return 0.0f;
+        }
+        break;
+
+        //Limit lowest base attribute to 1
+        case Attribute::MIGHT:
+        case Attribute::AGILITY:
+        case Attribute::INTELLECT:
+        {
+            if(attributeValue < 1.0f) return 1.0f;
+        }
+        break;
+
+        default:
+            //nothing, keep default case to quench GCC warnings
+        break;
+    }
+
+    return attributeValue;
+}
+
+void AttributeSet::update(const Context& context) const
+{
+    for(size_t i = 0; i < Attribute::NR_OF_ATTRIBUTES; ++i) {
+        if(i == Attribute::NR_OF_PRIMARY_ATTRIBUTES) {
+            continue;
+        }
+        _values[i] = compute(static_cast<Attribute::AttributeType>(i), context);
+    }
+    _dirty = false;
+}
+
+} //Ego
@@ -0,0 +1,109 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Logic/AttributeSet.hpp
+/// @brief The attributes of an Object: base values, enchant modifiers and the final values
+
+#pragma once
+
+#include "egolib/Logic/Attribute.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  The attributes of an Object: the base values, the modifiers of the active enchants and the
+ *  final values computed from them.
+ * @remark
+ *  The final values are read very often and change rarely, so all of them are computed at once
+ *  and kept in a flat array. Changing a base value or a modifier marks them dirty, the owner
+ *  must call invalidate() whenever something else the final values depend on changes (see
+ *  Context). The next read recomputes them.
+ */
+class AttributeSet
+{
+public:
+    /// The jump power of a flying Object.
+    static constexpr float JUMP_POWER_FLYING = 255.0f;
+
+    /// What the final values depend on besides the base values and the modifiers.
+    struct Context
+    {
+        bool wolverine;     ///< Has the Wolverine perk and holds a claw weapon
+        bool athletics;     ///< Has the Athletics perk
+    };
+
+    AttributeSet();
+
+    float getBase(const Attribute::AttributeType type) const;
+    void setBase(const Attribute::AttributeType type, float value);
+
+    /// @return true if an enchant modifies the attribute
+    bool hasModifier(const Attribute::AttributeType type) const;
+    /// @return the modifier of the attribute, 0 if no enchant modifies it
+    float getModifier(const Attribute::AttributeType type) const;
+    /// Set the modifier of an attribute, replacing any previous modifier
+    void setModifier(const Attribute::AttributeType type, float value);
+    /// Add to the modifier of an attribute
+    void addModifier(const Attribute::AttributeType type, float value);
+    /// Remove the modifier of an attribute
+    void removeModifier(const Attribute::AttributeType type);
+
+    /// Mark the final values dirty
+    void invalidate() {
+        _dirty = true;
+    }
+
+    bool isDirty() const {
+        return _dirty;
+    }
+
+    /**
+     * @brief
+     *  Get the final value of an attribute.
+     * @param getContext
+     *  a function returning the Context, only called if the final values are dirty
+     */
+    template <typename ContextFunction>
+    float get(const Attribute::AttributeType type, ContextFunction getContext) const {
+        if (_dirty) {
+            update(getContext());
+        }
+        return _values[type];
+    }
+
+    /**
+     * @brief
+     *  Compute the final value of an attribute without looking at the cached final values.
+     */
+    float compute(const Attribute::AttributeType type, const Context& context) const;
+
+private:
+    void update(const Context& context) const;
+
+    std::array<float, Attribute::NR_OF_ATTRIBUTES> _base;
+    std::array<float, Attribute::NR_OF_ATTRIBUTES> _modifiers;
+    std::bitset<Attribute::NR_OF_ATTRIBUTES> _hasModifier;
+
+    mutable std::array<float, Attribute::NR_OF_ATTRIBUTES> _values;
+    mutable bool _dirty;
+};
+
+} //Ego
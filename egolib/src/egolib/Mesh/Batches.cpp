@@ -0,0 +1,169 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/Batches.cpp
+/// @brief  The static geometry of the tiles of a mesh in chunked vertex and index buffers.
+
+#include "egolib/Mesh/Batches.hpp"
+
+namespace Ego {
+
+MeshBatches::MeshBatches() :
+    _width(0), _height(0), _tiles(), _chunks(), _draws() {
+    //ctor
+}
+
+void MeshBatches::resize(int width, int height) {
+    const int chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE,
+              chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    _width = width;
+    _height = height;
+    _tiles.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            _tiles[x + y * width] = Tile{static_cast<size_t>(x / CHUNK_SIZE + (y / CHUNK_SIZE) * chunksX), 0, 0, 0, 0};
+        }
+    }
+    _chunks.clear();
+    _chunks.resize(static_cast<size_t>(chunksX) * static_cast<size_t>(chunksY));
+    for (auto& chunk : _chunks) {
+        chunk.dirty = false;
+        chunk.indexCount = 0;
+    }
+}
+
+void MeshBatches::triangulate(const uint8_t *fanSizes, size_t numberOfFans, const uint16_t *fanVertices,
+                              uint16_t offset, std::vector<uint16_t>& triangles) {
+    for (size_t fan = 0, entry = 0; fan < numberOfFans; entry += fanSizes[fan], ++fan) {
+        // Vertices 0, i and i + 1 of a fan define its i-th triangle.
+        for (size_t i = 1; i + 1 < fanSizes[fan]; ++i) {
+            triangles.push_back(offset + fanVertices[entry]);
+            triangles.push_back(offset + fanVertices[entry + i]);
+            triangles.push_back(offset + fanVertices[entry + i + 1]);
+        }
+    }
+}
+
+void MeshBatches::setTile(size_t index, const Vertex *vertices, size_t numberOfVertices,
+                          const uint8_t *fanSizes, size_t numberOfFans, const uint16_t *fanVertices) {
+    Tile& tile = _tiles[index];
+    Chunk& chunk = _chunks[tile.chunk];
+    if (0 == tile.numberOfVertices) {
+        // Append the tile to its chunk.
+        tile.firstVertex = chunk.vertices.size();
+        tile.numberOfVertices = numberOfVertices;
+        tile.firstIndex = chunk.triangles.size();
+        chunk.vertices.insert(chunk.vertices.end(), vertices, vertices + numberOfVertices);
+        triangulate(fanSizes, numberOfFans, fanVertices, static_cast<uint16_t>(tile.firstVertex), chunk.triangles);
+        tile.numberOfIndices = chunk.triangles.size() - tile.firstIndex;
+    } else {
+        // Replace the tile in its chunk.
+        std::vector<uint16_t> triangles;
+        triangulate(fanSizes, numberOfFans, fanVertices, static_cast<uint16_t>(tile.firstVertex), triangles);
+        if (numberOfVertices != tile.numberOfVertices || triangles.size() != tile.numberOfIndices) {
+            throw std::invalid_argument("the geometry of the tile has changed its size");
+        }
+        std::copy(vertices, vertices + numberOfVertices, chunk.vertices.begin() + tile.firstVertex);
+        std::copy(triangles.begin(), triangles.end(), chunk.triangles.begin() + tile.firstIndex);
+    }
+    chunk.dirty = true;
+}
+
+void MeshBatches::setColours(size_t index, const float (*colours)[3]) {
+    const Tile& tile = _tiles[index];
+    Chunk& chunk = _chunks[tile.chunk];
+    for (size_t i = 0; i < tile.numberOfVertices; ++i) {
+        Vertex& vertex = chunk.vertices[tile.firstVertex + i];
+        vertex.r = colours[i][0];
+        vertex.g = colours[i][1];
+        vertex.b = colours[i][2];
+    }
+    if (!chunk.dirty && chunk.vertexBuffer) {
+        // Write only the colours of the tile to the vertex buffer.
+        VertexBufferScopedLock lock(*chunk.vertexBuffer);
+        Vertex *target = lock.get<Vertex>() + tile.firstVertex;
+        for (size_t i = 0; i < tile.numberOfVertices; ++i) {
+            target[i].r = colours[i][0];
+            target[i].g = colours[i][1];
+            target[i].b = colours[i][2];
+        }
+    }
+}
+
+void MeshBatches::upload(Chunk& chunk) {
+    chunk.vertexBuffer = std::make_unique<VertexBuffer>(chunk.vertices.size(), VertexFormatFactory::get<VertexFormat::P3FC3FT2F>());
+    {
+        VertexBufferScopedLock lock(*chunk.vertexBuffer);
+        std::copy(chunk.vertices.begin(), chunk.vertices.end(), lock.get<Vertex>());
+    }
+    // Every tile is rendered at most once per call, hence the triangles of all tiles fit.
+    chunk.indexBuffer = std::make_unique<IndexBuffer>(chunk.triangles.size(), IndexFormatFactory::get<IndexFormat::IU16>());
+    chunk.dirty = false;
+}
+
+size_t MeshBatches::render(Renderer& renderer, std::vector<Element>& elements, const std::function<void(const Element&)>& bindTexture) {
+    // Skip the tiles without geometry.
+    elements.erase(std::remove_if(elements.begin(), elements.end(),
+                                  [this](const Element& element) { return element.tile >= _tiles.size() || !hasTile(element.tile); }),
+                   elements.end());
+    std::stable_sort(elements.begin(), elements.end(), [this](const Element& x, const Element& y) {
+        return x.texture < y.texture || (x.texture == y.texture && _tiles[x.tile].chunk < _tiles[y.tile].chunk);
+    });
+
+    // Write the triangles of the tiles of each texture in each chunk to the index buffer of the chunk.
+    for (const auto& element : elements) {
+        _chunks[_tiles[element.tile].chunk].indexCount = 0;
+    }
+    _draws.clear();
+    for (size_t i = 0; i < elements.size();) {
+        const size_t chunkIndex = _tiles[elements[i].tile].chunk;
+        Chunk& chunk = _chunks[chunkIndex];
+        if (chunk.dirty) {
+            upload(chunk);
+        }
+        const size_t firstIndex = chunk.indexCount;
+        IndexBufferScopedLock lock(*chunk.indexBuffer);
+        uint16_t *indices = lock.get<uint16_t>();
+        size_t j = i;
+        for (; j < elements.size() && elements[j].texture == elements[i].texture && _tiles[elements[j].tile].chunk == chunkIndex; ++j) {
+            const Tile& tile = _tiles[elements[j].tile];
+            if (chunk.indexCount + tile.numberOfIndices > chunk.indexBuffer->getNumberOfIndices()) {
+                throw std::invalid_argument("a tile is rendered more than once");
+            }
+            std::copy(chunk.triangles.begin() + tile.firstIndex, chunk.triangles.begin() + tile.firstIndex + tile.numberOfIndices,
+                      indices + chunk.indexCount);
+            chunk.indexCount += tile.numberOfIndices;
+        }
+        _draws.push_back(Draw{i, chunkIndex, firstIndex, chunk.indexCount - firstIndex});
+        i = j;
+    }
+
+    // Bind each texture once and render the tiles of each texture in each chunk at once.
+    for (size_t i = 0; i < _draws.size(); ++i) {
+        const Draw& draw = _draws[i];
+        if (0 == i || elements[_draws[i - 1].element].texture != elements[draw.element].texture) {
+            bindTexture(elements[draw.element]);
+        }
+        Chunk& chunk = _chunks[draw.chunk];
+        renderer.render(*chunk.vertexBuffer, *chunk.indexBuffer, PrimitiveType::Triangles, draw.firstIndex, draw.numberOfIndices);
+    }
+    return _draws.size();
+}
+
+} // namespace Ego
@@ -0,0 +1,178 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/Batches.hpp
+/// @brief  The static geometry of the tiles of a mesh in chunked vertex and index buffers.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The triangulated geometry of the tiles of a mesh in chunks of #CHUNK_SIZE x #CHUNK_SIZE tiles.
+ * @remark
+ *  Each chunk stores the vertices of its tiles in one vertex buffer and the triangles of its tiles
+ *  as lists of indices. Rendering a list of tiles groups them by texture and by chunk and issues
+ *  one draw call for the tiles of a texture in a chunk instead of one draw call per triangle fan.
+ * @remark
+ *  The batches are a copy: the owner of the mesh must set the geometry of the tiles and
+ *  update the colours of their vertices if their lighting changes.
+ */
+class MeshBatches {
+public:
+    /// @brief The size, in tiles, of the sides of the chunks.
+    static const int CHUNK_SIZE = 8;
+
+    /// @brief A vertex of a tile, in the layout of Ego::VertexFormat::P3FC3FT2F.
+    struct Vertex {
+        float x, y, z;
+        float r, g, b;
+        float s, t;
+    };
+
+    /// @brief A tile to render.
+    struct Element {
+        size_t tile;        ///< The index of the tile.
+        uint32_t texture;   ///< The texture of the tile.
+    };
+
+    /// @brief Construct empty batches.
+    MeshBatches();
+
+    /**
+     * @brief
+     *  Resize these batches to a mesh of a size.
+     *  The tiles have no geometry.
+     * @param width, height
+     *  the size, in tiles, of the mesh
+     */
+    void resize(int width, int height);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    size_t getTileCount() const { return _tiles.size(); }
+    size_t getChunkCount() const { return _chunks.size(); }
+
+    /**
+     * @brief
+     *  Set the geometry of a tile.
+     * @param tile
+     *  the index of the tile
+     * @param vertices, numberOfVertices
+     *  the vertices of the tile
+     * @param fanSizes, numberOfFans
+     *  the number of vertices of each triangle fan of the tile
+     * @param fanVertices
+     *  the vertices of the triangle fans, relative to the first vertex of the tile
+     * @throw std::invalid_argument
+     *  if the geometry of the tile was set before with another number of vertices or triangles
+     */
+    void setTile(size_t tile, const Vertex *vertices, size_t numberOfVertices,
+                 const uint8_t *fanSizes, size_t numberOfFans, const uint16_t *fanVertices);
+
+    /// @brief Get if the geometry of a tile was set.
+    bool hasTile(size_t tile) const {
+        return _tiles[tile].numberOfVertices > 0;
+    }
+
+    /**
+     * @brief
+     *  Set the colours of the vertices of a tile.
+     *  Only the colours are written to the vertex buffer of the chunk of the tile.
+     * @param tile
+     *  the index of the tile
+     * @param colours
+     *  the colours of the vertices of the tile
+     */
+    void setColours(size_t tile, const float (*colours)[3]);
+
+    /**
+     * @brief
+     *  Render tiles.
+     * @param renderer
+     *  the renderer
+     * @param [in,out] elements
+     *  the tiles to render, each tile at most once. Reordered by texture and chunk, keeping the
+     *  order of the tiles with the same texture in the same chunk. Tiles without geometry are skipped.
+     * @param bindTexture
+     *  invoked with the first element of a texture before the tiles with that texture are rendered
+     * @return
+     *  the number of draw calls
+     * @throw std::invalid_argument
+     *  if tiles are to be rendered more than once and their triangles do not fit into the index buffers
+     */
+    size_t render(Renderer& renderer, std::vector<Element>& elements, const std::function<void(const Element&)>& bindTexture);
+
+    /**
+     * @brief
+     *  Triangulate triangle fans.
+     * @param fanSizes, numberOfFans
+     *  the number of vertices of each triangle fan
+     * @param fanVertices
+     *  the vertices of the triangle fans
+     * @param offset
+     *  added to the vertices
+     * @param [out] triangles
+     *  receives the vertices of the triangles, three per triangle
+     */
+    static void triangulate(const uint8_t *fanSizes, size_t numberOfFans, const uint16_t *fanVertices,
+                            uint16_t offset, std::vector<uint16_t>& triangles);
+
+private:
+    struct Tile {
+        size_t chunk;
+        /// The vertices and the indices of the triangles of this tile in its chunk.
+        size_t firstVertex, numberOfVertices;
+        size_t firstIndex, numberOfIndices;
+    };
+
+    struct Chunk {
+        std::vector<Vertex> vertices;
+        std::vector<uint16_t> triangles;
+        std::unique_ptr<VertexBuffer> vertexBuffer;
+        /// The indices of the tiles rendered by the last call to render().
+        std::unique_ptr<IndexBuffer> indexBuffer;
+        /// If the vertex buffer must be recreated from the vertices.
+        bool dirty;
+        /// The number of indices written to the index buffer by the current call to render().
+        size_t indexCount;
+    };
+
+    /// @brief Recreate the vertex and index buffers of a chunk.
+    void upload(Chunk& chunk);
+
+    int _width;
+    int _height;
+    std::vector<Tile> _tiles;
+    std::vector<Chunk> _chunks;
+    /// A draw call of the current call to render().
+    struct Draw {
+        /// The first element of the draw call.
+        size_t element;
+        /// The chunk and the range of the indices in the index buffer of the chunk.
+        size_t chunk;
+        size_t firstIndex, numberOfIndices;
+    };
+    std::vector<Draw> _draws;
+};
+
+} // namespace Ego
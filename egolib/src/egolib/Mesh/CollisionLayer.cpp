@@ -0,0 +1,62 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CollisionLayer.cpp
+/// @brief  The tiles of a mesh as seen by the physics: FX, twist and corner heights.
+
+#include "egolib/Mesh/CollisionLayer.hpp"
+#include "egolib/FileFormats/map_file.h"
+
+namespace Ego {
+
+MeshCollisionLayer::MeshCollisionLayer() :
+    _width(0), _height(0), _fx(), _twist(), _fanOff(), _maxZ(), _corners() {
+    //ctor
+}
+
+void MeshCollisionLayer::resize(int width, int height) {
+    const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    _width = width;
+    _height = height;
+    _fx.assign(count, 0);
+    _twist.assign(count, TWIST_FLAT);
+    _fanOff.assign(count, 0);
+    _maxZ.assign(count, 0.0f);
+    _corners.assign(count, { { 0.0f, 0.0f, 0.0f, 0.0f } });
+}
+
+void MeshCollisionLayer::setCorners(size_t i, const std::array<float, 4>& z) {
+    _corners[i] = z;
+    _maxZ[i] = std::max(std::max(z[0], z[1]), std::max(z[2], z[3]));
+}
+
+float MeshCollisionLayer::getElevation(size_t i, float x, float y) const {
+    const auto& z = _corners[i];
+
+    // Calculate where on the tile we are relative to top left corner of the tile (0,0).
+    const float px = static_cast<float>(static_cast<int>(x) % Info<int>::Grid::Size());
+    const float py = static_cast<float>(static_cast<int>(y) % Info<int>::Grid::Size());
+
+    // Get the weighted height of each side.
+    const float zleft = (z[0] * (Info<float>::Grid::Size() - py) + z[3] * py) / Info<float>::Grid::Size();
+    const float zright = (z[1] * (Info<float>::Grid::Size() - py) + z[2] * py) / Info<float>::Grid::Size();
+    return (zleft * (Info<float>::Grid::Size() - px) + zright * px) / Info<float>::Grid::Size();
+}
+
+} // namespace Ego
@@ -0,0 +1,124 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CollisionLayer.hpp
+/// @brief  The tiles of a mesh as seen by the physics: FX, twist and corner heights.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The tiles of a mesh as seen by the physics, in parallel arrays indexed by tile index.
+ * @remark
+ *  The wall, pressure and elevation queries run for every object and particle in every update.
+ *  The tile infos of a mesh mostly hold rendering state (normals and lighting caches), so each
+ *  tile looked at by such a query would pull in several cache lines of it. This layer holds the
+ *  few bytes per tile the queries need, packed tightly.
+ * @remark
+ *  The layer is a copy: the owner of the mesh must keep it in sync whenever the FX, the twist
+ *  or the image of a tile change.
+ */
+class MeshCollisionLayer {
+public:
+    /// @brief Construct an empty layer.
+    MeshCollisionLayer();
+
+    /**
+     * @brief
+     *  Resize this layer to a mesh of a size.
+     *  The tiles have no FX, are flat and at elevation 0.
+     * @param width, height
+     *  the size, in tiles, of the mesh
+     */
+    void resize(int width, int height);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    size_t getTileCount() const { return _fx.size(); }
+
+    /// @brief Get the FX of a tile.
+    uint8_t getFX(size_t i) const {
+        return _fx[i];
+    }
+
+    void setFX(size_t i, uint8_t fx) {
+        _fx[i] = fx;
+    }
+
+    /// @brief Get the twist of a tile.
+    uint8_t getTwist(size_t i) const {
+        return _twist[i];
+    }
+
+    void setTwist(size_t i, uint8_t twist) {
+        _twist[i] = twist;
+    }
+
+    /// @brief Get if a tile has its fan rendering turned off.
+    bool isFanOff(size_t i) const {
+        return 0 != _fanOff[i];
+    }
+
+    void setFanOff(size_t i, bool fanOff) {
+        _fanOff[i] = fanOff ? 1 : 0;
+    }
+
+    /**
+     * @brief
+     *  Set the heights of the corners of a tile.
+     * @param z
+     *  the heights of the top-left, top-right, bottom-right and bottom-left corner
+     */
+    void setCorners(size_t i, const std::array<float, 4>& z);
+
+    /// @brief Get the heights of the corners of a tile.
+    const std::array<float, 4>& getCorners(size_t i) const {
+        return _corners[i];
+    }
+
+    /// @brief Get the highest corner of a tile.
+    float getMaxElevation(size_t i) const {
+        return _maxZ[i];
+    }
+
+    /**
+     * @brief
+     *  Get the height of a tile at a point, interpolated between its corners.
+     * @param i
+     *  the index of the tile
+     * @param x, y
+     *  the point (world coordinates), on the tile
+     */
+    float getElevation(size_t i, float x, float y) const;
+
+private:
+    int _width;
+    int _height;
+    std::vector<uint8_t> _fx;
+    std::vector<uint8_t> _twist;
+    std::vector<uint8_t> _fanOff;
+    std::vector<float> _maxZ;
+    std::vector<std::array<float, 4>> _corners;
+};
+
+} // namespace Ego
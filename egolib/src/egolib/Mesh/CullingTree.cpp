@@ -0,0 +1,148 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CullingTree.cpp
+/// @brief  A quadtree of tile blocks for culling the tiles of a mesh against a view frustum.
+
+#include "egolib/Mesh/CullingTree.hpp"
+
+namespace Ego {
+
+MeshCullingTree::MeshCullingTree() :
+    _width(0), _height(0), _tiles(), _nodes() {
+    //ctor
+}
+
+void MeshCullingTree::resize(int width, int height) {
+    const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    _width = width;
+    _height = height;
+    _tiles.assign(count, AxisAlignedBox3f());
+    _nodes.clear();
+    if (0 == count) {
+        return;
+    }
+    _nodes.push_back(Node{AxisAlignedBox3f(), 0, 0, width, height, 0, 0});
+    build(0);
+    update();
+}
+
+void MeshCullingTree::build(size_t node) {
+    const int x0 = _nodes[node]._x0, y0 = _nodes[node]._y0,
+              x1 = _nodes[node]._x1, y1 = _nodes[node]._y1;
+    if (x1 - x0 <= BLOCK_SIZE && y1 - y0 <= BLOCK_SIZE) {
+        return;
+    }
+    // Split at the middle block along each axis longer than a block.
+    const int xm = (x1 - x0 <= BLOCK_SIZE) ? x1 : x0 + ((x1 - x0 + BLOCK_SIZE - 1) / BLOCK_SIZE / 2) * BLOCK_SIZE;
+    const int ym = (y1 - y0 <= BLOCK_SIZE) ? y1 : y0 + ((y1 - y0 + BLOCK_SIZE - 1) / BLOCK_SIZE / 2) * BLOCK_SIZE;
+    const size_t firstChild = _nodes.size();
+    const int xs[] = { x0, xm, x1 }, ys[] = { y0, ym, y1 };
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            if (xs[i] < xs[i + 1] && ys[j] < ys[j + 1]) {
+                _nodes.push_back(Node{AxisAlignedBox3f(), xs[i], ys[j], xs[i + 1], ys[j + 1], 0, 0});
+            }
+        }
+    }
+    _nodes[node]._firstChild = firstChild;
+    _nodes[node]._childCount = _nodes.size() - firstChild;
+    for (size_t i = firstChild, n = _nodes.size(); i < n; ++i) {
+        build(i);
+    }
+}
+
+void MeshCullingTree::update() {
+    // Children are stored after their parents, hence the bounds are joined bottom-up in reverse order.
+    for (size_t i = _nodes.size(); i > 0; --i) {
+        Node& node = _nodes[i - 1];
+        if (0 == node._childCount) {
+            node._bounds = _tiles[node._x0 + node._y0 * _width];
+            for (int y = node._y0; y < node._y1; ++y) {
+                for (int x = node._x0; x < node._x1; ++x) {
+                    node._bounds.join(_tiles[x + y * _width]);
+                }
+            }
+        } else {
+            node._bounds = _nodes[node._firstChild]._bounds;
+            for (size_t j = 1; j < node._childCount; ++j) {
+                node._bounds.join(_nodes[node._firstChild + j]._bounds);
+            }
+        }
+    }
+}
+
+size_t MeshCullingTree::cull(const Graphics::Frustum& frustum, const Point3f& viewpoint, size_t maximum, std::vector<size_t>& tiles) const {
+    tiles.clear();
+    if (!_nodes.empty() && maximum > 0) {
+        cull(0, false, frustum, viewpoint, maximum, tiles);
+    }
+    return tiles.size();
+}
+
+void MeshCullingTree::cull(size_t index, bool inside, const Graphics::Frustum& frustum, const Point3f& viewpoint, size_t maximum, std::vector<size_t>& tiles) const {
+    const Node& node = _nodes[index];
+    // If the parent is inside of the frustum, then so is this node.
+    if (!inside) {
+        switch (frustum.intersects(node._bounds, false)) {
+            case Math::Relation::outside:
+                return;
+            case Math::Relation::inside:
+                inside = true;
+                break;
+            default:
+                break;
+        }
+    }
+    if (0 == node._childCount) {
+        for (int y = node._y0; y < node._y1; ++y) {
+            for (int x = node._x0; x < node._x1; ++x) {
+                const size_t tile = x + y * _width;
+                if (inside || Math::Relation::outside != frustum.intersects(_tiles[tile], false)) {
+                    tiles.push_back(tile);
+                    if (tiles.size() >= maximum) {
+                        return;
+                    }
+                }
+            }
+        }
+        return;
+    }
+    // Visit the children from the nearest to the farthest such that
+    // the nearest tiles are kept if there are more than the maximum.
+    size_t order[4];
+    float distances[4];
+    for (size_t i = 0; i < node._childCount; ++i) {
+        const auto center = _nodes[node._firstChild + i]._bounds.getCenter();
+        const float dx = center[kX] - viewpoint[kX], dy = center[kY] - viewpoint[kY];
+        const float distance = dx * dx + dy * dy;
+        size_t j = i;
+        for (; j > 0 && distances[j - 1] > distance; --j) {
+            order[j] = order[j - 1];
+            distances[j] = distances[j - 1];
+        }
+        order[j] = node._firstChild + i;
+        distances[j] = distance;
+    }
+    for (size_t i = 0; i < node._childCount && tiles.size() < maximum; ++i) {
+        cull(order[i], inside, frustum, viewpoint, maximum, tiles);
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,114 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/CullingTree.hpp
+/// @brief  A quadtree of tile blocks for culling the tiles of a mesh against a view frustum.
+
+#pragma once
+
+#include "egolib/frustum.h"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  A quadtree over the tiles of a mesh for culling them against a view frustum.
+ * @remark
+ *  The leaves of the tree are blocks of at most #BLOCK_SIZE x #BLOCK_SIZE tiles, each node
+ *  stores the bounding box of the tiles below it, including their lowest and highest elevation.
+ *  A node outside of the frustum rejects all of its tiles, a node inside of the frustum accepts
+ *  all of its tiles, only the tiles of leaves partially overlapping the frustum are tested one by one.
+ * @remark
+ *  The tree is a copy: the owner of the mesh must set the bounds of the tiles and update the tree.
+ */
+class MeshCullingTree {
+public:
+    /// @brief The size, in tiles, of the sides of the blocks at the leaves of the tree.
+    static const int BLOCK_SIZE = 4;
+
+    /// @brief Construct an empty tree.
+    MeshCullingTree();
+
+    /**
+     * @brief
+     *  Resize this tree to a mesh of a size.
+     *  The tiles have empty bounds at the origin.
+     * @param width, height
+     *  the size, in tiles, of the mesh
+     */
+    void resize(int width, int height);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    size_t getTileCount() const { return _tiles.size(); }
+    size_t getNodeCount() const { return _nodes.size(); }
+
+    /// @brief Get the bounds of a tile.
+    const AxisAlignedBox3f& getTileBounds(size_t i) const {
+        return _tiles[i];
+    }
+
+    /// @brief Set the bounds of a tile. The tree must be updated before it is culled again.
+    void setTileBounds(size_t i, const AxisAlignedBox3f& bounds) {
+        _tiles[i] = bounds;
+    }
+
+    /// @brief Recompute the bounds of the nodes from the bounds of the tiles.
+    void update();
+
+    /**
+     * @brief
+     *  Get the tiles overlapping a view frustum.
+     * @param frustum
+     *  the view frustum. Its far and near planes are ignored.
+     * @param viewpoint
+     *  the point the frustum is viewed from. Nodes closer to it are visited first.
+     * @param maximum
+     *  the maximum number of tiles to get
+     * @param [out] tiles
+     *  receives the indices of the tiles, nearer blocks before farther blocks
+     * @return
+     *  the number of tiles
+     */
+    size_t cull(const Graphics::Frustum& frustum, const Point3f& viewpoint, size_t maximum, std::vector<size_t>& tiles) const;
+
+private:
+    struct Node {
+        AxisAlignedBox3f _bounds;
+        /// The tiles of this node, the rectangle from (_x0, _y0) inclusive to (_x1, _y1) exclusive.
+        int _x0, _y0, _x1, _y1;
+        /// The children of this node are stored consecutively. A leaf has no children.
+        size_t _firstChild;
+        size_t _childCount;
+    };
+
+    /// @brief Split a node into its children, recursively.
+    void build(size_t node);
+
+    /// @brief Cull a node, recursively.
+    void cull(size_t node, bool inside, const Graphics::Frustum& frustum, const Point3f& viewpoint, size_t maximum, std::vector<size_t>& tiles) const;
+
+    int _width;
+    int _height;
+    std::vector<AxisAlignedBox3f> _tiles;
+    /// The nodes, a parent before its children. The root is the first node.
+    std::vector<Node> _nodes;
+};
+
+} // namespace Ego
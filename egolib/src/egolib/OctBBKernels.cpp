@@ -0,0 +1,658 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/OctBBKernels.cpp
+/// @brief Octagonal bounding box operations with SSE2 and AVX kernels
+
+#include "egolib/OctBBKernels.hpp"
+
+// The SSE2 and AVX kernels are compiled for their instruction set regardless of the
+// compiler options and are only called if the processor supports it.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define EGO_OCT_X86 1
+    #define EGO_OCT_TARGET(TARGET) __attribute__((target(TARGET)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define EGO_OCT_X86 1
+    #define EGO_OCT_TARGET(TARGET)
+    #include <intrin.h>
+    #include <immintrin.h>
+#else
+    #define EGO_OCT_X86 0
+#endif
+
+namespace Ego {
+
+namespace {
+
+constexpr size_t LANES = oct_vec_v2_t::LANES;
+
+/// The bits of the lanes which are axes.
+constexpr int AXES = (1 << OCT_COUNT) - 1;
+
+/// The factors applied to the times and depths, the diagonal axes are scaled to the length of the other axes.
+const float SCALE[LANES] = { 1.0f, 1.0f, 1.0f, Math::invSqrtTwo<float>(), Math::invSqrtTwo<float>(), 1.0f, 1.0f, 1.0f };
+
+/// The parameters of a sweep which are the same for all pairs of bounding boxes.
+struct SweepParameters {
+    bool platform1, platform2;
+    /// The tolerances added to the vertical maximum of the first and of the second bounding box.
+    oct_vec_v2_t raise1, raise2;
+
+    SweepParameters(bool platform1, bool platform2, float tolerance)
+        : platform1(platform1), platform2(platform2),
+          raise1(0.0f, 0.0f, tolerance, 0.0f, 0.0f),
+          raise2(0.0f, 0.0f, platform2 ? tolerance : 0.0f, 0.0f, 0.0f) {
+    }
+};
+
+/// If a platform is above the other bounding box, its horizontal times are measured against mid points.
+bool isClose(const SweepParameters& parameters, const oct_bb_t& src1, const oct_bb_t& src2) {
+    return (parameters.platform1 && src1._mins[OCT_Z] > src2._maxs[OCT_Z])
+        || (parameters.platform2 && src2._mins[OCT_Z] > src1._maxs[OCT_Z]);
+}
+
+/// Replace the horizontal times by the times against the mid points.
+/// Platforms above other bounding boxes are rare, all kernels use this one.
+unsigned sweepClose(const SweepParameters& parameters, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                    oct_vec_v2_t& tmin, oct_vec_v2_t& tmax, unsigned axes) {
+    axes &= (1u << OCT_Z);
+    for (size_t i = 0; i < OCT_COUNT; ++i) {
+        if (OCT_Z == i) {
+            continue;
+        }
+        const float v = ovel2._v[i] - ovel1._v[i];
+        const float min1 = src1._mins._v[i], max1 = src1._maxs._v[i], mid1 = (min1 + max1) * 0.5f;
+        const float min2 = src2._mins._v[i], max2 = src2._maxs._v[i], mid2 = (min2 + max2) * 0.5f;
+        float time[4];
+        if (parameters.platform1) {
+            // The first bounding box is the platform.
+            time[0] = (min1 - mid2) / v;
+            time[1] = (max1 - mid2) / v;
+        } else {
+            time[0] = (mid1 - min2) / v;
+            time[1] = (mid1 - max2) / v;
+        }
+        if (parameters.platform2) {
+            // The second bounding box is the platform.
+            time[2] = (mid1 - min2) / v;
+            time[3] = (mid1 - max2) / v;
+        } else {
+            time[2] = time[0];
+            time[3] = time[1];
+        }
+        const float lo = std::min(std::min(time[0], time[1]), std::min(time[2], time[3])) * SCALE[i];
+        const float hi = std::max(std::max(time[0], time[1]), std::max(time[2], time[3])) * SCALE[i];
+        tmin._v[i] = lo;
+        tmax._v[i] = hi;
+        if (0.0f != v && !(hi < lo)) {
+            axes |= 1u << i;
+        }
+    }
+    return axes;
+}
+
+void joinScalar(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    for (size_t i = 0; i < LANES; ++i) {
+        dst._mins._v[i] = std::min(src1._mins._v[i], src2._mins._v[i]);
+        dst._maxs._v[i] = std::max(src1._maxs._v[i], src2._maxs._v[i]);
+    }
+    dst._empty = oct_bb_t::empty_raw(dst);
+}
+
+void intersectionScalar(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    for (size_t i = 0; i < LANES; ++i) {
+        dst._mins._v[i] = std::max(src1._mins._v[i], src2._mins._v[i]);
+        dst._maxs._v[i] = std::min(src1._maxs._v[i], src2._maxs._v[i]);
+    }
+    dst._empty = oct_bb_t::empty_raw(dst);
+}
+
+void expandScalar(const oct_bb_t& src, const oct_vec_v2_t& offsetMin, const oct_vec_v2_t& offsetMax, oct_bb_t& dst) {
+    for (size_t i = 0; i < LANES; ++i) {
+        const float min = src._mins._v[i], max = src._maxs._v[i];
+        dst._mins._v[i] = std::min(min + offsetMin._v[i], min + offsetMax._v[i]);
+        dst._maxs._v[i] = std::max(max + offsetMin._v[i], max + offsetMax._v[i]);
+    }
+    dst._empty = oct_bb_t::empty_raw(dst);
+}
+
+bool depthScalar(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+    oct_bb_t otmp;
+    intersectionScalar(bb_a, bb_b, otmp);
+    if (otmp._empty) {
+        odepth = oct_vec_v2_t();
+        return false;
+    }
+    bool retval = true;
+    for (size_t i = 0; i < LANES; ++i) {
+        const float fdiff = (bb_b._mins._v[i] + bb_b._maxs._v[i]) * 0.5f - (bb_a._mins._v[i] + bb_a._maxs._v[i]) * 0.5f;
+        const float fdepth = otmp._maxs._v[i] - otmp._mins._v[i];
+        if (i < OCT_COUNT && (fdepth <= 0.0f || 0.0f == fdiff)) {
+            retval = false;
+        }
+        odepth._v[i] = ((fdiff < 0.0f) ? -fdepth : fdepth) * SCALE[i];
+    }
+    return retval;
+}
+
+unsigned sweepScalar(const SweepParameters& parameters, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                     oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    unsigned axes = 0;
+    for (size_t i = 0; i < OCT_COUNT; ++i) {
+        const float v = ovel2._v[i] - ovel1._v[i];
+        const float min1 = src1._mins._v[i], max1 = src1._maxs._v[i];
+        const float min2 = src2._mins._v[i], max2 = src2._maxs._v[i];
+        // The second bounding box is the platform (or neither is).
+        const float plat2 = max2 + parameters.raise2._v[i];
+        const float t0 = (min1 - min2) / v, t1 = (min1 - plat2) / v, t2 = (max1 - min2) / v, t3 = (max1 - plat2) / v;
+        float lo = std::min(std::min(t0, t1), std::min(t2, t3));
+        float hi = std::max(std::max(t0, t1), std::max(t2, t3));
+        if (parameters.platform1 && parameters.platform2) {
+            // The first bounding box is the platform.
+            const float plat1 = max1 + parameters.raise1._v[i];
+            const float t4 = (min1 - max2) / v, t5 = (plat1 - min2) / v, t6 = (plat1 - max2) / v;
+            lo = std::min(lo, std::min(t4, std::min(t5, t6)));
+            hi = std::max(hi, std::max(t4, std::max(t5, t6)));
+        }
+        lo *= SCALE[i];
+        hi *= SCALE[i];
+        tmin._v[i] = lo;
+        tmax._v[i] = hi;
+        if (0.0f != v && !(hi <= lo)) {
+            axes |= 1u << i;
+        }
+    }
+    for (size_t i = OCT_COUNT; i < LANES; ++i) {
+        tmin._v[i] = tmax._v[i] = 0.0f;
+    }
+    return axes;
+}
+
+size_t overlapsScalar(const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results) {
+    size_t overlapping = 0;
+    for (size_t j = 0; j < count; ++j) {
+        oct_bb_t otmp;
+        // Intersection of two empty bounds is an empty bound.
+        if (!(box._empty && boxes[j]._empty)) {
+            intersectionScalar(box, boxes[j], otmp);
+        }
+        results[j] = !otmp._empty;
+        overlapping += results[j] ? 1 : 0;
+    }
+    return overlapping;
+}
+
+#if EGO_OCT_X86
+
+bool cpuSupportsSSE2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return 0 != (info[3] & (1 << 26));
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuSupportsAVX() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    // The operating system must save the AVX registers.
+    const bool osxsave = 0 != (info[2] & (1 << 27)), avx = 0 != (info[2] & (1 << 28));
+    return osxsave && avx && 6 == (_xgetbv(0) & 6);
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx");
+#endif
+}
+
+/// The lanes which are axes as a mask of floats, the padding floats of the times are set to zero with it.
+const uint32_t AXIS_MASK[LANES] = { ~0u, ~0u, ~0u, ~0u, ~0u, 0u, 0u, 0u };
+
+// std::min(a, b) is (b < a) ? b : a and _mm_min_ps(b, a) is the same, also for zeroes of different
+// sign and for NaNs. Likewise for std::max(a, b) and _mm_max_ps(b, a).
+
+EGO_OCT_TARGET("sse2")
+void joinSSE2(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    int empty = 0;
+    for (size_t i = 0; i < LANES; i += 4) {
+        const __m128 mins = _mm_min_ps(_mm_loadu_ps(src2._mins._v + i), _mm_loadu_ps(src1._mins._v + i));
+        const __m128 maxs = _mm_max_ps(_mm_loadu_ps(src2._maxs._v + i), _mm_loadu_ps(src1._maxs._v + i));
+        _mm_storeu_ps(dst._mins._v + i, mins);
+        _mm_storeu_ps(dst._maxs._v + i, maxs);
+        empty |= _mm_movemask_ps(_mm_cmpgt_ps(mins, maxs)) << i;
+    }
+    dst._empty = 0 != (empty & AXES);
+}
+
+EGO_OCT_TARGET("sse2")
+void intersectionSSE2(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    int empty = 0;
+    for (size_t i = 0; i < LANES; i += 4) {
+        const __m128 mins = _mm_max_ps(_mm_loadu_ps(src2._mins._v + i), _mm_loadu_ps(src1._mins._v + i));
+        const __m128 maxs = _mm_min_ps(_mm_loadu_ps(src2._maxs._v + i), _mm_loadu_ps(src1._maxs._v + i));
+        _mm_storeu_ps(dst._mins._v + i, mins);
+        _mm_storeu_ps(dst._maxs._v + i, maxs);
+        empty |= _mm_movemask_ps(_mm_cmpgt_ps(mins, maxs)) << i;
+    }
+    dst._empty = 0 != (empty & AXES);
+}
+
+EGO_OCT_TARGET("sse2")
+void expandSSE2(const oct_bb_t& src, const oct_vec_v2_t& offsetMin, const oct_vec_v2_t& offsetMax, oct_bb_t& dst) {
+    int empty = 0;
+    for (size_t i = 0; i < LANES; i += 4) {
+        const __m128 min = _mm_loadu_ps(src._mins._v + i), max = _mm_loadu_ps(src._maxs._v + i);
+        const __m128 lo = _mm_loadu_ps(offsetMin._v + i), hi = _mm_loadu_ps(offsetMax._v + i);
+        const __m128 mins = _mm_min_ps(_mm_add_ps(min, hi), _mm_add_ps(min, lo));
+        const __m128 maxs = _mm_max_ps(_mm_add_ps(max, hi), _mm_add_ps(max, lo));
+        _mm_storeu_ps(dst._mins._v + i, mins);
+        _mm_storeu_ps(dst._maxs._v + i, maxs);
+        empty |= _mm_movemask_ps(_mm_cmpgt_ps(mins, maxs)) << i;
+    }
+    dst._empty = 0 != (empty & AXES);
+}
+
+EGO_OCT_TARGET("sse2")
+bool depthSSE2(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+    const __m128 zero = _mm_setzero_ps(), half = _mm_set1_ps(0.5f), sign = _mm_set1_ps(-0.0f);
+    __m128 depth[LANES / 4];
+    int empty = 0, bad = 0;
+    for (size_t i = 0; i < LANES; i += 4) {
+        const __m128 minA = _mm_loadu_ps(bb_a._mins._v + i), maxA = _mm_loadu_ps(bb_a._maxs._v + i);
+        const __m128 minB = _mm_loadu_ps(bb_b._mins._v + i), maxB = _mm_loadu_ps(bb_b._maxs._v + i);
+        const __m128 mins = _mm_max_ps(minB, minA), maxs = _mm_min_ps(maxB, maxA);
+        empty |= _mm_movemask_ps(_mm_cmpgt_ps(mins, maxs)) << i;
+        const __m128 fdiff = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(minB, maxB), half), _mm_mul_ps(_mm_add_ps(minA, maxA), half));
+        const __m128 fdepth = _mm_sub_ps(maxs, mins);
+        bad |= _mm_movemask_ps(_mm_or_ps(_mm_cmple_ps(fdepth, zero), _mm_cmpeq_ps(fdiff, zero))) << i;
+        // Flip the sign of the depth where the difference is negative.
+        const __m128 flip = _mm_and_ps(_mm_cmplt_ps(fdiff, zero), sign);
+        depth[i / 4] = _mm_mul_ps(_mm_xor_ps(fdepth, flip), _mm_loadu_ps(SCALE + i));
+    }
+    if (0 != (empty & AXES)) {
+        odepth = oct_vec_v2_t();
+        return false;
+    }
+    for (size_t i = 0; i < LANES; i += 4) {
+        _mm_storeu_ps(odepth._v + i, depth[i / 4]);
+    }
+    return 0 == (bad & AXES);
+}
+
+EGO_OCT_TARGET("sse2")
+unsigned sweepSSE2(const SweepParameters& parameters, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                   oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    const bool both = parameters.platform1 && parameters.platform2;
+    int valid = 0, invalid = 0;
+    for (size_t i = 0; i < LANES; i += 4) {
+        const __m128 v = _mm_sub_ps(_mm_loadu_ps(ovel2._v + i), _mm_loadu_ps(ovel1._v + i));
+        const __m128 min1 = _mm_loadu_ps(src1._mins._v + i), max1 = _mm_loadu_ps(src1._maxs._v + i);
+        const __m128 min2 = _mm_loadu_ps(src2._mins._v + i), max2 = _mm_loadu_ps(src2._maxs._v + i);
+        // The second bounding box is the platform (or neither is).
+        const __m128 plat2 = _mm_add_ps(max2, _mm_loadu_ps(parameters.raise2._v + i));
+        const __m128 t0 = _mm_div_ps(_mm_sub_ps(min1, min2), v), t1 = _mm_div_ps(_mm_sub_ps(min1, plat2), v);
+        const __m128 t2 = _mm_div_ps(_mm_sub_ps(max1, min2), v), t3 = _mm_div_ps(_mm_sub_ps(max1, plat2), v);
+        __m128 lo = _mm_min_ps(_mm_min_ps(t1, t0), _mm_min_ps(t3, t2));
+        __m128 hi = _mm_max_ps(_mm_max_ps(t1, t0), _mm_max_ps(t3, t2));
+        if (both) {
+            // The first bounding box is the platform.
+            const __m128 plat1 = _mm_add_ps(max1, _mm_loadu_ps(parameters.raise1._v + i));
+            const __m128 t4 = _mm_div_ps(_mm_sub_ps(min1, max2), v);
+            const __m128 t5 = _mm_div_ps(_mm_sub_ps(plat1, min2), v), t6 = _mm_div_ps(_mm_sub_ps(plat1, max2), v);
+            lo = _mm_min_ps(_mm_min_ps(_mm_min_ps(t6, t5), t4), lo);
+            hi = _mm_max_ps(_mm_max_ps(_mm_max_ps(t6, t5), t4), hi);
+        }
+        const __m128 scale = _mm_loadu_ps(SCALE + i);
+        const __m128 mask = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(AXIS_MASK + i)));
+        lo = _mm_and_ps(_mm_mul_ps(lo, scale), mask);
+        hi = _mm_and_ps(_mm_mul_ps(hi, scale), mask);
+        _mm_storeu_ps(tmin._v + i, lo);
+        _mm_storeu_ps(tmax._v + i, hi);
+        valid |= _mm_movemask_ps(_mm_cmpneq_ps(v, _mm_setzero_ps())) << i;
+        invalid |= _mm_movemask_ps(_mm_cmple_ps(hi, lo)) << i;
+    }
+    return static_cast<unsigned>(valid & ~invalid & AXES);
+}
+
+EGO_OCT_TARGET("sse2")
+size_t overlapsSSE2(const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results) {
+    const __m128 minLo = _mm_loadu_ps(box._mins._v), minHi = _mm_loadu_ps(box._mins._v + 4);
+    const __m128 maxLo = _mm_loadu_ps(box._maxs._v), maxHi = _mm_loadu_ps(box._maxs._v + 4);
+    size_t overlapping = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const oct_bb_t& other = boxes[j];
+        if (box._empty && other._empty) {
+            results[j] = false;
+            continue;
+        }
+        const __m128 lo = _mm_cmpgt_ps(_mm_max_ps(_mm_loadu_ps(other._mins._v), minLo), _mm_min_ps(_mm_loadu_ps(other._maxs._v), maxLo));
+        const __m128 hi = _mm_cmpgt_ps(_mm_max_ps(_mm_loadu_ps(other._mins._v + 4), minHi), _mm_min_ps(_mm_loadu_ps(other._maxs._v + 4), maxHi));
+        const int empty = _mm_movemask_ps(lo) | (_mm_movemask_ps(hi) << 4);
+        results[j] = 0 == (empty & AXES);
+        overlapping += results[j] ? 1 : 0;
+    }
+    return overlapping;
+}
+
+EGO_OCT_TARGET("avx")
+void joinAVX(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    const __m256 mins = _mm256_min_ps(_mm256_loadu_ps(src2._mins._v), _mm256_loadu_ps(src1._mins._v));
+    const __m256 maxs = _mm256_max_ps(_mm256_loadu_ps(src2._maxs._v), _mm256_loadu_ps(src1._maxs._v));
+    _mm256_storeu_ps(dst._mins._v, mins);
+    _mm256_storeu_ps(dst._maxs._v, maxs);
+    dst._empty = 0 != (_mm256_movemask_ps(_mm256_cmp_ps(mins, maxs, _CMP_GT_OQ)) & AXES);
+}
+
+EGO_OCT_TARGET("avx")
+void intersectionAVX(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    const __m256 mins = _mm256_max_ps(_mm256_loadu_ps(src2._mins._v), _mm256_loadu_ps(src1._mins._v));
+    const __m256 maxs = _mm256_min_ps(_mm256_loadu_ps(src2._maxs._v), _mm256_loadu_ps(src1._maxs._v));
+    _mm256_storeu_ps(dst._mins._v, mins);
+    _mm256_storeu_ps(dst._maxs._v, maxs);
+    dst._empty = 0 != (_mm256_movemask_ps(_mm256_cmp_ps(mins, maxs, _CMP_GT_OQ)) & AXES);
+}
+
+EGO_OCT_TARGET("avx")
+void expandAVX(const oct_bb_t& src, const oct_vec_v2_t& offsetMin, const oct_vec_v2_t& offsetMax, oct_bb_t& dst) {
+    const __m256 min = _mm256_loadu_ps(src._mins._v), max = _mm256_loadu_ps(src._maxs._v);
+    const __m256 lo = _mm256_loadu_ps(offsetMin._v), hi = _mm256_loadu_ps(offsetMax._v);
+    const __m256 mins = _mm256_min_ps(_mm256_add_ps(min, hi), _mm256_add_ps(min, lo));
+    const __m256 maxs = _mm256_max_ps(_mm256_add_ps(max, hi), _mm256_add_ps(max, lo));
+    _mm256_storeu_ps(dst._mins._v, mins);
+    _mm256_storeu_ps(dst._maxs._v, maxs);
+    dst._empty = 0 != (_mm256_movemask_ps(_mm256_cmp_ps(mins, maxs, _CMP_GT_OQ)) & AXES);
+}
+
+EGO_OCT_TARGET("avx")
+bool depthAVX(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+    const __m256 zero = _mm256_setzero_ps(), half = _mm256_set1_ps(0.5f), sign = _mm256_set1_ps(-0.0f);
+    const __m256 minA = _mm256_loadu_ps(bb_a._mins._v), maxA = _mm256_loadu_ps(bb_a._maxs._v);
+    const __m256 minB = _mm256_loadu_ps(bb_b._mins._v), maxB = _mm256_loadu_ps(bb_b._maxs._v);
+    const __m256 mins = _mm256_max_ps(minB, minA), maxs = _mm256_min_ps(maxB, maxA);
+    if (0 != (_mm256_movemask_ps(_mm256_cmp_ps(mins, maxs, _CMP_GT_OQ)) & AXES)) {
+        odepth = oct_vec_v2_t();
+        return false;
+    }
+    const __m256 fdiff = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(minB, maxB), half), _mm256_mul_ps(_mm256_add_ps(minA, maxA), half));
+    const __m256 fdepth = _mm256_sub_ps(maxs, mins);
+    const int bad = _mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(fdepth, zero, _CMP_LE_OQ), _mm256_cmp_ps(fdiff, zero, _CMP_EQ_OQ)));
+    // Flip the sign of the depth where the difference is negative.
+    const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(fdiff, zero, _CMP_LT_OQ), sign);
+    _mm256_storeu_ps(odepth._v, _mm256_mul_ps(_mm256_xor_ps(fdepth, flip), _mm256_loadu_ps(SCALE)));
+    return 0 == (bad & AXES);
+}
+
+EGO_OCT_TARGET("avx")
+unsigned sweepAVX(const SweepParameters& parameters, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                  oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    const __m256 v = _mm256_sub_ps(_mm256_loadu_ps(ovel2._v), _mm256_loadu_ps(ovel1._v));
+    const __m256 min1 = _mm256_loadu_ps(src1._mins._v), max1 = _mm256_loadu_ps(src1._maxs._v);
+    const __m256 min2 = _mm256_loadu_ps(src2._mins._v), max2 = _mm256_loadu_ps(src2._maxs._v);
+    // The second bounding box is the platform (or neither is).
+    const __m256 plat2 = _mm256_add_ps(max2, _mm256_loadu_ps(parameters.raise2._v));
+    const __m256 t0 = _mm256_div_ps(_mm256_sub_ps(min1, min2), v), t1 = _mm256_div_ps(_mm256_sub_ps(min1, plat2), v);
+    const __m256 t2 = _mm256_div_ps(_mm256_sub_ps(max1, min2), v), t3 = _mm256_div_ps(_mm256_sub_ps(max1, plat2), v);
+    __m256 lo = _mm256_min_ps(_mm256_min_ps(t1, t0), _mm256_min_ps(t3, t2));
+    __m256 hi = _mm256_max_ps(_mm256_max_ps(t1, t0), _mm256_max_ps(t3, t2));
+    if (parameters.platform1 && parameters.platform2) {
+        // The first bounding box is the platform.
+        const __m256 plat1 = _mm256_add_ps(max1, _mm256_loadu_ps(parameters.raise1._v));
+        const __m256 t4 = _mm256_div_ps(_mm256_sub_ps(min1, max2), v);
+        const __m256 t5 = _mm256_div_ps(_mm256_sub_ps(plat1, min2), v), t6 = _mm256_div_ps(_mm256_sub_ps(plat1, max2), v);
+        lo = _mm256_min_ps(_mm256_min_ps(_mm256_min_ps(t6, t5), t4), lo);
+        hi = _mm256_max_ps(_mm256_max_ps(_mm256_max_ps(t6, t5), t4), hi);
+    }
+    const __m256 scale = _mm256_loadu_ps(SCALE);
+    const __m256 mask = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(AXIS_MASK)));
+    lo = _mm256_and_ps(_mm256_mul_ps(lo, scale), mask);
+    hi = _mm256_and_ps(_mm256_mul_ps(hi, scale), mask);
+    _mm256_storeu_ps(tmin._v, lo);
+    _mm256_storeu_ps(tmax._v, hi);
+    const int valid = _mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+    const int invalid = _mm256_movemask_ps(_mm256_cmp_ps(hi, lo, _CMP_LE_OQ));
+    return static_cast<unsigned>(valid & ~invalid & AXES);
+}
+
+EGO_OCT_TARGET("avx")
+size_t overlapsAVX(const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results) {
+    const __m256 min = _mm256_loadu_ps(box._mins._v), max = _mm256_loadu_ps(box._maxs._v);
+    size_t overlapping = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const oct_bb_t& other = boxes[j];
+        if (box._empty && other._empty) {
+            results[j] = false;
+            continue;
+        }
+        const __m256 mins = _mm256_max_ps(_mm256_loadu_ps(other._mins._v), min);
+        const __m256 maxs = _mm256_min_ps(_mm256_loadu_ps(other._maxs._v), max);
+        results[j] = 0 == (_mm256_movemask_ps(_mm256_cmp_ps(mins, maxs, _CMP_GT_OQ)) & AXES);
+        overlapping += results[j] ? 1 : 0;
+    }
+    return overlapping;
+}
+
+#endif
+
+OctBBKernels::Kernel getFastestKernel() {
+#if EGO_OCT_X86
+    if (cpuSupportsAVX()) {
+        return OctBBKernels::Kernel::AVX;
+    }
+    if (cpuSupportsSSE2()) {
+        return OctBBKernels::Kernel::SSE2;
+    }
+#endif
+    return OctBBKernels::Kernel::Scalar;
+}
+
+unsigned sweepPair(OctBBKernels::Kernel kernel, const SweepParameters& parameters, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+               oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    unsigned axes;
+    switch (kernel) {
+#if EGO_OCT_X86
+        case OctBBKernels::Kernel::AVX:
+            axes = sweepAVX(parameters, src1, ovel1, src2, ovel2, tmin, tmax);
+            break;
+        case OctBBKernels::Kernel::SSE2:
+            axes = sweepSSE2(parameters, src1, ovel1, src2, ovel2, tmin, tmax);
+            break;
+#endif
+        default:
+            axes = sweepScalar(parameters, src1, ovel1, src2, ovel2, tmin, tmax);
+            break;
+    }
+    if (isClose(parameters, src1, src2)) {
+        axes = sweepClose(parameters, src1, ovel1, src2, ovel2, tmin, tmax, axes);
+    }
+    return axes;
+}
+
+} // anonymous namespace
+
+OctBBKernels::Kernel OctBBKernels::_kernel = getFastestKernel();
+
+bool OctBBKernels::isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if EGO_OCT_X86
+        case Kernel::SSE2:
+            return cpuSupportsSSE2();
+        case Kernel::AVX:
+            return cpuSupportsAVX();
+#endif
+        default:
+            return false;
+    }
+}
+
+OctBBKernels::Kernel OctBBKernels::getKernel() {
+    return _kernel;
+}
+
+bool OctBBKernels::setKernel(Kernel kernel) {
+    if (!isSupported(kernel)) {
+        return false;
+    }
+    _kernel = kernel;
+    return true;
+}
+
+void OctBBKernels::join(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    join(_kernel, src1, src2, dst);
+}
+
+void OctBBKernels::join(Kernel kernel, const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+    switch (kernel) {
+#if EGO_OCT_X86
+        case Kernel::AVX:
+            joinAVX(src1, src2, dst);
+            break;
+        case Kernel::SSE2:
+            joinSSE2(src1, src2, dst);
+            break;
+#endif
+        default:
+            joinScalar(src1, src2, dst);
+            break;
+    }
+}
+
+oct_bb_t OctBBKernels::intersection(const oct_bb_t& src1, const oct_bb_t& src2) {
+    return intersection(_kernel, src1, src2);
+}
+
+oct_bb_t OctBBKernels::intersection(Kernel kernel, const oct_bb_t& src1, const oct_bb_t& src2) {
+    // Intersection of two empty bounds is an empty bound.
+    if (src1._empty && src2._empty) {
+        return oct_bb_t();
+    }
+    oct_bb_t dst;
+    switch (kernel) {
+#if EGO_OCT_X86
+        case Kernel::AVX:
+            intersectionAVX(src1, src2, dst);
+            break;
+        case Kernel::SSE2:
+            intersectionSSE2(src1, src2, dst);
+            break;
+#endif
+        default:
+            intersectionScalar(src1, src2, dst);
+            break;
+    }
+    return dst;
+}
+
+void OctBBKernels::expand(const oct_bb_t& src, const Vector3f& vel, float tmin, float tmax, oct_bb_t& dst) {
+    expand(_kernel, src, vel, tmin, tmax, dst);
+}
+
+void OctBBKernels::expand(Kernel kernel, const oct_bb_t& src, const Vector3f& vel, float tmin, float tmax, oct_bb_t& dst) {
+    if (0.0f == vel.length_abs()) {
+        dst = src;
+        return;
+    }
+    // At time 0 the bounding box is not translated. Adding -0 leaves every float as it is, also +0.
+    static const oct_vec_v2_t Identity(-0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+    const oct_vec_v2_t offsetMin = (0.0f == tmin) ? Identity : oct_vec_v2_t(vel * tmin);
+    const oct_vec_v2_t offsetMax = (0.0f == tmax) ? Identity : oct_vec_v2_t(vel * tmax);
+    switch (kernel) {
+#if EGO_OCT_X86
+        case Kernel::AVX:
+            expandAVX(src, offsetMin, offsetMax, dst);
+            break;
+        case Kernel::SSE2:
+            expandSSE2(src, offsetMin, offsetMax, dst);
+            break;
+#endif
+        default:
+            expandScalar(src, offsetMin, offsetMax, dst);
+            break;
+    }
+}
+
+bool OctBBKernels::getCollisionDepth(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+    return getCollisionDepth(_kernel, bb_a, bb_b, odepth);
+}
+
+bool OctBBKernels::getCollisionDepth(Kernel kernel, const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+    // are the initial volumes any good?
+    if (bb_a._empty || bb_b._empty) {
+        odepth = oct_vec_v2_t();
+        return false;
+    }
+    switch (kernel) {
+#if EGO_OCT_X86
+        case Kernel::AVX:
+            return depthAVX(bb_a, bb_b, odepth);
+        case Kernel::SSE2:
+            return depthSSE2(bb_a, bb_b, odepth);
+#endif
+        default:
+            return depthScalar(bb_a, bb_b, odepth);
+    }
+}
+
+unsigned OctBBKernels::sweep(const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                             bool platform1, bool platform2, float tolerance, oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    return sweep(_kernel, src1, ovel1, src2, ovel2, platform1, platform2, tolerance, tmin, tmax);
+}
+
+unsigned OctBBKernels::sweep(Kernel kernel, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                             bool platform1, bool platform2, float tolerance, oct_vec_v2_t& tmin, oct_vec_v2_t& tmax) {
+    const SweepParameters parameters(platform1, platform2, tolerance);
+    return sweepPair(kernel, parameters, src1, ovel1, src2, ovel2, tmin, tmax);
+}
+
+size_t OctBBKernels::overlaps(const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results) {
+    return overlaps(_kernel, box, boxes, count, results);
+}
+
+size_t OctBBKernels::overlaps(Kernel kernel, const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results) {
+    switch (kernel) {
+#if EGO_OCT_X86
+        case Kernel::AVX:
+            return overlapsAVX(box, boxes, count, results);
+        case Kernel::SSE2:
+            return overlapsSSE2(box, boxes, count, results);
+#endif
+        default:
+            return overlapsScalar(box, boxes, count, results);
+    }
+}
+
+void OctBBKernels::sweep(const oct_bb_t& box, const oct_vec_v2_t& ovel, const oct_bb_t *boxes, const oct_vec_v2_t *ovels, size_t count,
+                         bool platform1, bool platform2, float tolerance, oct_vec_v2_t *tmins, oct_vec_v2_t *tmaxs, unsigned *axes) {
+    sweep(_kernel, box, ovel, boxes, ovels, count, platform1, platform2, tolerance, tmins, tmaxs, axes);
+}
+
+void OctBBKernels::sweep(Kernel kernel, const oct_bb_t& box, const oct_vec_v2_t& ovel, const oct_bb_t *boxes, const oct_vec_v2_t *ovels, size_t count,
+                         bool platform1, bool platform2, float tolerance, oct_vec_v2_t *tmins, oct_vec_v2_t *tmaxs, unsigned *axes) {
+    const SweepParameters parameters(platform1, platform2, tolerance);
+    for (size_t j = 0; j < count; ++j) {
+        axes[j] = sweepPair(kernel, parameters, box, ovel, boxes[j], ovels[j], tmins[j], tmaxs[j]);
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,167 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/OctBBKernels.hpp
+/// @brief Octagonal bounding box operations with SSE2 and AVX kernels
+
+#pragma once
+
+#include "egolib/bbox.h"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The operations on octagonal bounding boxes used by the collision detection.
+ * @remark
+ *  The SSE2 kernel processes the eight floats of an octagonal vector four at a time, the
+ *  AVX kernel all eight at once. The padding floats are computed along but never affect a result.
+ * @remark
+ *  All kernels compute the same values as the scalar kernel, they do not use fused
+ *  multiply-add instructions and divide where the scalar code divides.
+ */
+class OctBBKernels {
+public:
+    enum class Kernel {
+        Scalar,
+        SSE2,
+        AVX,
+    };
+
+    /**
+     * @brief
+     *  Get if the processor and the build support a kernel.
+     */
+    static bool isSupported(Kernel kernel);
+
+    /**
+     * @brief
+     *  Get the kernel used by the operations, by default the fastest supported one.
+     */
+    static Kernel getKernel();
+
+    /**
+     * @brief
+     *  Set the kernel used by the operations.
+     * @return
+     *  @a false if the kernel is not supported, the kernel is not changed in that case
+     */
+    static bool setKernel(Kernel kernel);
+
+public:
+    /**
+     * @brief
+     *  Compute the join (the union) of two octagonal bounding boxes, see oct_bb_t::join.
+     * @remark
+     *  @a dst may be @a src1 or @a src2.
+     */
+    static void join(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst);
+    static void join(Kernel kernel, const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst);
+
+    /**
+     * @brief
+     *  Compute the intersection of two octagonal bounding boxes, see oct_bb_t::intersection.
+     */
+    static oct_bb_t intersection(const oct_bb_t& src1, const oct_bb_t& src2);
+    static oct_bb_t intersection(Kernel kernel, const oct_bb_t& src1, const oct_bb_t& src2);
+
+    /**
+     * @brief
+     *  Expand an octagonal bounding box to cover its movement in the time range [tmin, tmax].
+     * @param src
+     *  the bounding box at time @a 0
+     * @param vel
+     *  the velocity of the bounding box
+     * @param dst
+     *  the join of the bounding box translated to time @a tmin and to time @a tmax
+     * @remark
+     *  @a dst may be @a src.
+     */
+    static void expand(const oct_bb_t& src, const Vector3f& vel, float tmin, float tmax, oct_bb_t& dst);
+    static void expand(Kernel kernel, const oct_bb_t& src, const Vector3f& vel, float tmin, float tmax, oct_bb_t& dst);
+
+    /**
+     * @brief
+     *  Get the signed depth of the overlap of two octagonal bounding boxes along each axis.
+     * @param odepth
+     *  the depths, negative along the axes along which the mid point of @a bb_b is smaller than the one of @a bb_a.
+     *  The depths along the diagonal axes are scaled to the length of the other axes.
+     * @return
+     *  @a true if the bounding boxes overlap along every axis and their mid points differ along every axis,
+     *  @a false otherwise
+     */
+    static bool getCollisionDepth(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth);
+    static bool getCollisionDepth(Kernel kernel, const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth);
+
+    /**
+     * @brief
+     *  Get when two moving octagonal bounding boxes overlap along each axis.
+     * @param src1, src2
+     *  the bounding boxes at time @a 0
+     * @param ovel1, ovel2
+     *  the velocities of the bounding boxes
+     * @param platform1, platform2
+     *  if the first or the second bounding box may be a platform for the other one
+     * @param tolerance
+     *  the height above a platform at which the other bounding box still counts as standing on it
+     * @param tmin, tmax
+     *  the times at which the bounding boxes start and stop overlapping along an axis.
+     *  The times along the diagonal axes are scaled to the length of the other axes.
+     * @return
+     *  the axes with a valid time range, bit @a i is set for axis @a i
+     * @remark
+     *  If a bounding box may be a platform and its feet are above the other one, the horizontal
+     *  times are measured against its mid point, the vertical times include the tolerance.
+     */
+    static unsigned sweep(const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                          bool platform1, bool platform2, float tolerance, oct_vec_v2_t& tmin, oct_vec_v2_t& tmax);
+    static unsigned sweep(Kernel kernel, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2,
+                          bool platform1, bool platform2, float tolerance, oct_vec_v2_t& tmin, oct_vec_v2_t& tmax);
+
+public:
+    /**
+     * @brief
+     *  Get which of some octagonal bounding boxes overlap an octagonal bounding box.
+     * @param results
+     *  <tt>results[i]</tt> is @a true if the intersection of @a box and <tt>boxes[i]</tt> is not empty
+     * @return
+     *  the number of overlapping bounding boxes
+     */
+    static size_t overlaps(const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results);
+    static size_t overlaps(Kernel kernel, const oct_bb_t& box, const oct_bb_t *boxes, size_t count, bool *results);
+
+    /**
+     * @brief
+     *  Get when a moving octagonal bounding box overlaps some other moving octagonal bounding boxes along each axis.
+     * @param tmins, tmaxs, axes
+     *  <tt>tmins[i]</tt>, <tt>tmaxs[i]</tt> and <tt>axes[i]</tt> receive the results of sweep()
+     *  for @a box and <tt>boxes[i]</tt>
+     * @remark
+     *  @a platform1 refers to @a box and @a platform2 to the other bounding boxes.
+     */
+    static void sweep(const oct_bb_t& box, const oct_vec_v2_t& ovel, const oct_bb_t *boxes, const oct_vec_v2_t *ovels, size_t count,
+                      bool platform1, bool platform2, float tolerance, oct_vec_v2_t *tmins, oct_vec_v2_t *tmaxs, unsigned *axes);
+    static void sweep(Kernel kernel, const oct_bb_t& box, const oct_vec_v2_t& ovel, const oct_bb_t *boxes, const oct_vec_v2_t *ovels, size_t count,
+                      bool platform1, bool platform2, float tolerance, oct_vec_v2_t *tmins, oct_vec_v2_t *tmaxs, unsigned *axes);
+
+private:
+    static Kernel _kernel;
+};
+
+} // namespace Ego
@@ -30,12 +30,38 @@
 #include "egolib/Audio/AudioSystem.hpp"
 #include "egolib/FileFormats/template.h"
 #include "egolib/Math/Random.hpp"
+#include "egolib/egoboo_setup.h"
 
 static const SkinInfo INVALID_SKIN = SkinInfo();
 
+struct ObjectProfile::PendingResources
+{
+    PendingResources() :
+        enchant(nullptr),
+        particles(),
+        sounds()
+    {
+        //ctor
+    }
+
+    ~PendingResources()
+    {
+        // Free the sounds which were never added to the audio system
+        for (const auto &element : sounds)
+        {
+            Mix_FreeChunk(element.second);
+        }
+    }
+
+    std::shared_ptr<EnchantProfile> enchant;
+    std::vector<std::pair<LocalParticleProfileRef, std::shared_ptr<ParticleProfile>>> particles;
+    std::vector<std::pair<size_t, Mix_Chunk *>> sounds;
+};
+
 ObjectProfile::ObjectProfile() :
     _spawnRequestCount(0),
     _spawnCount(0),
+    _pendingResources(nullptr),
     _pathname("*NONE*"),
     _model(nullptr),
     _ieve(INVALID_EVE_REF),
@@ -241,19 +267,20 @@ void ObjectProfile::loadTextures(const std::string &folderPath)
     _texturesLoaded.clear();
     _iconsLoaded.clear();
 
-    // Load the skins and icons
+    // Load the skins and icons, skip those not listed in the module's objects
+    const Ego::VfsDirectoryIndex &index = setup_get_module_vfs_index();
     for (size_t cnt = 0; cnt < 30; cnt++)
     {
         // do the texture
         const std::string skinPath = folderPath + "/tris" + std::to_string(cnt);
-        if(ego_texture_exists_vfs(skinPath))
+        if(index.mayExistWithAnyExtension(skinPath) && ego_texture_exists_vfs(skinPath))
         {
             _texturesLoaded[cnt] = Ego::DeferredTexture(skinPath);
         }
 
         // do the icon
         const std::string iconPath = folderPath + "/icon" + std::to_string(cnt);
-	    if(ego_texture_exists_vfs(iconPath))
+	    if(index.mayExistWithAnyExtension(iconPath) && ego_texture_exists_vfs(iconPath))
         {
             _iconsLoaded[cnt] = Ego::DeferredTexture(iconPath);
         }
@@ -967,6 +994,51 @@ bool ObjectProfile::hasIDSZ(const IDSZ2& idsz) const
 }
 
 std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &folderPath, const PRO_REF slotNumber, const bool lightWeight)
+{
+    std::shared_ptr<ObjectProfile> profile = readFromFile(folderPath, slotNumber, lightWeight);
+    if (profile)
+    {
+        profile->registerResources();
+    }
+    return profile;
+}
+
+void ObjectProfile::registerResources()
+{
+    if (!_pendingResources)
+    {
+        return;
+    }
+    std::unique_ptr<PendingResources> pending = std::move(_pendingResources);
+
+    // Add the enchantment for this profile (optional)
+    _ieve = ProfileSystem::get().EnchantProfileSystem.insert(pending->enchant, static_cast<EVE_REF>(_slotNumber));
+
+    // Add the particles for this profile (optional)
+    for (const auto &element : pending->particles)
+    {
+        PIP_REF particleProfile = ProfileSystem::get().ParticleProfileSystem.insert(element.second, INVALID_PIP_REF);
+
+        // Make sure it's referenced properly
+        if(particleProfile != INVALID_PIP_REF) {
+            _particleProfiles[element.first] = particleProfile;
+        }
+    }
+
+    // Add the waves for this iobj, the audio system owns them from now on
+    for (auto &element : pending->sounds)
+    {
+        SoundID soundID = AudioSystem::get().addSound(element.second);
+        element.second = nullptr;
+
+        if(soundID != INVALID_SOUND_ID) {
+            _soundMap[element.first] = soundID;
+        }
+    }
+    pending->sounds.clear();
+}
+
+std::shared_ptr<ObjectProfile> ObjectProfile::readFromFile(const std::string &folderPath, const PRO_REF slotNumber, const bool lightWeight)
 {
     //Make sure slot number is valid
     if(slotNumber == INVALID_PRO_REF)
@@ -994,8 +1066,16 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
             return nullptr;
         }
 
+        profile->_pendingResources = std::make_unique<PendingResources>();
+
+        // The optional files of objects in the module are listed, the others are probed
+        const Ego::VfsDirectoryIndex &index = setup_get_module_vfs_index();
+
         // Load the enchantment for this profile (optional)
-        profile->_ieve = ProfileSystem::get().EnchantProfileSystem.load_one(folderPath + "/enchant.txt", static_cast<EVE_REF>(slotNumber) );
+        if (index.mayExist(folderPath + "/enchant.txt"))
+        {
+            profile->_pendingResources->enchant = EnchantProfile::readFromFile(folderPath + "/enchant.txt");
+        }
 
         // Load the messages for this profile, do this before loading the AI script
         // to ensure any dynamic loaded messages get loaded last (optional)
@@ -1005,11 +1085,11 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
         for (LocalParticleProfileRef cnt(0); cnt.get() < 30; ++cnt) //TODO: find better way of listing files
         {
             const std::string particleName = folderPath + "/part" + std::to_string(cnt.get()) + ".txt";
-            PIP_REF particleProfile = ProfileSystem::get().ParticleProfileSystem.load_one(particleName.c_str(), INVALID_PIP_REF);
+            if (!index.mayExist(particleName)) continue;
+            std::shared_ptr<ParticleProfile> particleProfile = ParticleProfile::readFromFile(particleName);
 
-            // Make sure it's referenced properly
-            if(particleProfile != INVALID_PIP_REF) {
-                profile->_particleProfiles[cnt] = particleProfile; 
+            if(particleProfile) {
+                profile->_pendingResources->particles.emplace_back(cnt, particleProfile);
             }
         }
 
@@ -1017,10 +1097,11 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
         for ( size_t cnt = 0; cnt < 30; cnt++ ) //TODO: make better search than just 30 (list files?)
         {
             const std::string soundName = folderPath + "/sound" + std::to_string(cnt);
-            SoundID soundID = AudioSystem::get().loadSound(soundName);
+            if (!index.mayExistWithAnyExtension(soundName)) continue;
+            Mix_Chunk *sound = AudioSystem::readSound(soundName);
 
-            if(soundID != INVALID_SOUND_ID) {
-                profile->_soundMap[cnt] = soundID;
+            if(sound) {
+                profile->_pendingResources->sounds.emplace_back(cnt, sound);
             }
         }
     }
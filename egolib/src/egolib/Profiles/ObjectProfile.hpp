@@ -582,6 +582,19 @@ public:
     **/
     static std::shared_ptr<ObjectProfile> loadFromFile(const std::string &folderPath, const PRO_REF slotOverride, const bool lightWeight = false);
 
+    /**
+    * @brief Reads a new ObjectProfile object from the folder path like loadFromFile(), but does not
+    *        add its enchant, particles and sounds to the profile and audio systems yet
+    * @remark This can be called from any thread. The profile is not usable before registerResources() was called.
+    **/
+    static std::shared_ptr<ObjectProfile> readFromFile(const std::string &folderPath, const PRO_REF slotOverride, const bool lightWeight = false);
+
+    /**
+    * @brief Adds the enchant, particles and sounds read by readFromFile() to the profile and audio systems
+    * @remark This must be called from the main thread, in the order the profiles should get their references.
+    **/
+    void registerResources();
+
     /**
     * @brief Writes the contents of this character instance to a profile data.txt file
     **/
@@ -621,6 +634,10 @@ private:
     void setupXPTable();
 
 private:
+    /// The enchant, particles and sounds read but not yet registered
+    struct PendingResources;
+    std::unique_ptr<PendingResources> _pendingResources;
+
     std::string _pathname;                      ///< Usually the source filename
 
     // the sub-profiles
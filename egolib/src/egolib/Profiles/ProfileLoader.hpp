@@ -0,0 +1,151 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Profiles/ProfileLoader.hpp
+/// @brief  Loading a list of object folders on a job system
+
+#pragma once
+
+#include "egolib/Core/JobSystem.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  Load object folders with the same result as loading them one after another, in order.
+ *  The slot numbers and the objects are read on a job system, the objects are stored
+ *  on the calling thread in the order of the folders.
+ * @param jobSystem
+ *  the job system to read on, if null everything is read on the calling thread
+ * @param source
+ *  provides
+ *  - <tt>int getSlot(const std::string& folderPath)</tt>
+ *  - <tt>P read(const std::string& folderPath, int slot)</tt>, returns a null pointer if that failed
+ *  - <tt>bool isLoaded(int slot)</tt>
+ *  - <tt>void store(int slot, const P& profile)</tt>
+ *  - <tt>void failed(const std::string& folderPath, int slot)</tt>
+ *  - <tt>bool loadOne(const std::string& folderPath)</tt>, loads a folder the slow way
+ *  Only @a getSlot and @a read are called on worker threads.
+ * @param folderPaths
+ *  the folders
+ * @param slotCount
+ *  the number of slots, a slot outside of <tt>[0, slotCount)</tt> is invalid
+ * @return
+ *  the number of objects stored
+ * @throw ...
+ *  an exception thrown by @a source is rethrown once all folders before it are stored
+ */
+template <typename Source>
+size_t loadProfiles(Core::JobSystem *jobSystem, Source& source, const std::vector<std::string>& folderPaths, int slotCount)
+{
+    using ProfilePointer = decltype(source.read(std::string(), 0));
+
+    /// One object to load
+    struct Entry
+    {
+        Entry() : slot(-1), read(false), profile(), exception(nullptr) {}
+        int slot;                                   ///< The slot from data.txt
+        bool read;                                  ///< If the object was read by a worker
+        ProfilePointer profile;                     ///< The object read by a worker, null if that failed
+        std::exception_ptr exception;               ///< The exception thrown while reading the object
+    };
+    std::vector<Entry> entries(folderPaths.size());
+
+    const auto forEach = [jobSystem, &entries](size_t grainSize, const std::function<void(size_t, size_t)>& function)
+    {
+        if (jobSystem)
+        {
+            jobSystem->parallelFor(0, entries.size(), grainSize, function);
+        }
+        else
+        {
+            function(0, entries.size());
+        }
+    };
+
+    // Get the slot of each object
+    forEach(16, [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            try {
+                entries[i].slot = source.getSlot(folderPaths[i]);
+            }
+            catch (...) {
+                entries[i].exception = std::current_exception();
+            }
+        }
+    });
+
+    // The first object of a free slot is read. If two objects want the same slot, the second
+    // one is only loaded (below) if the first one fails, just like loading one after another would do.
+    std::unordered_set<int> claimedSlots;
+    for (Entry &entry : entries)
+    {
+        if (entry.exception || entry.slot < 0 || entry.slot >= slotCount) continue;
+        if (source.isLoaded(entry.slot)) continue;
+        entry.read = claimedSlots.insert(entry.slot).second;
+    }
+
+    // Read the objects
+    forEach(1, [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            if (!entries[i].read) continue;
+            try {
+                entries[i].profile = source.read(folderPaths[i], entries[i].slot);
+            }
+            catch (...) {
+                entries[i].exception = std::current_exception();
+            }
+        }
+    });
+
+    // Store the objects in order
+    size_t count = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        Entry &entry = entries[i];
+        if (entry.exception)
+        {
+            std::rethrow_exception(entry.exception);
+        }
+        if (!entry.read)
+        {
+            // Not read, but the object which claimed the slot may have failed
+            if (entry.slot >= 0 && entry.slot < slotCount && source.loadOne(folderPaths[i]))
+            {
+                count++;
+            }
+            continue;
+        }
+        if (!entry.profile)
+        {
+            source.failed(folderPaths[i], entry.slot);
+            continue;
+        }
+        source.store(entry.slot, entry.profile);
+        count++;
+    }
+
+    return count;
+}
+
+} // namespace Ego
@@ -26,6 +26,7 @@
 #include "egolib/Profiles/ProfileSystem.hpp"
 #include "egolib/Profiles/ObjectProfile.hpp"
 #include "egolib/Profiles/ModuleProfile.hpp"
+#include "egolib/Profiles/ProfileLoader.hpp"
 #include "game/GameStates/LoadPlayerElement.hpp"
 #include "game/Entities/_Include.hpp"
 #include "game/game.h"
@@ -41,12 +42,13 @@ static const std::shared_ptr<ObjectProfile> NULL_PROFILE = nullptr;
 
 
 ProfileSystem::ProfileSystem() :
+    EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt"),
+    ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt"),
     _profilesLoaded(),
     _profilesLoadedByName(),
+    _particleProfilesLoaded(),
     _moduleProfilesLoaded(),
-    _loadPlayerList(),
-    EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt"),
-    ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt")
+    _loadPlayerList()
 {
     // Initialize the script compiler.
     parser_state_t::initialize();
@@ -194,6 +196,41 @@ PRO_REF ProfileSystem::loadOneProfile(const std::string &pathName, int slot_over
     return iobj;
 }
 
+size_t ProfileSystem::loadProfiles(const std::vector<std::string> &folderPaths)
+{
+    /// Connects Ego::loadProfiles() to this profile system
+    struct Source
+    {
+        ProfileSystem& system;
+        int getSlot(const std::string& folderPath) { return system.getProfileSlotNumber(folderPath); }
+        std::shared_ptr<ObjectProfile> read(const std::string& folderPath, int slot) { return ObjectProfile::readFromFile(folderPath, static_cast<PRO_REF>(slot)); }
+        bool isLoaded(int slot) const { return system._profilesLoaded.find(static_cast<PRO_REF>(slot)) != system._profilesLoaded.end(); }
+        bool loadOne(const std::string& folderPath) { return INVALID_PRO_REF != system.loadOneProfile(folderPath); }
+        void failed(const std::string& folderPath, int slot)
+        {
+			Log::get().warn("ProfileSystem::loadProfiles() - Failed to load (%s) into slot number %d\n", folderPath.c_str(), slot);
+        }
+        void store(int slot, const std::shared_ptr<ObjectProfile>& profile)
+        {
+            profile->registerResources();
+
+            //Success! Store object into the loaded profile map
+            system._profilesLoaded[static_cast<PRO_REF>(slot)] = profile;
+            system._profilesLoadedByName[profile->getPathname().substr(profile->getPathname().find_last_of('/') + 1)] = profile;
+        }
+    };
+    Source source{*this};
+
+    // The workers only live while the module is loading
+    std::unique_ptr<Ego::Core::JobSystem> jobSystem;
+    const size_t cores = std::thread::hardware_concurrency();
+    if (cores > 1)
+    {
+        jobSystem = std::make_unique<Ego::Core::JobSystem>(cores - 1);
+    }
+    return Ego::loadProfiles(jobSystem.get(), source, folderPaths, INVALID_PRO_REF);
+}
+
 const Ego::DeferredTexture& ProfileSystem::getSpellBookIcon(size_t index) const
 {
     return _profilesLoaded.find(SPELLBOOK)->second->getIcon(index);
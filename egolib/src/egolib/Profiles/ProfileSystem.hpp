@@ -96,6 +96,20 @@ public:
      */
     PRO_REF loadOneProfile(const std::string &folderPath, int slot_override = -1);
 
+    /**
+     * @brief
+     *  Load several objects, each into the slot given by its data.txt.
+     * @param folderPaths
+     *  the folders of the objects
+     * @return
+     *  the number of objects loaded
+     * @remark
+     *  The result is the same as calling loadOneProfile() for each folder in order: the profiles are
+     *  read by worker threads, but slots, enchants, particles and sounds are assigned in folder order.
+     *  The worker threads are joined before this function returns.
+     */
+    size_t loadProfiles(const std::vector<std::string> &folderPaths);
+
     /**
      * @brief Loads only the slot number from data.txt
      *        If slot_override is valid, then that is used indead
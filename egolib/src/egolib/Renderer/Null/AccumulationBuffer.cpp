@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/AccumulationBuffer.cpp
+/// @brief  Implementation of an accumulation buffer facade for the null renderer.
+
+#include "egolib/Renderer/Null/AccumulationBuffer.hpp"
+
+namespace Ego {
+namespace Null {
+
+AccumulationBuffer::AccumulationBuffer(Statistics& statistics) :
+    Ego::AccumulationBuffer(), colourDepth(64, 16, 16, 16, 16), clearValue(Colour4f(0.0f, 0.0f, 0.0f, 0.0f)), statistics(statistics)
+{}
+
+AccumulationBuffer::~AccumulationBuffer()
+{}
+
+void AccumulationBuffer::clear() {
+    statistics.clears++;
+}
+
+void AccumulationBuffer::setClearValue(const Colour4f& value) {
+    statistics.count(value != clearValue);
+    clearValue = value;
+}
+
+const ColourDepth& AccumulationBuffer::getColourDepth() {
+    return colourDepth;
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/DepthBuffer.cpp
+/// @brief  Implementation of a depth buffer facade for the null renderer.
+
+#include "egolib/Renderer/Null/DepthBuffer.hpp"
+
+namespace Ego {
+namespace Null {
+
+DepthBuffer::DepthBuffer(Statistics& statistics) :
+    Ego::DepthBuffer(), depth(24), clearValue(1.0f), statistics(statistics)
+{}
+
+DepthBuffer::~DepthBuffer()
+{}
+
+void DepthBuffer::clear() {
+    statistics.clears++;
+}
+
+void DepthBuffer::setClearValue(const float& value) {
+    statistics.count(value != clearValue);
+    clearValue = value;
+}
+
+uint8_t DepthBuffer::getDepth() {
+    return depth;
+}
+
+} // namespace Null
+} // namespace Ego
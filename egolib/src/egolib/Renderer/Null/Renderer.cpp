@@ -0,0 +1,270 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.cpp
+/// @brief  Implementation of a renderer which renders nothing.
+
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Null {
+
+Renderer::Renderer() :
+    _statistics(),
+    _accumulationBuffer(_statistics), _colourBuffer(_statistics), _depthBuffer(_statistics),
+    _stencilBuffer(_statistics), _textureUnit(_statistics),
+    _info("null", "Egoboo", "1.0"),
+    _alphaTestEnabled(false), _alphaFunction(CompareFunction::AlwaysPass), _alphaReferenceValue(0.0f),
+    _blendingEnabled(false),
+    _blendFunction{{BlendFunction::One, BlendFunction::One, BlendFunction::Zero, BlendFunction::Zero}},
+    _colour(Colour4f::white()), _cullingMode(CullingMode::None),
+    _depthFunction(CompareFunction::Less), _depthTestEnabled(false), _depthWriteEnabled(true),
+    _scissorRectangle{{0.0f, 0.0f, 0.0f, 0.0f}}, _scissorTestEnabled(false),
+    _stencilMaskBack(0xffffffff), _stencilMaskFront(0xffffffff), _stencilTestEnabled(false),
+    _viewportRectangle{{0.0f, 0.0f, 0.0f, 0.0f}}, _windingMode(WindingMode::AntiClockwise),
+    _perspectiveCorrectionEnabled(false), _ditheringEnabled(true),
+    _pointSmoothEnabled(false), _lineSmoothEnabled(false), _lineWidth(1.0f), _pointSize(1.0f),
+    _polygonSmoothEnabled(false), _multisamplesEnabled(true), _lightingEnabled(false),
+    _rasterizationMode(RasterizationMode::Solid), _gouraudShadingEnabled(true)
+{}
+
+Renderer::~Renderer() {}
+
+const Statistics& Renderer::getStatistics() const {
+    return _statistics;
+}
+
+void Renderer::resetStatistics() {
+    _statistics = Statistics();
+}
+
+const Ego::RendererInfo& Renderer::getInfo() {
+    return _info;
+}
+
+Ego::AccumulationBuffer& Renderer::getAccumulationBuffer() {
+    return _accumulationBuffer;
+}
+
+Ego::ColourBuffer& Renderer::getColourBuffer() {
+    return _colourBuffer;
+}
+
+Ego::DepthBuffer& Renderer::getDepthBuffer() {
+    return _depthBuffer;
+}
+
+Ego::StencilBuffer& Renderer::getStencilBuffer() {
+    return _stencilBuffer;
+}
+
+Ego::TextureUnit& Renderer::getTextureUnit() {
+    return _textureUnit;
+}
+
+void Renderer::setAlphaTestEnabled(bool enabled) {
+    set(_alphaTestEnabled, enabled);
+}
+
+void Renderer::setAlphaFunction(CompareFunction function, float value) {
+    if (value < 0.0f || value > 1.0f) {
+        throw std::invalid_argument("reference alpha value out of bounds");
+    }
+    _statistics.count(function != _alphaFunction || value != _alphaReferenceValue);
+    _alphaFunction = function;
+    _alphaReferenceValue = value;
+}
+
+void Renderer::setBlendingEnabled(bool enabled) {
+    set(_blendingEnabled, enabled);
+}
+
+void Renderer::setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                BlendFunction destinationColour, BlendFunction destinationAlpha) {
+    set(_blendFunction, std::array<BlendFunction, 4>{{sourceColour, sourceAlpha, destinationColour, destinationAlpha}});
+}
+
+void Renderer::setColour(const Colour4f& colour) {
+    set(_colour, colour);
+}
+
+void Renderer::setCullingMode(CullingMode mode) {
+    set(_cullingMode, mode);
+}
+
+void Renderer::setDepthFunction(CompareFunction function) {
+    set(_depthFunction, function);
+}
+
+void Renderer::setDepthTestEnabled(bool enabled) {
+    set(_depthTestEnabled, enabled);
+}
+
+void Renderer::setDepthWriteEnabled(bool enabled) {
+    set(_depthWriteEnabled, enabled);
+}
+
+void Renderer::setScissorTestEnabled(bool enabled) {
+    set(_scissorTestEnabled, enabled);
+}
+
+void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "width < 0");
+    }
+    if (height < 0) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "height < 0");
+    }
+    set(_scissorRectangle, std::array<float, 4>{{left, bottom, width, height}});
+}
+
+void Renderer::setStencilMaskBack(uint32_t mask) {
+    set(_stencilMaskBack, mask);
+}
+
+void Renderer::setStencilMaskFront(uint32_t mask) {
+    set(_stencilMaskFront, mask);
+}
+
+void Renderer::setStencilTestEnabled(bool enabled) {
+    set(_stencilTestEnabled, enabled);
+}
+
+void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw std::invalid_argument("width < 0");
+    }
+    if (height < 0) {
+        throw std::invalid_argument("height < 0");
+    }
+    set(_viewportRectangle, std::array<float, 4>{{left, bottom, width, height}});
+}
+
+void Renderer::setWindingMode(WindingMode mode) {
+    set(_windingMode, mode);
+}
+
+void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
+    // Multiplying with the identity does not change the matrix.
+    _statistics.count(!(matrix == Matrix4f4f::identity()));
+}
+
+void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
+    set(_perspectiveCorrectionEnabled, enabled);
+}
+
+void Renderer::setDitheringEnabled(bool enabled) {
+    set(_ditheringEnabled, enabled);
+}
+
+void Renderer::setPointSmoothEnabled(bool enabled) {
+    set(_pointSmoothEnabled, enabled);
+}
+
+void Renderer::setLineSmoothEnabled(bool enabled) {
+    set(_lineSmoothEnabled, enabled);
+}
+
+void Renderer::setLineWidth(float width) {
+    set(_lineWidth, width);
+}
+
+void Renderer::setPointSize(float size) {
+    set(_pointSize, size);
+}
+
+void Renderer::setPolygonSmoothEnabled(bool enabled) {
+    set(_polygonSmoothEnabled, enabled);
+}
+
+void Renderer::setMultisamplesEnabled(bool enabled) {
+    set(_multisamplesEnabled, enabled);
+}
+
+void Renderer::setLightingEnabled(bool enabled) {
+    set(_lightingEnabled, enabled);
+}
+
+void Renderer::setRasterizationMode(RasterizationMode mode) {
+    set(_rasterizationMode, mode);
+}
+
+void Renderer::setGouraudShadingEnabled(bool enabled) {
+    set(_gouraudShadingEnabled, enabled);
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    if (index + length > vertexBuffer.getNumberOfVertices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    _statistics.draw(primitiveType, length);
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    if (index + length > indexBuffer.getNumberOfIndices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    // Unlike a graphics device, check the indices against the number of vertices.
+    const char *indices = static_cast<const char *>(indexBuffer.lock());
+    for (size_t i = index; i < index + length; ++i) {
+        size_t vertex;
+        switch (indexBuffer.getIndexDescriptor().getSyntax()) {
+            case IndexDescriptor::Syntax::U8:
+                vertex = reinterpret_cast<const uint8_t *>(indices)[i];
+                break;
+            case IndexDescriptor::Syntax::U16:
+                vertex = reinterpret_cast<const uint16_t *>(indices)[i];
+                break;
+            case IndexDescriptor::Syntax::U32:
+                vertex = reinterpret_cast<const uint32_t *>(indices)[i];
+                break;
+            default:
+                throw Id::UnhandledSwitchCaseException(__FILE__, __LINE__);
+        };
+        if (vertex >= vertexBuffer.getNumberOfVertices()) {
+            indexBuffer.unlock();
+            throw std::invalid_argument("index out of bounds");
+        }
+    }
+    indexBuffer.unlock();
+    _statistics.draw(primitiveType, length);
+}
+
+std::shared_ptr<Ego::Texture> Renderer::createTexture() {
+    _statistics.textures++;
+    return std::make_shared<Texture>();
+}
+
+void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
+    _statistics.count(!(getProjectionMatrix() == projectionMatrix));
+    this->Ego::Renderer::setProjectionMatrix(projectionMatrix);
+}
+
+void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
+    _statistics.count(!(getViewMatrix() == viewMatrix));
+    this->Ego::Renderer::setViewMatrix(viewMatrix);
+}
+
+void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
+    _statistics.count(!(getWorldMatrix() == worldMatrix));
+    this->Ego::Renderer::setWorldMatrix(worldMatrix);
+}
+
+} // namespace Null
+} // namespace Ego
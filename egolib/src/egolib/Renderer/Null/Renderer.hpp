@@ -0,0 +1,260 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.hpp
+/// @brief  Implementation of a renderer which renders nothing.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Statistics.hpp"
+#include "egolib/Renderer/Null/AccumulationBuffer.hpp"
+#include "egolib/Renderer/Null/ColourBuffer.hpp"
+#include "egolib/Renderer/Null/DepthBuffer.hpp"
+#include "egolib/Renderer/Null/StencilBuffer.hpp"
+#include "egolib/Renderer/Null/TextureUnit.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+
+/**
+ * @brief
+ *  The Egoboo null back-end.
+ *  It does not need a graphics device, it only keeps track of its state and counts
+ *  what it is asked to do, e.g. to benchmark or test rendering code without a GPU.
+ */
+namespace Ego {
+namespace Null {
+
+using namespace Math;
+
+class Renderer : public Ego::Renderer
+{
+protected:
+    /// @brief What this renderer was asked to do since its statistics were reset.
+    Statistics _statistics;
+
+    /// @brief The accumulation buffer facade.
+    AccumulationBuffer _accumulationBuffer;
+
+    /// @brief The colour buffer facade.
+    ColourBuffer _colourBuffer;
+
+    /// @brief The depth buffer facade.
+    DepthBuffer _depthBuffer;
+
+    /// @brief The stencil buffer facade.
+    StencilBuffer _stencilBuffer;
+
+    /// @brief The texture unit facade.
+    TextureUnit _textureUnit;
+
+    /// @brief Information about the backend.
+    RendererInfo _info;
+
+    /// @brief The state of this renderer, initially the state of an OpenGL context.
+    bool _alphaTestEnabled;
+    CompareFunction _alphaFunction;
+    float _alphaReferenceValue;
+    bool _blendingEnabled;
+    std::array<BlendFunction, 4> _blendFunction;
+    Colour4f _colour;
+    CullingMode _cullingMode;
+    CompareFunction _depthFunction;
+    bool _depthTestEnabled;
+    bool _depthWriteEnabled;
+    std::array<float, 4> _scissorRectangle;
+    bool _scissorTestEnabled;
+    uint32_t _stencilMaskBack;
+    uint32_t _stencilMaskFront;
+    bool _stencilTestEnabled;
+    std::array<float, 4> _viewportRectangle;
+    WindingMode _windingMode;
+    bool _perspectiveCorrectionEnabled;
+    bool _ditheringEnabled;
+    bool _pointSmoothEnabled;
+    bool _lineSmoothEnabled;
+    float _lineWidth;
+    float _pointSize;
+    bool _polygonSmoothEnabled;
+    bool _multisamplesEnabled;
+    bool _lightingEnabled;
+    RasterizationMode _rasterizationMode;
+    bool _gouraudShadingEnabled;
+
+public:
+    /// @brief Construct this null renderer.
+    Renderer();
+
+    /// @brief Destruct this null renderer.
+    virtual ~Renderer();
+
+public:
+    /**
+     * @brief
+     *  Get what this renderer was asked to do since its statistics were reset.
+     * @return
+     *  the statistics
+     */
+    const Statistics& getStatistics() const;
+
+    /**
+     * @brief
+     *  Reset the statistics of this renderer, e.g. at the beginning of a frame.
+     *  The state of this renderer is kept.
+     */
+    void resetStatistics();
+
+public:
+    /** @copydoc Ego::Renderer::getInfo() */
+    virtual const Ego::RendererInfo& getInfo() override;
+
+public:
+
+    /** @copydoc Ego::Renderer::getAccumulationBuffer() */
+    virtual Ego::AccumulationBuffer& getAccumulationBuffer() override;
+
+    /** @copydoc Ego::Renderer::getColourBuffer */
+    virtual Ego::ColourBuffer& getColourBuffer() override;
+
+    /** @copydoc Ego::Renderer::getDepthBuffer() */
+    virtual Ego::DepthBuffer& getDepthBuffer() override;
+
+    /** @copydoc Ego::Renderer::getStencilBuffer() */
+    virtual Ego::StencilBuffer& getStencilBuffer() override;
+
+    /** @copydoc Ego::Renderer::getTextureUnit() */
+    virtual Ego::TextureUnit& getTextureUnit() override;
+
+    /** @copydoc Ego::Renderer::setAlphaTestEnabled */
+    virtual void setAlphaTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setAlphaFunction */
+    virtual void setAlphaFunction(CompareFunction function, float value) override;
+
+    /** @copydoc Ego::Renderer::setBlendingEnabled */
+    virtual void setBlendingEnabled(bool enabled) override;
+
+    using Ego::Renderer::setBlendFunction;
+
+    /** @copydoc Ego::Renderer::setSourceBlendFunction */
+    virtual void setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                  BlendFunction destinationColour, BlendFunction destinationAlpha) override;
+
+    /** @copydoc Ego::Renderer::setColour */
+    virtual void setColour(const Colour4f& colour) override;
+
+    /** @copydoc Ego::Renderer::setCullingMode */
+    virtual void setCullingMode(CullingMode mode) override;
+
+    /** @copydoc Ego::Renderer::setDepthFunction */
+    virtual void setDepthFunction(CompareFunction function) override;
+
+    /** @copydoc Ego::Renderer::setDepthTestEnabled */
+    virtual void setDepthTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDepthWriteEnabled */
+    virtual void setDepthWriteEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorTestEnabled */
+    virtual void setScissorTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorRectangle */
+    virtual void setScissorRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskBack */
+    virtual void setStencilMaskBack(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskFront */
+    virtual void setStencilMaskFront(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilTestEnabled */
+    virtual void setStencilTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setViewportRectangle */
+    virtual void setViewportRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setWindingMode */
+    virtual void setWindingMode(WindingMode mode) override;
+
+    /** @copydoc Ego::Renderer::multMatrix */
+    virtual void multiplyMatrix(const Matrix4f4f& matrix) override;
+
+    /** @copydoc Ego::Renderer::setPerspectiveCorrectionEnabled */
+    virtual void setPerspectiveCorrectionEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDitheringEnabled  */
+    virtual void setDitheringEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setPointSmoothEnabled */
+    virtual void setPointSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineSmoothEnabled */
+    virtual void setLineSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineWidth */
+    virtual void setLineWidth(float width) override;
+
+    /** @copydoc Ego::Renderer::setPointSize */
+    virtual void setPointSize(float size) override;
+
+    /** @copydoc Ego::Renderer::setPolygonSmoothEnabled */
+    virtual void setPolygonSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setMultisamplesEnabled */
+    virtual void setMultisamplesEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLightingEnabled */
+    virtual void setLightingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setRasterizationMode */
+    virtual void setRasterizationMode(RasterizationMode mode) override;
+
+    /** @copydoc Ego::Renderer::setGouraudShadingEnabled */
+    virtual void setGouraudShadingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+
+    /** @copydoc Ego::Renderer::render(VertexBuffer&, IndexBuffer&, PrimitiveType, size_t, size_t) */
+    virtual void render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+
+    /** @copydoc Ego::Renderer::createTexture */
+    virtual SharedPtr<Ego::Texture> createTexture() override;
+
+public:
+    /** @copydoc Ego::Renderer::setProjectionMatrix */
+    void setProjectionMatrix(const Matrix4f4f& projectionMatrix) override;
+
+    /** @copydoc Ego::Renderer::setViewMatrix */
+    void setViewMatrix(const Matrix4f4f& viewMatrix) override;
+
+    /** @copydoc Ego::Renderer::setWorldMatrix */
+    void setWorldMatrix(const Matrix4f4f& worldMatrix) override;
+
+private:
+    /// @brief Set a state of this renderer and count the call.
+    template <typename Type>
+    void set(Type& state, const Type& value) {
+        _statistics.count(!(state == value));
+        state = value;
+    }
+
+}; // class Renderer
+
+} // namespace Null
+} // namespace Ego
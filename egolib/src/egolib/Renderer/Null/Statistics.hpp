@@ -0,0 +1,84 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Statistics.hpp
+/// @brief  What the null renderer was asked to do.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include "egolib/Renderer/PrimitiveType.hpp"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  What the null renderer was asked to do since its statistics were reset,
+ *  usually at the beginning of a frame.
+ */
+struct Statistics {
+    /// @brief The number of calls changing the state of the renderer or of its facades.
+    size_t stateChanges;
+    /// @brief The number of calls setting a state the renderer or its facades already had.
+    size_t redundantStateChanges;
+    /// @brief The number of draw calls.
+    size_t drawCalls;
+    /// @brief The number of draw calls of each primitive type, indexed by Ego::PrimitiveType.
+    std::array<size_t, static_cast<size_t>(PrimitiveType::QuadriliteralStrip) + 1> drawCallsByPrimitiveType;
+    /// @brief The number of vertices, or indices for indexed draw calls, of the draw calls.
+    size_t vertices;
+    /// @brief The number of times a texture unit was activated with another texture.
+    size_t textureBinds;
+    /// @brief The number of buffers cleared.
+    size_t clears;
+    /// @brief The number of textures created.
+    size_t textures;
+
+    /**
+     * @brief
+     *  Count a call setting a state.
+     * @param changed
+     *  if the call changed the state
+     */
+    void count(bool changed) {
+        if (changed) {
+            stateChanges++;
+        } else {
+            redundantStateChanges++;
+        }
+    }
+
+    /**
+     * @brief
+     *  Count a draw call.
+     * @param primitiveType
+     *  the primitive type of the draw call
+     * @param length
+     *  the number of vertices, or indices for indexed draw calls, of the draw call
+     */
+    void draw(PrimitiveType primitiveType, size_t length) {
+        drawCalls++;
+        drawCallsByPrimitiveType[static_cast<size_t>(primitiveType)]++;
+        vertices += length;
+    }
+};
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/StencilBuffer.cpp
+/// @brief  Implementation of a stencil buffer facade for the null renderer.
+
+#include "egolib/Renderer/Null/StencilBuffer.hpp"
+
+namespace Ego {
+namespace Null {
+
+StencilBuffer::StencilBuffer(Statistics& statistics) :
+    Ego::StencilBuffer(), depth(8), clearValue(0.0f), statistics(statistics)
+{}
+
+StencilBuffer::~StencilBuffer()
+{}
+
+void StencilBuffer::clear() {
+    statistics.clears++;
+}
+
+void StencilBuffer::setClearValue(const float& value) {
+    statistics.count(value != clearValue);
+    clearValue = value;
+}
+
+uint8_t StencilBuffer::getDepth() {
+    return depth;
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,84 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.cpp
+/// @brief  Implementation of textures for the null renderer.
+
+#include "egolib/Renderer/Null/Texture.hpp"
+#include "egolib/Extensions/SDL_GL_extensions.h"
+#include "egolib/Math/_Include.hpp"
+
+namespace Ego {
+namespace Null {
+
+Texture::Texture() :
+    Ego::Texture("<default texture>", TextureType::_2D, TextureAddressMode::Repeat, TextureAddressMode::Repeat,
+                 1, 1, 1, 1, nullptr, false),
+    _default(true)
+{}
+
+Texture::~Texture()
+{}
+
+bool Texture::load(const String& name, const SharedPtr<SDL_Surface>& surface) {
+    if (!surface) {
+        return false;
+    }
+    // Like the OpenGL textures, a texture of a height of 1 is a 1D texture and the texture is a power of two.
+    _type = ((1 == surface->h) && (surface->w > 1)) ? TextureType::_1D : TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = Math::powerOfTwo(surface->w);
+    _height = Math::powerOfTwo(surface->h);
+    _source = surface;
+    _sourceWidth = surface->w;
+    _sourceHeight = surface->h;
+    _hasAlpha = Graphics::SDL::testAlpha(surface);
+    _name = name;
+    _default = false;
+    return true;
+}
+
+bool Texture::load(const SharedPtr<SDL_Surface>& surface) {
+    std::ostringstream stream;
+    stream << "<source " << static_cast<void *>(surface.get()) << ">";
+    return load(stream.str(), surface);
+}
+
+void Texture::release() {
+    if (isDefault()) {
+        return;
+    }
+    _type = TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = _height = 1;
+    _source = nullptr;
+    _sourceWidth = _sourceHeight = 1;
+    _hasAlpha = false;
+    _name = "<default texture>";
+    _default = true;
+}
+
+bool Texture::isDefault() const {
+    return _default;
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,72 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.hpp
+/// @brief  Implementation of textures for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  A texture of the null renderer.
+ *  Its pixels are not uploaded anywhere, only its name, type, size and source are kept.
+ */
+class Texture : public Ego::Texture {
+private:
+    /// @brief If the default texture data is "uploaded" to this texture.
+    bool _default;
+
+public:
+
+    /**
+     * @brief
+     *  Construct this texture.
+     * @post
+     *  The default texture data is uploaded to this texture.
+     */
+    Texture();
+
+    /**
+     * @brief
+     *  Destruct this texture.
+     */
+    virtual ~Texture();
+
+public:
+    /** @override Ego::Texture::load(const String&, const SharedPtr<SDL_Surface>&) */
+    bool load(const String& name, const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::load(const SharedPtr<SDL_Surface>&) */
+    bool load(const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::release */
+    void release() override;
+
+    /** @override Ego::Texture::isDefault */
+    bool isDefault() const override;
+
+}; // class Texture
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,67 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/TextureUnit.hpp
+/// @brief  Implementation of a texture unit facade for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Statistics.hpp"
+
+namespace Ego {
+namespace Null {
+
+class TextureUnit : public Ego::TextureUnit {
+private:
+    /// @brief The texture this texture unit is activated with, a null pointer if it is deactivated.
+    const Ego::Texture *texture;
+    Statistics& statistics;
+
+public:
+
+    /**
+     * @brief
+     *  Construct this texture unit facade.
+     * @param statistics
+     *  the statistics of the renderer
+     */
+    TextureUnit(Statistics& statistics);
+
+    /**
+     * @brief
+     *  Destruct this texture unit facade.
+     */
+    virtual ~TextureUnit();
+
+    /** @copydoc Ego::TextureUnit::setActivated */
+    virtual void setActivated(const Ego::Texture *texture) override;
+
+    /**
+     * @brief
+     *  Get the texture this texture unit is activated with.
+     * @return
+     *  the texture, a null pointer if this texture unit is deactivated
+     */
+    const Ego::Texture *getActivated() const;
+
+}; // class TextureUnit
+
+} // namespace Null
+} // namespace Ego
@@ -416,11 +416,15 @@ void Renderer::setGouraudShadingEnabled(bool enabled) {
     Utilities::isError();
 }
 
-void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+void Renderer::resetVertexPointers() {
     glDisableClientState(GL_VERTEX_ARRAY);
     glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     glDisableClientState(GL_NORMAL_ARRAY);
+}
+
+void Renderer::setVertexPointers(VertexBuffer& vertexBuffer) {
+    resetVertexPointers();
     const char *vertices = static_cast<char *>(vertexBuffer.lock());
     const auto& vertexDescriptor = vertexBuffer.getVertexDescriptor();
     for (auto it = vertexDescriptor.begin(); it != vertexDescriptor.end(); ++it) {
@@ -538,16 +542,43 @@ void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, s
                 throw Id::UnhandledSwitchCaseException(__FILE__, __LINE__);
         };
     }
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    setVertexPointers(vertexBuffer);
     const GLenum primitiveType_gl = Utilities::toOpenGL(primitiveType);
     if (index + length > vertexBuffer.getNumberOfVertices()) {
         throw std::invalid_argument("out of bounds");
     }
-    // Disable the enabled client-side capabilities again. 
     glDrawArrays(primitiveType_gl, index, length);
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
+    // Disable the enabled client-side capabilities again.
+    resetVertexPointers();
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    const auto& indexDescriptor = indexBuffer.getIndexDescriptor();
+    GLenum type;
+    switch (indexDescriptor.getSyntax()) {
+        case IndexDescriptor::Syntax::U8:
+            type = GL_UNSIGNED_BYTE;
+            break;
+        case IndexDescriptor::Syntax::U16:
+            type = GL_UNSIGNED_SHORT;
+            break;
+        case IndexDescriptor::Syntax::U32:
+            type = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw Id::UnhandledSwitchCaseException(__FILE__, __LINE__);
+    };
+    if (index + length > indexBuffer.getNumberOfIndices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    setVertexPointers(vertexBuffer);
+    const char *indices = static_cast<char *>(indexBuffer.lock());
+    glDrawElements(Utilities::toOpenGL(primitiveType), length, type, indices + index * indexDescriptor.getIndexSize());
+    // Disable the enabled client-side capabilities again.
+    resetVertexPointers();
 }
 
 std::array<float, 16> Renderer::toOpenGL(const Matrix4f4f& source) {
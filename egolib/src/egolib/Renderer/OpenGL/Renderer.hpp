@@ -195,6 +195,9 @@ public:
     /** @copydoc Ego::Renderer::render */
     virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
 
+    /** @copydoc Ego::Renderer::render(VertexBuffer&, IndexBuffer&, PrimitiveType, size_t, size_t) */
+    virtual void render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+
     /** @copydoc Ego::Renderer::createTexture */
     virtual SharedPtr<Ego::Texture> createTexture() override;
 
@@ -209,6 +212,10 @@ public:
     void setWorldMatrix(const Matrix4f4f& worldMatrix) override;
 
 private:
+    /// @brief Enable the client-side arrays of the vertex elements of a vertex buffer and set their pointers.
+    void setVertexPointers(VertexBuffer& vertexBuffer);
+    /// @brief Disable the client-side arrays again.
+    void resetVertexPointers();
     std::array<float, 16> toOpenGL(const Matrix4f4f& source);
     GLenum toOpenGL(BlendFunction source);
 
@@ -23,6 +23,7 @@
 
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
 
 namespace Ego
 {
@@ -33,6 +34,16 @@ Renderer *CreateFunctor<Renderer>::operator()() const {
     return new Ego::OpenGL::Renderer();
 }
 
+Renderer *CreateFunctor<Renderer>::operator()(const std::string& backend) const {
+    if (backend == "OpenGL") {
+        return new Ego::OpenGL::Renderer();
+    } else if (backend == "Null") {
+        return new Ego::Null::Renderer();
+    } else {
+        throw std::invalid_argument("no back-end of that name");
+    }
+}
+
 }
 
 AccumulationBuffer::AccumulationBuffer()
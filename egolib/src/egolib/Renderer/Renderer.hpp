@@ -34,6 +34,7 @@
 #include "egolib/Renderer/TextureSampler.hpp"
 #include "egolib/Renderer/RendererInfo.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Graphics/IndexBuffer.hpp"
 #include "egolib/Renderer/Texture.hpp"
 
 namespace Ego {
@@ -277,7 +278,14 @@ namespace Core {
  */
 template <>
 struct CreateFunctor<Renderer> {
+    /// @brief Create the OpenGL back-end.
     Renderer *operator()() const;
+    /**
+     * @brief Create a back-end.
+     * @param backend the name of the back-end, "OpenGL" or "Null"
+     * @throw std::invalid_argument if there is no back-end of that name
+     */
+    Renderer *operator()(const std::string& backend) const;
 };
 
 } // namespace Core
@@ -688,6 +696,24 @@ public:
      */
     virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) = 0;
 
+    /**
+     * @brief
+     *  Render an indexed vertex buffer.
+     * @param vertexBuffer
+     *  a pointer to a vertex buffer
+     * @param indexBuffer
+     *  a pointer to an index buffer, its indices refer to the vertices of the vertex buffer
+     * @param primitiveType
+     *  the primitive type
+     * @param index
+     *  the index of the first index to render
+     * @param length
+     *  the number of indices to render
+     * @throw std::invalid_argument
+     *  if <tt>index + length</tt> is greater than the number of indices in the index buffer
+     */
+    virtual void render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) = 0;
+
     /**
      * @brief
      *  Create a texture.
@@ -56,7 +56,7 @@ protected:
 
         /// @brief Copy-construct these function statistics from other function statistics.
         /// @param other the other function statistics
-        FunctionStatistics(const FunctionStatistics& other) : numberOfCalls(other.numberOfCalls), totalTime(other.totalTime) {}
+        FunctionStatistics(const FunctionStatistics& other) : numberOfCalls(other.numberOfCalls), totalTime(other.totalTime), maxTime(other.maxTime) {}
 
         /// @brief Assign these function statistics from other function statistics.
         /// @param other the other function statistics
@@ -90,8 +90,8 @@ public:
         if (_functionStatistics.cend() == it) {
             _functionStatistics.emplace(functionName, FunctionStatistics(1, time, time));
         } else {
-            (*it).second.numberOfCalls = (*it).first + 1;
-            (*it).second.totalTime = time;
+            (*it).second.numberOfCalls++;
+            (*it).second.totalTime += time;
             (*it).second.maxTime = std::max((*it).second.maxTime, time);
         }
     }
@@ -0,0 +1,231 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/Interpreter/CodeGenerator.hpp
+/// @brief  Emits a decoded program as C++ code.
+
+#pragma once
+
+#include "egolib/Script/script.h"
+
+namespace Ego {
+namespace Script {
+namespace Interpreter {
+
+/**
+ * @brief
+ *  Emits a decoded program as C++ code.
+ * @remark
+ *  The emitted code is the program's run loop unrolled: every call becomes a direct call of
+ *  the native function and every failing call a @a goto. Assignments are emitted as the
+ *  arithmetic on <tt>script_state_t::operationsum</tt>, with constant operands and the
+ *  temporary registers inlined. Only operands referring to objects or other game state are
+ *  evaluated by the @a Operands type the code is instantiated with, which also handles
+ *  divisions by zero and invalid operators and variables. This gives the same result as
+ *  running the program with Program::run and script_state_t::run_operation.
+ * @remark
+ *  The code is <tt>template <typename Operands> void run(script_state_t& state, ai_state_t& aiState, script_info_t& script)</tt>.
+ *  @a Operands provides
+ *  - <tt>Operands(ai_state_t& aiState)</tt> and <tt>explicit operator bool() const</tt>,
+ *    @a false if the operands of an assignment are skipped
+ *  - <tt>int32_t load(script_state_t& state, ai_state_t& aiState, uint8_t variable) const</tt>
+ *  - <tt>static void apply(script_state_t& state, uint8_t operation, int32_t value)</tt>
+ *  - <tt>static void store(script_state_t& state, uint8_t variable)</tt>
+ *  - <tt>static bool call(script_state_t& state, ai_state_t& aiState, script_info_t& script, uint32_t value)</tt>,
+ *    for calls of unknown functions
+ *  The caller wraps the code into a namespace and provides the includes.
+ */
+class CodeGenerator {
+public:
+    /**
+     * @brief
+     *  Construct this code generator.
+     * @param functionNames
+     *  the names of the native functions indexed by function value code
+     * @param functionPrefix
+     *  prepended to a function name to get the name of the C++ function
+     */
+    CodeGenerator(const std::vector<std::string>& functionNames, const std::string& functionPrefix) :
+        _functionNames(functionNames), _functionPrefix(functionPrefix) {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Emit a program.
+     * @param program
+     *  the program
+     * @return
+     *  the C++ code
+     */
+    template <typename Function>
+    std::string generate(const Program<Function>& program) const {
+        const auto& instructions = program.getInstructions();
+        const auto& operands = program.getOperands();
+
+        // Only instructions which are jumped to need a label.
+        std::vector<bool> isTarget(instructions.size() + 1, false);
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            if (instructions[i].isCall && instructions[i].jump != i + 1) {
+                isTarget[instructions[i].jump] = true;
+            }
+        }
+
+        std::ostringstream os;
+        os << "template <typename Operands>" << std::endl
+           << "void run(script_state_t& state, ai_state_t& aiState, script_info_t& script) {" << std::endl;
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            const auto& instruction = instructions[i];
+            if (isTarget[i]) {
+                os << "i" << i << ":" << std::endl;
+            }
+            // Only a call can terminate the script.
+            if (0 == i || isTarget[i] || instructions[i - 1].isCall) {
+                os << "    if (aiState.terminate) return;" << std::endl;
+            }
+            os << "    script.indent_last = script.indent; script.indent = " << static_cast<int>(instruction.indent) << ";" << std::endl;
+            if (instruction.isCall) {
+                const std::string call = getCall(instruction);
+                if (instruction.jump == i + 1) {
+                    os << "    " << call << ";" << std::endl;
+                } else {
+                    os << "    if (!" << call << ") goto i" << instruction.jump << ";" << std::endl;
+                }
+            } else {
+                os << "    {" << std::endl
+                   << "        const Operands operands(aiState);" << std::endl
+                   << "        state.operationsum = 0;" << std::endl;
+                if (instruction.operandCount > 0) {
+                    os << "        if (operands) {" << std::endl;
+                    for (uint32_t j = 0; j < instruction.operandCount; ++j) {
+                        os << "            " << getOperation(operands[instruction.firstOperand + j]) << ";" << std::endl;
+                    }
+                    os << "        }" << std::endl;
+                }
+                os << "        " << getStore(static_cast<uint8_t>(instruction.value)) << ";" << std::endl
+                   << "    }" << std::endl;
+            }
+        }
+        if (isTarget[instructions.size()]) {
+            os << "i" << instructions.size() << ":" << std::endl;
+        }
+        os << "    return;" << std::endl
+           << "}" << std::endl;
+
+        return os.str();
+    }
+
+    /**
+     * @brief
+     *  Get a C++ string literal.
+     * @param string
+     *  the string
+     * @return
+     *  @a string quoted, with backslashes, quotes and non-printable characters escaped
+     */
+    static std::string quote(const std::string& string) {
+        std::ostringstream os;
+        os << '"';
+        for (const char c : string) {
+            const unsigned char u = static_cast<unsigned char>(c);
+            if ('\\' == c || '"' == c) {
+                os << '\\' << c;
+            } else if (u < 0x20 || u >= 0x7f) {
+                // Three octal digits, so that a following digit is not taken as part of the escape.
+                os << '\\' << static_cast<char>('0' + (u >> 6)) << static_cast<char>('0' + ((u >> 3) & 7)) << static_cast<char>('0' + (u & 7));
+            } else {
+                os << c;
+            }
+        }
+        os << '"';
+        return os.str();
+    }
+
+private:
+    template <typename Instruction>
+    std::string getCall(const Instruction& instruction) const {
+        std::ostringstream os;
+        if (nullptr == instruction.function || instruction.value >= _functionNames.size()) {
+            os << "Operands::call(state, aiState, script, " << instruction.value << "u)";
+        } else {
+            os << _functionPrefix << _functionNames[instruction.value] << "(state, aiState)";
+        }
+        return os.str();
+    }
+
+    /// @brief Get the C++ expression of a temporary register, empty if @a variable is not one.
+    static std::string getRegister(uint32_t variable) {
+        switch (variable) {
+            case VARTMPX: return "state.x";
+            case VARTMPY: return "state.y";
+            case VARTMPDISTANCE: return "state.distance";
+            case VARTMPTURN: return "state.turn";
+            case VARTMPARGUMENT: return "state.argument";
+            default: return std::string();
+        }
+    }
+
+    static std::string getOperation(const DecodedOperand& operand) {
+        std::string value;
+        if (operand.isConstant) {
+            value = operand.value < 0 ? "(" + std::to_string(operand.value) + ")" : std::to_string(operand.value);
+        } else {
+            value = getRegister(static_cast<uint8_t>(operand.value));
+            if (value.empty()) {
+                value = "operands.load(state, aiState, " + std::to_string(static_cast<uint8_t>(operand.value)) + ")";
+            }
+        }
+        const bool isNonZeroConstant = operand.isConstant && 0 != operand.value;
+        switch (operand.operation) {
+            case OPADD: return "state.operationsum = int(state.operationsum) + " + value;
+            case OPSUB: return "state.operationsum = int(state.operationsum) - " + value;
+            case OPAND: return "state.operationsum = int(state.operationsum) & " + value;
+            case OPSHR: return "state.operationsum = int(state.operationsum) >> " + value;
+            case OPSHL: return "state.operationsum = int(state.operationsum) << " + value;
+            case OPMUL: return "state.operationsum = int(state.operationsum) * " + value;
+            case OPDIV:
+                if (isNonZeroConstant) {
+                    return "state.operationsum = static_cast<float>(state.operationsum) / " + value;
+                }
+                break;
+            case OPMOD:
+                if (isNonZeroConstant) {
+                    return "state.operationsum = int(state.operationsum) % " + value;
+                }
+                break;
+        }
+        // Divisions which may be by zero and invalid operators
+        return "Operands::apply(state, " + std::to_string(operand.operation) + ", " + value + ")";
+    }
+
+    static std::string getStore(uint8_t variable) {
+        const std::string name = getRegister(variable);
+        if (name.empty()) {
+            return "Operands::store(state, " + std::to_string(variable) + ")";
+        }
+        return name + " = state.operationsum";
+    }
+
+    std::vector<std::string> _functionNames;
+    std::string _functionPrefix;
+};
+
+} // namespace Interpreter
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,223 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/Interpreter/Program.hpp
+/// @brief  A compiled script decoded into a flat, directly dispatchable form.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+namespace Script {
+namespace Interpreter {
+
+/// @brief An operand of an assignment.
+struct DecodedOperand {
+    /// @brief The constant value or the variable to load.
+    int32_t value;
+    /// @brief The operator combining this operand with the sum so far.
+    uint8_t operation;
+    /// @brief @a true if @a value is a constant, @a false if it is a variable.
+    bool isConstant;
+};
+
+/// @brief An instruction i.e. a function call or an assignment.
+template <typename Function>
+struct DecodedInstruction {
+    /// @brief Calls: The function, @a nullptr if the value code does not name a known function.
+    Function *function;
+    /// @brief Calls: The function value code. Assignments: The variable assigned to.
+    uint32_t value;
+    /// @brief Calls: The index of the instruction to continue with if the function fails.
+    uint32_t jump;
+    /// @brief Assignments: The index of the first operand.
+    uint32_t firstOperand;
+    /// @brief Assignments: The number of operands.
+    uint32_t operandCount;
+    /// @brief The indention level of the line.
+    uint8_t indent;
+    /// @brief @a true if this is a function call, @a false if this is an assignment.
+    bool isCall;
+};
+
+/**
+ * @brief
+ *  A compiled script decoded once at load time.
+ * @remark
+ *  The compiler emits a stream of bit-packed words. Running that stream directly means
+ *  re-extracting bit fields, looking up function pointers and skipping over operand
+ *  counts for every instruction on every run. A program does all of that once:
+ *  function pointers are resolved, jump targets refer to decoded instructions and the
+ *  operands of all assignments live in one contiguous array.
+ */
+template <typename Function>
+class Program {
+public:
+    using Instruction = DecodedInstruction<Function>;
+    using Operand = DecodedOperand;
+
+    Program() : _instructions(), _operands() {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Decode an instruction list.
+     * @param list
+     *  the instruction list, jumps must have been resolved by the compiler
+     * @param functions, numberOfFunctions
+     *  the function pointers indexed by function value code
+     */
+    template <typename InstructionList>
+    void decode(const InstructionList& list, Function *const *functions, size_t numberOfFunctions) {
+        static const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+        _instructions.clear();
+        _operands.clear();
+
+        const size_t length = list.getLength();
+        std::vector<uint32_t> decodedIndices(length + 1, NONE);
+
+        size_t index = 0;
+        while (index < length) {
+            decodedIndices[index] = static_cast<uint32_t>(_instructions.size());
+
+            Instruction instruction;
+            instruction.indent = list[index].getDataBits();
+            instruction.value = list[index].getValueBits();
+            instruction.isCall = list[index].isInv();
+            instruction.function = nullptr;
+            instruction.jump = NONE;
+            instruction.firstOperand = static_cast<uint32_t>(_operands.size());
+            instruction.operandCount = 0;
+
+            // The function value code or the variable is followed by the jump target or the operand count.
+            const uint32_t argument = (index + 1 < length) ? list[index + 1].getBits() : 0;
+            index += 2;
+
+            if (instruction.isCall) {
+                if (instruction.value < numberOfFunctions) {
+                    instruction.function = functions[instruction.value];
+                }
+                // Still an index into the instruction list, fixed below.
+                instruction.jump = argument;
+            } else {
+                for (uint32_t i = 0; i < argument && index < length; ++i, ++index) {
+                    Operand operand;
+                    operand.isConstant = list[index].isLdc();
+                    operand.value = list[index].getValueBits();
+                    operand.operation = list[index].getDataBits();
+                    _operands.push_back(operand);
+                }
+                instruction.operandCount = static_cast<uint32_t>(_operands.size()) - instruction.firstOperand;
+            }
+            _instructions.push_back(instruction);
+        }
+
+        // A jump to an index which is not the start of an instruction continues with the next instruction.
+        decodedIndices[length] = static_cast<uint32_t>(_instructions.size());
+        for (size_t i = length; i > 0; --i) {
+            if (NONE == decodedIndices[i - 1]) {
+                decodedIndices[i - 1] = decodedIndices[i];
+            }
+        }
+        for (Instruction& instruction : _instructions) {
+            if (instruction.isCall) {
+                instruction.jump = decodedIndices[std::min<size_t>(instruction.jump, length)];
+            }
+        }
+    }
+
+    /**
+     * @brief
+     *  Compute a hash of an instruction list (64 bit FNV-1a over the instruction words).
+     * @remark
+     *  Used to recognize a compiled script, e.g. to find a version of it compiled ahead of time.
+     *  The same source may compile to different instructions depending on which profiles are
+     *  loaded, so the hash is taken over the instructions and not the source.
+     */
+    template <typename InstructionList>
+    static uint64_t hash(const InstructionList& list) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < list.getLength(); ++i) {
+            const uint32_t bits = list[i].getBits();
+            for (size_t j = 0; j < 4; ++j) {
+                hash ^= (bits >> (8 * j)) & 0xff;
+                hash *= 0x100000001b3ull;
+            }
+        }
+        return hash;
+    }
+
+    /// @brief Remove all instructions.
+    void clear() {
+        _instructions.clear();
+        _operands.clear();
+    }
+
+    /// @brief Get the instructions.
+    const std::vector<Instruction>& getInstructions() const {
+        return _instructions;
+    }
+
+    /// @brief Get the operands of all assignments.
+    const std::vector<Operand>& getOperands() const {
+        return _operands;
+    }
+
+    /**
+     * @brief
+     *  Run this program.
+     * @param machine
+     *  provides what depends on the caller:
+     *  - <tt>bool isTerminated()</tt>: stop before the next instruction if @a true
+     *  - <tt>void enter(const Instruction&)</tt>: called before an instruction is run
+     *  - <tt>bool call(const Instruction&)</tt>: run a function call, @a false means the function failed
+     *  - <tt>void assign(const Instruction&, const Operand *operands)</tt>: run an assignment
+     * @return
+     *  the number of instructions run
+     */
+    template <typename Machine>
+    size_t run(Machine& machine) const {
+        size_t count = 0;
+        size_t position = 0;
+        const size_t size = _instructions.size();
+        while (position < size && !machine.isTerminated()) {
+            const Instruction& instruction = _instructions[position];
+            machine.enter(instruction);
+            if (instruction.isCall) {
+                position = machine.call(instruction) ? position + 1 : instruction.jump;
+            } else {
+                machine.assign(instruction, _operands.data() + instruction.firstOperand);
+                position++;
+            }
+            count++;
+        }
+        return count;
+    }
+
+private:
+    std::vector<Instruction> _instructions;
+    std::vector<Operand> _operands;
+};
+
+} // namespace Interpreter
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,146 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/ThinkScheduler.cpp
+/// @brief  Decides which AI scripts run in an update.
+
+#include "egolib/Script/ThinkScheduler.hpp"
+
+namespace Ego {
+namespace Script {
+
+const uint32_t ThinkScheduler::MAX_INTERVAL;
+
+ThinkScheduler::ThinkScheduler(uint32_t wakeAlerts) :
+    _wakeAlerts(wakeAlerts),
+    _budget(std::numeric_limits<double>::infinity()),
+    _nearDistance(std::numeric_limits<float>::infinity()),
+    _farDistance(std::numeric_limits<float>::infinity()),
+    _frame(0),
+    _cursor(0),
+    _slots(),
+    _lastThink(),
+    _lastScheduled(),
+    _scheduled(),
+    _previousScheduled(),
+    _woken(),
+    _due(),
+    _counters(),
+    _totals() {
+    //ctor
+}
+
+void ThinkScheduler::setBudget(double budget) {
+    _budget = budget;
+}
+
+double ThinkScheduler::getBudget() const {
+    return _budget;
+}
+
+void ThinkScheduler::setDistances(float nearDistance, float farDistance) {
+    _nearDistance = nearDistance;
+    _farDistance = std::max(nearDistance, farDistance);
+}
+
+uint32_t ThinkScheduler::getInterval(float distance, bool idle) const {
+    uint32_t interval = 4;
+    if (distance <= _nearDistance) {
+        interval = 1;
+    } else if (distance <= _farDistance) {
+        interval = 2;
+    }
+    if (idle) {
+        interval *= 2;
+    }
+    return std::min(interval, MAX_INTERVAL);
+}
+
+void ThinkScheduler::clear() {
+    _cursor = 0;
+    _slots.clear();
+    _lastThink.clear();
+    _lastScheduled.clear();
+    _scheduled.clear();
+    _previousScheduled.clear();
+    _woken.clear();
+    _due.clear();
+    _counters = Counters();
+    _totals = Counters();
+}
+
+void ThinkScheduler::beginFrame(uint32_t frame) {
+    // Forget the scripts scheduled in the update before the last one but not in the last one.
+    for (size_t index : _previousScheduled) {
+        const DenseIndex::Slot slot = _slots.find(index);
+        if (slot != DenseIndex::NONE && _lastScheduled[slot] != _frame) {
+            _slots.erase(index);
+        }
+    }
+    _previousScheduled.swap(_scheduled);
+    _scheduled.clear();
+
+    _frame = frame;
+    _counters = Counters();
+    _woken.clear();
+    _due.clear();
+}
+
+void ThinkScheduler::schedule(size_t index, float distance, uint32_t alert, bool idle) {
+    // A script seen for the first time gets a phase derived from its index,
+    // so that scripts with the same interval do not all run in the same update.
+    bool inserted;
+    const DenseIndex::Slot slot = _slots.insert(index, &inserted);
+    if (slot >= _lastThink.size()) {
+        _lastThink.resize(slot + 1);
+        _lastScheduled.resize(slot + 1);
+    }
+    if (inserted) {
+        _lastThink[slot] = _frame - 1 - static_cast<uint32_t>(index % MAX_INTERVAL);
+    }
+    if (_lastScheduled[slot] != _frame || inserted) {
+        _lastScheduled[slot] = _frame;
+        _scheduled.push_back(index);
+    }
+    const uint32_t lastThink = _lastThink[slot];
+
+    if (0 != (alert & _wakeAlerts)) {
+        _woken.push_back(index);
+        _counters.woken++;
+    } else if (_frame - lastThink >= getInterval(distance, idle)) {
+        _due.push_back(index);
+    } else {
+        _counters.skipped++;
+    }
+}
+
+const ThinkScheduler::Counters& ThinkScheduler::getCounters() const {
+    return _counters;
+}
+
+const ThinkScheduler::Counters& ThinkScheduler::getTotals() const {
+    return _totals;
+}
+
+size_t ThinkScheduler::getScriptCount() const {
+    return _slots.size();
+}
+
+} // namespace Script
+} // namespace Ego
@@ -0,0 +1,204 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/ThinkScheduler.hpp
+/// @brief  Decides which AI scripts run in an update.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include "egolib/Time/Stopwatch.hpp"
+#include "egolib/Core/DenseIndex.hpp"
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  Decides which AI scripts run in an update.
+ * @remark
+ *  Each update, every script which may think is scheduled with its distance to the nearest
+ *  player, its alert bits and whether it is idle. A script then either
+ *  - is woken: one of its alert bits is a wake alert. It runs in this update, whatever its
+ *    interval and the budget.
+ *  - is due: at least its interval has passed since it last ran. Its interval grows with the
+ *    distance to the nearest player and doubles if it is idle. Due scripts run in round-robin
+ *    order until the budget of this update is spent, the remaining ones are deferred and run
+ *    first in the next update.
+ *  - is skipped: it ran recently enough.
+ * @remark
+ *  Scripts are identified by an index e.g. the index of the object running it. The indices may
+ *  be sparse. A script which was not scheduled in the last update is forgotten and starts over
+ *  with a new phase when it is scheduled again.
+ */
+class ThinkScheduler {
+public:
+    /// @brief The longest interval, in updates, between two runs of a script.
+    static const uint32_t MAX_INTERVAL = 8;
+
+    /// @brief What happened to the scripts scheduled in an update.
+    struct Counters {
+        /// @brief The number of due scripts run.
+        size_t run;
+        /// @brief The number of scripts skipped because they ran recently enough.
+        size_t skipped;
+        /// @brief The number of due scripts deferred to the next update because the budget was spent.
+        size_t deferred;
+        /// @brief The number of scripts run because of a wake alert.
+        size_t woken;
+
+        Counters() : run(0), skipped(0), deferred(0), woken(0) {
+            //ctor
+        }
+    };
+
+    /**
+     * @brief
+     *  Construct this scheduler.
+     * @param wakeAlerts
+     *  the alert bits which make a script run immediately
+     */
+    ThinkScheduler(uint32_t wakeAlerts);
+
+    /// @brief Set the time, in seconds, due scripts may take per update. At least one due script runs per update.
+    void setBudget(double budget);
+
+    /// @brief Get the time, in seconds, due scripts may take per update.
+    double getBudget() const;
+
+    /**
+     * @brief
+     *  Set the distances determining the interval of a script.
+     * @param nearDistance
+     *  scripts within this distance to a player run every update
+     * @param farDistance
+     *  scripts within this distance to a player run every other update, scripts farther away every fourth update
+     */
+    void setDistances(float nearDistance, float farDistance);
+
+    /**
+     * @brief
+     *  Get the interval between two runs of a script.
+     * @param distance
+     *  the distance of the script's object to the nearest player
+     * @param idle
+     *  if the script is idle i.e. has no alerts and its timer has not run out
+     * @return
+     *  the interval in updates
+     */
+    uint32_t getInterval(float distance, bool idle) const;
+
+    /// @brief Forget all scripts and counters e.g. when a module is started.
+    void clear();
+
+    /// @brief Begin an update.
+    void beginFrame(uint32_t frame);
+
+    /**
+     * @brief
+     *  Schedule a script in this update.
+     * @param index
+     *  the index of the script
+     * @param distance
+     *  the distance of the script's object to the nearest player
+     * @param alert
+     *  the alert bits of the script
+     * @param idle
+     *  if the script is idle i.e. has no alerts and its timer has not run out
+     */
+    void schedule(size_t index, float distance, uint32_t alert, bool idle);
+
+    /**
+     * @brief
+     *  Run the scripts scheduled in this update.
+     * @param think
+     *  called with the index of each script to run
+     */
+    template <typename Think>
+    void run(Think think) {
+        Time::Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (size_t index : _woken) {
+            think(index);
+            _lastThink[_slots.find(index)] = _frame;
+        }
+
+        // Continue where the budget ran out in the last update.
+        std::sort(_due.begin(), _due.end());
+        const size_t count = _due.size();
+        const size_t first = std::lower_bound(_due.begin(), _due.end(), _cursor) - _due.begin();
+        for (size_t i = 0; i < count; ++i) {
+            const size_t index = _due[(first + i) % count];
+            if (i > 0 && stopwatch.elapsed() >= _budget) {
+                _counters.deferred = count - i;
+                _cursor = index;
+                break;
+            }
+            think(index);
+            _lastThink[_slots.find(index)] = _frame;
+            _counters.run++;
+        }
+
+        _totals.run += _counters.run;
+        _totals.skipped += _counters.skipped;
+        _totals.deferred += _counters.deferred;
+        _totals.woken += _counters.woken;
+        _woken.clear();
+        _due.clear();
+    }
+
+    /// @brief Get the counters of the last update.
+    const Counters& getCounters() const;
+
+    /// @brief Get the counters summed over all updates.
+    const Counters& getTotals() const;
+
+    /// @brief Get the number of scripts the scheduler keeps track of.
+    size_t getScriptCount() const;
+
+private:
+    uint32_t _wakeAlerts;
+    double _budget;
+    float _nearDistance;
+    float _farDistance;
+
+    /// @brief The current update.
+    uint32_t _frame;
+    /// @brief The index of the first deferred script.
+    size_t _cursor;
+    /// @brief The slot of each script scheduled in this or the last update.
+    DenseIndex _slots;
+    /// @brief The update in which a script last ran, indexed by slot. Wraps around, only differences matter.
+    std::vector<uint32_t> _lastThink;
+    /// @brief The update in which a script was last scheduled, indexed by slot.
+    std::vector<uint32_t> _lastScheduled;
+    /// @brief The scripts scheduled in this update and in the last update.
+    std::vector<size_t> _scheduled, _previousScheduled;
+    /// @brief The scripts woken in this update.
+    std::vector<size_t> _woken;
+    /// @brief The scripts due in this update.
+    std::vector<size_t> _due;
+
+    Counters _counters;
+    Counters _totals;
+};
+
+} // namespace Script
+} // namespace Ego
@@ -78,13 +78,13 @@ std::array<std::string, ScriptOperators::SCRIPT_OPERATORS_COUNT> _scriptOperator
 };
 
 Runtime::Runtime()
-    :_functionValueCodeToFunctionPointer{
-        #define Define(name) { name, &scr_##name },
-        #define DefineAlias(alias, name) { alias, &scr_##name },     
+    :_functionPointers{{
+        #define Define(name) &scr_##name,
+        #define DefineAlias(alias, name)
         #include "egolib/Script/Functions.in"
         #undef DefineAlias
         #undef Define
-    },
+    }},
     _statistics(std::make_unique<RuntimeStatistics>()),
     _clock(std::make_unique<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("runtime clock", 1))
     {
@@ -95,16 +95,143 @@ Runtime::~Runtime() {
     /* Intentionally empty. */
 }
 
-} // namespace Script
-} // namespace Ego
+/// @brief The compiled scripts linked into the program.
+/// @remark A function-local static so that compiled scripts can register themselves during static initialization.
+static std::vector<const CompiledScript *>& getCompiledScripts() {
+    static std::vector<const CompiledScript *> compiledScripts;
+    return compiledScripts;
+}
 
-//--------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------
+CompiledScript::CompiledScript(uint64_t hash, const char *name, Function *function)
+    : _hash(hash), _name(name), _function(function) {
+    getCompiledScripts().push_back(this);
+}
+
+ScriptOperands::ScriptOperands(ai_state_t& aiState)
+    : _self(nullptr), _target(nullptr), _owner(nullptr) {
+    const auto& objectHandler = _currentModule->getObjectHandler();
+    if (objectHandler.exists(aiState.getSelf())) {
+        _self = objectHandler.get(aiState.getSelf());
+        if (objectHandler.exists(aiState.getTarget())) {
+            _target = objectHandler.get(aiState.getTarget());
+        }
+        if (objectHandler.exists(aiState.owner)) {
+            _owner = objectHandler.get(aiState.owner);
+        }
+    }
+}
+
+int32_t ScriptOperands::load(script_state_t& state, ai_state_t& aiState, uint8_t variable) const {
+    const char *name;
+    return script_state_t::get_variable(state, aiState, _self, _target, _owner, variable, name);
+}
 
-static PRO_REF script_error_model = INVALID_PRO_REF;
-static const char * script_error_classname = "UNKNOWN";
+void ScriptOperands::apply(script_state_t& state, uint8_t operation, int32_t value) {
+    script_state_t::run_operator(state, operation, value);
+}
+
+void ScriptOperands::store(script_state_t& state, uint8_t variable) {
+    script_state_t::set_operand(state, variable);
+}
+
+namespace {
+void traceFunction(const script_info_t& script, uint32_t value) {
+    if (debug_scripts && debug_script_file) {
+        for (uint32_t i = 0; i < script.indent; i++) { vfs_printf(debug_script_file, "  "); }
+
+        for (uint32_t i = 0; i < Opcodes.size(); i++) {
+            if (Token::Type::Function == Opcodes[i]._type && value == Opcodes[i].iValue) {
+                vfs_printf(debug_script_file, "%s\n", Opcodes[i].cName.c_str());
+                break;
+            }
+        }
+    }
+}
+} // namespace
+
+bool ScriptOperands::call(script_state_t& state, ai_state_t& aiState, script_info_t& script, uint32_t value) {
+    traceFunction(script, value);
+
+    if (MAX_OPCODE == value) {
+        Log::get().message("%s:%d:%s: model == %d, class name == \"%s\" - Unknown opcode found!\n", \
+                           __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
+        return false;
+    }
+
+    if (value > ScriptFunctions::SCRIPT_FUNCTIONS_COUNT) {
+        //TODO: empty block? why?
+        return true;
+    }
+
+    Log::get().message("%s:%d:%s: script error - ai script \"%s\" - unhandled script function %d\n", \
+                       __FILE__, __LINE__, __FUNCTION__, script._name.c_str(), value);
+    return false;
+}
+
+bool ScriptOperands::invoke(script_state_t& state, ai_state_t& aiState, script_info_t& script, const script_state_t::Instruction& instruction) {
+    traceFunction(script, instruction.value);
+
+    if (!egoboo_config_t::get().debug_scriptProfiling_enable.getValue()) {
+        return 0 != instruction.function(state, aiState);
+    }
+
+    auto& runtime = Runtime::get();
+    Uint8 returncode;
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
+        returncode = instruction.function(state, aiState);
+    }
+    runtime.getStatistics().onFunctionInvoked(instruction.value, runtime.getClock().lst());
+    return 0 != returncode;
+}
+
+void ScriptOperands::traceAssignment(const script_info_t& script, uint8_t variable) {
+    if (debug_scripts && debug_script_file) {
+        const char *name = "UNKNOWN";
+
+        for (auto i = 0; i < script.indent; i++) { vfs_printf(debug_script_file, "  "); }
+
+        for (auto i = 0; i < Opcodes.size(); i++) {
+            if (Token::Type::Variable == Opcodes[i]._type && variable == Opcodes[i].iValue) {
+                name = Opcodes[i].cName.c_str();
+                break;
+            }
+        }
+
+        vfs_printf(debug_script_file, "%s = ", name);
+    }
+}
+
+void ScriptOperands::traceOperand(const script_state_t::Operand& operand, int32_t value) {
+    if (debug_scripts && debug_script_file) {
+        const char *op = operand.operation < _scriptOperatorNames.size() ? _scriptOperatorNames[operand.operation].c_str() : "UNKNOWN";
+        if (operand.isConstant) {
+            vfs_printf(debug_script_file, "%s %d ", op, value);
+        } else {
+            const char *name = operand.value < _scriptVariableNames.size() ? _scriptVariableNames[operand.value].c_str() : "UNKNOWN";
+            vfs_printf(debug_script_file, "%s %s(%d) ", op, name, value);
+        }
+    }
+}
+
+void ScriptOperands::traceResult(const script_state_t& state) {
+    if (debug_scripts && debug_script_file) {
+        vfs_printf(debug_script_file, " == %d \n", (int)state.operationsum);
+    }
+}
+
+const CompiledScript *CompiledScript::find(uint64_t hash) {
+    for (const CompiledScript *compiledScript : getCompiledScripts()) {
+        if (hash == compiledScript->_hash) {
+            return compiledScript;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace Script
+} // namespace Ego
 
-//--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void scripting_system_begin()
 {
@@ -116,12 +243,13 @@ void scripting_system_begin()
 void scripting_system_end()
 {
     if (Runtime::isInitialized()) {
-        Runtime::get().getStatistics().append("/debug/script_function_timing.txt");
+        if (egoboo_config_t::get().debug_scriptProfiling_enable.getValue()) {
+            Runtime::get().getStatistics().append("/debug/script_function_timing.txt");
+        }
 		Runtime::uninitialize();
     }
 }
 
-//--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void scr_run_chr_script(Object *pchr) {
 
@@ -220,24 +348,12 @@ void scr_run_chr_script(Object *pchr) {
 	script.indent = 0;
 
 	// Run the AI Script.
-	script.set_pos(0);
-	while (!aiState.terminate && script.get_pos() < script._instructions.getLength()) {
-		// This is used by the Else function
-		// it only keeps track of functions.
-		script.indent_last = script.indent;
-		script.indent = script._instructions[script.get_pos()].getDataBits();
-
-		// Was it a function.
-		if (script._instructions[script.get_pos()].isInv()) {
-			if (!script_state_t::run_function_call(my_state, aiState, script)) {
-				break;
-			}
-		}
-		else {
-			if (!script_state_t::run_operation(my_state, aiState, script)) {
-				break;
-			}
-		}
+	// Prefer a version of the script compiled ahead of time, unless the script is being debugged or profiled.
+	if (nullptr != script._compiled && !debug_scripts && !egoboo_config_t::get().debug_scriptProfiling_enable.getValue()) {
+		script._compiled->_function(my_state, aiState, script);
+	} else {
+		Ego::Script::ScriptMachine<Ego::Script::ScriptOperands> machine(my_state, aiState, script);
+		script._program.run(machine);
 	}
 
 	// Set movement latches
@@ -276,849 +392,552 @@ void scr_run_chr_script( const ObjectRef character )
 }
 
 //--------------------------------------------------------------------------------------------
-bool script_state_t::run_function_call( script_state_t& state, ai_state_t& aiState, script_info_t& script )
-{
-    Uint8  functionreturn;
-
-    // check for valid execution pointer
-    if ( script.get_pos() >= script._instructions.getLength() ) return false;
-
-    // Run the function
-	functionreturn = script_state_t::run_function(state, aiState, script);
-
-    // move the execution pointer to the jump code
-    script.increment_pos();
-    if ( functionreturn )
-    {
-        // move the execution pointer to the next opcode
-		script.increment_pos();
-    }
-    else
-    {
-        // use the jump code to jump to the right location
-        size_t new_index = script._instructions[script.get_pos()]._value;
-
-        // make sure the value is valid
-        EGOBOO_ASSERT( new_index <= script._instructions.getLength() );
-
-        // actually do the jump
-		script.set_pos(new_index);
-    }
-
-    return true;
-}
-
-//--------------------------------------------------------------------------------------------
-/// @todo Merge with caller.
-bool script_state_t::run_operation( script_state_t& state, ai_state_t& aiState, script_info_t& script )
-{
-    // check for valid execution pointer
-    if ( script.get_pos() >= script._instructions.getLength() ) return false;
-
-    auto var_value = script._instructions[script.get_pos()].getValueBits();
-
-    // debug stuff
-    std::string variable = "UNKNOWN";
-    if ( debug_scripts && debug_script_file )
-    {
-
-        for (auto  i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file, "  " ); }
-
-        for (auto i = 0; i < Opcodes.size(); i++ )
-        {
-            if ( Token::Type::Variable == Opcodes[i]._type && var_value == Opcodes[i].iValue )
-            {
-                variable = Opcodes[i].cName;
-                break;
-            }
-        }
-
-        vfs_printf( debug_script_file, "%s = ", variable.c_str() );
-    }
-
-    // Get the number of operands
-	script.increment_pos();
-    auto operand_count = script._instructions[script.get_pos()]._value;
-
-    // Now run the operation
-    state.operationsum = 0;
-    for (auto i = 0; i < operand_count && script.get_pos() < script._instructions.getLength(); ++i )
-    {
-		script.increment_pos();
-		script_state_t::run_operand(state, aiState, script);
-    }
-    if ( debug_scripts && debug_script_file )
-    {
-        vfs_printf( debug_script_file, " == %d \n", (int)state.operationsum );
-    }
-
-    // Save the results in the register that called the arithmetic
-    script_state_t::set_operand( state, var_value );
-
-    // go to the next opcode
-	script.increment_pos();
-
-    return true;
-}
-
-//--------------------------------------------------------------------------------------------
-Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script)
-{
-    /// @author BB
-    /// @details This is about half-way to what is needed for Lua integration
-
-    // Mask out the indentation
-    uint32_t valuecode = script._instructions[script.get_pos()].getValueBits();
-
-    // Assume that the function will pass, as most do
-    Uint8 returncode = true;
-    if ( MAX_OPCODE == valuecode )
-    {
-		Log::get().message("%s:%d:%s: model == %d, class name == \"%s\" - Unknown opcode found!\n", \
-			               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
-        return false;
-    }
-
-    // debug stuff
-    if ( debug_scripts && debug_script_file )
-    {
-        for (uint32_t i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file,  "  " ); }
-
-        for (uint32_t i = 0; i < Opcodes.size(); i++ )
-        {
-            if ( Token::Type::Function == Opcodes[i]._type && valuecode == Opcodes[i].iValue )
-            {
-                vfs_printf( debug_script_file,  "%s\n", Opcodes[i].cName.c_str() );
-                break;
-            };
-        }
-    }
-
-    if (valuecode > Ego::Script::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT)
-    {
-    	//TODO: empty block? why?
-    }
-    else
-    {
-        auto& runtime = Runtime::get();
-		{ 
-
-			Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
-			const auto& result = runtime._functionValueCodeToFunctionPointer.find(valuecode);
-			if (Runtime::get()._functionValueCodeToFunctionPointer.cend() == result) {
-				Log::get().message("%s:%d:%s: script error - ai script \"%s\" - unhandled script function %d\n", \
-					               __FILE__, __LINE__, __FUNCTION__, script._name.c_str(), valuecode);
-				returncode = false;
-			} else {
-				returncode = result->second(self, aiState);
-			}
-        }
-        runtime.getStatistics().onFunctionInvoked(valuecode, runtime.getClock().lst());
-    }
-
-    return returncode;
-}
-
-//--------------------------------------------------------------------------------------------
-void script_state_t::set_operand( script_state_t& state, Uint8 variable )
+int32_t script_state_t::get_variable( script_state_t& state, ai_state_t& aiState, Object *pchr, Object *ptarget, Object *powner, uint8_t variable, const char *& varname )
 {
-    /// @author ZZ
-    /// @details This function sets one of the tmp* values for scripted AI
+    int32_t iTmp = 0;
     switch ( variable )
     {
         case VARTMPX:
-            state.x = state.operationsum;
+            varname = "TMPX";
+            iTmp = state.x;
             break;
 
         case VARTMPY:
-            state.y = state.operationsum;
+            varname = "TMPY";
+            iTmp = state.y;
             break;
 
         case VARTMPDISTANCE:
-            state.distance = state.operationsum;
+            varname = "TMPDISTANCE";
+            iTmp = state.distance;
             break;
 
         case VARTMPTURN:
-            state.turn = state.operationsum;
+            varname = "TMPTURN";
+            iTmp = state.turn;
             break;
 
         case VARTMPARGUMENT:
-            state.argument = state.operationsum;
+            varname = "TMPARGUMENT";
+            iTmp = state.argument;
             break;
 
-        default:
-			Log::get().warn( "scr_set_operand() - cannot assign a number to index %d\n", variable );
+        case VARRAND:
+            varname = "RAND";
+            iTmp = Random::next(std::numeric_limits<uint16_t>::max());
             break;
-    }
-}
-
-//--------------------------------------------------------------------------------------------
-void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, script_info_t& script )
-{
-    /// @author ZZ
-    /// @details This function does the scripted arithmetic in OPERATOR, OPERAND pscriptrs
-
-	if (!_currentModule->getObjectHandler().exists(aiState.getSelf())) return;
-	Object *pchr = _currentModule->getObjectHandler().get(aiState.getSelf());
-
-    Object *ptarget = nullptr;
-	if (_currentModule->getObjectHandler().exists(aiState.getTarget()))
-    {
-		ptarget = _currentModule->getObjectHandler().get(aiState.getTarget());
-    }
-
-    Object *powner = nullptr;
-	if (_currentModule->getObjectHandler().exists(aiState.owner))
-    {
-		powner = _currentModule->getObjectHandler().get(aiState.owner);
-    }
-
-    std::string varname;
-
-    // get the operator
-    int32_t iTmp = 0;
-    
-    uint8_t operation = script._instructions[script.get_pos()].getDataBits();
-    if (script._instructions[script.get_pos()].isLdc()) {
-        // Get the working opcode from a constant, constants are all but high 5 bits
-        iTmp = script._instructions[script.get_pos()].getValueBits();
-        if (debug_scripts) {
-            std::stringstream stringStream;
-            stringStream << iTmp;
-            varname = stringStream.str();
-        }
-    }
-    else
-    {
-        // Get the variable opcode from a register
-        uint8_t variable = script._instructions[script.get_pos()].getValueBits();
 
-        switch ( variable )
-        {
-            case VARTMPX:
-                varname = "TMPX";
-                iTmp = state.x;
-                break;
+        case VARSELFX:
+            varname = "SELFX";
+            iTmp = pchr->getPosX();
+            break;
 
-            case VARTMPY:
-                varname = "TMPY";
-                iTmp = state.y;
-                break;
+        case VARSELFY:
+            varname = "SELFY";
+            iTmp = pchr->getPosY();
+            break;
 
-            case VARTMPDISTANCE:
-                varname = "TMPDISTANCE";
-                iTmp = state.distance;
-                break;
+        case VARSELFTURN:
+            varname = "SELFTURN";
+            iTmp = uint16_t(pchr->ori.facing_z);
+            break;
 
-            case VARTMPTURN:
-                varname = "TMPTURN";
-                iTmp = state.turn;
-                break;
+        case VARSELFCOUNTER:
+            varname = "SELFCOUNTER";
+				iTmp = aiState.order_counter;
+            break;
 
-            case VARTMPARGUMENT:
-                varname = "TMPARGUMENT";
-                iTmp = state.argument;
-                break;
+        case VARSELFORDER:
+            varname = "SELFORDER";
+				iTmp = aiState.order_value;
+            break;
 
-            case VARRAND:
-                varname = "RAND";
-                iTmp = Random::next(std::numeric_limits<uint16_t>::max());
-                break;
+        case VARSELFMORALE:
+            varname = "SELFMORALE";
+            iTmp = _currentModule->getTeamList()[pchr->team_base].getMorale();
+            break;
 
-            case VARSELFX:
-                varname = "SELFX";
-                iTmp = pchr->getPosX();
-                break;
+        case VARSELFLIFE:
+            varname = "SELFLIFE";
+            iTmp = FLOAT_TO_FP8(pchr->getLife());
+            break;
 
-            case VARSELFY:
-                varname = "SELFY";
-                iTmp = pchr->getPosY();
-                break;
+        case VARTARGETX:
+            varname = "TARGETX";
+            iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosX();
+            break;
 
-            case VARSELFTURN:
-                varname = "SELFTURN";
-                iTmp = uint16_t(pchr->ori.facing_z);
-                break;
+        case VARTARGETY:
+            varname = "TARGETY";
+            iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosY();
+            break;
 
-            case VARSELFCOUNTER:
-                varname = "SELFCOUNTER";
-				iTmp = aiState.order_counter;
-                break;
+        case VARTARGETDISTANCE:
+            varname = "TARGETDISTANCE";
+            if ( nullptr == ptarget )
+            {
+                iTmp = 0x7FFFFFFF;
+            }
+            else
+            {
+                iTmp = std::abs(ptarget->getPosX() - pchr->getPosX())
+                     + std::abs(ptarget->getPosY() - pchr->getPosY());
+            }
+            break;
 
-            case VARSELFORDER:
-                varname = "SELFORDER";
-				iTmp = aiState.order_value;
-                break;
+        case VARTARGETTURN:
+            varname = "TARGETTURN";
+            iTmp = ( nullptr == ptarget ) ? 0 : uint16_t(ptarget->ori.facing_z);
+            break;
 
-            case VARSELFMORALE:
-                varname = "SELFMORALE";
-                iTmp = _currentModule->getTeamList()[pchr->team_base].getMorale();
-                break;
+        case VARLEADERX:
+        {
+            varname = "LEADERX";
+            iTmp = pchr->getPosX();
+            std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
+            if ( leader )
+                iTmp = leader->getPosX();
+            break;
+        }
 
-            case VARSELFLIFE:
-                varname = "SELFLIFE";
-                iTmp = FLOAT_TO_FP8(pchr->getLife());
-                break;
+        case VARLEADERY:
+        {
+            varname = "LEADERY";
+            iTmp = pchr->getPosY();
+            std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
+            if ( leader )
+                iTmp = leader->getPosY();
 
-            case VARTARGETX:
-                varname = "TARGETX";
-                iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosX();
-                break;
+            break; 
+        }
 
-            case VARTARGETY:
-                varname = "TARGETY";
-                iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosY();
-                break;
+        case VARLEADERDISTANCE:
+            {
+                varname = "LEADERDISTANCE";
 
-            case VARTARGETDISTANCE:
-                varname = "TARGETDISTANCE";
-                if ( nullptr == ptarget )
+                std::shared_ptr<Object> pleader = _currentModule->getTeamList()[pchr->team].getLeader();
+                if ( !pleader )
                 {
                     iTmp = 0x7FFFFFFF;
                 }
                 else
                 {
-                    iTmp = std::abs(ptarget->getPosX() - pchr->getPosX())
-                         + std::abs(ptarget->getPosY() - pchr->getPosY());
+                    iTmp = std::abs(pleader->getPosX() - pchr->getPosX())
+                         + std::abs(pleader->getPosY() - pchr->getPosY());
                 }
-                break;
-
-            case VARTARGETTURN:
-                varname = "TARGETTURN";
-                iTmp = ( nullptr == ptarget ) ? 0 : uint16_t(ptarget->ori.facing_z);
-                break;
-
-            case VARLEADERX:
-            {
-                varname = "LEADERX";
-                iTmp = pchr->getPosX();
-                std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
-                if ( leader )
-                    iTmp = leader->getPosX();
-                break;
             }
+            break;
 
-            case VARLEADERY:
-            {
-                varname = "LEADERY";
-                iTmp = pchr->getPosY();
-                std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
-                if ( leader )
-                    iTmp = leader->getPosY();
-
-                break; 
-            }
-
-            case VARLEADERDISTANCE:
-                {
-                    varname = "LEADERDISTANCE";
-
-                    std::shared_ptr<Object> pleader = _currentModule->getTeamList()[pchr->team].getLeader();
-                    if ( !pleader )
-                    {
-                        iTmp = 0x7FFFFFFF;
-                    }
-                    else
-                    {
-                        iTmp = std::abs(pleader->getPosX() - pchr->getPosX())
-                             + std::abs(pleader->getPosY() - pchr->getPosY());
-                    }
-                }
-                break;
-
-            case VARLEADERTURN:
-                varname = "LEADERTURN";
-                iTmp = uint16_t(pchr->ori.facing_z);
-                if ( _currentModule->getTeamList()[pchr->team].getLeader() )
-                    iTmp = uint16_t(_currentModule->getTeamList()[pchr->team].getLeader()->ori.facing_z);
+        case VARLEADERTURN:
+            varname = "LEADERTURN";
+            iTmp = uint16_t(pchr->ori.facing_z);
+            if ( _currentModule->getTeamList()[pchr->team].getLeader() )
+                iTmp = uint16_t(_currentModule->getTeamList()[pchr->team].getLeader()->ori.facing_z);
 
-                break;
+            break;
 
-            case VARGOTOX:
-                varname = "GOTOX";
+        case VARGOTOX:
+            varname = "GOTOX";
 
 				ai_state_t::ensure_wp(aiState);
 
 				if (!aiState.wp_valid)
-                {
-                    iTmp = pchr->getPosX();
-                }
-                else
-                {
+            {
+                iTmp = pchr->getPosX();
+            }
+            else
+            {
 					iTmp = aiState.wp[kX];
-                }
-                break;
+            }
+            break;
 
-            case VARGOTOY:
-                varname = "GOTOY";
+        case VARGOTOY:
+            varname = "GOTOY";
 
 				ai_state_t::ensure_wp(aiState);
 
 				if (!aiState.wp_valid)
-                {
-                    iTmp = pchr->getPosY();
-                }
-                else
-                {
+            {
+                iTmp = pchr->getPosY();
+            }
+            else
+            {
 					iTmp = aiState.wp[kY];
-                }
-                break;
+            }
+            break;
 
-            case VARGOTODISTANCE:
-                varname = "GOTODISTANCE";
+        case VARGOTODISTANCE:
+            varname = "GOTODISTANCE";
 
 				ai_state_t::ensure_wp(aiState);
 
 				if (!aiState.wp_valid)
-                {
-                    iTmp = 0x7FFFFFFF;
-                }
-                else
-                {
+            {
+                iTmp = 0x7FFFFFFF;
+            }
+            else
+            {
 					iTmp = std::abs(aiState.wp[kX] - pchr->getPosX())
 						 + std::abs(aiState.wp[kY] - pchr->getPosY());
-                }
-                break;
+            }
+            break;
 
-            case VARTARGETTURNTO:
-                varname = "TARGETTURNTO";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = FACING_T(vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() ));
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
+        case VARTARGETTURNTO:
+            varname = "TARGETTURNTO";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = FACING_T(vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() ));
+                iTmp = Ego::Math::clipBits<16>( iTmp );
+            }
+            break;
 
-            case VARPASSAGE:
-                varname = "PASSAGE";
+        case VARPASSAGE:
+            varname = "PASSAGE";
 				iTmp = aiState.passage;
-                break;
+            break;
 
-            case VARWEIGHT:
-                varname = "WEIGHT";
-                iTmp = pchr->holdingweight;
-                break;
+        case VARWEIGHT:
+            varname = "WEIGHT";
+            iTmp = pchr->holdingweight;
+            break;
 
-            case VARSELFALTITUDE:
-                varname = "SELFALTITUDE";
-                iTmp = pchr->getPosZ() - pchr->getObjectPhysics().getGroundElevation();
-                break;
+        case VARSELFALTITUDE:
+            varname = "SELFALTITUDE";
+            iTmp = pchr->getPosZ() - pchr->getObjectPhysics().getGroundElevation();
+            break;
 
-            case VARSELFID:
-                varname = "SELFID";
+        case VARSELFID:
+            varname = "SELFID";
 				iTmp = pchr->getProfile()->getIDSZ(IDSZ_TYPE).toUint32();
-                break;
+            break;
 
-            case VARSELFHATEID:
-                varname = "SELFHATEID";
+        case VARSELFHATEID:
+            varname = "SELFHATEID";
 				iTmp = pchr->getProfile()->getIDSZ(IDSZ_HATE).toUint32();
-                break;
+            break;
 
-            case VARSELFMANA:
-                varname = "SELFMANA";
-                iTmp = FLOAT_TO_FP8(pchr->getMana());
-                if ( pchr->getAttribute(Ego::Attribute::CHANNEL_LIFE) )  iTmp += FLOAT_TO_FP8(pchr->getLife());
+        case VARSELFMANA:
+            varname = "SELFMANA";
+            iTmp = FLOAT_TO_FP8(pchr->getMana());
+            if ( pchr->getAttribute(Ego::Attribute::CHANNEL_LIFE) )  iTmp += FLOAT_TO_FP8(pchr->getLife());
 
-                break;
+            break;
 
-            case VARTARGETSTR:
-                varname = "TARGETSTR";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MIGHT));
-                break;
+        case VARTARGETSTR:
+            varname = "TARGETSTR";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MIGHT));
+            break;
 
-            case VARTARGETINT:
-                varname = "TARGETINT";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::INTELLECT));
-                break;
+        case VARTARGETINT:
+            varname = "TARGETINT";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::INTELLECT));
+            break;
 
-            case VARTARGETDEX:
-                varname = "TARGETDEX";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::AGILITY));
-                break;
+        case VARTARGETDEX:
+            varname = "TARGETDEX";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::AGILITY));
+            break;
 
-            case VARTARGETLIFE:
-                varname = "TARGETLIFE";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getLife());
-                break;
+        case VARTARGETLIFE:
+            varname = "TARGETLIFE";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getLife());
+            break;
 
-            case VARTARGETMANA:
-                varname = "TARGETMANA";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = FLOAT_TO_FP8(ptarget->getMana());
-                    if ( ptarget->getAttribute(Ego::Attribute::CHANNEL_LIFE) ) iTmp += FLOAT_TO_FP8(ptarget->getLife());
-                }
+        case VARTARGETMANA:
+            varname = "TARGETMANA";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = FLOAT_TO_FP8(ptarget->getMana());
+                if ( ptarget->getAttribute(Ego::Attribute::CHANNEL_LIFE) ) iTmp += FLOAT_TO_FP8(ptarget->getLife());
+            }
 
-                break;
+            break;
 
-            case VARTARGETLEVEL:
-                varname = "TARGETLEVEL";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->experiencelevel;
-                break;
+        case VARTARGETLEVEL:
+            varname = "TARGETLEVEL";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->experiencelevel;
+            break;
 
-            case VARTARGETSPEEDX:
-                varname = "TARGETSPEEDX";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kX]);
-                break;
+        case VARTARGETSPEEDX:
+            varname = "TARGETSPEEDX";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kX]);
+            break;
 
-            case VARTARGETSPEEDY:
-                varname = "TARGETSPEEDY";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kY]);
-                break;
+        case VARTARGETSPEEDY:
+            varname = "TARGETSPEEDY";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kY]);
+            break;
 
-            case VARTARGETSPEEDZ:
-                varname = "TARGETSPEEDZ";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kZ]);
-                break;
+        case VARTARGETSPEEDZ:
+            varname = "TARGETSPEEDZ";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kZ]);
+            break;
 
-            case VARSELFSPAWNX:
-                varname = "SELFSPAWNX";
-                iTmp = pchr->getSpawnPosition()[kX];
-                break;
+        case VARSELFSPAWNX:
+            varname = "SELFSPAWNX";
+            iTmp = pchr->getSpawnPosition()[kX];
+            break;
 
-            case VARSELFSPAWNY:
-                varname = "SELFSPAWNY";
-                iTmp = pchr->getSpawnPosition()[kY];
-                break;
+        case VARSELFSPAWNY:
+            varname = "SELFSPAWNY";
+            iTmp = pchr->getSpawnPosition()[kY];
+            break;
 
-            case VARSELFSTATE:
-                varname = "SELFSTATE";
+        case VARSELFSTATE:
+            varname = "SELFSTATE";
 				iTmp = aiState.state;
-                break;
+            break;
 
-            case VARSELFCONTENT:
-                varname = "SELFCONTENT";
+        case VARSELFCONTENT:
+            varname = "SELFCONTENT";
 				iTmp = aiState.content;
-                break;
+            break;
 
-            case VARSELFSTR:
-                varname = "SELFSTR";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::MIGHT));
-                break;
+        case VARSELFSTR:
+            varname = "SELFSTR";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::MIGHT));
+            break;
 
-            case VARSELFINT:
-                varname = "SELFINT";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::INTELLECT));
-                break;
+        case VARSELFINT:
+            varname = "SELFINT";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::INTELLECT));
+            break;
 
-            case VARSELFDEX:
-                varname = "SELFDEX";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::AGILITY));
-                break;
+        case VARSELFDEX:
+            varname = "SELFDEX";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::AGILITY));
+            break;
 
-            case VARSELFMANAFLOW:
-                varname = "SELFMANAFLOW";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::SPELL_POWER));
-                break;
+        case VARSELFMANAFLOW:
+            varname = "SELFMANAFLOW";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::SPELL_POWER));
+            break;
 
-            case VARTARGETMANAFLOW:
-                varname = "TARGETMANAFLOW";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::SPELL_POWER));
-                break;
+        case VARTARGETMANAFLOW:
+            varname = "TARGETMANAFLOW";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::SPELL_POWER));
+            break;
 
-            case VARSELFATTACHED:
-                varname = "SELFATTACHED";
+        case VARSELFATTACHED:
+            varname = "SELFATTACHED";
 				iTmp = number_of_attached_particles(aiState.getSelf());
-                break;
+            break;
 
-            case VARSWINGTURN:
-                varname = "SWINGTURN";
-                {
+        case VARSWINGTURN:
+            varname = "SWINGTURN";
+            {
 					auto camera = CameraSystem::get().getCamera(aiState.getSelf());
-                    iTmp = nullptr != camera ? camera->getSwing() << 2 : 0;
-                }
-                break;
+                iTmp = nullptr != camera ? camera->getSwing() << 2 : 0;
+            }
+            break;
 
-            case VARXYDISTANCE:
-                varname = "XYDISTANCE";
-                iTmp = std::sqrt( state.x * state.x + state.y * state.y );
-                break;
+        case VARXYDISTANCE:
+            varname = "XYDISTANCE";
+            iTmp = std::sqrt( state.x * state.x + state.y * state.y );
+            break;
 
-            case VARSELFZ:
-                varname = "SELFZ";
-                iTmp = pchr->getPosZ();
-                break;
+        case VARSELFZ:
+            varname = "SELFZ";
+            iTmp = pchr->getPosZ();
+            break;
 
-            case VARTARGETALTITUDE:
-                varname = "TARGETALTITUDE";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ() - ptarget->getObjectPhysics().getGroundElevation();
-                break;
+        case VARTARGETALTITUDE:
+            varname = "TARGETALTITUDE";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ() - ptarget->getObjectPhysics().getGroundElevation();
+            break;
 
-            case VARTARGETZ:
-                varname = "TARGETZ";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ();
-                break;
+        case VARTARGETZ:
+            varname = "TARGETZ";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ();
+            break;
 
-            case VARSELFINDEX:
-                varname = "SELFINDEX";
+        case VARSELFINDEX:
+            varname = "SELFINDEX";
 				iTmp = aiState.getSelf().get();
-                break;
-
-            case VAROWNERX:
-                varname = "OWNERX";
-                iTmp = ( NULL == powner ) ? 0 : powner->getPosX();
-                break;
+            break;
 
-            case VAROWNERY:
-                varname = "OWNERY";
-                iTmp = ( NULL == powner ) ? 0 : powner->getPosY();
-                break;
+        case VAROWNERX:
+            varname = "OWNERX";
+            iTmp = ( NULL == powner ) ? 0 : powner->getPosX();
+            break;
 
-            case VAROWNERTURN:
-                varname = "OWNERTURN";
-                iTmp = ( NULL == powner ) ? 0 : uint16_t(powner->ori.facing_z);
-                break;
+        case VAROWNERY:
+            varname = "OWNERY";
+            iTmp = ( NULL == powner ) ? 0 : powner->getPosY();
+            break;
 
-            case VAROWNERDISTANCE:
-                varname = "OWNERDISTANCE";
-                if ( NULL == powner )
-                {
-                    iTmp = 0x7FFFFFFF;
-                }
-                else
-                {
-                    iTmp = std::abs(powner->getPosX() - pchr->getPosX())
-                         + std::abs(powner->getPosY() - pchr->getPosY());
-                }
-                break;
+        case VAROWNERTURN:
+            varname = "OWNERTURN";
+            iTmp = ( NULL == powner ) ? 0 : uint16_t(powner->ori.facing_z);
+            break;
 
-            case VAROWNERTURNTO:
-                varname = "OWNERTURNTO";
-                if ( NULL == powner )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = FACING_T(vec_to_facing( powner->getPosX() - pchr->getPosX() , powner->getPosY() - pchr->getPosY() ));
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
+        case VAROWNERDISTANCE:
+            varname = "OWNERDISTANCE";
+            if ( NULL == powner )
+            {
+                iTmp = 0x7FFFFFFF;
+            }
+            else
+            {
+                iTmp = std::abs(powner->getPosX() - pchr->getPosX())
+                     + std::abs(powner->getPosY() - pchr->getPosY());
+            }
+            break;
 
-            case VARXYTURNTO:
-                varname = "XYTURNTO";
-                iTmp = FACING_T(vec_to_facing( state.x - pchr->getPosX() , state.y - pchr->getPosY() ));
+        case VAROWNERTURNTO:
+            varname = "OWNERTURNTO";
+            if ( NULL == powner )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = FACING_T(vec_to_facing( powner->getPosX() - pchr->getPosX() , powner->getPosY() - pchr->getPosY() ));
                 iTmp = Ego::Math::clipBits<16>( iTmp );
-                break;
-
-            case VARSELFMONEY:
-                varname = "SELFMONEY";
-                iTmp = pchr->getMoney();
-                break;
-
-            case VARSELFACCEL:
-                varname = "SELFACCEL";
-                iTmp = ( pchr->getAttribute(Ego::Attribute::ACCELERATION) * 100.0f );
-                break;
-
-            case VARTARGETEXP:
-                varname = "TARGETEXP";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->experience;
-                break;
-
-            case VARSELFAMMO:
-                varname = "SELFAMMO";
-                iTmp = pchr->ammo;
-                break;
-
-            case VARTARGETAMMO:
-                varname = "TARGETAMMO";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->ammo;
-                break;
-
-            case VARTARGETMONEY:
-                varname = "TARGETMONEY";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->getMoney();
-                break;
-
-            case VARTARGETTURNAWAY:
-                varname = "TARGETTURNAWAY";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = FACING_T(vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() ));
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
-
-            case VARSELFLEVEL:
-                varname = "SELFLEVEL";
-                iTmp = pchr->experiencelevel;
-                break;
+            }
+            break;
 
-            case VARTARGETRELOADTIME:
-                varname = "TARGETRELOADTIME";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->reload_timer;
-                break;
+        case VARXYTURNTO:
+            varname = "XYTURNTO";
+            iTmp = FACING_T(vec_to_facing( state.x - pchr->getPosX() , state.y - pchr->getPosY() ));
+            iTmp = Ego::Math::clipBits<16>( iTmp );
+            break;
 
-            case VARSPAWNDISTANCE:
-                varname = "SPAWNDISTANCE";
-                iTmp = std::abs( pchr->getSpawnPosition()[kX] - pchr->getPosX() )
-                     + std::abs( pchr->getSpawnPosition()[kY] - pchr->getPosY() );
-                break;
+        case VARSELFMONEY:
+            varname = "SELFMONEY";
+            iTmp = pchr->getMoney();
+            break;
 
-            case VARTARGETMAXLIFE:
-                varname = "TARGETMAXLIFE";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MAX_LIFE));
-                break;
+        case VARSELFACCEL:
+            varname = "SELFACCEL";
+            iTmp = ( pchr->getAttribute(Ego::Attribute::ACCELERATION) * 100.0f );
+            break;
 
-            case VARTARGETTEAM:
-                varname = "TARGETTEAM";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->team;
-                //iTmp = REF_TO_INT( chr_get_iteam( pself->target ) );
-                break;
+        case VARTARGETEXP:
+            varname = "TARGETEXP";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->experience;
+            break;
 
-            case VARTARGETARMOR:
-                varname = "TARGETARMOR";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->skin;
-                break;
+        case VARSELFAMMO:
+            varname = "SELFAMMO";
+            iTmp = pchr->ammo;
+            break;
 
-            case VARDIFFICULTY:
-                varname = "DIFFICULTY";
-                iTmp = static_cast<uint32_t>(egoboo_config_t::get().game_difficulty.getValue());
-                break;
+        case VARTARGETAMMO:
+            varname = "TARGETAMMO";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->ammo;
+            break;
 
-            case VARTIMEHOURS:
-                varname = "TIMEHOURS";
-                iTmp = Ego::Time::LocalTime().getHours();
-                break;
+        case VARTARGETMONEY:
+            varname = "TARGETMONEY";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->getMoney();
+            break;
 
-            case VARTIMEMINUTES:
-                varname = "TIMEMINUTES";
-                iTmp = Ego::Time::LocalTime().getMinutes();
-                break;
+        case VARTARGETTURNAWAY:
+            varname = "TARGETTURNAWAY";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = FACING_T(vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() ));
+                iTmp = Ego::Math::clipBits<16>( iTmp );
+            }
+            break;
 
-            case VARTIMESECONDS:
-                varname = "TIMESECONDS";
-                iTmp = Ego::Time::LocalTime().getSeconds();
-                break;
+        case VARSELFLEVEL:
+            varname = "SELFLEVEL";
+            iTmp = pchr->experiencelevel;
+            break;
 
-            case VARDATEMONTH:
-                varname = "DATEMONTH";
-                iTmp = Ego::Time::LocalTime().getMonth() + 1; /// @todo The addition of +1 should be removed and
-				                                              /// the whole Ego::Time::LocalTime class should be
-				                                              /// made available via EgoScript. However, EgoScript
-				                                              /// is not yet ready for that ... not yet.
-                break;
+        case VARTARGETRELOADTIME:
+            varname = "TARGETRELOADTIME";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->reload_timer;
+            break;
 
-            case VARDATEDAY:
-                varname = "DATEDAY";
-                iTmp = Ego::Time::LocalTime().getDayOfMonth();
-                break;
+        case VARSPAWNDISTANCE:
+            varname = "SPAWNDISTANCE";
+            iTmp = std::abs( pchr->getSpawnPosition()[kX] - pchr->getPosX() )
+                 + std::abs( pchr->getSpawnPosition()[kY] - pchr->getPosY() );
+            break;
 
-            default:
-				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Unknown variable found!\n", \
-					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
-                break;
-        }
-    }
+        case VARTARGETMAXLIFE:
+            varname = "TARGETMAXLIFE";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MAX_LIFE));
+            break;
 
-    // Now do the math
-    std::string op = "UNKNOWN";
-    switch ( operation )
-    {
-        case OPADD:
-            op = "ADD";
-            state.operationsum = int(state.operationsum) + iTmp;
+        case VARTARGETTEAM:
+            varname = "TARGETTEAM";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->team;
+            //iTmp = REF_TO_INT( chr_get_iteam( pself->target ) );
             break;
 
-        case OPSUB:
-            op = "SUB";
-            state.operationsum = int(state.operationsum) - iTmp;
+        case VARTARGETARMOR:
+            varname = "TARGETARMOR";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->skin;
             break;
 
-        case OPAND:
-            op = "AND";
-            state.operationsum = int(state.operationsum) & iTmp;
+        case VARDIFFICULTY:
+            varname = "DIFFICULTY";
+            iTmp = static_cast<uint32_t>(egoboo_config_t::get().game_difficulty.getValue());
             break;
 
-        case OPSHR:
-            op = "SHR";
-            state.operationsum = int(state.operationsum) >> iTmp;
+        case VARTIMEHOURS:
+            varname = "TIMEHOURS";
+            iTmp = Ego::Time::LocalTime().getHours();
             break;
 
-        case OPSHL:
-            op = "SHL";
-            state.operationsum = int(state.operationsum) << iTmp;
+        case VARTIMEMINUTES:
+            varname = "TIMEMINUTES";
+            iTmp = Ego::Time::LocalTime().getMinutes();
             break;
 
-        case OPMUL:
-            op = "MUL";
-            state.operationsum = int(state.operationsum) * iTmp;
+        case VARTIMESECONDS:
+            varname = "TIMESECONDS";
+            iTmp = Ego::Time::LocalTime().getSeconds();
             break;
 
-        case OPDIV:
-            op = "DIV";
-            if ( iTmp != 0 )
-            {
-                state.operationsum = static_cast<float>(state.operationsum) / iTmp;
-            }
-            else
-            {
-				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Cannot divide by zero!\n", \
-					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
-            }
+        case VARDATEMONTH:
+            varname = "DATEMONTH";
+            iTmp = Ego::Time::LocalTime().getMonth() + 1; /// @todo The addition of +1 should be removed and
+				                                              /// the whole Ego::Time::LocalTime class should be
+				                                              /// made available via EgoScript. However, EgoScript
+				                                              /// is not yet ready for that ... not yet.
             break;
 
-        case OPMOD:
-            op = "MOD";
-            if ( iTmp != 0 )
-            {
-                state.operationsum = int(state.operationsum) % iTmp;
-            }
-            else
-            {
-				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Cannot modulo by zero!\n",\
-					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT( script_error_model ), script_error_classname );
-            }
+        case VARDATEDAY:
+            varname = "DATEDAY";
+            iTmp = Ego::Time::LocalTime().getDayOfMonth();
             break;
 
         default:
-			Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - unknown op\n",\
-				               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT( script_error_model ), script_error_classname );
+				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Unknown variable found!\n", \
+					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
             break;
     }
 
-    if ( debug_scripts && debug_script_file )
-    {
-        vfs_printf( debug_script_file, "%s %s(%d) ", op.c_str(), varname.c_str(), iTmp );
-    }
+    return iTmp;
 }
 
 //--------------------------------------------------------------------------------------------
-
-bool script_info_t::increment_pos() {
-	if (_position >= _instructions.getLength()) {
-		return false;
-	}
-	_position++;
-    return true;
-}
-
-size_t script_info_t::get_pos() const {
-	return _position;
-}
-
-bool script_info_t::set_pos(size_t position) {
-	if (position >= _instructions.getLength()) {
-		return false;
-	}
-	_position = position;
-    return true;
+void script_info_t::decode() {
+	// Make sure that the runtime and its function pointers exist.
+	scripting_system_begin();
+	const auto& functionPointers = Runtime::get()._functionPointers;
+	_program.decode(_instructions, functionPointers.data(), functionPointers.size());
+	_hash = Ego::Script::Interpreter::Program<Ego::Script::NativeInterface::Function>::hash(_instructions);
+	_compiled = Ego::Script::CompiledScript::find(_hash);
 }
 
-//--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 bool ai_state_t::get_wp( ai_state_t& self )
 {
@@ -1145,7 +964,6 @@ bool ai_state_t::ensure_wp(ai_state_t& self)
     return ai_state_t::get_wp(self);
 }
 
-//--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void set_alerts( const ObjectRef character )
 {
@@ -1251,50 +1069,6 @@ void issue_special_order( uint32_t value, const IDSZ2& idsz )
 
 //--------------------------------------------------------------------------------------------
 
-ai_state_t::ai_state_t()
-    : AI::State<ObjectRef>() {
-	_clock = std::make_shared<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("", 8);
-	poof_time = -1;
-	changed = false;
-	terminate = false;
-
-	// who are we related to?
-	owner = ObjectRef::Invalid;
-	child = ObjectRef::Invalid;
-
-	// some local storage
-	alert = 0;
-	state = 0;
-	content = 0;
-	passage = 0;
-	timer = 0;
-	for (size_t i = 0; i < STOR_COUNT; ++i) {
-		x[i] = 0;
-		y[i] = 0;
-	}
-
-	// ai memory from the last event
-	bumplast_time = 0;
-
-	hitlast = ObjectRef::Invalid;
-	directionlast = Facing(0);
-	damagetypelast = DamageType::DAMAGE_DIRECT;
-	lastitemused = ObjectRef::Invalid;
-
-	// message handling
-	order_value = 0;
-	order_counter = 0;
-
-	// waypoints
-	wp_valid = false;
-	wp_lst._head = wp_lst._tail = 0;
-	astar_timer = 0;
-}
-
-ai_state_t::~ai_state_t() {
-	_clock = nullptr;
-}
-
 void ai_state_t::reset(ai_state_t& self)
 {
 	self._clock->reinit();
@@ -1430,15 +1204,3 @@ void ai_state_t::spawn(ai_state_t& self, const ObjectRef index, const PRO_REF io
 }
 
 //--------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------
-script_state_t::script_state_t()
-	: x(0), y(0), turn(0), distance(0),
-	  argument(0), operationsum()
-{
-}
-
-script_state_t::script_state_t(const script_state_t& other)
-	: x(other.x), y(other.y), turn(other.turn), distance(other.distance),
-	  argument(other.argument), operationsum(other.operationsum)
-{
-}
@@ -28,6 +28,7 @@
 #include "egolib/Clock.hpp"
 #include "egolib/AI/WaypointList.h"
 #include "egolib/_math.h"
+#include "egolib/Script/Interpreter/Program.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -113,6 +114,36 @@ enum chr_alert_bits
 // struct script_info_t
 //--------------------------------------------------------------------------------------------
 
+struct script_state_t;
+struct ai_state_t;
+
+namespace Ego {
+namespace Script {
+
+namespace NativeInterface {
+	/**
+	 * @brief
+	 *  The type of a C/C++ native interface (NI) function.
+	 */
+	using Function = uint8_t(script_state_t&, ai_state_t&);
+	/**
+	 * @brief
+	 *  Combination of a pointer to a C/C++ NI function with its name in the DSL.
+	 */
+	struct FunctionInfo {
+		/// The name of the function in the DSL.
+		std::string _name;
+		/// A pointer to the C/C++ NI function.
+		Function *_pointer;
+	};
+} // namespace NativeInterface
+
+// Forward declaration.
+struct CompiledScript;
+
+} // namespace Script
+} // namespace Ego
+
 struct Instruction
 {
 public:
@@ -302,8 +333,10 @@ public:
         _name(),
         indent(0),
         indent_last(0),
-        _position(0),
-        _instructions()
+        _instructions(),
+        _program(),
+        _hash(0),
+        _compiled(nullptr)
     {
         //ctor
     }
@@ -328,22 +361,37 @@ public:
     uint32_t        indent;
     uint32_t        indent_last;
 
+	/**
+	 * @brief
+	 *	The instruction list.
+	 */
+	InstructionList _instructions;
+
+	/**
+	 * @brief
+	 *	The instruction list decoded for running.
+	 */
+	Ego::Script::Interpreter::Program<Ego::Script::NativeInterface::Function> _program;
 
 	/**
 	 * @brief
-	 *	The instruction index.
+	 *	The hash of the instruction list.
 	 */
-    size_t _position;
+	uint64_t _hash;
 
 	/**
 	 * @brief
-	 *	The instruction list.
+	 *	The version of this script compiled ahead of time, @a nullptr if there is none.
 	 */
-	InstructionList _instructions;
+	const Ego::Script::CompiledScript *_compiled;
 
-	bool increment_pos();
-	size_t get_pos() const;
-	bool set_pos(size_t position);
+	/**
+	 * @brief
+	 *	Decode the instruction list into the program and look up a version compiled ahead of time.
+	 * @remark
+	 *	Must be called whenever the instruction list was changed.
+	 */
+	void decode();
 
 };
 
@@ -433,13 +481,170 @@ struct script_state_t
 	script_state_t();
 	script_state_t(const script_state_t& self);
 	// protected
-	static Uint8 run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script);
+	using Instruction = Ego::Script::Interpreter::Program<Ego::Script::NativeInterface::Function>::Instruction;
+	using Operand = Ego::Script::Interpreter::Program<Ego::Script::NativeInterface::Function>::Operand;
 	static void set_operand(script_state_t& self, Uint8 variable);
-	static void run_operand(script_state_t& self, ai_state_t& aiState, script_info_t& script);
-	static bool run_operation(script_state_t& self, ai_state_t& aiState, script_info_t& script);
-	static bool run_function_call(script_state_t& self, ai_state_t& aiState, script_info_t& script);
+	static int32_t get_variable(script_state_t& self, ai_state_t& aiState, Object *pchr, Object *ptarget, Object *powner, uint8_t variable, const char *& name);
+	static const char *run_operator(script_state_t& self, uint8_t operation, int32_t value);
+	/// @brief Call the function of an instruction, @a Operands is Ego::Script::ScriptOperands in the game.
+	template <typename Operands>
+	static Uint8 run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script, const Instruction& instruction);
+	/// @brief Evaluate the operands of an assignment and store the result, @a Operands is Ego::Script::ScriptOperands in the game.
+	template <typename Operands>
+	static void run_operation(script_state_t& self, ai_state_t& aiState, script_info_t& script, const Instruction& instruction, const Operand *operands);
 };
 
+/// The model and the class name of the character running its script, for error messages
+extern PRO_REF script_error_model;
+extern const char *script_error_classname;
+
+namespace Ego {
+namespace Script {
+
+/// @brief Connects a decoded program to the character running it.
+template <typename Operands>
+struct ScriptMachine {
+    using Instruction = script_state_t::Instruction;
+    using Operand = script_state_t::Operand;
+
+    script_state_t& _state;
+    ai_state_t& _aiState;
+    script_info_t& _script;
+
+    ScriptMachine(script_state_t& state, ai_state_t& aiState, script_info_t& script)
+        : _state(state), _aiState(aiState), _script(script) {
+        //ctor
+    }
+
+    bool isTerminated() const {
+        return _aiState.terminate;
+    }
+
+    void enter(const Instruction& instruction) {
+        // This is used by the Else function
+        // it only keeps track of functions.
+        _script.indent_last = _script.indent;
+        _script.indent = instruction.indent;
+    }
+
+    bool call(const Instruction& instruction) {
+        return 0 != script_state_t::run_function<Operands>(_state, _aiState, _script, instruction);
+    }
+
+    void assign(const Instruction& instruction, const Operand *operands) {
+        script_state_t::run_operation<Operands>(_state, _aiState, _script, instruction, operands);
+    }
+};
+
+/**
+ * @brief
+ *  Evaluates the operands of the assignments of a script compiled ahead of time,
+ *  see Ego::Script::Interpreter::CodeGenerator.
+ */
+struct ScriptOperands {
+    /// @brief The objects the operands may refer to, @a _self is @a nullptr if the character does not exist.
+    Object *_self, *_target, *_owner;
+
+    explicit ScriptOperands(ai_state_t& aiState);
+
+    /// @brief Get if the operands are evaluated. Like in the interpreter, they are skipped if the character does not exist.
+    explicit operator bool() const {
+        return nullptr != _self;
+    }
+
+    /// @brief Get the value of a variable.
+    int32_t load(script_state_t& state, ai_state_t& aiState, uint8_t variable) const;
+
+    /// @brief Apply an operator which was not inlined e.g. a division by a variable.
+    static void apply(script_state_t& state, uint8_t operation, int32_t value);
+
+    /// @brief Store the result in a variable which was not inlined.
+    static void store(script_state_t& state, uint8_t variable);
+
+    /// @brief Call a function which was not resolved.
+    static bool call(script_state_t& state, ai_state_t& aiState, script_info_t& script, uint32_t value);
+
+    /// @brief Call a function which was resolved, profiled if script profiling is enabled.
+    static bool invoke(script_state_t& state, ai_state_t& aiState, script_info_t& script, const script_state_t::Instruction& instruction);
+
+    /// @brief Write an assignment to the script debug file if scripts are debugged.
+    /// @{
+    static void traceAssignment(const script_info_t& script, uint8_t variable);
+    static void traceOperand(const script_state_t::Operand& operand, int32_t value);
+    static void traceResult(const script_state_t& state);
+    /// @}
+};
+
+} // namespace Script
+} // namespace Ego
+
+template <typename Operands>
+Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script, const Instruction& instruction)
+{
+    // The common case: the function pointer was resolved when the script was decoded
+    if (nullptr != instruction.function)
+    {
+        return Operands::invoke(self, aiState, script, instruction);
+    }
+    return Operands::call(self, aiState, script, instruction.value);
+}
+
+template <typename Operands>
+void script_state_t::run_operation(script_state_t& self, ai_state_t& aiState, script_info_t& script, const Instruction& instruction, const Operand *operands)
+{
+    Operands::traceAssignment(script, instruction.value);
+
+    // The objects the operands may refer to are the same for all operands,
+    // the operands are skipped if the character does not exist
+    const Operands objects(aiState);
+
+    // Now run the operation
+    self.operationsum = 0;
+    for (uint32_t i = 0; i < instruction.operandCount && objects; ++i)
+    {
+        const Operand& operand = operands[i];
+        // Constants are all but high 5 bits, variables are read from a register or the objects
+        const int32_t value = operand.isConstant ? operand.value : objects.load(self, aiState, operand.value);
+        Operands::apply(self, operand.operation, value);
+        Operands::traceOperand(operand, value);
+    }
+    Operands::traceResult(self);
+
+    // Save the results in the register that called the arithmetic
+    Operands::store(self, instruction.value);
+}
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  A script compiled ahead of time to C++ (see Ego::Script::Interpreter::CodeGenerator).
+ * @remark
+ *  A compiled script registers itself on construction, so linking in its translation
+ *  unit is enough. A loaded script uses it if the hash of its instructions matches,
+ *  otherwise it is interpreted.
+ */
+struct CompiledScript {
+    using Function = void(script_state_t&, ai_state_t&, script_info_t&);
+
+    CompiledScript(uint64_t hash, const char *name, Function *function);
+
+    /// @brief Find the compiled script with the specified hash.
+    /// @return the compiled script, @a nullptr if there is none
+    static const CompiledScript *find(uint64_t hash);
+
+    /// @brief The hash of the instructions this script was compiled from.
+    uint64_t _hash;
+    /// @brief The name of the script file this script was compiled from.
+    const char *_name;
+    /// @brief Run this script.
+    Function *_function;
+};
+
+} // namespace Script
+} // namespace Ego
+
 //--------------------------------------------------------------------------------------------
 // FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------
@@ -458,24 +663,6 @@ namespace Script {
 template <typename FunctionType>
 struct IRuntimeStatistics;
 
-namespace NativeInterface {
-	/**
-	 * @brief
-	 *  The type of a C/C++ native interface (NI) function.
-	 */
-	using Function = uint8_t(script_state_t&, ai_state_t&);
-	/**
-	 * @brief
-	 *  Combination of a pointer to a C/C++ NI function with its name in the DSL.
-	 */
-	struct FunctionInfo {
-		/// The name of the function in the DSL.
-		std::string _name;
-		/// A pointer to the C/C++ NI function.
-		Function *_pointer;
-	};
-} // namespace NativeInterface
-
 /// @brief A list of all possible EgoScript functions.
 enum ScriptFunctions {
 #define Define(name) name,
@@ -527,8 +714,8 @@ protected:
 	~Runtime();
 
 public:
-	/// @brief A map from function value codes to function pointers.
-	std::unordered_map<uint32_t, NativeInterface::Function*> _functionValueCodeToFunctionPointer;
+	/// @brief The function pointers indexed by function value code.
+	std::array<NativeInterface::Function*, ScriptFunctions::SCRIPT_FUNCTIONS_COUNT> _functionPointers;
 
 private:
     /// @brief A clock to measure the time from the beginning to the end of an action performed by the runtime.
@@ -0,0 +1,192 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file  egolib/Script/script_state.c
+/// @brief The construction of the script states and the arithmetic of the assignments.
+/// @details Kept apart from script.c, which depends on the game, so that the states can be used on their own e.g. in tests.
+
+#include "egolib/Script/script.h"
+
+using namespace Ego::Script;
+
+//--------------------------------------------------------------------------------------------
+ai_state_t::ai_state_t()
+    : AI::State<ObjectRef>() {
+	_clock = std::make_shared<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("", 8);
+	poof_time = -1;
+	changed = false;
+	terminate = false;
+
+	// who are we related to?
+	owner = ObjectRef::Invalid;
+	child = ObjectRef::Invalid;
+
+	// some local storage
+	alert = 0;
+	state = 0;
+	content = 0;
+	passage = 0;
+	timer = 0;
+	for (size_t i = 0; i < STOR_COUNT; ++i) {
+		x[i] = 0;
+		y[i] = 0;
+	}
+
+	// ai memory from the last event
+	bumplast_time = 0;
+
+	hitlast = ObjectRef::Invalid;
+	directionlast = Facing(0);
+	damagetypelast = DamageType::DAMAGE_DIRECT;
+	lastitemused = ObjectRef::Invalid;
+
+	// message handling
+	order_value = 0;
+	order_counter = 0;
+
+	// waypoints
+	wp_valid = false;
+	wp_lst._head = wp_lst._tail = 0;
+	astar_timer = 0;
+}
+
+ai_state_t::~ai_state_t() {
+	_clock = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------
+script_state_t::script_state_t()
+	: x(0), y(0), turn(0), distance(0),
+	  argument(0), operationsum()
+{
+}
+
+script_state_t::script_state_t(const script_state_t& other)
+	: x(other.x), y(other.y), turn(other.turn), distance(other.distance),
+	  argument(other.argument), operationsum(other.operationsum)
+{
+}
+
+//--------------------------------------------------------------------------------------------
+PRO_REF script_error_model = INVALID_PRO_REF;
+const char *script_error_classname = "UNKNOWN";
+
+//--------------------------------------------------------------------------------------------
+void script_state_t::set_operand( script_state_t& state, Uint8 variable )
+{
+    /// @author ZZ
+    /// @details This function sets one of the tmp* values for scripted AI
+    switch ( variable )
+    {
+        case VARTMPX:
+            state.x = state.operationsum;
+            break;
+
+        case VARTMPY:
+            state.y = state.operationsum;
+            break;
+
+        case VARTMPDISTANCE:
+            state.distance = state.operationsum;
+            break;
+
+        case VARTMPTURN:
+            state.turn = state.operationsum;
+            break;
+
+        case VARTMPARGUMENT:
+            state.argument = state.operationsum;
+            break;
+
+        default:
+			Log::get().warn( "scr_set_operand() - cannot assign a number to index %d\n", variable );
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+const char *script_state_t::run_operator( script_state_t& state, uint8_t operation, int32_t iTmp )
+{
+    const char *op = "UNKNOWN";
+    switch ( operation )
+    {
+        case OPADD:
+            op = "ADD";
+            state.operationsum = int(state.operationsum) + iTmp;
+            break;
+
+        case OPSUB:
+            op = "SUB";
+            state.operationsum = int(state.operationsum) - iTmp;
+            break;
+
+        case OPAND:
+            op = "AND";
+            state.operationsum = int(state.operationsum) & iTmp;
+            break;
+
+        case OPSHR:
+            op = "SHR";
+            state.operationsum = int(state.operationsum) >> iTmp;
+            break;
+
+        case OPSHL:
+            op = "SHL";
+            state.operationsum = int(state.operationsum) << iTmp;
+            break;
+
+        case OPMUL:
+            op = "MUL";
+            state.operationsum = int(state.operationsum) * iTmp;
+            break;
+
+        case OPDIV:
+            op = "DIV";
+            if ( iTmp != 0 )
+            {
+                state.operationsum = static_cast<float>(state.operationsum) / iTmp;
+            }
+            else
+            {
+				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Cannot divide by zero!\n", \
+					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
+            }
+            break;
+
+        case OPMOD:
+            op = "MOD";
+            if ( iTmp != 0 )
+            {
+                state.operationsum = int(state.operationsum) % iTmp;
+            }
+            else
+            {
+				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Cannot modulo by zero!\n",\
+					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT( script_error_model ), script_error_classname );
+            }
+            break;
+
+        default:
+			Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - unknown op\n",\
+				               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT( script_error_model ), script_error_classname );
+            break;
+    }
+
+    return op;
+}
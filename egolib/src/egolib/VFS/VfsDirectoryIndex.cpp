@@ -0,0 +1,84 @@
+#include "egolib/VFS/VfsDirectoryIndex.hpp"
+#include "egolib/Core/StringUtilities.hpp"
+
+namespace Ego {
+
+VfsDirectoryIndex::VfsDirectoryIndex() : _directories() {}
+
+std::string VfsDirectoryIndex::normalize(const std::string& path) {
+    std::string result;
+    result.reserve(path.length());
+    for (char c : path) {
+        // Backslash to Slash. Slash Slash to Slash.
+        if ('\\' == c) {
+            c = '/';
+        }
+        if ('/' == c && (result.empty() || '/' == result.back())) {
+            continue;
+        }
+        // Whether the file system ignores the case of file names depends on the file system, not on the platform.
+        // Ignoring it always can only turn a "does not exist" into a "may exist".
+        c = Ego::tolower(c);
+        result.push_back(c);
+    }
+    if (!result.empty() && '/' == result.back()) {
+        result.pop_back();
+    }
+    return result;
+}
+
+void VfsDirectoryIndex::add(const std::string& directory, const std::vector<std::string>& names) {
+    Directory& entry = _directories[normalize(directory)];
+    entry.names.clear();
+    entry.stems.clear();
+    for (const auto& entryName : names) {
+        const std::string name = normalize(entryName);
+        entry.names.insert(name);
+        // A leading period does not start an extension.
+        auto periodPos = name.rfind('.');
+        entry.stems.insert((periodPos == std::string::npos || periodPos == 0) ? name : name.substr(0, periodPos));
+    }
+}
+
+void VfsDirectoryIndex::clear() {
+    _directories.clear();
+}
+
+size_t VfsDirectoryIndex::getDirectoryCount() const {
+    return _directories.size();
+}
+
+bool VfsDirectoryIndex::isIndexed(const std::string& directory) const {
+    return _directories.find(normalize(directory)) != _directories.end();
+}
+
+const VfsDirectoryIndex::Directory *VfsDirectoryIndex::find(const std::string& pathname, std::string& name) const {
+    if (_directories.empty()) {
+        return nullptr;
+    }
+    std::string path = normalize(pathname);
+    auto slashPos = path.rfind('/');
+    if (slashPos == std::string::npos) {
+        return nullptr;
+    }
+    auto it = _directories.find(path.substr(0, slashPos));
+    if (it == _directories.end()) {
+        return nullptr;
+    }
+    name = path.substr(slashPos + 1);
+    return &(it->second);
+}
+
+bool VfsDirectoryIndex::mayExist(const std::string& pathname) const {
+    std::string name;
+    const Directory *directory = find(pathname, name);
+    return nullptr == directory || directory->names.count(name) > 0;
+}
+
+bool VfsDirectoryIndex::mayExistWithAnyExtension(const std::string& pathname) const {
+    std::string name;
+    const Directory *directory = find(pathname, name);
+    return nullptr == directory || directory->stems.count(name) > 0;
+}
+
+} // namespace Ego
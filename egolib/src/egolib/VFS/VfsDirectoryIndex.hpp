@@ -0,0 +1,66 @@
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+
+/// @brief An index of the entries of some directories in the virtual file system.
+/// @remark
+/// The entries of a directory are listed once (e.g. when a module is mounted) and queries are answered from memory
+/// instead of probing every mount point for every file. For directories which are not indexed nothing is known, hence
+/// the queries only tell if a file can not exist.
+/// @remark
+/// The index is not changed while it is queried, so it can be queried from several threads at once.
+class VfsDirectoryIndex {
+public:
+    /// @brief Construct this index.
+    /// @post This index is empty.
+    VfsDirectoryIndex();
+
+    /// @brief Add a directory and the names of its entries to this index.
+    /// @param directory the path of the directory
+    /// @param names the names of the entries, without path
+    /// @remark If the directory is already indexed, its entries are replaced.
+    void add(const std::string& directory, const std::vector<std::string>& names);
+
+    /// @brief Remove all directories from this index.
+    void clear();
+
+    /// @brief Get the number of directories in this index.
+    /// @return the number of directories
+    size_t getDirectoryCount() const;
+
+    /// @brief Get if a directory is indexed.
+    /// @param directory the path of the directory
+    /// @return @a true if the directory is indexed, @a false otherwise
+    bool isIndexed(const std::string& directory) const;
+
+    /// @brief Get if a file may exist.
+    /// @param pathname the path of the file
+    /// @return @a false if the directory of the file is indexed and has no entry of that name, @a true otherwise
+    bool mayExist(const std::string& pathname) const;
+
+    /// @brief Get if a file with any extension may exist.
+    /// @param pathname the path of the file without extension e.g. <tt>"mp_objects/sword.obj/tris0"</tt>
+    /// @return @a false if the directory of the file is indexed and has no entry of that name with or without an extension,
+    /// @a true otherwise
+    bool mayExistWithAnyExtension(const std::string& pathname) const;
+
+private:
+    /// @brief The entries of an indexed directory.
+    struct Directory {
+        std::unordered_set<std::string> names;  ///< The names of the entries.
+        std::unordered_set<std::string> stems;  ///< The names of the entries without extension.
+    };
+
+    /// @brief Get a path in lower case with slashes only, without doubled slashes and without leading or trailing slashes.
+    static std::string normalize(const std::string& path);
+
+    /// @brief Get the indexed directory of a file and the name of the file.
+    /// @return the directory or a null pointer if the directory is not indexed
+    const Directory *find(const std::string& pathname, std::string& name) const;
+
+    std::unordered_map<std::string, Directory> _directories;
+};
+
+} // namespace Ego
@@ -22,6 +22,7 @@
 /// @details
 
 #include "egolib/bbox.h"
+#include "egolib/OctBBKernels.hpp"
 #include "egolib/_math.h"
 #include "egolib/Math/_Include.hpp"
 
@@ -520,12 +521,7 @@ void oct_bb_t::join(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst)
 {
 	// @todo Obviously the author does not know how set union works.
 	// no simple case, do the hard work
-	for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
-		dst._mins[i] = std::min(src1._mins[i], src2._mins[i]);
-		dst._maxs[i] = std::max(src1._maxs[i], src2._maxs[i]);
-	}
-
-    dst._empty = oct_bb_t::empty_raw(dst);
+	Ego::OctBBKernels::join(src1, src2, dst);
 }
 
 void oct_bb_t::join(const oct_vec_v2_t& v)
@@ -543,12 +539,7 @@ void oct_bb_t::join(const oct_bb_t& other)
 {
 	// @todo Obviously the author does not know how set union works.
 	// No simple case, do the hard work.
-	for (size_t i = 0; i < OCT_COUNT; ++i)
-	{
-		_mins[i] = std::min(_mins[i], other._mins[i]);
-		_maxs[i] = std::max(_maxs[i], other._maxs[i]);
-	}
-    this->_empty = oct_bb_t::empty_raw(*this);
+	Ego::OctBBKernels::join(*this, other, *this);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -574,20 +565,7 @@ egolib_rv oct_bb_t::cut(const oct_bb_t& other, int index)
 
 oct_bb_t oct_bb_t::intersection(const oct_bb_t& src1, const oct_bb_t& src2)
 {
-	// Intersection of two empty bounds is an empty bound.
-    if (src1._empty && src2._empty) {
-        return oct_bb_t();
-    }
-
-    /// @todo Rewrite this in some fluffy C++ fashion.
-    oct_bb_t dst;
-    for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
-        dst._mins[i]  = std::max(src1._mins[i], src2._mins[i]);
-        dst._maxs[i]  = std::min(src1._maxs[i], src2._maxs[i]);
-    }
-
-    dst._empty = oct_bb_t::empty_raw(dst);
-	return dst;
+    return Ego::OctBBKernels::intersection(src1, src2);
 }
 
 //--------------------------------------------------------------------------------------------
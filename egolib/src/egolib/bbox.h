@@ -64,7 +64,11 @@
 
     public:
 
-        float _v[OCT_COUNT];
+        /// The number of floats of an octagonal vector.
+        /// The axes are padded with zeroes to eight floats such that the SIMD kernels can load them at once.
+        static constexpr size_t LANES = 8;
+
+        float _v[LANES];
 
         static const oct_vec_v2_t Zero;
 
@@ -77,9 +81,9 @@
 
         void add(const oct_vec_v2_t& other)
         {
-            for (size_t i = 0; i < OCT_COUNT; ++i)
+            for (size_t i = 0; i < LANES; ++i)
             {
-                _v[i] += other[i];
+                _v[i] += other._v[i];
             }
         }
 
@@ -90,9 +94,9 @@
 
         void sub(const oct_vec_v2_t& other)
         {
-            for (size_t i = 0; i < OCT_COUNT; ++i)
+            for (size_t i = 0; i < LANES; ++i)
             {
-                _v[i] -= other[i];
+                _v[i] -= other._v[i];
             }
         }
 
@@ -106,7 +110,7 @@
 
         void assign(const oct_vec_v2_t& other)
         {
-            for (size_t i = 0; i < OCT_COUNT; ++i)
+            for (size_t i = 0; i < LANES; ++i)
             {
                 _v[i] = other._v[i];
             }
@@ -128,7 +132,7 @@
 
         oct_vec_v2_t(const oct_vec_v2_t& other)
         {
-            for (size_t i = 0; i < OCT_COUNT; ++i)
+            for (size_t i = 0; i < LANES; ++i)
             {
                 _v[i] = other._v[i];
             }
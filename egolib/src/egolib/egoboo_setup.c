@@ -98,13 +98,6 @@ egoboo_config_t::egoboo_config_t() :
     network_lagTolerance(10,"network.lagTolerance","tolerance of lag in seconds"),
     network_hostName("Egoboo host","network.hostName", "name of host to join"),
     network_playerName("Egoboo player", "network.playerName", "player name in network games"),
-    // Game configuration section.
-    game_difficulty(Ego::GameDifficulty::Normal, "game.difficulty", "game difficulty",
-    {
-        { "Easy", Ego::GameDifficulty::Easy },
-        { "Normal", Ego::GameDifficulty::Normal },
-        { "Hard", Ego::GameDifficulty::Hard },
-    }),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -112,6 +105,16 @@ egoboo_config_t::egoboo_config_t() :
         { "Auto", CameraTurnMode::Auto },
         { "None", CameraTurnMode::None },
     }),
+    // Game configuration section.
+    game_difficulty(Ego::GameDifficulty::Normal, "game.difficulty", "game difficulty",
+    {
+        { "Easy", Ego::GameDifficulty::Easy },
+        { "Normal", Ego::GameDifficulty::Normal },
+        { "Hard", Ego::GameDifficulty::Hard },
+    }),
+    game_parallelCollisions_enable(false, "game.parallelCollisions.enable", "enable/disable parallel collision detection"),
+    game_aiScheduler_enable(false, "game.aiScheduler.enable", "enable/disable running AI scripts of far away or idle characters less often"),
+    game_aiScheduler_budget(4000, "game.aiScheduler.budget", "time in microseconds scheduled AI scripts may take per update, 0 for no budget"),
     // HUD configuration section.
     hud_feedback(Ego::FeedbackType::Text, "hud.feedback", "feed back given to the player",
     {
@@ -133,7 +136,9 @@ egoboo_config_t::egoboo_config_t() :
     debug_hideMouse(true,"debug.hideMouse","show/hide mouse"),
     debug_grabMouse(true,"debug.grabMouse","grab/don't grab mouse"),
     debug_developerMode_enable(false,"debug.developerMode.enable","enable/disable developer mode"),
-    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function")
+    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function"),
+    debug_scriptProfiling_enable(false,"debug.scriptProfiling.enable","enable/disable timing of script function calls"),
+    debug_scriptExport_enable(false,"debug.scriptExport.enable","enable/disable writing loaded scripts as C++ code")
 {}
 
 egoboo_config_t::~egoboo_config_t()
@@ -192,6 +197,9 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
 
     // Game configuration section.
     game_difficulty = other.game_difficulty;
+    game_parallelCollisions_enable = other.game_parallelCollisions_enable;
+    game_aiScheduler_enable = other.game_aiScheduler_enable;
+    game_aiScheduler_budget = other.game_aiScheduler_budget;
     
     // HUD configuration section.
     hud_displayGameTime = other.hud_displayGameTime;
@@ -211,6 +219,8 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
     debug_grabMouse = other.debug_grabMouse;
     debug_developerMode_enable = other.debug_developerMode_enable;
     debug_sdlImage_enable = other.debug_sdlImage_enable;
+    debug_scriptProfiling_enable = other.debug_scriptProfiling_enable;
+    debug_scriptExport_enable = other.debug_scriptExport_enable;
 
     return *this;
 }
@@ -339,6 +349,37 @@ void setup_clear_base_vfs_paths()
     vfs_remove_mount_point( Ego::VfsPath("mp_remote") );
 }
 
+//--------------------------------------------------------------------------------------------
+static Ego::VfsDirectoryIndex _module_vfs_index;
+
+const Ego::VfsDirectoryIndex& setup_get_module_vfs_index()
+{
+    return _module_vfs_index;
+}
+
+static void setup_index_module_objects(const std::string& objectsPath)
+{
+    try
+    {
+        SearchContext objects(Ego::VfsPath(objectsPath), Ego::Extension("obj"), VFS_SEARCH_DIR);
+        for (; objects.hasData(); objects.nextData())
+        {
+            std::vector<std::string> names;
+            SearchContext files(objects.getData(), VFS_SEARCH_ALL | VFS_SEARCH_BARE);
+            for (; files.hasData(); files.nextData())
+            {
+                names.push_back(files.getData().string());
+            }
+            _module_vfs_index.add(objects.getData().string(), names);
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        // without an index every file is probed
+        _module_vfs_index.clear();
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 bool setup_init_module_vfs_paths(const char *mod_path)
 {
@@ -408,6 +449,9 @@ bool setup_init_module_vfs_paths(const char *mod_path)
     // put the global globalparticles data after the module gamedat data
     vfs_add_mount_point( fs_getDataDirectory(), Ego::FsPath("basicdat" SLASH_STR "globalparticles"), Ego::VfsPath("mp_data"), 1 );
 
+    //---- list the files of the module's objects once, loading them probes for many optional files
+    setup_index_module_objects(std::string("mp_modules" NETWORK_SLASH_STR) + mod_dir_string + NETWORK_SLASH_STR "objects");
+
     return true;
 }
 
@@ -422,6 +466,7 @@ void setup_clear_module_vfs_paths()
 
     // clear out the module's mount points
     vfs_remove_mount_point( Ego::VfsPath("mp_objects") );
+    _module_vfs_index.clear();
 
     // set up the basic mount points again
     setup_init_base_vfs_paths();
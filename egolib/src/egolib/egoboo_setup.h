@@ -30,6 +30,7 @@
 //Forward declarations
 enum class CameraTurnMode : uint8_t;
 struct egoboo_config_t;
+namespace Ego { class VfsDirectoryIndex; }
 
 //--------------------------------------------------------------------------------------------
 // CONSTANTS
@@ -216,6 +217,9 @@ public:
             network_playerName,
             //
             game_difficulty,
+            game_parallelCollisions_enable,
+            game_aiScheduler_enable,
+            game_aiScheduler_budget,
             //
             camera_control,
             //
@@ -234,7 +238,9 @@ public:
             debug_hideMouse,
             debug_grabMouse,
             debug_developerMode_enable,
-            debug_sdlImage_enable
+            debug_sdlImage_enable,
+            debug_scriptProfiling_enable,
+            debug_scriptExport_enable
             );
         for_each(variables, f);
     }
@@ -617,6 +623,35 @@ public:
      */
     EnumerationVariable<Ego::GameDifficulty> game_difficulty;
 
+    /**
+     * @brief
+     *  Enable/disable parallel collision detection.
+     *  The collisions found are resolved in the same order either way.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> game_parallelCollisions_enable;
+
+    /**
+     * @brief
+     *  Enable/disable scheduling of AI scripts.
+     *  If enabled, scripts of characters far away from the players or idle run less often.
+     *  Alerts like being bumped or attacked still make a script run immediately.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> game_aiScheduler_enable;
+
+    /**
+     * @brief
+     *  The time, in microseconds, scheduled AI scripts may take per update.
+     *  Scripts not run because of the budget run first in the next update.
+     *  @a 0 means no budget.
+     * @remark
+     *  Default value is @a 4000.
+     */
+    StandardVariable<int> game_aiScheduler_budget;
+
     // HUD configuration section.
 
     /**
@@ -746,6 +781,24 @@ public:
      */
     StandardVariable<bool> debug_sdlImage_enable;
 
+    /**
+     * @brief
+     *  Enable/disable timing of every script function call.
+     *  The timings are written to "/debug/script_function_timing.txt".
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> debug_scriptProfiling_enable;
+
+    /**
+     * @brief
+     *  Enable/disable writing every loaded AI script as C++ code to "/debug/compiled_scripts".
+     *  Added to the game's sources, these are used instead of the interpreter.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> debug_scriptExport_enable;
+
 public:
 
     /**
@@ -828,3 +881,6 @@ bool setup_init_module_vfs_paths(const char *mod_path);
 /// Remove from the VFS the module specific mount points/search paths.
 void setup_clear_module_vfs_paths();
 
+/// Get the index of the object directories of the module mounted by setup_init_module_vfs_paths().
+const Ego::VfsDirectoryIndex& setup_get_module_vfs_index();
+
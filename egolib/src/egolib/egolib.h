@@ -32,6 +32,9 @@
 #include "egolib/Core/System.hpp"
 #include "egolib/Core/Singleton.hpp"
 #include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/SpatialGrid.hpp"
+#include "egolib/Core/SweepAndPrune.hpp"
+#include "egolib/Core/JobSystem.hpp"
 
 //--------------------------------------------------------------------------------------------
 
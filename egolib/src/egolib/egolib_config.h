@@ -146,14 +146,6 @@
  */
 #define MAX_WAVE 30
 
-/**
- * @brief
- *  Maximum number of dynamic lights.
- * @ingroup
- *  compile-time
- */
-#define TOTAL_MAX_DYNA 64
-
 /**
  * @brief
  *  Maximum number of MADs.
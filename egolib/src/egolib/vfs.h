@@ -36,6 +36,7 @@
 #include "egolib/egolib_config.h"
 #include "egolib/VFS/FsPath.hpp"
 #include "egolib/VFS/VfsPath.hpp"
+#include "egolib/VFS/VfsDirectoryIndex.hpp"
 
 //--------------------------------------------------------------------------------------------
 // MACROS
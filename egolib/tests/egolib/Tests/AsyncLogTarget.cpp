@@ -0,0 +1,155 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Log/AsyncTarget.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(AsyncLogTarget) {
+    /// A log target remembering what is written to it.
+    struct RecordingTarget : Log::Target {
+        RecordingTarget() : Log::Target(Log::Level::Debug), mutex(), records(), flushes(0) {}
+        void writev(Log::Level level, const char *format, va_list args) override {
+            char buffer[1024];
+            vsnprintf(buffer, sizeof(buffer), format, args);
+            std::lock_guard<std::mutex> lock(mutex);
+            records.emplace_back(level, buffer);
+        }
+        void flush() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushes++;
+        }
+        std::vector<std::pair<Log::Level, std::string>> getRecords() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return records;
+        }
+        std::mutex mutex;
+        std::vector<std::pair<Log::Level, std::string>> records;
+        int flushes;
+    };
+
+    EgoTest_Test(runAsyncLogTargetTestProducers) {
+        //Messages are never dropped, not even if the ring buffer is much too small
+        static const int THREADS = 4, MESSAGES = 500;
+        auto sink = std::make_unique<RecordingTarget>();
+        RecordingTarget& records = *sink;
+        Log::AsyncTarget target(std::move(sink), Log::Level::Warning, 8);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREADS; ++i) {
+            threads.emplace_back([&target, i]() {
+                for (int j = 0; j < MESSAGES; ++j) {
+                    target.message("%d %d\n", i, j);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        target.flush();
+
+        //All messages arrived, the ones of each thread in order
+        std::vector<int> next(THREADS, 0);
+        const auto written = records.getRecords();
+        EgoTest_Assert(THREADS * MESSAGES == written.size());
+        for (const auto& record : written) {
+            int i = -1, j = -1;
+            EgoTest_Assert(2 == sscanf(record.second.c_str(), "%d %d", &i, &j));
+            EgoTest_Assert(next[i] == j);
+            next[i]++;
+        }
+        EgoTest_Assert(0 == target.getDropped());
+    }
+
+    EgoTest_Test(runAsyncLogTargetTestFilterAndCoalesce) {
+        auto sink = std::make_unique<RecordingTarget>();
+        RecordingTarget& records = *sink;
+        Log::AsyncTarget target(std::move(sink), Log::Level::Warning);
+
+        //Below the log level nothing is written
+        EgoTest_Assert(!target.isEnabled(Log::Level::Info));
+        target.info("info\n");
+        target.debug("debug\n");
+        target.log(Log::Level::Debug, "debug\n");
+
+        //Repetitions are written once
+        for (int i = 0; i < 10; ++i) {
+            target.warn("the same warning\n");
+        }
+        target.warn("another warning\n");
+        target.flush();
+
+        const auto written = records.getRecords();
+        EgoTest_Assert(3 == written.size());
+        EgoTest_Assert("the same warning\n" == written[0].second);
+        EgoTest_Assert("last message repeated 9 times\n" == written[1].second);
+        EgoTest_Assert("another warning\n" == written[2].second);
+        EgoTest_Assert(Log::Level::Warning == written[1].first);
+    }
+
+    EgoTest_Test(runAsyncLogTargetTestRateLimit) {
+        auto sink = std::make_unique<RecordingTarget>();
+        RecordingTarget& records = *sink;
+        Log::AsyncTarget target(std::move(sink), Log::Level::Warning, 64, 5);
+        for (int i = 0; i < 20; ++i) {
+            target.warn("warning %d\n", i);
+        }
+        //Messages and errors are not subject to the rate limit
+        target.message("message\n");
+        target.flush();
+
+        EgoTest_Assert(15 == target.getDropped());
+        size_t warnings = 0, messages = 0, dropped = 0;
+        for (const auto& record : records.getRecords()) {
+            size_t count = 0;
+            if (1 == sscanf(record.second.c_str(), "%zu log messages dropped", &count)) {
+                dropped += count;
+            } else if ("message\n" == record.second) {
+                messages++;
+            } else {
+                EgoTest_Assert("warning " + std::to_string(warnings) + "\n" == record.second);
+                warnings++;
+            }
+        }
+        EgoTest_Assert(5 == warnings);
+        EgoTest_Assert(1 == messages);
+        EgoTest_Assert(15 == dropped);
+    }
+
+    EgoTest_Test(runAsyncLogTargetTestFlushOnError) {
+        auto sink = std::make_unique<RecordingTarget>();
+        RecordingTarget& records = *sink;
+        Log::AsyncTarget target(std::move(sink), Log::Level::Warning);
+        target.warn("warning\n");
+        target.error("error\n");
+
+        //Without waiting, the error and everything before it is written and flushed
+        const auto written = records.getRecords();
+        EgoTest_Assert(2 == written.size());
+        EgoTest_Assert("error\n" == written[1].second);
+        EgoTest_Assert(Log::Level::Error == written[1].first);
+        std::lock_guard<std::mutex> lock(records.mutex);
+        EgoTest_Assert(records.flushes > 0);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,156 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Logic/AttributeSet.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(AttributeSetTest) {
+    /// An enchant as Ego::Enchantment applies it: set types replace, all others add up.
+    struct Enchant {
+        std::vector<std::pair<Attribute::AttributeType, float>> modifiers;
+
+        void apply(AttributeSet& attributes) const {
+            for (const auto& modifier : modifiers) {
+                if (Attribute::isOverrideSetAttribute(modifier.first)) {
+                    attributes.setModifier(modifier.first, modifier.second);
+                } else {
+                    attributes.addModifier(modifier.first, modifier.second);
+                }
+            }
+        }
+
+        void remove(AttributeSet& attributes) const {
+            for (const auto& modifier : modifiers) {
+                if (Attribute::isOverrideSetAttribute(modifier.first)) {
+                    attributes.removeModifier(modifier.first);
+                } else {
+                    attributes.addModifier(modifier.first, -modifier.second);
+                }
+            }
+        }
+    };
+
+    static Attribute::AttributeType anAttribute(std::mt19937& generator) {
+        std::uniform_int_distribution<int> type(0, Attribute::NR_OF_ATTRIBUTES - 1);
+        int i;
+        do {
+            i = type(generator);
+        } while (Attribute::NR_OF_PRIMARY_ATTRIBUTES == i);
+        return static_cast<Attribute::AttributeType>(i);
+    }
+
+    EgoTest_Test(testCachedEqualsUncached) {
+        std::mt19937 generator(19);
+        std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+        std::uniform_int_distribution<int> action(0, 9), count(1, 4);
+
+        for (int sequence = 0; sequence < 50; ++sequence) {
+            AttributeSet attributes;
+            AttributeSet::Context context = { false, false };
+            for (int i = 0; i < Attribute::NR_OF_ATTRIBUTES; ++i) {
+                if (Attribute::NR_OF_PRIMARY_ATTRIBUTES != i) {
+                    attributes.setBase(static_cast<Attribute::AttributeType>(i), value(generator));
+                }
+            }
+
+            std::vector<Enchant> active;
+            for (int step = 0; step < 200; ++step) {
+                const int a = action(generator);
+                if (a < 5) {
+                    // Add an enchant, only one enchant sets a set type at a time.
+                    Enchant enchant;
+                    for (int i = count(generator); i > 0; --i) {
+                        const Attribute::AttributeType type = anAttribute(generator);
+                        if (Attribute::isOverrideSetAttribute(type) && attributes.hasModifier(type)) {
+                            continue;
+                        }
+                        enchant.modifiers.emplace_back(type, value(generator));
+                    }
+                    enchant.apply(attributes);
+                    active.push_back(enchant);
+                } else if (a < 8 && !active.empty()) {
+                    // Remove an enchant.
+                    std::uniform_int_distribution<size_t> which(0, active.size() - 1);
+                    const size_t i = which(generator);
+                    active[i].remove(attributes);
+                    active.erase(active.begin() + i);
+                } else if (a < 9) {
+                    // A perk is gained or an item is picked up or dropped.
+                    context.wolverine = !context.wolverine;
+                    context.athletics = 0 == (step % 3);
+                    attributes.invalidate();
+                } else {
+                    // A level up.
+                    const Attribute::AttributeType type = anAttribute(generator);
+                    attributes.setBase(type, attributes.getBase(type) + value(generator));
+                }
+
+                for (int i = 0; i < Attribute::NR_OF_ATTRIBUTES; ++i) {
+                    if (Attribute::NR_OF_PRIMARY_ATTRIBUTES == i) {
+                        continue;
+                    }
+                    const Attribute::AttributeType type = static_cast<Attribute::AttributeType>(i);
+                    EgoTest_Assert(attributes.compute(type, context) == attributes.get(type, [&context]() { return context; }));
+                }
+
+                //Cumulative modifiers add up to the sum of the active enchants
+                float sum = 0.0f;
+                for (const Enchant& enchant : active) {
+                    for (const auto& modifier : enchant.modifiers) {
+                        if (Attribute::DEFENCE == modifier.first) {
+                            sum += modifier.second;
+                        }
+                    }
+                }
+                EgoTest_Assert(std::abs(attributes.getModifier(Attribute::DEFENCE) - sum) < 1e-3f);
+            }
+        }
+    }
+
+    EgoTest_Test(testRecomputeOnlyWhenDirty) {
+        AttributeSet attributes;
+        attributes.setBase(Attribute::MIGHT, 10.0f);
+        int calls = 0;
+        auto getContext = [&calls]() { calls++; return AttributeSet::Context{ false, true }; };
+
+        EgoTest_Assert(10.0f == attributes.get(Attribute::MIGHT, getContext));
+        EgoTest_Assert(1.0f == attributes.get(Attribute::AGILITY, getContext));
+        EgoTest_Assert(1 == calls);
+
+        attributes.addModifier(Attribute::MIGHT, 5.0f);
+        EgoTest_Assert(15.0f == attributes.get(Attribute::MIGHT, getContext));
+        EgoTest_Assert(2 == calls);
+
+        //Set types replace the base value
+        attributes.setBase(Attribute::FLY_TO_HEIGHT, 0.0f);
+        attributes.setModifier(Attribute::FLY_TO_HEIGHT, 50.0f);
+        EgoTest_Assert(50.0f == attributes.get(Attribute::FLY_TO_HEIGHT, getContext));
+        EgoTest_Assert(AttributeSet::JUMP_POWER_FLYING == attributes.get(Attribute::JUMP_POWER, getContext));
+        attributes.removeModifier(Attribute::FLY_TO_HEIGHT);
+        EgoTest_Assert(0.0f == attributes.get(Attribute::FLY_TO_HEIGHT, getContext));
+        EgoTest_Assert(4 == calls);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
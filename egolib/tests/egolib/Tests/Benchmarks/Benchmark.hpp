@@ -0,0 +1,44 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file   egolib/Tests/Benchmarks/Benchmark.hpp
+/// @brief  Helpers shared by the benchmarks.
+/// @remark The benchmarks are not part of the tests, they are run with "make benchmark".
+
+#pragma once
+
+#include "egolib/egolib.h"
+#include "egolib/Time/Stopwatch.hpp"
+
+namespace Ego {
+namespace Test {
+
+/// Get the time it takes to call a function once.
+template <typename Function>
+double measure(Function function) {
+    Ego::Time::Stopwatch stopwatch;
+    stopwatch.start();
+    function();
+    stopwatch.stop();
+    return stopwatch.elapsed();
+}
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,196 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/DynamicLighting.cpp
+/// @brief  Dynamic lighting of the visible tiles with the lights binned into a grid compared to
+///         testing every tile against every light, and the selection of the closest lights.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Graphics/DynamicLighting.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(DynamicLightingBenchmark) {
+    static constexpr float TILE_SIZE = 128.0f;
+    static constexpr int TILES_X = 32, TILES_Y = 24;
+    static const int FRAMES = 20;
+    static const size_t TOTAL_LIGHTS = 64;
+
+    /// The former registry of the lights reaching the visible tiles.
+    struct Registration {
+        int reference;
+        ego_frect_t bound;
+    };
+
+    /// The former lighting of the visible tiles, every tile is tested against every light.
+    static void legacyIlluminate(const ego_frect_t& mesh_bound, const std::vector<dynalight_data_t>& lights, std::vector<LightingVector>& low, std::vector<LightingVector>& high) {
+        std::vector<Registration> reg;
+        ego_frect_t light_bound = { mesh_bound.xmax, mesh_bound.ymax, mesh_bound.xmin, mesh_bound.ymin };
+        for (size_t cnt = 0; cnt < lights.size(); cnt++) {
+            const dynalight_data_t& pdyna = lights[cnt];
+            if (pdyna.falloff <= 0.0f || 0.0f == pdyna.level) continue;
+            const float radius = std::sqrt(pdyna.falloff * 765.0f * 0.5f);
+            ego_frect_t ftmp;
+            ftmp.xmin = std::max(pdyna.pos[kX] - radius, mesh_bound.xmin);
+            ftmp.xmax = std::min(pdyna.pos[kX] + radius, mesh_bound.xmax);
+            ftmp.ymin = std::max(pdyna.pos[kY] - radius, mesh_bound.ymin);
+            ftmp.ymax = std::min(pdyna.pos[kY] + radius, mesh_bound.ymax);
+            if (ftmp.xmin >= ftmp.xmax || ftmp.ymin >= ftmp.ymax) continue;
+            reg.push_back({ static_cast<int>(cnt), ftmp });
+            light_bound.xmin = std::min(light_bound.xmin, ftmp.xmin);
+            light_bound.xmax = std::max(light_bound.xmax, ftmp.xmax);
+            light_bound.ymin = std::min(light_bound.ymin, ftmp.ymin);
+            light_bound.ymax = std::max(light_bound.ymax, ftmp.ymax);
+        }
+        for (int y = 0; y < TILES_Y; ++y) {
+            for (int x = 0; x < TILES_X; ++x) {
+                const float x0 = mesh_bound.xmin + x * TILE_SIZE, y0 = mesh_bound.ymin + y * TILE_SIZE;
+                ego_frect_t fgrid_rect = { x0 - TILE_SIZE * 0.5f, y0 - TILE_SIZE * 0.5f, x0 + TILE_SIZE * 0.5f, y0 + TILE_SIZE * 0.5f };
+                if (fgrid_rect.xmin > light_bound.xmax || fgrid_rect.xmax < light_bound.xmin) continue;
+                if (fgrid_rect.ymin > light_bound.ymax || fgrid_rect.ymax < light_bound.ymin) continue;
+                for (const Registration& r : reg) {
+                    if (fgrid_rect.xmin > r.bound.xmax || fgrid_rect.xmax < r.bound.xmin) continue;
+                    if (fgrid_rect.ymin > r.bound.ymax || fgrid_rect.ymax < r.bound.ymin) continue;
+                    const dynalight_data_t& pdyna = lights[r.reference];
+                    Vector3f nrm(pdyna.pos[kX] - x0, pdyna.pos[kY] - y0, pdyna.pos[kZ] - 0.0f);
+                    sum_dyna_lighting(&pdyna, low[y * TILES_X + x], nrm);
+                    nrm[kZ] = pdyna.pos[kZ] - 200.0f;
+                    sum_dyna_lighting(&pdyna, high[y * TILES_X + x], nrm);
+                }
+            }
+        }
+    }
+
+    static void gridIlluminate(Graphics::DynamicLightGrid& grid, const ego_frect_t& mesh_bound, const std::vector<dynalight_data_t>& lights, std::vector<LightingVector>& low, std::vector<LightingVector>& high) {
+        grid.reset(mesh_bound, lights);
+        for (int y = 0; y < TILES_Y; ++y) {
+            for (int x = 0; x < TILES_X; ++x) {
+                grid.illuminate(mesh_bound.xmin + x * TILE_SIZE, mesh_bound.ymin + y * TILE_SIZE, 0.0f, 200.0f, low[y * TILES_X + x], high[y * TILES_X + x]);
+            }
+        }
+    }
+
+    /// The former selection of the closest lights, an insertion scan over all particles.
+    static size_t legacySelect(const std::vector<dynalight_data_t>& particles, size_t dynalist_max, dynalight_data_t *lst) {
+        size_t size = 0;
+        float distance_max = 0.0f;
+        dynalight_data_t *plight_max = nullptr;
+        for (const dynalight_data_t& particle : particles) {
+            if (0.0f == particle.level) continue;
+            dynalight_data_t *plight = nullptr;
+            const float distance = particle.distance;
+            if (size < dynalist_max) {
+                distance_max = (0 == size) ? distance : std::max(distance_max, distance);
+                plight = lst + size;
+                size++;
+                if (distance_max == distance) plight_max = plight;
+            } else if (distance < distance_max) {
+                plight = plight_max;
+                distance_max = lst[0].distance;
+                plight_max = lst + 0;
+                for (size_t tnc = 1; tnc < dynalist_max; tnc++) {
+                    if (lst[tnc].distance > distance_max) {
+                        plight_max = lst + tnc;
+                        distance_max = plight_max->distance;
+                    }
+                }
+            }
+            if (plight) *plight = particle;
+        }
+        return size;
+    }
+
+    EgoTest_Test(benchmarkGridLighting) {
+        std::mt19937 generator(41);
+        const ego_frect_t mesh_bound = { 2048.0f, 2048.0f, 2048.0f + TILES_X * TILE_SIZE, 2048.0f + TILES_Y * TILE_SIZE };
+        std::uniform_real_distribution<float> x(mesh_bound.xmin - 500.0f, mesh_bound.xmax + 500.0f), y(mesh_bound.ymin - 500.0f, mesh_bound.ymax + 500.0f);
+        std::uniform_real_distribution<float> z(0.0f, 200.0f), level(0.1f, 1.0f), falloff(20.0f, 200.0f);
+
+        std::cout << "DynamicLightingBenchmark: " << TILES_X << "x" << TILES_Y << " tiles" << std::endl;
+        Graphics::DynamicLightGrid grid(4 * TILE_SIZE, TILE_SIZE);
+        for (size_t count : { 8, 64, 256, 1024 }) {
+            std::vector<dynalight_data_t> lights(count);
+            for (auto& light : lights) {
+                light.pos = Vector3f(x(generator), y(generator), z(generator));
+                light.level = level(generator);
+                light.falloff = falloff(generator);
+                light.distance = 0.0f;
+            }
+            std::vector<LightingVector> expectedLow(TILES_X * TILES_Y), expectedHigh(TILES_X * TILES_Y);
+            std::vector<LightingVector> actualLow(TILES_X * TILES_Y), actualHigh(TILES_X * TILES_Y);
+            const double legacyTime = measure([&]() {
+                for (int i = 0; i < FRAMES; ++i) {
+                    legacyIlluminate(mesh_bound, lights, expectedLow, expectedHigh);
+                }
+            });
+            const double gridTime = measure([&]() {
+                for (int i = 0; i < FRAMES; ++i) {
+                    gridIlluminate(grid, mesh_bound, lights, actualLow, actualHigh);
+                }
+            });
+            //Both give the same lighting
+            EgoTest_Assert(expectedLow == actualLow);
+            EgoTest_Assert(expectedHigh == actualHigh);
+
+            std::cout << "    " << count << " lights: every light " << legacyTime / FRAMES * 1000.0 << " ms/frame, "
+                      << "binned " << gridTime / FRAMES * 1000.0 << " ms/frame" << std::endl;
+        }
+    }
+
+    EgoTest_Test(benchmarkSelection) {
+        std::mt19937 generator(43);
+        std::uniform_real_distribution<float> distance(0.0f, 1e7f);
+        std::bernoulli_distribution lit(0.25);
+        std::vector<dynalight_data_t> particles(2048);
+        for (auto& particle : particles) {
+            dynalight_data_t::init(particle);
+            particle.distance = distance(generator);
+            particle.level = lit(generator) ? 1.0f : 0.0f;
+        }
+
+        std::vector<dynalight_data_t> lst(TOTAL_LIGHTS), selected;
+        size_t legacySize = 0;
+        const double legacyTime = measure([&]() {
+            for (int i = 0; i < FRAMES; ++i) {
+                legacySize = legacySelect(particles, TOTAL_LIGHTS, lst.data());
+            }
+        });
+        const double selectTime = measure([&]() {
+            for (int i = 0; i < FRAMES; ++i) {
+                selected.clear();
+                for (const auto& particle : particles) {
+                    if (0.0f == particle.level) continue;
+                    selected.push_back(particle);
+                }
+                Graphics::select_dynalights(selected, TOTAL_LIGHTS);
+            }
+        });
+        EgoTest_Assert(legacySize == selected.size());
+
+        std::cout << "DynamicLightingBenchmark: closest " << TOTAL_LIGHTS << " of " << particles.size() << " particles" << std::endl
+                  << "    insertion scan " << legacyTime / FRAMES * 1000.0 << " ms/frame, "
+                  << "partial sort " << selectTime / FRAMES * 1000.0 << " ms/frame" << std::endl;
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,209 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/FontCache.cpp
+/// @brief  The text calls of a typical frame (status panels, message log, debug overlay)
+///         against the LRU cache of Ego::Font compared to the former cache of 20 entries.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Core/LRUCache.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(FontCacheBenchmark) {
+    static const int FRAMES = 1000;
+
+    /// The laid out text, a P3FT2F quad per character as Font::layoutToBuffer creates it.
+    typedef std::shared_ptr<std::vector<float>> LaidText;
+
+    struct Key {
+        std::string text;
+        int width, height, spacing;
+
+        bool operator==(const Key& other) const {
+            return width == other.width && height == other.height && spacing == other.spacing && text == other.text;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t hash = std::hash<std::string>()(key.text);
+            for (int value : { key.width, key.height, key.spacing }) {
+                hash ^= std::hash<int>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    static LaidText layout(const std::string& text) {
+        auto vertices = std::make_shared<std::vector<float>>(text.size() * 4 * 5);
+        float x = 0.0f;
+        for (size_t i = 0; i < text.size(); ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                float *vertex = vertices->data() + (i * 4 + j) * 5;
+                vertex[0] = x + static_cast<float>(j % 2) * 8.0f;
+                vertex[1] = static_cast<float>(j / 2) * 12.0f;
+                vertex[2] = 0.0f;
+                vertex[3] = static_cast<float>(text[i] % 16) / 16.0f;
+                vertex[4] = static_cast<float>(text[i] / 16) / 16.0f;
+            }
+            x += 8.0f;
+        }
+        return vertices;
+    }
+
+    /// The former cache: linear search, sorted by the time of the last use when full.
+    struct LegacyCache {
+        struct Entry {
+            LaidText cache;
+            uint32_t lastUseInTicks;
+            Key key;
+        };
+        std::vector<std::shared_ptr<Entry>> entries;
+        size_t misses = 0;
+
+        LaidText get(const Key& key, uint32_t ticks) {
+            auto it = std::find_if(entries.begin(), entries.end(), [&key](const std::shared_ptr<Entry>& entry) {
+                return entry->key == key;
+            });
+            std::shared_ptr<Entry> entry;
+            if (it != entries.end()) {
+                entry = *it;
+            } else {
+                if (entries.size() < 20) {
+                    entry = std::make_shared<Entry>();
+                    entries.push_back(entry);
+                } else {
+                    std::sort(entries.begin(), entries.end(), [](const std::shared_ptr<Entry>& a, const std::shared_ptr<Entry>& b) {
+                        return a->lastUseInTicks < b->lastUseInTicks;
+                    });
+                    entry = entries[0];
+                }
+                entry->cache = layout(key.text);
+                entry->key = key;
+                misses++;
+            }
+            entry->lastUseInTicks = ticks;
+            return entry->cache;
+        }
+    };
+
+    /// The text calls of one frame, some of them change every frame.
+    static std::vector<Key> aFrame(int frame) {
+        std::vector<Key> keys;
+        static const char *names[] = { "Aragorn the Soldier", "Bilbo the Thief", "Gandalf the Wizard", "Legolas the Archer" };
+        for (int i = 0; i < 4; ++i) {
+            keys.push_back({ names[i], 0, 0, 0 });
+            keys.push_back({ "Life " + std::to_string(40 + i) + "/60", 0, 0, 0 });
+            keys.push_back({ "Mana " + std::to_string(10 + i) + "/20", 0, 0, 0 });
+            keys.push_back({ "$" + std::to_string(100 * i), 0, 0, 0 });
+            keys.push_back({ "Level " + std::to_string(3 + i), 0, 0, 0 });
+        }
+        for (int i = 0; i < 6; ++i) {
+            const int message = frame / 200 + i;
+            keys.push_back({ "Message " + std::to_string(message) + ": The goblin hits you for " + std::to_string(message % 7) + " damage.", 300, 0, 4 });
+        }
+        keys.push_back({ "FPS " + std::to_string(60 - frame % 3), 0, 0, 0 });
+        keys.push_back({ "Objects " + std::to_string(120 + frame % 5), 0, 0, 0 });
+        keys.push_back({ "Particles " + std::to_string(400 + frame % 11), 0, 0, 0 });
+        keys.push_back({ "Camera 2048.0 1536.0 600.0", 0, 0, 0 });
+        for (const char *line : { "Map: Goblin Caves", "Pause [P]", "Inventory [I]", "Quest Log [Q]" }) {
+            keys.push_back({ line, 0, 0, 0 });
+        }
+        return keys;
+    }
+
+    EgoTest_Test(benchmarkFrames) {
+        std::vector<std::vector<Key>> frames;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            frames.push_back(aFrame(frame));
+        }
+
+        LegacyCache legacy;
+        LRUCache<Key, LaidText, KeyHash> cache(256 * 1024);
+        float legacySum = 0.0f, sum = 0.0f;
+        const double legacyTime = measure([&]() {
+            for (int frame = 0; frame < FRAMES; ++frame) {
+                for (const Key& key : frames[frame]) {
+                    legacySum += legacy.get(key, frame)->back();
+                }
+            }
+        });
+        const double time = measure([&]() {
+            for (int frame = 0; frame < FRAMES; ++frame) {
+                for (const Key& key : frames[frame]) {
+                    LaidText *laidText = cache.find(key);
+                    if (!laidText) {
+                        LaidText newText = layout(key.text);
+                        laidText = &cache.insert(key, newText, sizeof(Key) + key.text.size() + newText->size() * sizeof(float));
+                    }
+                    sum += (*laidText)->back();
+                }
+            }
+        });
+
+        //Both render the same text
+        EgoTest_Assert(legacySum == sum);
+        const LRUCacheStatistics& statistics = cache.getStatistics();
+        EgoTest_Assert(statistics.misses < legacy.misses);
+        EgoTest_Assert(statistics.bytes <= cache.getCapacity());
+
+        const size_t calls = FRAMES * frames[0].size();
+        std::cout << "FontCacheBenchmark: " << FRAMES << " frames, " << frames[0].size() << " text calls per frame" << std::endl
+                  << "    20 entries, linear search  " << legacy.misses << " misses, " << FRAMES / legacyTime << " frames/s" << std::endl
+                  << "    LRU, " << cache.getCapacity() / 1024 << " KB budget        " << statistics.misses << " misses, " << FRAMES / time << " frames/s, "
+                  << statistics.entries << " entries, " << statistics.bytes / 1024 << " KB" << std::endl
+                  << "    hit rate " << 100.0 * (calls - legacy.misses) / calls << "% vs. " << 100.0 * statistics.hits / calls << "%" << std::endl;
+    }
+
+    EgoTest_Test(testEviction) {
+        LRUCache<std::string, int> cache(100);
+        cache.insert("a", 1, 40);
+        cache.insert("b", 2, 40);
+        EgoTest_Assert(nullptr != cache.find("a"));
+
+        //"b" is the least recently used entry
+        cache.insert("c", 3, 40);
+        EgoTest_Assert(nullptr == cache.find("b"));
+        EgoTest_Assert(1 == *cache.find("a"));
+        EgoTest_Assert(3 == *cache.find("c"));
+        EgoTest_Assert(2 == cache.getStatistics().entries);
+        EgoTest_Assert(80 == cache.getStatistics().bytes);
+        EgoTest_Assert(1 == cache.getStatistics().evictions);
+        EgoTest_Assert(3 == cache.getStatistics().hits);
+        EgoTest_Assert(1 == cache.getStatistics().misses);
+
+        //Replacing an entry updates its size, an entry larger than the budget is kept alone
+        cache.insert("a", 4, 20);
+        EgoTest_Assert(60 == cache.getStatistics().bytes);
+        cache.insert("d", 5, 200);
+        EgoTest_Assert(1 == cache.getStatistics().entries);
+        EgoTest_Assert(5 == *cache.find("d"));
+
+        cache.setCapacity(0);
+        EgoTest_Assert(0 == cache.getStatistics().entries);
+        EgoTest_Assert(nullptr == cache.find("d"));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
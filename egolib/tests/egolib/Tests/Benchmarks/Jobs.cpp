@@ -0,0 +1,102 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/Jobs.cpp
+/// @brief  Submit latency and parallelFor scaling of the JobSystem.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(JobSystemBenchmark) {
+    static const size_t SUBMIT_JOBS = 100000;       //< Empty jobs submitted for the latency benchmark
+    static const size_t RANGE = 1 << 20;            //< Indices processed by parallelFor
+    static const size_t GRAIN_SIZE = 1024;
+    static const size_t REPETITIONS = 10;
+
+    EgoTest_Test(benchmarkSubmitLatency) {
+        for (size_t workers : { 0, 1, 3 }) {
+            Ego::Core::JobSystem jobSystem(workers);
+            std::atomic<size_t> count(0);
+            Ego::Core::JobCounter counter;
+
+            //Batches stay below the deque capacity, so nothing runs inline on overflow
+            const size_t batch = Ego::Core::JobSystem::DEQUE_CAPACITY / 2;
+            double submit = 0.0;
+            const double total = measure([&]() {
+                for (size_t i = 0; i < SUBMIT_JOBS; i += batch) {
+                    submit += measure([&]() {
+                        counter.add(std::min(SUBMIT_JOBS, i + batch) - i);
+                        for (size_t j = i; j < std::min(SUBMIT_JOBS, i + batch); ++j) {
+                            jobSystem.submit([&count]() { count.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                        }
+                    });
+                    jobSystem.wait(counter);
+                }
+            });
+            EgoTest_Assert(SUBMIT_JOBS == count.load());
+
+            std::cout << "JobSystemBenchmark: " << workers << " workers, "
+                      << "submit " << submit * 1e9 / SUBMIT_JOBS << " ns/job, "
+                      << "submit and run " << total * 1e9 / SUBMIT_JOBS << " ns/job" << std::endl;
+        }
+    }
+
+    EgoTest_Test(benchmarkParallelForScaling) {
+        std::vector<float> values(RANGE);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<float>(i);
+        }
+        //Some non-trivial arithmetic per index
+        auto kernel = [&values](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                float x = values[i];
+                for (size_t k = 0; k < 16; ++k) {
+                    x = std::sqrt(x * x + 1.0f);
+                }
+                values[i] = x;
+            }
+        };
+
+        double single = 0.0;
+        for (size_t threads : { 1, 2, 4, 8, 16, 32 }) {
+            //The calling thread is one of the threads
+            Ego::Core::JobSystem jobSystem(threads - 1);
+            jobSystem.parallelFor(0, values.size(), GRAIN_SIZE, kernel);
+            const double elapsed = measure([&]() {
+                for (size_t i = 0; i < REPETITIONS; ++i) {
+                    jobSystem.parallelFor(0, values.size(), GRAIN_SIZE, kernel);
+                }
+            }) / REPETITIONS;
+            if (1 == threads) {
+                single = elapsed;
+            }
+
+            std::cout << "JobSystemBenchmark: parallelFor " << RANGE << " indices, " << threads << " threads "
+                      << "(" << std::thread::hardware_concurrency() << " cores), "
+                      << elapsed * 1000.0 << " ms, speedup " << single / elapsed << std::endl;
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,229 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/MD2Interpolation.cpp
+/// @brief  Interpolation of every frame of the shipped tris.md2 files with each supported
+///         kernel compared to the former per vertex interpolation. The models are looked up in
+///         $EGOBOO_DATA (default: data), if there are none a generated model is used.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Graphics/MD2Interpolation.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MD2InterpolationBenchmark) {
+    static const int REPETITIONS = 20;
+
+    /// A vertex as the game renders it.
+    struct Vertex {
+        float pos[4];
+        float nrm[3];
+        float env[2];
+        float tex[2];
+        float col[4];
+        int color_dir;
+    };
+
+    /// A vertex as MD2_Frame stored it before.
+    struct LegacyVertex {
+        Vector3f pos;
+        Vector3f nrm;
+        size_t normal;
+    };
+
+    /// The frames of a model, stored both ways.
+    struct Model {
+        std::string name;
+        std::vector<MD2_Frame> frames;
+        std::vector<std::vector<LegacyVertex>> legacyFrames;
+    };
+
+    /// The former interpolation, one vertex and one component at a time.
+    static void legacyInterpolate(const std::vector<LegacyVertex>& lst_ary, const std::vector<LegacyVertex>& nxt_ary, const float *indextoenvirox, float flip, std::vector<Vertex>& vertices) {
+        for (size_t i = 0; i < vertices.size(); i++) {
+            Vertex *dst = &vertices[i];
+            const LegacyVertex &srcLast = lst_ary[i];
+            const LegacyVertex &srcNext = nxt_ary[i];
+
+            dst->pos[0] = srcLast.pos[kX] + (srcNext.pos[kX] - srcLast.pos[kX]) * flip;
+            dst->pos[1] = srcLast.pos[kY] + (srcNext.pos[kY] - srcLast.pos[kY]) * flip;
+            dst->pos[2] = srcLast.pos[kZ] + (srcNext.pos[kZ] - srcLast.pos[kZ]) * flip;
+            dst->pos[3] = 1.0f;
+
+            dst->nrm[0] = srcLast.nrm[kX] + (srcNext.nrm[kX] - srcLast.nrm[kX]) * flip;
+            dst->nrm[1] = srcLast.nrm[kY] + (srcNext.nrm[kY] - srcLast.nrm[kY]) * flip;
+            dst->nrm[2] = srcLast.nrm[kZ] + (srcNext.nrm[kZ] - srcLast.nrm[kZ]) * flip;
+
+            dst->env[0] = indextoenvirox[srcLast.normal] + (indextoenvirox[srcNext.normal] - indextoenvirox[srcLast.normal]) * flip;
+            dst->env[1] = 0.5f * (1.0f + dst->nrm[2]);
+        }
+    }
+
+    static void setVertex(Model& model, size_t frame, size_t i, const Vector3f& pos, size_t normal) {
+        LegacyVertex& vertex = model.legacyFrames[frame][i];
+        vertex.pos = pos;
+        vertex.normal = std::min<size_t>(normal, MD2_MAX_NORMALS);
+        vertex.nrm = Vector3f(MD2Model::getMD2Normal(vertex.normal, 0), MD2Model::getMD2Normal(vertex.normal, 1), MD2Model::getMD2Normal(vertex.normal, 2));
+        model.frames[frame].setPosition(i, vertex.pos);
+        model.frames[frame].setNormalIndex(i, vertex.normal);
+        model.frames[frame].setNormal(i, vertex.nrm);
+    }
+
+    static void resize(Model& model, size_t frameCount, size_t vertexCount) {
+        model.frames.resize(frameCount);
+        model.legacyFrames.resize(frameCount);
+        for (size_t i = 0; i < frameCount; ++i) {
+            model.frames[i].resize(vertexCount);
+            model.legacyFrames[i].resize(vertexCount);
+        }
+    }
+
+    /// Read the frames of an MD2 file.
+    static bool read(const std::string& bytes, Model& model) {
+        id_md2_header_t header;
+        if (bytes.size() < sizeof(header)) {
+            return false;
+        }
+        memcpy(&header, bytes.data(), sizeof(header));
+        const size_t frameCount = ENDIAN_TO_SYS_INT32(header.num_frames), vertexCount = ENDIAN_TO_SYS_INT32(header.num_vertices);
+        const size_t offset = ENDIAN_TO_SYS_INT32(header.offset_frames);
+        const size_t frameSize = sizeof(id_md2_frame_header_t) + vertexCount * sizeof(id_md2_vertex_t);
+        if (ENDIAN_TO_SYS_INT32(header.ident) != MD2_MAGIC_NUMBER || offset + frameCount * frameSize > bytes.size()) {
+            return false;
+        }
+        resize(model, frameCount, vertexCount);
+        for (size_t frame = 0; frame < frameCount; ++frame) {
+            id_md2_frame_header_t frameHeader;
+            const char *data = bytes.data() + offset + frame * frameSize;
+            memcpy(&frameHeader, data, sizeof(frameHeader));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                id_md2_vertex_t vertex;
+                memcpy(&vertex, data + sizeof(frameHeader) + i * sizeof(vertex), sizeof(vertex));
+                setVertex(model, frame, i, Vector3f(vertex.v[0] * frameHeader.scale[0] + frameHeader.translate[0],
+                                                    vertex.v[1] * frameHeader.scale[1] + frameHeader.translate[1],
+                                                    vertex.v[2] * frameHeader.scale[2] + frameHeader.translate[2]), vertex.normalIndex);
+            }
+        }
+        return true;
+    }
+
+    /// A model of 40 frames and 500 vertices with random contents, about the size of a character.
+    static Model aModel(std::mt19937& generator) {
+        std::uniform_real_distribution<float> coordinate(-64.0f, 64.0f);
+        std::uniform_int_distribution<size_t> normal(0, MD2_MAX_NORMALS - 1);
+        Model model;
+        model.name = "generated";
+        resize(model, 40, 500);
+        for (size_t frame = 0; frame < model.frames.size(); ++frame) {
+            for (size_t i = 0; i < model.frames[frame].getVertexCount(); ++i) {
+                setVertex(model, frame, i, Vector3f(coordinate(generator), coordinate(generator), coordinate(generator)), normal(generator));
+            }
+        }
+        return model;
+    }
+
+    /// The tris.md2 files in a directory and its subdirectories.
+    static void findShippedModels(const std::string& directory, int depth, std::vector<Model>& models) {
+        std::ifstream file(directory + SLASH_STR "tris.md2", std::ios::binary);
+        Model model;
+        if (file && read(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()), model)) {
+            model.name = directory;
+            models.push_back(std::move(model));
+        }
+        if (depth == 0) {
+            return;
+        }
+        std::vector<std::string> entries;
+        fs_find_context_t context;
+        for (const char *entry = fs_findFirstFile(directory.c_str(), nullptr, &context); entry; entry = fs_findNextFile(&context)) {
+            entries.push_back(entry);
+        }
+        fs_findClose(&context);
+        for (const auto& entry : entries) {
+            findShippedModels(directory + SLASH_STR + entry, depth - 1, models);
+        }
+    }
+
+    EgoTest_Test(benchmarkShippedModels) {
+        const char *data = getenv("EGOBOO_DATA");
+        std::vector<Model> models;
+        findShippedModels(data ? data : "data", 4, models);
+        if (models.empty()) {
+            std::mt19937 generator(29);
+            models.push_back(aModel(generator));
+        }
+
+        float indextoenvirox[EGO_NORMAL_COUNT];
+        for (size_t i = 0; i < EGO_NORMAL_COUNT; ++i) {
+            indextoenvirox[i] = std::atan2(MD2Model::getMD2Normal(i, 1), MD2Model::getMD2Normal(i, 0)) * Ego::Math::invTwoPi<float>();
+        }
+
+        static const std::array<MD2Interpolation::Kernel, 3> kernels = { { MD2Interpolation::Kernel::Scalar, MD2Interpolation::Kernel::SSE2, MD2Interpolation::Kernel::AVX2 } };
+        static const std::array<const char *, 3> names = { { "scalar", "SSE2  ", "AVX2  " } };
+        std::array<double, 3> times = { { 0.0, 0.0, 0.0 } };
+        double legacyTime = 0.0;
+        size_t vertices = 0, frames = 0;
+        for (const Model& model : models) {
+            if (model.frames.size() < 2 || 0 == model.frames[0].getVertexCount()) {
+                continue;
+            }
+            const size_t vertexCount = model.frames[0].getVertexCount();
+            std::vector<Vertex> expected(vertexCount), actual(vertexCount);
+            for (size_t frame = 0; frame + 1 < model.frames.size(); ++frame) {
+                // The flips of an animation at the default rate, the key frames are copied and left out.
+                for (float flip : { 0.25f, 0.5f, 0.75f }) {
+                    legacyTime += measure([&]() {
+                        for (int i = 0; i < REPETITIONS; ++i) {
+                            legacyInterpolate(model.legacyFrames[frame], model.legacyFrames[frame + 1], indextoenvirox, flip, expected);
+                        }
+                    });
+                    for (size_t k = 0; k < kernels.size(); ++k) {
+                        if (!MD2Interpolation::isSupported(kernels[k])) {
+                            continue;
+                        }
+                        times[k] += measure([&]() {
+                            for (int i = 0; i < REPETITIONS; ++i) {
+                                MD2Interpolation::interpolate(kernels[k], model.frames[frame], model.frames[frame + 1], 0, vertexCount - 1, flip,
+                                                              actual.data()->pos, sizeof(Vertex) / sizeof(float));
+                            }
+                        });
+                        //Both give the same vertices
+                        EgoTest_Assert(0 == memcmp(expected.data(), actual.data(), expected.size() * sizeof(Vertex)));
+                    }
+                    vertices += vertexCount * REPETITIONS;
+                    frames += REPETITIONS;
+                }
+            }
+        }
+
+        std::cout << "MD2InterpolationBenchmark: " << models.size() << " models, " << frames << " interpolated frames" << std::endl
+                  << "    per vertex  " << vertices / legacyTime / 1e6 << " M vertices/s" << std::endl;
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            if (MD2Interpolation::isSupported(kernels[k])) {
+                std::cout << "    " << names[k] << "      " << vertices / times[k] / 1e6 << " M vertices/s" << std::endl;
+            }
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
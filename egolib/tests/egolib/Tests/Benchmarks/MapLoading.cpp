@@ -0,0 +1,196 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/MapLoading.cpp
+/// @brief  Load time of the shipped MPD files, decoded from memory compared to the former
+///         decoding field by field. The modules are looked up in $EGOBOO_DATA/mp_modules
+///         (default: data/mp_modules), if there are none a generated map is used.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/FileFormats/map_file.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MapLoadingBenchmark) {
+    static const int REPETITIONS = 10;
+
+    /// The former decoding, one read per field.
+    struct LegacyReader {
+        static Uint32 readUint32(std::istream& is) {
+            Uint32 value = 0;
+            is.read(reinterpret_cast<char *>(&value), sizeof(value));
+            return ENDIAN_TO_SYS_INT32(value);
+        }
+        static float readFloat(std::istream& is) {
+            float value = 0.0f;
+            is.read(reinterpret_cast<char *>(&value), sizeof(value));
+            return ENDIAN_TO_SYS_IEEE32(value);
+        }
+        static Uint8 readUint8(std::istream& is) {
+            char value = 0;
+            is.read(&value, 1);
+            return static_cast<Uint8>(value);
+        }
+
+        /// Load a version "D" map.
+        static bool load(std::istream& is, map_t& map) {
+            readUint32(is);
+            const Uint32 vertexCount = readUint32(is), tileCountX = readUint32(is), tileCountY = readUint32(is);
+            if (!map.setInfo(map_info_t(vertexCount, tileCountX, tileCountY))) {
+                return false;
+            }
+            for (auto& tile : map._mem.tiles) {
+                const Uint32 value = readUint32(is);
+                tile.type = Ego::Math::clipBits<8>(value >> 24);
+                tile.fx = Ego::Math::clipBits<8>(value >> 16);
+                tile.img = Ego::Math::clipBits<16>(value >> 0);
+            }
+            for (auto& tile : map._mem.tiles) {
+                tile.twist = readUint8(is);
+            }
+            for (auto& vertex : map._mem.vertices) {
+                vertex.pos[kX] = readFloat(is);
+            }
+            for (auto& vertex : map._mem.vertices) {
+                vertex.pos[kY] = readFloat(is);
+            }
+            for (auto& vertex : map._mem.vertices) {
+                vertex.pos[kZ] = readFloat(is) / 16.0f;
+            }
+            for (auto& vertex : map._mem.vertices) {
+                vertex.a = readUint8(is);
+            }
+            return !is.fail();
+        }
+    };
+
+    static void writeUint32(std::string& bytes, Uint32 value) {
+        value = ENDIAN_TO_FILE_INT32(value);
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    static void writeFloat(std::string& bytes, float value) {
+        value = ENDIAN_TO_FILE_IEEE32(value);
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    /// A version "D" map of 128 x 128 tiles with random contents.
+    static std::string aMap(std::mt19937& generator) {
+        static const Uint32 SIZE = 128, VERTICES = SIZE * SIZE * 4;
+        std::uniform_int_distribution<Uint32> word;
+        std::uniform_real_distribution<float> coordinate(0.0f, 16384.0f);
+        std::string bytes;
+        writeUint32(bytes, SDL_Swap32(MAP_ID_BASE + 'D' - 'A'));
+        writeUint32(bytes, VERTICES);
+        writeUint32(bytes, SIZE);
+        writeUint32(bytes, SIZE);
+        for (Uint32 i = 0; i < SIZE * SIZE; ++i) {
+            writeUint32(bytes, word(generator));
+        }
+        for (Uint32 i = 0; i < SIZE * SIZE; ++i) {
+            bytes.push_back(static_cast<char>(word(generator)));
+        }
+        for (Uint32 i = 0; i < 3 * VERTICES; ++i) {
+            writeFloat(bytes, coordinate(generator));
+        }
+        for (Uint32 i = 0; i < VERTICES; ++i) {
+            bytes.push_back(static_cast<char>(word(generator)));
+        }
+        return bytes;
+    }
+
+    /// The shipped MPD files.
+    static std::vector<std::pair<std::string, std::string>> theShippedMaps() {
+        const char *data = getenv("EGOBOO_DATA");
+        const std::string directory = std::string(data ? data : "data") + SLASH_STR "mp_modules";
+        std::vector<std::pair<std::string, std::string>> maps;
+        fs_find_context_t context;
+        for (const char *module = fs_findFirstFile(directory.c_str(), "mod", &context); module; module = fs_findNextFile(&context)) {
+            std::ifstream file(directory + SLASH_STR + module + SLASH_STR "gamedat" SLASH_STR "level.mpd", std::ios::binary);
+            if (file) {
+                maps.emplace_back(module, std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+            }
+        }
+        fs_findClose(&context);
+        return maps;
+    }
+
+    static bool equal(const map_t& first, const map_t& second) {
+        if (first._mem.tiles.size() != second._mem.tiles.size() || first._mem.vertices.size() != second._mem.vertices.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < first._mem.tiles.size(); ++i) {
+            const auto& x = first._mem.tiles[i], &y = second._mem.tiles[i];
+            if (x.type != y.type || x.fx != y.fx || x.img != y.img || x.twist != y.twist) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < first._mem.vertices.size(); ++i) {
+            const auto& x = first._mem.vertices[i], &y = second._mem.vertices[i];
+            if (x.pos != y.pos || x.a != y.a) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    EgoTest_Test(benchmarkLoadTime) {
+        auto maps = theShippedMaps();
+        if (maps.empty()) {
+            std::mt19937 generator(13);
+            maps.emplace_back("generated", aMap(generator));
+        }
+
+        size_t bytes = 0;
+        double legacyTime = 0.0, time = 0.0;
+        for (const auto& map : maps) {
+            map_t legacy, loaded;
+            legacyTime += measure([&]() {
+                for (int i = 0; i < REPETITIONS; ++i) {
+                    std::istringstream is(map.second);
+                    EgoTest_Assert(LegacyReader::load(is, legacy));
+                }
+            });
+            time += measure([&]() {
+                for (int i = 0; i < REPETITIONS; ++i) {
+                    EgoTest_Assert(loaded.load(map.second.data(), map.second.size()));
+                }
+            });
+            bytes += map.second.size();
+
+            //Both decode the same
+            EgoTest_Assert(equal(legacy, loaded));
+
+            //A truncated file is rejected
+            EgoTest_Assert(!loaded.load(map.second.data(), map.second.size() - 1));
+            EgoTest_Assert(0 == loaded._mem.tiles.size());
+        }
+
+        const double megabytes = static_cast<double>(bytes) * REPETITIONS / (1024.0 * 1024.0);
+        std::cout << "MapLoadingBenchmark: " << maps.size() << " maps, " << bytes / 1024 << " KiB" << std::endl
+                  << "    field by field  " << legacyTime * 1e3 / REPETITIONS << " ms, " << megabytes / legacyTime << " MiB/s" << std::endl
+                  << "    from memory     " << time * 1e3 / REPETITIONS << " ms, " << megabytes / time << " MiB/s" << std::endl;
+    }
+};
+
+} // namespace Test
+} // namespace Ego
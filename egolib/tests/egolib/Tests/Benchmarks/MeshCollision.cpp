@@ -0,0 +1,186 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/MeshCollision.cpp
+/// @brief  Wall and elevation queries on a 256 x 256 mesh against the collision layer compared
+///         to the former queries against the tile infos.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Mesh/CollisionLayer.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MeshCollisionBenchmark) {
+    static const int SIZE = 256;            //< The size of the mesh in tiles
+    static const size_t QUERIES = 1000000;
+
+    /// A tile info as the game has it: the fields the physics needs among the rendering state.
+    struct TileInfo {
+        size_t itile;
+        uint8_t type;
+        uint16_t img;
+        size_t vrtstart;
+        bool fanoff;
+        float ncache[4][3];
+        char vertexLightingCache[40];
+        float oct[2][5];
+        bool octEmpty;
+        BIT_FIELD base_fx;
+        uint8_t twist;
+        BIT_FIELD pass_fx;
+        uint8_t a, l;
+        char cache[100];
+        int cache_frame;
+    };
+
+    /// The former queries, the heights are looked up in the vertex positions.
+    struct LegacyMesh {
+        std::vector<TileInfo> tiles;
+        std::vector<std::array<float, 3>> positions;
+
+        BIT_FIELD testWall(int xmin, int ymin, int xmax, int ymax, BIT_FIELD bits) const {
+            for (int iy = ymin; iy <= ymax; ++iy) {
+                for (int ix = xmin; ix <= xmax; ++ix) {
+                    BIT_FIELD pass = tiles[ix + iy * SIZE].pass_fx & bits;
+                    if (EMPTY_BIT_FIELD != pass) {
+                        return pass;
+                    }
+                }
+            }
+            return EMPTY_BIT_FIELD;
+        }
+
+        float getElevation(float x, float y) const {
+            const TileInfo& tile = tiles[static_cast<int>(x) / Info<int>::Grid::Size() + static_cast<int>(y) / Info<int>::Grid::Size() * SIZE];
+            float z0 = positions[tile.vrtstart + 0][2];
+            float z1 = positions[tile.vrtstart + 1][2];
+            float z2 = positions[tile.vrtstart + 2][2];
+            float z3 = positions[tile.vrtstart + 3][2];
+            const float px = static_cast<float>(static_cast<int>(x) % Info<int>::Grid::Size());
+            const float py = static_cast<float>(static_cast<int>(y) % Info<int>::Grid::Size());
+            float zleft = (z0 * (Info<float>::Grid::Size() - py) + z3 * py) / Info<float>::Grid::Size();
+            float zright = (z1 * (Info<float>::Grid::Size() - py) + z2 * py) / Info<float>::Grid::Size();
+            return (zleft * (Info<float>::Grid::Size() - px) + zright * px) / Info<float>::Grid::Size();
+        }
+    };
+
+    static BIT_FIELD testWall(const MeshCollisionLayer& layer, int xmin, int ymin, int xmax, int ymax, BIT_FIELD bits) {
+        for (int iy = ymin; iy <= ymax; ++iy) {
+            for (int ix = xmin; ix <= xmax; ++ix) {
+                BIT_FIELD pass = layer.getFX(ix + iy * layer.getWidth()) & bits;
+                if (EMPTY_BIT_FIELD != pass) {
+                    return pass;
+                }
+            }
+        }
+        return EMPTY_BIT_FIELD;
+    }
+
+    /// A mesh with a few walls, four vertices per tile.
+    static void aMesh(std::mt19937& generator, LegacyMesh& legacy, MeshCollisionLayer& layer) {
+        std::uniform_int_distribution<int> wall(0, 15);
+        std::uniform_real_distribution<float> height(0.0f, 256.0f);
+        legacy.tiles.resize(SIZE * SIZE);
+        legacy.positions.resize(SIZE * SIZE * 4);
+        layer.resize(SIZE, SIZE);
+        for (size_t i = 0; i < legacy.tiles.size(); ++i) {
+            TileInfo& tile = legacy.tiles[i];
+            tile.vrtstart = i * 4;
+            tile.pass_fx = 0 == wall(generator) ? (MAPFX_WALL | MAPFX_IMPASS) : 0;
+            std::array<float, 4> corners;
+            for (size_t j = 0; j < 4; ++j) {
+                corners[j] = legacy.positions[tile.vrtstart + j][2] = height(generator);
+            }
+            layer.setFX(i, tile.pass_fx);
+            layer.setCorners(i, corners);
+        }
+    }
+
+    EgoTest_Test(benchmarkQueries) {
+        std::mt19937 generator(17);
+        LegacyMesh legacy;
+        MeshCollisionLayer layer;
+        aMesh(generator, legacy, layer);
+
+        // Objects spread over the whole mesh, each one covering up to 3 x 3 tiles.
+        const float edge = SIZE * Info<float>::Grid::Size();
+        std::uniform_real_distribution<float> coordinate(Info<float>::Grid::Size(), edge - 2 * Info<float>::Grid::Size());
+        std::vector<std::array<float, 2>> positions(QUERIES);
+        for (auto& position : positions) {
+            position = { { coordinate(generator), coordinate(generator) } };
+        }
+        auto rect = [](const std::array<float, 2>& position, int i) {
+            return static_cast<int>(position[i % 2] / Info<float>::Grid::Size()) + (i < 2 ? -1 : 1);
+        };
+
+        size_t legacyWalls = 0, walls = 0;
+        float legacyElevation = 0.0f, elevation = 0.0f;
+        const double legacyWallTime = measure([&]() {
+            for (const auto& position : positions) {
+                legacyWalls += legacy.testWall(rect(position, 0), rect(position, 1), rect(position, 2), rect(position, 3), MAPFX_WALL) ? 1 : 0;
+            }
+        });
+        const double wallTime = measure([&]() {
+            for (const auto& position : positions) {
+                walls += testWall(layer, rect(position, 0), rect(position, 1), rect(position, 2), rect(position, 3), MAPFX_WALL) ? 1 : 0;
+            }
+        });
+        const double legacyElevationTime = measure([&]() {
+            for (const auto& position : positions) {
+                legacyElevation += legacy.getElevation(position[0], position[1]);
+            }
+        });
+        const double elevationTime = measure([&]() {
+            for (const auto& position : positions) {
+                const size_t i = static_cast<int>(position[0]) / Info<int>::Grid::Size() + static_cast<int>(position[1]) / Info<int>::Grid::Size() * SIZE;
+                elevation += layer.getElevation(i, position[0], position[1]);
+            }
+        });
+
+        //Both give the same answers
+        EgoTest_Assert(legacyWalls == walls);
+        EgoTest_Assert(legacyElevation == elevation);
+
+        std::cout << "MeshCollisionBenchmark: " << SIZE << " x " << SIZE << " tiles, " << QUERIES << " queries" << std::endl
+                  << "    tile infos       " << sizeof(TileInfo) << " bytes/tile, wall " << QUERIES / legacyWallTime << " queries/s, elevation " << QUERIES / legacyElevationTime << " queries/s" << std::endl
+                  << "    collision layer  " << sizeof(float) + sizeof(std::array<float, 4>) + 3 << " bytes/tile, wall " << QUERIES / wallTime << " queries/s, elevation " << QUERIES / elevationTime << " queries/s" << std::endl;
+    }
+
+    EgoTest_Test(testElevation) {
+        MeshCollisionLayer layer;
+        layer.resize(2, 1);
+        layer.setCorners(1, { { 0.0f, 128.0f, 256.0f, 64.0f } });
+        EgoTest_Assert(256.0f == layer.getMaxElevation(1));
+
+        //The corners and the center of the tile
+        const float x = Info<float>::Grid::Size();
+        EgoTest_Assert(0.0f == layer.getElevation(1, x, 0.0f));
+        EgoTest_Assert(112.0f == layer.getElevation(1, x + 64.0f, 64.0f));
+
+        //The tiles are initially flat
+        EgoTest_Assert(0.0f == layer.getElevation(0, 64.0f, 64.0f));
+        EgoTest_Assert(TWIST_FLAT == layer.getTwist(0));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,120 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/MeshCullingTree.cpp
+/// @brief  Culling the tiles of large meshes against the view frustum at various camera angles
+///         with the culling tree compared to culling every tile on its own.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Mesh/CullingTree.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MeshCullingTreeBenchmark) {
+    static const size_t FRAMES = 100;
+    static const size_t CAPACITY = 1024;    //< The capacity of a tile render list
+
+    struct View {
+        const char *name;
+        Vector3f eye, center;
+    };
+
+    static Ego::Graphics::Frustum aFrustum(const View& view) {
+        struct Frustum : public Ego::Graphics::Frustum {
+            Frustum(const View& view) {
+                calculate(Ego::Math::Transform::perspective(Ego::Math::Degrees(60.0f), 4.0f / 3.0f, 1.0f, 1000000.0f),
+                          Ego::Math::Transform::lookAt(view.eye, view.center, Vector3f(0.0f, 0.0f, 1.0f)));
+            }
+        };
+        return Frustum(view);
+    }
+
+    /// A hilly mesh with walls.
+    static void aMesh(std::mt19937& generator, int size, Ego::MeshCullingTree& tree) {
+        std::uniform_int_distribution<int> wall(0, 15);
+        std::uniform_real_distribution<float> height(0.0f, 128.0f);
+        const float tileSize = Info<float>::Grid::Size();
+        tree.resize(size, size);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const float z0 = 256.0f * std::sin(x * 0.05f) * std::cos(y * 0.07f) + height(generator);
+                const float z1 = z0 + (0 == wall(generator) ? 512.0f : height(generator));
+                tree.setTileBounds(x + y * size, AxisAlignedBox3f(Point3f(x * tileSize, y * tileSize, z0),
+                                                                   Point3f((x + 1) * tileSize, (y + 1) * tileSize, z1)));
+            }
+        }
+        tree.update();
+    }
+
+    EgoTest_Test(benchmarkCulling) {
+        std::mt19937 generator(17);
+        for (int size : { 128, 256, 512 }) {
+            Ego::MeshCullingTree tree;
+            aMesh(generator, size, tree);
+            const float middle = size * Info<float>::Grid::Size() * 0.5f;
+            const View views[] = {
+                { "default", Vector3f(middle, middle - 1000.0f, 1500.0f), Vector3f(middle, middle, 0.0f) },
+                { "zoomed out", Vector3f(middle, middle - 3000.0f, 4500.0f), Vector3f(middle, middle, 0.0f) },
+                { "top down", Vector3f(middle, middle - 10.0f, 8000.0f), Vector3f(middle, middle, 0.0f) },
+                { "horizon", Vector3f(middle, middle, 400.0f), Vector3f(middle + 3000.0f, middle + 3000.0f, 0.0f) },
+            };
+            std::cout << "MeshCullingTreeBenchmark: " << size << " x " << size << " tiles, " << tree.getNodeCount() << " nodes, " << FRAMES << " frames" << std::endl;
+            for (const auto& view : views) {
+                const auto frustum = aFrustum(view);
+                const Point3f viewpoint = Point3f::toPoint(view.eye);
+                std::vector<size_t> legacyTiles, tiles, cappedTiles;
+                const double legacyTime = measure([&]() {
+                    for (size_t frame = 0; frame < FRAMES; ++frame) {
+                        legacyTiles.clear();
+                        for (size_t i = 0; i < tree.getTileCount(); ++i) {
+                            if (Ego::Math::Relation::outside != frustum.intersects(tree.getTileBounds(i), false)) {
+                                legacyTiles.push_back(i);
+                            }
+                        }
+                    }
+                });
+                const double time = measure([&]() {
+                    for (size_t frame = 0; frame < FRAMES; ++frame) {
+                        tree.cull(frustum, viewpoint, tree.getTileCount(), tiles);
+                    }
+                });
+                const double cappedTime = measure([&]() {
+                    for (size_t frame = 0; frame < FRAMES; ++frame) {
+                        tree.cull(frustum, viewpoint, CAPACITY, cappedTiles);
+                    }
+                });
+
+                //Both give the same tiles
+                std::sort(tiles.begin(), tiles.end());
+                EgoTest_Assert(legacyTiles == tiles);
+
+                std::cout << "    " << view.name << ": " << tiles.size() << " visible tiles" << std::endl
+                          << "        each tile        " << FRAMES / legacyTime << " frames/s" << std::endl
+                          << "        culling tree     " << FRAMES / time << " frames/s" << std::endl
+                          << "        up to " << CAPACITY << " tiles " << FRAMES / cappedTime << " frames/s" << std::endl;
+            }
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
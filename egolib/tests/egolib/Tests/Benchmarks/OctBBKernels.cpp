@@ -0,0 +1,253 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/OctBBKernels.cpp
+/// @brief  The narrow phase of the collision detection of moving octagonal bounding boxes with
+///         each supported kernel compared to the former one axis at a time code, and the test of
+///         one bounding box against many with a batch call compared to one call per bounding box.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/OctBBKernels.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(OctBBKernelsBenchmark) {
+    static const int REPETITIONS = 20;
+    static const size_t PAIRS = 4096;
+
+    /// A moving bounding box, about the size of a character.
+    struct Body {
+        oct_bb_t box;
+        Vector3f vel;
+    };
+
+    /// The result of the narrow phase of a pair.
+    struct Hit {
+        unsigned axes;
+        float tmin, tmax;
+        bool overlap;
+        oct_vec_v2_t odepth;
+    };
+
+    /// The former intersection, one axis at a time.
+    static oct_bb_t legacyIntersection(const oct_bb_t& src1, const oct_bb_t& src2) {
+        if (src1._empty && src2._empty) {
+            return oct_bb_t();
+        }
+        oct_bb_t dst;
+        for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
+            dst._mins[i] = std::max(src1._mins[i], src2._mins[i]);
+            dst._maxs[i] = std::min(src1._maxs[i], src2._maxs[i]);
+        }
+        dst._empty = oct_bb_t::empty_raw(dst);
+        return dst;
+    }
+
+    /// The former phys_expand_oct_bb.
+    static void legacyExpand(const oct_bb_t& src, const Vector3f& vel, const float tmin, const float tmax, oct_bb_t& dst) {
+        if (0.0f == vel.length_abs()) {
+            dst = src;
+            return;
+        }
+        oct_bb_t tmp_min = (0.0f == tmin) ? src : oct_bb_t::translate(src, vel * tmin);
+        oct_bb_t tmp_max = (0.0f == tmax) ? src : oct_bb_t::translate(src, vel * tmax);
+        for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
+            dst._mins[i] = std::min(tmp_min._mins[i], tmp_max._mins[i]);
+            dst._maxs[i] = std::max(tmp_min._maxs[i], tmp_max._maxs[i]);
+        }
+        dst._empty = oct_bb_t::empty_raw(dst);
+    }
+
+    /// The former phys_get_collision_depth.
+    static bool legacyDepth(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+        odepth = oct_vec_v2_t();
+        if (bb_a._empty || bb_b._empty) return false;
+        oct_bb_t otmp = legacyIntersection(bb_a, bb_b);
+        if (otmp.isEmpty()) return false;
+        oct_vec_v2_t opos_a = bb_a.getMid();
+        oct_vec_v2_t opos_b = bb_b.getMid();
+        bool retval = true;
+        for (size_t i = 0; i < OCT_COUNT; ++i) {
+            float fdiff = opos_b[i] - opos_a[i];
+            float fdepth = otmp._maxs[i] - otmp._mins[i];
+            if (fdepth <= 0.0f || 0.0f == fdiff) retval = false;
+            odepth[i] = (fdiff < 0.0f) ? -fdepth : fdepth;
+        }
+        odepth[OCT_XY] *= Ego::Math::invSqrtTwo<float>();
+        odepth[OCT_YX] *= Ego::Math::invSqrtTwo<float>();
+        return retval;
+    }
+
+    /// The former phys_intersect_oct_bb_index if neither bounding box is a platform.
+    static bool legacyIndex(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, float *tmin, float *tmax) {
+        if (index < 0 || index >= OCT_COUNT) {
+            throw std::invalid_argument("index out of range");
+        }
+        float vdiff = ovel2[index] - ovel1[index];
+        if (0.0f == vdiff) return false;
+        float time[4];
+        time[0] = (src1._mins[index] - src2._mins[index]) / vdiff;
+        time[1] = (src1._mins[index] - src2._maxs[index]) / vdiff;
+        time[2] = (src1._maxs[index] - src2._mins[index]) / vdiff;
+        time[3] = (src1._maxs[index] - src2._maxs[index]) / vdiff;
+        *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
+        *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
+        if (OCT_XY == index || OCT_YX == index) {
+            *tmin *= Ego::Math::invSqrtTwo<float>();
+            *tmax *= Ego::Math::invSqrtTwo<float>();
+        }
+        return !(*tmax <= *tmin);
+    }
+
+    /// The time range of the overlap of two bodies, as phys_intersect_oct_bb combines the axes.
+    static void combine(const Hit& hit, const oct_vec_v2_t& tmins, const oct_vec_v2_t& tmaxs, float& tmin, float& tmax) {
+        tmin = 0.0f;
+        tmax = 1.0f;
+        for (size_t index = 0; index < OCT_COUNT; ++index) {
+            if (HAS_SOME_BITS(hit.axes, 1u << index)) {
+                tmin = std::max(tmin, tmins[index]);
+                tmax = std::min(tmax, tmaxs[index]);
+            }
+        }
+    }
+
+    static void legacyNarrowPhase(const Body& a, const Body& b, Hit& hit) {
+        const oct_vec_v2_t ovel1(a.vel), ovel2(b.vel);
+        oct_vec_v2_t tmins, tmaxs;
+        hit.axes = 0;
+        for (int index = 0; index < OCT_COUNT; ++index) {
+            if (legacyIndex(index, a.box, ovel1, b.box, ovel2, &tmins[index], &tmaxs[index])) {
+                hit.axes |= 1u << index;
+            }
+        }
+        combine(hit, tmins, tmaxs, hit.tmin, hit.tmax);
+        oct_bb_t exp1, exp2;
+        legacyExpand(a.box, a.vel, hit.tmin, hit.tmax, exp1);
+        legacyExpand(b.box, b.vel, hit.tmin, hit.tmax, exp2);
+        hit.overlap = !legacyIntersection(exp1, exp2).isEmpty();
+        legacyDepth(exp1, exp2, hit.odepth);
+    }
+
+    static void narrowPhase(OctBBKernels::Kernel kernel, const Body& a, const Body& b, Hit& hit) {
+        const oct_vec_v2_t ovel1(a.vel), ovel2(b.vel);
+        oct_vec_v2_t tmins, tmaxs;
+        hit.axes = OctBBKernels::sweep(kernel, a.box, ovel1, b.box, ovel2, false, false, 0.0f, tmins, tmaxs);
+        combine(hit, tmins, tmaxs, hit.tmin, hit.tmax);
+        oct_bb_t exp1, exp2;
+        OctBBKernels::expand(kernel, a.box, a.vel, hit.tmin, hit.tmax, exp1);
+        OctBBKernels::expand(kernel, b.box, b.vel, hit.tmin, hit.tmax, exp2);
+        hit.overlap = !OctBBKernels::intersection(kernel, exp1, exp2).isEmpty();
+        OctBBKernels::getCollisionDepth(kernel, exp1, exp2, hit.odepth);
+    }
+
+    static bool same(const Hit& x, const Hit& y) {
+        if (x.axes != y.axes || x.tmin != y.tmin || x.tmax != y.tmax || x.overlap != y.overlap) return false;
+        for (size_t i = 0; i < OCT_COUNT; ++i) {
+            if (x.odepth[i] != y.odepth[i]) return false;
+        }
+        return true;
+    }
+
+    static Body aBody(std::mt19937& generator) {
+        std::uniform_real_distribution<float> position(0.0f, 256.0f), size(16.0f, 48.0f), height(32.0f, 96.0f), speed(-16.0f, 16.0f);
+        const float s = size(generator), h = height(generator);
+        bumper_t bumper;
+        bumper.size = s;
+        bumper.size_big = s * 1.4f;
+        bumper.height = h;
+        Body body;
+        body.box = oct_bb_t::translate(oct_bb_t(bumper), Vector3f(position(generator), position(generator), position(generator) * 0.25f));
+        body.vel = Vector3f(speed(generator), speed(generator), speed(generator) * 0.25f);
+        return body;
+    }
+
+    EgoTest_Test(benchmarkNarrowPhase) {
+        std::mt19937 generator(71);
+        std::vector<Body> first, second;
+        for (size_t i = 0; i < PAIRS; ++i) {
+            first.push_back(aBody(generator));
+            second.push_back(aBody(generator));
+        }
+
+        static const std::array<OctBBKernels::Kernel, 3> kernels = { { OctBBKernels::Kernel::Scalar, OctBBKernels::Kernel::SSE2, OctBBKernels::Kernel::AVX } };
+        static const std::array<const char *, 3> names = { { "scalar", "SSE2  ", "AVX   " } };
+        std::vector<Hit> expected(PAIRS), actual(PAIRS);
+        const double legacyTime = measure([&]() {
+            for (int i = 0; i < REPETITIONS; ++i) {
+                for (size_t j = 0; j < PAIRS; ++j) {
+                    legacyNarrowPhase(first[j], second[j], expected[j]);
+                }
+            }
+        });
+        std::cout << "OctBBKernelsBenchmark: " << PAIRS << " moving pairs" << std::endl
+                  << "    per axis    " << PAIRS * REPETITIONS / legacyTime / 1e6 << " M pairs/s" << std::endl;
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            if (!OctBBKernels::isSupported(kernels[k])) {
+                continue;
+            }
+            const double time = measure([&]() {
+                for (int i = 0; i < REPETITIONS; ++i) {
+                    for (size_t j = 0; j < PAIRS; ++j) {
+                        narrowPhase(kernels[k], first[j], second[j], actual[j]);
+                    }
+                }
+            });
+            //Both give the same hits
+            for (size_t j = 0; j < PAIRS; ++j) {
+                EgoTest_Assert(same(expected[j], actual[j]));
+            }
+            std::cout << "    " << names[k] << "      " << PAIRS * REPETITIONS / time / 1e6 << " M pairs/s" << std::endl;
+        }
+    }
+
+    EgoTest_Test(benchmarkOneAgainstMany) {
+        std::mt19937 generator(73);
+        std::vector<oct_bb_t> boxes;
+        for (size_t i = 0; i < PAIRS; ++i) {
+            boxes.push_back(aBody(generator).box);
+        }
+        const oct_bb_t box = aBody(generator).box;
+
+        std::unique_ptr<bool[]> expected(new bool[PAIRS]), actual(new bool[PAIRS]);
+        const double legacyTime = measure([&]() {
+            for (int i = 0; i < REPETITIONS; ++i) {
+                for (size_t j = 0; j < PAIRS; ++j) {
+                    expected[j] = !legacyIntersection(box, boxes[j]).isEmpty();
+                }
+            }
+        });
+        const double batchTime = measure([&]() {
+            for (int i = 0; i < REPETITIONS; ++i) {
+                OctBBKernels::overlaps(box, boxes.data(), PAIRS, actual.get());
+            }
+        });
+        //Both find the same boxes
+        EgoTest_Assert(0 == memcmp(expected.get(), actual.get(), PAIRS * sizeof(bool)));
+
+        std::cout << "OctBBKernelsBenchmark: one against " << PAIRS << " bounding boxes" << std::endl
+                  << "    one call per box " << legacyTime / REPETITIONS * 1e6 << " us, "
+                  << "batch " << batchTime / REPETITIONS * 1e6 << " us" << std::endl;
+    }
+};
+
+} // namespace Test
+} // namespace Ego
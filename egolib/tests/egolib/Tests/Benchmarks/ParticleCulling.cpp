@@ -0,0 +1,95 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/ParticleCulling.cpp
+/// @brief  Culling clustered particles against the view frustum in bins compared to
+///         testing the spheres of every particle, as the entity list did.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Graphics/ParticleCulling.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(ParticleCullingBenchmark) {
+    static const size_t FRAMES = 200;
+
+    struct Frustum : public Ego::Graphics::Frustum {
+        Frustum(const Vector3f& eye, const Vector3f& center) {
+            calculate(Ego::Math::Transform::perspective(Ego::Math::Degrees(60.0f), 4.0f / 3.0f, 1.0f, 1000000.0f),
+                      Ego::Math::Transform::lookAt(eye, center, Vector3f(0.0f, 0.0f, 1.0f)));
+        }
+    };
+
+    EgoTest_Test(benchmarkCulling) {
+        std::mt19937 generator(5);
+        // Particles in clouds around emitters spread over a 256 x 256 tile mesh.
+        std::uniform_real_distribution<float> emitter(0.0f, 256.0f * 128.0f), offset(-256.0f, 256.0f), elevation(0.0f, 256.0f);
+        // The camera looks at the middle of the mesh.
+        const Vector3f eye(16384.0f, 15384.0f, 1500.0f);
+        const Frustum frustum(eye, Vector3f(16384.0f, 16384.0f, 0.0f));
+        for (size_t count : { 512, 2048, 8192 }) {
+            std::vector<Sphere3f> spheres, reflectedSpheres;
+            while (spheres.size() < count) {
+                const float x = emitter(generator), y = emitter(generator);
+                for (size_t i = 0; i < 64; ++i) {
+                    const Point3f center(x + offset(generator), y + offset(generator), elevation(generator));
+                    spheres.push_back(Sphere3f(center, 16.0f));
+                    reflectedSpheres.push_back(Sphere3f(Point3f(center[kX], center[kY], -center[kZ]), 16.0f));
+                }
+            }
+            size_t legacyVisible = 0;
+            const double legacyTime = measure([&]() {
+                for (size_t frame = 0; frame < FRAMES; ++frame) {
+                    legacyVisible = 0;
+                    for (size_t i = 0; i < spheres.size(); ++i) {
+                        if (Ego::Math::Relation::outside != frustum.intersects(spheres[i], false) ||
+                            Ego::Math::Relation::outside != frustum.intersects(reflectedSpheres[i], false)) {
+                            legacyVisible++;
+                        }
+                    }
+                }
+            });
+            Ego::Graphics::ParticleCulling culling;
+            culling.setDistances(1.0e6f, 1.0e6f);
+            std::vector<Ego::Graphics::ParticleCulling::Visible> visible;
+            // The spheres are collected in every frame anyway, only the culling is measured.
+            for (size_t i = 0; i < spheres.size(); ++i) {
+                culling.add(i, spheres[i], reflectedSpheres[i], false);
+            }
+            const double time = measure([&]() {
+                for (size_t frame = 0; frame < FRAMES; ++frame) {
+                    culling.cull(frustum, Point3f::toPoint(eye), spheres.size(), visible);
+                }
+            });
+
+            //Both find the same particles
+            EgoTest_Assert(legacyVisible == visible.size());
+
+            std::cout << "ParticleCullingBenchmark: " << spheres.size() << " particles, " << visible.size() << " visible, " << FRAMES << " frames" << std::endl
+                      << "    each particle  " << FRAMES / legacyTime << " frames/s" << std::endl
+                      << "    binned         " << FRAMES / time << " frames/s" << std::endl;
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
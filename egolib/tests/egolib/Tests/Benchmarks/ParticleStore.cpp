@@ -0,0 +1,356 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/ParticleStore.cpp
+/// @brief  The gravity, integration and lifetime decay of a full particle pool, one particle object
+///         at a time as the game does it compared to a structure of arrays with scalar, SSE2 and AVX
+///         loops. The structure of arrays is measured owning the fields and with the fields copied
+///         in from the particle objects and back in every update.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define EGO_PRT_X86 1
+    #define EGO_PRT_TARGET(TARGET) __attribute__((target(TARGET)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define EGO_PRT_X86 1
+    #define EGO_PRT_TARGET(TARGET)
+    #include <intrin.h>
+    #include <immintrin.h>
+#else
+    #define EGO_PRT_X86 0
+#endif
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+enum class Kernel {
+    Scalar,
+    SSE2,
+    AVX,
+};
+
+/// The fields of the particles one array per field, indexed by slot.
+struct ParticleStore {
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> velocityX, velocityY, velocityZ;
+    std::vector<float> falls;           ///< 1 if gravity accelerates the particle, 0 otherwise
+    std::vector<int32_t> lifetimes;     ///< The remaining lifetimes, negative for eternal particles
+    std::vector<int32_t> ageing;        ///< -1 if the particle ages in this update, 0 otherwise
+    std::vector<size_t> expired;        ///< The ageing particles without lifetime left
+
+    explicit ParticleStore(size_t capacity) :
+        positionX(capacity), positionY(capacity), positionZ(capacity),
+        velocityX(capacity), velocityY(capacity), velocityZ(capacity),
+        falls(capacity), lifetimes(capacity), ageing(capacity), expired() {
+        expired.reserve(capacity);
+    }
+
+    void setMotion(size_t slot, const Vector3f& position, const Vector3f& velocity, bool fall) {
+        positionX[slot] = position.x();
+        positionY[slot] = position.y();
+        positionZ[slot] = position.z();
+        velocityX[slot] = velocity.x();
+        velocityY[slot] = velocity.y();
+        velocityZ[slot] = velocity.z();
+        falls[slot] = fall ? 1.0f : 0.0f;
+    }
+
+    void age(size_t slot) {
+        ageing[slot] = (lifetimes[slot] < 0) ? 0 : -1;
+    }
+};
+
+void integrateScalar(ParticleStore& store, size_t begin, float gravity) {
+    for (size_t i = begin, n = store.falls.size(); i < n; ++i) {
+        store.velocityZ[i] += store.falls[i] * gravity;
+        store.positionX[i] += store.velocityX[i];
+        store.positionY[i] += store.velocityY[i];
+        store.positionZ[i] += store.velocityZ[i];
+    }
+}
+
+void decayScalar(ParticleStore& store, size_t begin) {
+    for (size_t i = begin, n = store.lifetimes.size(); i < n; ++i) {
+        if (0 == store.ageing[i]) {
+            continue;
+        }
+        if (store.lifetimes[i] > 0) {
+            store.lifetimes[i]--;
+        } else {
+            store.expired.push_back(i);
+        }
+        store.ageing[i] = 0;
+    }
+}
+
+#if EGO_PRT_X86
+
+bool cpuSupportsSSE2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return 0 != (info[3] & (1 << 26));
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuSupportsAVX() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    // The operating system must save the AVX registers.
+    const bool osxsave = 0 != (info[2] & (1 << 27)), avx = 0 != (info[2] & (1 << 28));
+    return osxsave && avx && 6 == (_xgetbv(0) & 6);
+#else
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx");
+#endif
+}
+
+EGO_PRT_TARGET("sse2")
+void integrateSSE2(ParticleStore& store, float gravity) {
+    const __m128 g = _mm_set1_ps(gravity);
+    size_t i = 0;
+    for (const size_t n = store.falls.size(); i + 4 <= n; i += 4) {
+        const __m128 velocityZ = _mm_add_ps(_mm_loadu_ps(&store.velocityZ[i]), _mm_mul_ps(_mm_loadu_ps(&store.falls[i]), g));
+        _mm_storeu_ps(&store.velocityZ[i], velocityZ);
+        _mm_storeu_ps(&store.positionX[i], _mm_add_ps(_mm_loadu_ps(&store.positionX[i]), _mm_loadu_ps(&store.velocityX[i])));
+        _mm_storeu_ps(&store.positionY[i], _mm_add_ps(_mm_loadu_ps(&store.positionY[i]), _mm_loadu_ps(&store.velocityY[i])));
+        _mm_storeu_ps(&store.positionZ[i], _mm_add_ps(_mm_loadu_ps(&store.positionZ[i]), velocityZ));
+    }
+    integrateScalar(store, i, gravity);
+}
+
+EGO_PRT_TARGET("avx")
+void integrateAVX(ParticleStore& store, float gravity) {
+    const __m256 g = _mm256_set1_ps(gravity);
+    size_t i = 0;
+    for (const size_t n = store.falls.size(); i + 8 <= n; i += 8) {
+        const __m256 velocityZ = _mm256_add_ps(_mm256_loadu_ps(&store.velocityZ[i]), _mm256_mul_ps(_mm256_loadu_ps(&store.falls[i]), g));
+        _mm256_storeu_ps(&store.velocityZ[i], velocityZ);
+        _mm256_storeu_ps(&store.positionX[i], _mm256_add_ps(_mm256_loadu_ps(&store.positionX[i]), _mm256_loadu_ps(&store.velocityX[i])));
+        _mm256_storeu_ps(&store.positionY[i], _mm256_add_ps(_mm256_loadu_ps(&store.positionY[i]), _mm256_loadu_ps(&store.velocityY[i])));
+        _mm256_storeu_ps(&store.positionZ[i], _mm256_add_ps(_mm256_loadu_ps(&store.positionZ[i]), velocityZ));
+    }
+    integrateScalar(store, i, gravity);
+}
+
+/// Integer operations on eight lanes need AVX2, the AVX kernel decays with SSE2 as well.
+EGO_PRT_TARGET("sse2")
+void decaySSE2(ParticleStore& store) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (const size_t n = store.lifetimes.size(); i + 4 <= n; i += 4) {
+        __m128i *lifetimes = reinterpret_cast<__m128i *>(&store.lifetimes[i]), *ageing = reinterpret_cast<__m128i *>(&store.ageing[i]);
+        const __m128i lifetime = _mm_loadu_si128(lifetimes), ages = _mm_loadu_si128(ageing);
+        const __m128i alive = _mm_cmpgt_epi32(lifetime, zero);
+        // Adding -1 counts down the ageing lanes with lifetime left.
+        _mm_storeu_si128(lifetimes, _mm_add_epi32(lifetime, _mm_and_si128(ages, alive)));
+        _mm_storeu_si128(ageing, zero);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(alive, ages)));
+        for (size_t j = i; 0 != mask; ++j, mask >>= 1) {
+            if (0 != (mask & 1)) {
+                store.expired.push_back(j);
+            }
+        }
+    }
+    decayScalar(store, i);
+}
+
+#endif
+
+bool isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if EGO_PRT_X86
+        case Kernel::SSE2:
+            return cpuSupportsSSE2();
+        case Kernel::AVX:
+            return cpuSupportsAVX();
+#endif
+        default:
+            return false;
+    }
+}
+
+/// Apply the gravity, move the particles and count down their lifetimes.
+const std::vector<size_t>& update(Kernel kernel, ParticleStore& store, float gravity) {
+    store.expired.clear();
+    switch (kernel) {
+#if EGO_PRT_X86
+        case Kernel::AVX:
+            integrateAVX(store, gravity);
+            decaySSE2(store);
+            break;
+        case Kernel::SSE2:
+            integrateSSE2(store, gravity);
+            decaySSE2(store);
+            break;
+#endif
+        default:
+            integrateScalar(store, 0, gravity);
+            decayScalar(store, 0);
+            break;
+    }
+    return store.expired;
+}
+
+} // anonymous namespace
+
+EgoTest_TestCase(ParticleStoreBenchmark) {
+    static const int REPETITIONS = 1000;
+    /// PARTICLES_MAX, the pool is full.
+    static const size_t PARTICLES = 2048;
+
+    /// A particle object with other fields in between the updated ones, about the size of Ego::Particle.
+    struct LegacyParticle {
+        Vector3f position;
+        char other[512];
+        Vector3f velocity;
+        bool falls;
+        char more[256];
+        bool eternal;
+        bool terminated;
+        size_t lifetime;
+    };
+
+    EgoTest_Test(benchmarkUpdate) {
+        std::mt19937 generator(31);
+        std::uniform_real_distribution<float> coordinate(0.0f, 4000.0f), speed(-8.0f, 8.0f);
+        std::uniform_int_distribution<int32_t> lifetime(REPETITIONS / 2, REPETITIONS * 2);
+        std::vector<LegacyParticle> initial(PARTICLES);
+        for (size_t i = 0; i < PARTICLES; ++i) {
+            initial[i].position = Vector3f(coordinate(generator), coordinate(generator), coordinate(generator));
+            initial[i].velocity = Vector3f(speed(generator), speed(generator), speed(generator));
+            initial[i].falls = (0 != i % 4);
+            initial[i].eternal = (0 == i % 8);
+            initial[i].terminated = false;
+            initial[i].lifetime = lifetime(generator);
+        }
+        // One allocation per particle as the particle handler does it.
+        std::vector<std::shared_ptr<LegacyParticle>> particles;
+        for (size_t i = 0; i < PARTICLES; ++i) {
+            particles.push_back(std::make_shared<LegacyParticle>(initial[i]));
+        }
+        auto aStore = [&]() {
+            ParticleStore store(PARTICLES);
+            for (size_t i = 0; i < PARTICLES; ++i) {
+                store.setMotion(i, initial[i].position, initial[i].velocity, initial[i].falls);
+                store.lifetimes[i] = initial[i].eternal ? -1 : int32_t(initial[i].lifetime);
+            }
+            return store;
+        };
+        const float gravity = -1.0f * 0.9868f;
+
+        // As Particle::update() and ParticlePhysics::updatePhysics() do it.
+        const double legacyTime = measure([&]() {
+            for (int i = 0; i < REPETITIONS; ++i) {
+                for (const auto& particle : particles) {
+                    if (particle->falls) {
+                        particle->velocity.z() += gravity;
+                    }
+                    particle->position += particle->velocity;
+                    if (particle->eternal) continue;
+                    if (particle->lifetime > 0) {
+                        particle->lifetime--;
+                    } else {
+                        particle->terminated = true;
+                    }
+                }
+            }
+        });
+        std::vector<LegacyParticle> expected;
+        for (const auto& particle : particles) {
+            expected.push_back(*particle);
+        }
+
+        static const std::array<Kernel, 3> kernels = { { Kernel::Scalar, Kernel::SSE2, Kernel::AVX } };
+        static const std::array<const char *, 3> names = { { "scalar", "SSE2  ", "AVX   " } };
+        std::cout << "ParticleStoreBenchmark: " << PARTICLES << " particles, " << REPETITIONS << " updates" << std::endl
+                  << "    per object                  " << legacyTime / REPETITIONS * 1e6 << " us/update" << std::endl;
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            if (!isSupported(kernels[k])) {
+                continue;
+            }
+
+            // The store owns the fields.
+            ParticleStore owning = aStore();
+            std::vector<bool> terminated(PARTICLES, false);
+            const double owningTime = measure([&]() {
+                for (int i = 0; i < REPETITIONS; ++i) {
+                    for (size_t j = 0; j < PARTICLES; ++j) {
+                        owning.age(j);
+                    }
+                    for (size_t slot : update(kernels[k], owning, gravity)) {
+                        terminated[slot] = true;
+                    }
+                }
+            });
+
+            // The particle objects own the fields, they are copied into the store and back.
+            for (size_t i = 0; i < PARTICLES; ++i) {
+                *particles[i] = initial[i];
+            }
+            ParticleStore copying = aStore();
+            const double copyingTime = measure([&]() {
+                for (int i = 0; i < REPETITIONS; ++i) {
+                    for (size_t j = 0; j < PARTICLES; ++j) {
+                        const LegacyParticle& particle = *particles[j];
+                        copying.setMotion(j, particle.position, particle.velocity, particle.falls);
+                        copying.age(j);
+                    }
+                    const std::vector<size_t>& expired = update(kernels[k], copying, gravity);
+                    for (size_t j = 0; j < PARTICLES; ++j) {
+                        LegacyParticle& particle = *particles[j];
+                        particle.position = Vector3f(copying.positionX[j], copying.positionY[j], copying.positionZ[j]);
+                        particle.velocity = Vector3f(copying.velocityX[j], copying.velocityY[j], copying.velocityZ[j]);
+                    }
+                    for (size_t slot : expired) {
+                        particles[slot]->terminated = true;
+                    }
+                }
+            });
+
+            //All give the same particles
+            for (size_t i = 0; i < PARTICLES; ++i) {
+                EgoTest_Assert(Vector3f(owning.positionX[i], owning.positionY[i], owning.positionZ[i]) == expected[i].position);
+                EgoTest_Assert(terminated[i] == expected[i].terminated);
+                EgoTest_Assert(particles[i]->position == expected[i].position);
+                EgoTest_Assert(particles[i]->velocity == expected[i].velocity);
+                EgoTest_Assert(particles[i]->terminated == expected[i].terminated);
+                EgoTest_Assert(expected[i].eternal || int32_t(expected[i].lifetime) == copying.lifetimes[i]);
+            }
+
+            std::cout << "    " << names[k] << " owning the fields   " << owningTime / REPETITIONS * 1e6 << " us/update" << std::endl
+                      << "    " << names[k] << " copying the fields  " << copyingTime / REPETITIONS * 1e6 << " us/update" << std::endl;
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
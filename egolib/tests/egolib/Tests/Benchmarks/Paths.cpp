@@ -0,0 +1,140 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/Paths.cpp
+/// @brief  Queries per second and success rate of the path finder compared to the former
+///         A* implementation (a shared node per explored tile, at most 512 tiles explored).
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/AI/PathFinder.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(PathFindingBenchmark) {
+    static const int SIZE = 128;            //< The size of the mesh in tiles
+    static const size_t QUERIES = 2000;
+
+    /// The former A* implementation.
+    struct LegacyAStar {
+        struct Node {
+            Node(int x, int y, float weight, const std::shared_ptr<Node>& parent) : weight(weight), ix(x), iy(y), parent(parent) {}
+            float weight;
+            int ix, iy;
+            std::shared_ptr<Node> parent;
+        };
+
+        static float distance(int sx, int sy, int tx, int ty) {
+            return std::sqrt(static_cast<float>((tx - sx) * (tx - sx) + (ty - sy) * (ty - sy)));
+        }
+
+        static bool find(const Ego::AI::PathGraph& graph, int sx, int sy, int tx, int ty) {
+            static const int OFFSETS[4][2] = { { -1, 0 }, { 0, -1 }, { 1, 0 }, { 0, 1 } };
+            auto comparator = [](const std::shared_ptr<Node>& first, const std::shared_ptr<Node>& second) {
+                return first->weight < second->weight;
+            };
+            std::unordered_set<int> closedNodes;
+            std::priority_queue<std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>, decltype(comparator)> openNodes(comparator);
+            openNodes.push(std::make_shared<Node>(sx, sy, distance(sx, sy, tx, ty), nullptr));
+            while (!openNodes.empty()) {
+                if (closedNodes.size() >= 512) {
+                    break;
+                }
+                std::shared_ptr<Node> current = openNodes.top();
+                openNodes.pop();
+                for (const auto& offset : OFFSETS) {
+                    const int x = current->ix + offset[0], y = current->iy + offset[1];
+                    if (closedNodes.find(x | y << 16) != closedNodes.end()) {
+                        continue;
+                    }
+                    closedNodes.insert(x | y << 16);
+                    if (x == tx && y == ty) {
+                        return true;
+                    }
+                    if (!graph.isPassable(x, y)) {
+                        continue;
+                    }
+                    openNodes.push(std::make_shared<Node>(x, y, distance(x, y, current->ix, current->iy) + distance(x, y, tx, ty), current));
+                }
+            }
+            return false;
+        }
+    };
+
+    /// Rooms of 10 x 10 tiles with a few doors each.
+    static std::shared_ptr<Ego::AI::PathGraph> aMesh(std::mt19937& generator) {
+        std::uniform_int_distribution<int> door(0, 5);
+        std::vector<uint8_t> passable(SIZE * SIZE, 1);
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                if ((0 == x % 10 || 0 == y % 10) && 0 != door(generator)) {
+                    passable[y * SIZE + x] = 0;
+                }
+            }
+        }
+        return std::make_shared<Ego::AI::PathGraph>(SIZE, SIZE, passable);
+    }
+
+    EgoTest_Test(benchmarkQueriesPerSecond) {
+        std::mt19937 generator(11);
+        std::shared_ptr<Ego::AI::PathGraph> graph;
+        const double buildTime = measure([&]() { graph = aMesh(generator); });
+
+        // Short queries as in a fight, long queries as when walking to the other end of a level.
+        for (int range : { 12, SIZE }) {
+            std::uniform_int_distribution<int> coordinate(0, SIZE - 1), offset(-range, range);
+            std::vector<std::array<int, 4>> queries;
+            while (queries.size() < QUERIES) {
+                const int sx = coordinate(generator), sy = coordinate(generator);
+                const int tx = Ego::Math::constrain(sx + offset(generator), 0, SIZE - 1);
+                const int ty = Ego::Math::constrain(sy + offset(generator), 0, SIZE - 1);
+                if (graph->isPassable(sx, sy) && graph->isPassable(tx, ty) && (sx != tx || sy != ty)) {
+                    queries.push_back({ { sx, sy, tx, ty } });
+                }
+            }
+
+            size_t legacyFound = 0, found = 0;
+            const double legacyTime = measure([&]() {
+                for (const auto& query : queries) {
+                    legacyFound += LegacyAStar::find(*graph, query[0], query[1], query[2], query[3]) ? 1 : 0;
+                }
+            });
+            Ego::AI::PathFinder finder;
+            std::vector<int> path;
+            const double time = measure([&]() {
+                for (const auto& query : queries) {
+                    found += finder.find(*graph, query[0], query[1], query[2], query[3], path) ? 1 : 0;
+                }
+            });
+
+            //Everything the former implementation found is found
+            EgoTest_Assert(found >= legacyFound);
+
+            std::cout << "PathFindingBenchmark: " << SIZE << " x " << SIZE << " tiles, " << QUERIES << " queries within " << range << " tiles"
+                      << " (graph built in " << buildTime * 1e3 << " ms)" << std::endl
+                      << "    former A*    " << QUERIES / legacyTime << " queries/s, " << legacyFound << " paths found" << std::endl
+                      << "    path finder  " << QUERIES / time << " queries/s, " << found << " paths found" << std::endl;
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,210 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/ScriptInterpreter.cpp
+/// @brief  Instructions per second of the decoded script program compared to walking the
+///         compiled instruction list with a hash map lookup per function call.
+/// @remark The scripts are synthetic but shaped like the shipped ones: blocks guarded by
+///         an "If" function with a few indented calls and assignments each.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/Script/script.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(ScriptInterpreterBenchmark) {
+    /// Stands in for ai_state_t.
+    struct State {
+        uint32_t alert;
+        int32_t timer;
+        int32_t content;
+        int32_t tmp[5];
+    };
+    using Function = uint8_t(State&);
+    using Program = Ego::Script::Interpreter::Program<Function>;
+
+    static const size_t NUMBER_OF_FUNCTIONS = 64;
+    static const size_t NUMBER_OF_SCRIPTS = 32;
+    static const size_t NUMBER_OF_STATES = 256;     //< Synthetic inputs, every script runs on each
+    static const size_t ROUNDS = 40;
+
+    template <size_t Index>
+    static uint8_t aFunction(State& state) {
+        // Even functions are conditions on the alert bits, odd functions have side effects.
+        if (0 == Index % 2) {
+            return 0 != (state.alert & (1u << (Index / 2 % 32)));
+        }
+        state.content += static_cast<int32_t>(Index);
+        state.timer -= 1;
+        return true;
+    }
+
+    template <size_t... Indices>
+    static std::array<Function *, NUMBER_OF_FUNCTIONS> makeFunctions(std::index_sequence<Indices...>) {
+        return std::array<Function *, NUMBER_OF_FUNCTIONS>{ { &aFunction<Indices>... } };
+    }
+
+    static std::array<Function *, NUMBER_OF_FUNCTIONS> getFunctions() {
+        return makeFunctions(std::make_index_sequence<NUMBER_OF_FUNCTIONS>{});
+    }
+
+    static Instruction aCall(uint32_t function, uint32_t indent) {
+        return Instruction(Instruction::FUNCTIONBITS | ((indent & 0x0f) << 27) | function);
+    }
+
+    static InstructionList aScript(std::mt19937& generator) {
+        std::uniform_int_distribution<uint32_t> condition(0, NUMBER_OF_FUNCTIONS / 2 - 1);
+        std::uniform_int_distribution<uint32_t> statement(0, NUMBER_OF_FUNCTIONS / 2 - 1);
+        std::uniform_int_distribution<uint32_t> length(2, 6);
+        std::uniform_int_distribution<uint32_t> constant(0, 255);
+
+        InstructionList list;
+        while (list.getLength() + 64 < MAXAICOMPILESIZE) {
+            // if <condition>
+            list.append(aCall(2 * condition(generator), 0));
+            const size_t jump = list.getLength();
+            list.append(Instruction(0));
+            for (uint32_t i = 0, n = length(generator); i < n; ++i) {
+                if (i % 3 == 2) {
+                    // tmpx = tmpy + <constant> - tmpx
+                    list.append(Instruction((1 << 27) | 0));
+                    list.append(Instruction(3));
+                    list.append(Instruction(1));
+                    list.append(Instruction(Instruction::FUNCTIONBITS | constant(generator)));
+                    list.append(Instruction((1 << 27) | 0));
+                } else {
+                    list.append(aCall(2 * statement(generator) + 1, 1));
+                    list.append(Instruction(list.getLength() + 1));
+                }
+            }
+            list[jump] = Instruction(list.getLength());
+        }
+        return list;
+    }
+
+    /// Runs the decoded program.
+    struct Machine {
+        State& state;
+        bool isTerminated() const { return false; }
+        void enter(const Program::Instruction&) {}
+        bool call(const Program::Instruction& instruction) { return instruction.function(state); }
+        void assign(const Program::Instruction& instruction, const Program::Operand *operands) {
+            int32_t sum = 0;
+            for (uint32_t i = 0; i < instruction.operandCount; ++i) {
+                const int32_t value = operands[i].isConstant ? operands[i].value : state.tmp[operands[i].value % 5];
+                sum = (0 == operands[i].operation) ? sum + value : sum - value;
+            }
+            state.tmp[instruction.value % 5] = sum;
+        }
+    };
+
+    /// Walks the compiled instruction list, the way scripts were run before they were decoded.
+    static size_t runInstructionList(const InstructionList& list, const std::unordered_map<uint32_t, Function *>& functions, State& state) {
+        size_t count = 0;
+        size_t position = 0;
+        while (position < list.getLength()) {
+            const Instruction& instruction = list[position];
+            if (instruction.isInv()) {
+                const auto it = functions.find(instruction.getValueBits());
+                const bool passed = (functions.cend() != it) && it->second(state);
+                position = passed ? position + 2 : list[position + 1].getBits();
+            } else {
+                const uint32_t variable = instruction.getValueBits();
+                const uint32_t operands = list[position + 1].getBits();
+                position += 2;
+                int32_t sum = 0;
+                for (uint32_t i = 0; i < operands && position < list.getLength(); ++i, ++position) {
+                    const int32_t value = list[position].isLdc() ? list[position].getValueBits() : state.tmp[list[position].getValueBits() % 5];
+                    sum = (0 == list[position].getDataBits()) ? sum + value : sum - value;
+                }
+                state.tmp[variable % 5] = sum;
+            }
+            count++;
+        }
+        return count;
+    }
+
+    EgoTest_Test(benchmarkInstructionsPerSecond) {
+        std::mt19937 generator(5);
+        std::uniform_int_distribution<uint32_t> bits;
+
+        const auto functions = getFunctions();
+        std::unordered_map<uint32_t, Function *> functionMap;
+        for (uint32_t i = 0; i < functions.size(); ++i) {
+            functionMap[i] = functions[i];
+        }
+
+        std::vector<InstructionList> scripts;
+        std::vector<Program> programs(NUMBER_OF_SCRIPTS);
+        for (size_t i = 0; i < NUMBER_OF_SCRIPTS; ++i) {
+            scripts.push_back(aScript(generator));
+            programs[i].decode(scripts[i], functions.data(), functions.size());
+        }
+
+        std::vector<State> inputs(NUMBER_OF_STATES);
+        for (State& input : inputs) {
+            input.alert = bits(generator);
+            input.timer = 0;
+            input.content = 0;
+            std::fill(std::begin(input.tmp), std::end(input.tmp), 0);
+        }
+
+        std::vector<State> listStates, programStates;
+        size_t listCount = 0, programCount = 0;
+        const double listTime = measure([&]() {
+            for (size_t round = 0; round < ROUNDS; ++round) {
+                listStates = inputs;
+                for (size_t i = 0; i < NUMBER_OF_SCRIPTS; ++i) {
+                    for (State& state : listStates) {
+                        listCount += runInstructionList(scripts[i], functionMap, state);
+                    }
+                }
+            }
+        });
+        const double programTime = measure([&]() {
+            for (size_t round = 0; round < ROUNDS; ++round) {
+                programStates = inputs;
+                for (size_t i = 0; i < NUMBER_OF_SCRIPTS; ++i) {
+                    for (State& state : programStates) {
+                        Machine machine{ state };
+                        programCount += programs[i].run(machine);
+                    }
+                }
+            }
+        });
+
+        //Both must run the same instructions to the same effect
+        EgoTest_Assert(listCount == programCount);
+        for (size_t i = 0; i < NUMBER_OF_STATES; ++i) {
+            EgoTest_Assert(listStates[i].content == programStates[i].content);
+            EgoTest_Assert(std::equal(std::begin(listStates[i].tmp), std::end(listStates[i].tmp), std::begin(programStates[i].tmp)));
+        }
+
+        std::cout << "ScriptInterpreterBenchmark: " << NUMBER_OF_SCRIPTS << " scripts, "
+                  << NUMBER_OF_STATES << " inputs, " << programCount << " instructions" << std::endl
+                  << "    instruction list " << listCount / listTime / 1e6 << " M instructions/s" << std::endl
+                  << "    decoded program  " << programCount / programTime / 1e6 << " M instructions/s" << std::endl;
+    }
+};
+
+} // namespace Test
+} // namespace Ego
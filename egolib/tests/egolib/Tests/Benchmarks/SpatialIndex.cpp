@@ -0,0 +1,139 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/SpatialIndex.cpp
+/// @brief  Compares the per-frame rebuilt QuadTree against the incremental SpatialGrid.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SpatialIndexBenchmark) {
+    class Entity {
+    public:
+        Entity(float x, float y, float size) : _bounds(Point2f(x - size, y - size), Point2f(x + size, y + size)) {
+            //ctor
+        }
+
+        AxisAlignedBox2f& getAxisAlignedBox2D() { return _bounds; }
+
+    private:
+        AxisAlignedBox2f _bounds;
+    };
+
+    static const size_t FRAMES = 50;                 //< Number of simulated update frames
+    static const size_t QUERIES_PER_FRAME = 200;     //< findObjects() calls per frame
+    static constexpr float LEVEL_SIZE = 64 * 128.0f; //< A 64x64 tile level
+    static constexpr float QUERY_RADIUS = 448.0f;    //< WIDE
+
+    static void runBenchmark(size_t entityCount) {
+        std::mt19937 generator(entityCount);
+        std::uniform_real_distribution<float> position(0.0f, LEVEL_SIZE);
+        std::uniform_real_distribution<float> step(-8.0f, 8.0f);
+
+        std::vector<std::shared_ptr<Entity>> entities;
+        for (size_t i = 0; i < entityCount; ++i) {
+            entities.push_back(std::make_shared<Entity>(position(generator), position(generator), 20.0f));
+        }
+        std::vector<AxisAlignedBox2f> queries;
+        for (size_t i = 0; i < FRAMES * QUERIES_PER_FRAME; ++i) {
+            const float x = position(generator), y = position(generator);
+            queries.push_back(AxisAlignedBox2f(Point2f(x - QUERY_RADIUS, y - QUERY_RADIUS), Point2f(x + QUERY_RADIUS, y + QUERY_RADIUS)));
+        }
+
+        Ego::QuadTree<Entity> quadTree;
+        Ego::SpatialGrid grid(128.0f);
+        grid.reset(0.0f, 0.0f, LEVEL_SIZE, LEVEL_SIZE);
+        std::vector<std::shared_ptr<Entity>> quadTreeResult;
+        std::vector<Ego::SpatialGrid::Index> gridResult;
+        double quadTreeUpdate = 0.0, quadTreeFind = 0.0, gridUpdate = 0.0, gridFind = 0.0;
+        size_t quadTreeHits = 0, gridHits = 0;
+
+        for (size_t frame = 0; frame < FRAMES; ++frame) {
+            //Move everything a bit, but stay inside the level (the QuadTree drops anything outside)
+            for (const std::shared_ptr<Entity> &entity : entities) {
+                AxisAlignedBox2f &bounds = entity->getAxisAlignedBox2D();
+                const Vector2f delta(step(generator), step(generator));
+                const AxisAlignedBox2f moved(bounds.getMin() + delta, bounds.getMax() + delta);
+                if (moved.getMin()[kX] >= 0.0f && moved.getMin()[kY] >= 0.0f &&
+                    moved.getMax()[kX] <= LEVEL_SIZE && moved.getMax()[kY] <= LEVEL_SIZE) {
+                    bounds = moved;
+                }
+            }
+            const size_t firstQuery = frame * QUERIES_PER_FRAME, lastQuery = firstQuery + QUERIES_PER_FRAME;
+
+            //The QuadTree has to be rebuilt every frame
+            quadTreeUpdate += measure([&]() {
+                quadTree.clear(0.0f, 0.0f, LEVEL_SIZE, LEVEL_SIZE);
+                for (const std::shared_ptr<Entity> &entity : entities) {
+                    quadTree.insert(entity);
+                }
+            });
+            quadTreeFind += measure([&]() {
+                for (size_t i = firstQuery; i < lastQuery; ++i) {
+                    quadTree.find(queries[i], quadTreeResult);
+                    quadTreeHits += quadTreeResult.size();
+                    quadTreeResult.clear();
+                }
+            });
+
+            //The SpatialGrid only relocates
+            gridUpdate += measure([&]() {
+                for (size_t i = 0; i < entities.size(); ++i) {
+                    grid.update(i, entities[i]->getAxisAlignedBox2D());
+                }
+            });
+            gridFind += measure([&]() {
+                for (size_t i = firstQuery; i < lastQuery; ++i) {
+                    grid.find(queries[i], gridResult);
+                    gridHits += gridResult.size();
+                    gridResult.clear();
+                }
+            });
+        }
+
+        //Both must see the same world
+        EgoTest_Assert(quadTreeHits == gridHits);
+
+        std::cout << "SpatialIndexBenchmark: " << entityCount << " entities, "
+                  << FRAMES << " frames, " << QUERIES_PER_FRAME << " queries/frame" << std::endl
+                  << "    QuadTree    update " << quadTreeUpdate * 1000.0 / FRAMES << " ms/frame, "
+                  << "find " << quadTreeFind * 1000.0 / FRAMES << " ms/frame" << std::endl
+                  << "    SpatialGrid update " << gridUpdate * 1000.0 / FRAMES << " ms/frame, "
+                  << "find " << gridFind * 1000.0 / FRAMES << " ms/frame" << std::endl;
+    }
+
+    EgoTest_Test(benchmark100) {
+        runBenchmark(100);
+    }
+
+    EgoTest_Test(benchmark1000) {
+        runBenchmark(1000);
+    }
+
+    EgoTest_Test(benchmark10000) {
+        runBenchmark(10000);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
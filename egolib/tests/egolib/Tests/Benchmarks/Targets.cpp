@@ -0,0 +1,140 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/Benchmarks/Targets.cpp
+/// @brief  Target selection of particles: the former linear search over all objects compared
+///         to the TargetFinder.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Tests/Benchmarks/Benchmark.hpp"
+#include "egolib/AI/TargetFinder.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(TargetFinderBenchmark) {
+    static const size_t QUERIES = 20000;
+    static const size_t TEAMS = 4;
+    static constexpr float LEVEL_SIZE = 64 * 128.0f; //< A 64x64 tile level
+    static constexpr float RADIUS = 6 * 128.0f;      //< WIDE
+
+    /// What prt_find_target() looks at.
+    struct Object {
+        size_t index;
+        Vector3f position;
+        bool alive, item, invictus;
+        size_t team;
+    };
+
+    struct Scene {
+        std::vector<std::shared_ptr<Object>> objects;
+        std::array<std::array<bool, TEAMS>, TEAMS> hates;
+    };
+
+    static bool accept(const Scene& scene, const Object& object, size_t team, size_t dontTarget) {
+        return object.alive && !object.item && !object.invictus && object.index != dontTarget && scene.hates[team][object.team];
+    }
+
+    /// The former linear search.
+    static bool aLinearSearch(const Scene& scene, const Ego::AI::TargetFinder::Query& query, size_t team, size_t dontTarget, size_t& target) {
+        float longdist2 = query.radius * query.radius;
+        bool found = false;
+        for (const std::shared_ptr<Object>& object : scene.objects) {
+            if (!accept(scene, *object, team, dontTarget)) continue;
+            Facing angle = Ego::AI::TargetFinder::getRelativeFacing(query.position, query.facing, object->position);
+            if (Ego::AI::TargetFinder::isInCone(angle, query.coneAngle)) {
+                const float dist2 = (object->position - query.position).length_2();
+                if (dist2 < longdist2) {
+                    target = object->index;
+                    longdist2 = dist2;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    EgoTest_Test(benchmarkQueriesPerSecond) {
+        for (size_t objectCount : { 100, 1000, 4000 }) {
+            std::mt19937 generator(objectCount);
+            std::uniform_real_distribution<float> position(0.0f, LEVEL_SIZE), height(0.0f, 256.0f);
+            std::uniform_int_distribution<size_t> team(0, TEAMS - 1);
+            std::uniform_int_distribution<int> facing(0, 0xFFFF), cone(0x1000, 0x4000);
+            std::bernoulli_distribution coin(0.5), rarely(0.1);
+
+            Scene scene;
+            Ego::AI::TargetFinder finder(128.0f);
+            finder.reset(0.0f, 0.0f, LEVEL_SIZE, LEVEL_SIZE);
+            for (size_t i = 0; i < TEAMS; ++i) {
+                for (size_t j = 0; j < TEAMS; ++j) {
+                    scene.hates[i][j] = i != j && coin(generator);
+                }
+            }
+            for (size_t i = 0; i < objectCount; ++i) {
+                scene.objects.push_back(std::make_shared<Object>(Object{ i, Vector3f(position(generator), position(generator), height(generator)),
+                                                                         !rarely(generator), rarely(generator), rarely(generator), team(generator) }));
+                finder.insert(i, scene.objects.back()->position);
+            }
+            struct Query {
+                Ego::AI::TargetFinder::Query query;
+                size_t team;
+                size_t dontTarget;
+            };
+            std::vector<Query> queries;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                // Particles spawn next to their owner.
+                const Object& owner = *scene.objects[i % objectCount];
+                Query query;
+                query.query.position = owner.position + Vector3f(8.0f, 8.0f, 32.0f);
+                query.query.facing = Facing(FACING_T(facing(generator)));
+                query.query.coneAngle = static_cast<FACING_T>(cone(generator));
+                query.query.radius = RADIUS;
+                query.team = owner.team;
+                query.dontTarget = owner.index;
+                queries.push_back(query);
+            }
+
+            std::vector<size_t> linearTargets(QUERIES, objectCount), targets(QUERIES, objectCount);
+            const double linearTime = measure([&]() {
+                for (size_t i = 0; i < QUERIES; ++i) {
+                    aLinearSearch(scene, queries[i].query, queries[i].team, queries[i].dontTarget, linearTargets[i]);
+                }
+            });
+            const double time = measure([&]() {
+                for (size_t i = 0; i < QUERIES; ++i) {
+                    const Query& query = queries[i];
+                    Facing angle;
+                    finder.find(query.query, [&scene, &query](size_t index) { return accept(scene, *scene.objects[index], query.team, query.dontTarget); },
+                                targets[i], angle);
+                }
+            });
+
+            EgoTest_Assert(linearTargets == targets);
+            const size_t found = QUERIES - std::count(targets.begin(), targets.end(), objectCount);
+
+            std::cout << "TargetFinderBenchmark: " << objectCount << " objects, " << QUERIES << " queries, " << found << " targets found" << std::endl
+                      << "    linear search  " << QUERIES / linearTime << " queries/s" << std::endl
+                      << "    target finder  " << QUERIES / time << " queries/s" << std::endl;
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,62 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Core/DenseIndex.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(DenseIndex) {
+    EgoTest_Test(runDenseIndexTestInsertErase) {
+        Ego::DenseIndex index;
+        bool inserted = false;
+        EgoTest_Assert(0 == index.insert(1000000, &inserted) && inserted);
+        EgoTest_Assert(1 == index.insert(5, &inserted) && inserted);
+        EgoTest_Assert(0 == index.insert(1000000, &inserted) && !inserted);
+        EgoTest_Assert(2 == index.size());
+        EgoTest_Assert(1 == index.find(5));
+        EgoTest_Assert(Ego::DenseIndex::NONE == index.find(6));
+        EgoTest_Assert(1000000 == index.getKey(0));
+
+        EgoTest_Assert(0 == index.erase(1000000));
+        EgoTest_Assert(Ego::DenseIndex::NONE == index.erase(1000000));
+        EgoTest_Assert(Ego::DenseIndex::NONE == index.find(1000000));
+        EgoTest_Assert(1 == index.size());
+    }
+
+    EgoTest_Test(runDenseIndexTestReuse) {
+        //Keys that keep growing reuse the slots of erased keys
+        Ego::DenseIndex index;
+        const size_t alive = 16;
+        for (size_t key = 0; key < 100000; ++key) {
+            EgoTest_Assert(index.insert(key * 7919) < alive);
+            if (key >= alive - 1) {
+                EgoTest_Assert(Ego::DenseIndex::NONE != index.erase((key - alive + 1) * 7919));
+            }
+        }
+        EgoTest_Assert(index.capacity() == alive);
+        EgoTest_Assert(index.size() == alive - 1);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
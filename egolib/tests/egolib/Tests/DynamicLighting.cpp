@@ -0,0 +1,149 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Graphics/DynamicLighting.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(DynamicLightGridTest) {
+    static constexpr float TILE_SIZE = 128.0f;
+
+    /// The former lighting of a grid point, testing every light.
+    static void legacyIlluminate(const ego_frect_t& bound, const std::vector<dynalight_data_t>& lights, float x0, float y0, float zLow, float zHigh, LightingVector& low, LightingVector& high) {
+        for (const dynalight_data_t& light : lights) {
+            if (light.falloff <= 0.0f || 0.0f == light.level) continue;
+            const float radius = std::sqrt(light.falloff * 765.0f * 0.5f);
+            ego_frect_t ftmp;
+            ftmp.xmin = std::max(light.pos[kX] - radius, bound.xmin);
+            ftmp.xmax = std::min(light.pos[kX] + radius, bound.xmax);
+            ftmp.ymin = std::max(light.pos[kY] - radius, bound.ymin);
+            ftmp.ymax = std::min(light.pos[kY] + radius, bound.ymax);
+            if (ftmp.xmin >= ftmp.xmax || ftmp.ymin >= ftmp.ymax) continue;
+
+            ego_frect_t fgrid_rect;
+            fgrid_rect.xmin = x0 - TILE_SIZE * 0.5f;
+            fgrid_rect.xmax = x0 + TILE_SIZE * 0.5f;
+            fgrid_rect.ymin = y0 - TILE_SIZE * 0.5f;
+            fgrid_rect.ymax = y0 + TILE_SIZE * 0.5f;
+            if (fgrid_rect.xmin > ftmp.xmax || fgrid_rect.xmax < ftmp.xmin) continue;
+            if (fgrid_rect.ymin > ftmp.ymax || fgrid_rect.ymax < ftmp.ymin) continue;
+
+            Vector3f nrm;
+            nrm[kX] = light.pos[kX] - x0;
+            nrm[kY] = light.pos[kY] - y0;
+            nrm[kZ] = light.pos[kZ] - zLow;
+            sum_dyna_lighting(&light, low, nrm);
+            nrm[kZ] = light.pos[kZ] - zHigh;
+            sum_dyna_lighting(&light, high, nrm);
+        }
+    }
+
+    static dynalight_data_t aLight(std::mt19937& generator, const ego_frect_t& area) {
+        std::uniform_real_distribution<float> x(area.xmin, area.xmax), y(area.ymin, area.ymax), z(-100.0f, 300.0f);
+        std::uniform_real_distribution<float> level(-1.0f, 1.0f), falloff(0.0f, 200.0f), distance(0.0f, 1e6f);
+        dynalight_data_t light;
+        light.pos = Vector3f(x(generator), y(generator), z(generator));
+        light.level = level(generator);
+        light.falloff = falloff(generator);
+        light.distance = distance(generator);
+        return light;
+    }
+
+    EgoTest_Test(testMatchesLegacy) {
+        std::mt19937 generator(31);
+        std::uniform_real_distribution<float> cellSizes(100.0f, 1000.0f);
+        for (int i = 0; i < 20; ++i) {
+            // The visible tiles, the lights are placed around them.
+            ego_frect_t bound = { 1280.0f, 640.0f, 1280.0f + 32 * TILE_SIZE, 640.0f + 24 * TILE_SIZE };
+            ego_frect_t area = { bound.xmin - 1000.0f, bound.ymin - 1000.0f, bound.xmax + 1000.0f, bound.ymax + 1000.0f };
+            std::vector<dynalight_data_t> lights;
+            for (int j = 0; j < 10 * i; ++j) {
+                lights.push_back(aLight(generator, area));
+            }
+
+            Graphics::DynamicLightGrid grid(cellSizes(generator), TILE_SIZE);
+            grid.reset(bound, lights);
+            EgoTest_Assert(grid.getLightCount() <= lights.size());
+            for (int y = -2; y <= 26; ++y) {
+                for (int x = -2; x <= 34; ++x) {
+                    const float x0 = bound.xmin + x * TILE_SIZE, y0 = bound.ymin + y * TILE_SIZE;
+                    LightingVector expectedLow = {}, expectedHigh = {}, actualLow = {}, actualHigh = {};
+                    legacyIlluminate(bound, lights, x0, y0, -50.0f, 150.0f, expectedLow, expectedHigh);
+                    grid.illuminate(x0, y0, -50.0f, 150.0f, actualLow, actualHigh);
+                    //Lights are summed in the same order, so the results are equal
+                    EgoTest_Assert(expectedLow == actualLow);
+                    EgoTest_Assert(expectedHigh == actualHigh);
+                }
+            }
+        }
+    }
+
+    EgoTest_Test(testLeftOutLights) {
+        ego_frect_t bound = { 0.0f, 0.0f, 10 * TILE_SIZE, 10 * TILE_SIZE };
+        std::vector<dynalight_data_t> lights(4);
+        for (auto& light : lights) {
+            dynalight_data_t::init(light);
+            light.pos = Vector3f(5 * TILE_SIZE, 5 * TILE_SIZE, 0.0f);
+            light.level = 1.0f;
+        }
+        lights[0].level = 0.0f;
+        lights[1].falloff = 0.0f;
+        lights[2].pos = Vector3f(-1000.0f, 5 * TILE_SIZE, 0.0f);
+
+        Graphics::DynamicLightGrid grid(4 * TILE_SIZE, TILE_SIZE);
+        grid.reset(bound, lights);
+        EgoTest_Assert(1 == grid.getLightCount());
+        LightingVector low = {}, high = {};
+        EgoTest_Assert(1 == grid.illuminate(5 * TILE_SIZE, 5 * TILE_SIZE, 0.0f, 100.0f, low, high));
+        EgoTest_Assert(0 == grid.illuminate(20 * TILE_SIZE, 5 * TILE_SIZE, 0.0f, 100.0f, low, high));
+
+        grid.clear();
+        EgoTest_Assert(0 == grid.getLightCount());
+        EgoTest_Assert(0 == grid.illuminate(5 * TILE_SIZE, 5 * TILE_SIZE, 0.0f, 100.0f, low, high));
+    }
+
+    EgoTest_Test(testSelectClosest) {
+        std::mt19937 generator(37);
+        ego_frect_t area = { 0.0f, 0.0f, 1000.0f, 1000.0f };
+        for (size_t count : { 0, 1, 8, 64, 100, 500 }) {
+            std::vector<dynalight_data_t> lights;
+            for (int i = 0; i < 300; ++i) {
+                lights.push_back(aLight(generator, area));
+            }
+            std::vector<dynalight_data_t> selected = lights;
+            Graphics::select_dynalights(selected, count);
+            EgoTest_Assert(std::min<size_t>(count, lights.size()) == selected.size());
+
+            std::vector<float> distances;
+            for (const auto& light : lights) {
+                distances.push_back(light.distance);
+            }
+            std::sort(distances.begin(), distances.end());
+            for (size_t i = 0; i < selected.size(); ++i) {
+                EgoTest_Assert(distances[i] == selected[i].distance);
+            }
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,155 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(JobSystem) {
+    EgoTest_Test(runJobSystemTestParallelFor) {
+        for (size_t workers : { 0, 1, 3 }) {
+            Ego::Core::JobSystem jobSystem(workers);
+            std::vector<std::atomic<int>> visits(10000);
+            for (std::atomic<int> &visit : visits) {
+                visit = 0;
+            }
+            jobSystem.parallelFor(0, visits.size(), 37, [&visits](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    visits[i]++;
+                }
+            });
+
+            //Every index exactly once
+            for (const std::atomic<int> &visit : visits) {
+                EgoTest_Assert(1 == visit.load());
+            }
+        }
+    }
+
+    EgoTest_Test(runJobSystemTestDependencies) {
+        Ego::Core::JobSystem jobSystem(3);
+        std::atomic<bool> released(false);
+        std::atomic<size_t> firstDone(0), secondStarted(0), secondSawIncomplete(0);
+        Ego::Core::JobCounter first, second;
+        first.add(200);
+        second.add(100);
+
+        //Submit the dependent jobs before the jobs they depend on
+        for (size_t i = 0; i < 100; ++i) {
+            jobSystem.submit([&firstDone, &secondStarted, &secondSawIncomplete]() {
+                secondStarted++;
+                if (firstDone.load() != 200) {
+                    secondSawIncomplete++;
+                }
+            }, &second, &first);
+        }
+        //The jobs depended on are held back until released
+        for (size_t i = 0; i < 200; ++i) {
+            jobSystem.submit([&released, &firstDone]() {
+                while (!released.load()) {
+                    std::this_thread::yield();
+                }
+                firstDone++;
+            }, &first);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EgoTest_Assert(0 == secondStarted.load());
+        EgoTest_Assert(!first.isDone());
+
+        released = true;
+        jobSystem.wait(second);
+
+        EgoTest_Assert(first.isDone());
+        EgoTest_Assert(200 == firstDone.load());
+        EgoTest_Assert(100 == secondStarted.load());
+        EgoTest_Assert(0 == secondSawIncomplete.load());
+    }
+
+    EgoTest_Test(runJobSystemTestOverflow) {
+        //More jobs than a deque can hold are run by the submitting thread
+        Ego::Core::JobSystem jobSystem(0);
+        std::atomic<size_t> count(0);
+        Ego::Core::JobCounter counter;
+        const size_t jobs = Ego::Core::JobSystem::DEQUE_CAPACITY + 100;
+        counter.add(jobs);
+        for (size_t i = 0; i < jobs; ++i) {
+            jobSystem.submit([&count]() { count++; }, &counter);
+        }
+        jobSystem.wait(counter);
+        EgoTest_Assert(jobs == count.load());
+    }
+
+    EgoTest_Test(runJobSystemTestFullDequeDependencies) {
+        //Jobs running on workers fill the deques of their workers with jobs that are not ready
+        //yet, and threads that are not workers fill their shared deque while others put jobs
+        //that are not ready back into it.
+        Ego::Core::JobSystem jobSystem(2);
+        const size_t threads = 3;
+        const size_t jobsPerThread = 2 * Ego::Core::JobSystem::DEQUE_CAPACITY;
+        std::atomic<bool> gateDone(false);
+        std::atomic<size_t> ready(0), dependent(0), sawIncomplete(0);
+        Ego::Core::JobCounter gate, dependentCounter;
+        gate.add(1);
+        //The jobs submitting dependent jobs and the dependent jobs submitted by them and by the threads
+        dependentCounter.add(threads + 2 * threads * jobsPerThread);
+
+        jobSystem.submit([&gateDone]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            gateDone = true;
+        }, &gate);
+
+        const auto submitDependent = [&]() {
+            for (size_t i = 0; i < jobsPerThread; ++i) {
+                jobSystem.submit([&]() {
+                    if (!gateDone.load()) {
+                        sawIncomplete++;
+                    }
+                    dependent++;
+                }, &dependentCounter, &gate);
+            }
+        };
+        std::vector<std::thread> submitters;
+        for (size_t t = 0; t < threads; ++t) {
+            jobSystem.submit(submitDependent, &dependentCounter);
+            submitters.emplace_back(submitDependent);
+            submitters.emplace_back([&]() {
+                Ego::Core::JobCounter counter;
+                counter.add(jobsPerThread);
+                for (size_t i = 0; i < jobsPerThread; ++i) {
+                    jobSystem.submit([&ready]() { ready++; }, &counter);
+                }
+                jobSystem.wait(counter);
+            });
+        }
+        for (std::thread& submitter : submitters) {
+            submitter.join();
+        }
+        jobSystem.wait(dependentCounter);
+
+        //Every job exactly once and none before its dependency
+        EgoTest_Assert(threads * jobsPerThread == ready.load());
+        EgoTest_Assert(2 * threads * jobsPerThread == dependent.load());
+        EgoTest_Assert(0 == sawIncomplete.load());
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,158 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Graphics/MD2Interpolation.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MD2InterpolationTest) {
+    /// A vertex as the game renders it.
+    struct Vertex {
+        float pos[4];
+        float nrm[3];
+        float env[2];
+        float tex[2];
+        float col[4];
+        int color_dir;
+    };
+
+    /// A vertex as MD2_Frame stored it before.
+    struct LegacyVertex {
+        Vector3f pos;
+        Vector3f nrm;
+        size_t normal;
+    };
+
+    /// The former interpolation, one vertex and one component at a time.
+    static void legacyInterpolate(const std::vector<LegacyVertex>& lst_ary, const std::vector<LegacyVertex>& nxt_ary, size_t vmin, size_t vmax, float flip, std::vector<Vertex>& vertices) {
+        float indextoenvirox[EGO_NORMAL_COUNT];
+        for (size_t i = 0; i < EGO_NORMAL_COUNT; ++i) {
+            indextoenvirox[i] = std::atan2(MD2Model::getMD2Normal(i, 1), MD2Model::getMD2Normal(i, 0)) * Ego::Math::invTwoPi<float>();
+        }
+        for (size_t i = vmin; i <= vmax; i++) {
+            Vertex *dst = &vertices[i];
+            const LegacyVertex &srcLast = lst_ary[i];
+            const LegacyVertex &srcNext = nxt_ary[i];
+            if (0.0f == flip || 1.0f == flip) {
+                const LegacyVertex &src = (0.0f == flip) ? srcLast : srcNext;
+                for (size_t j = 0; j < 3; ++j) {
+                    dst->pos[j] = src.pos[j];
+                    dst->nrm[j] = src.nrm[j];
+                }
+                dst->pos[3] = 1.0f;
+                dst->env[0] = indextoenvirox[src.normal];
+            } else {
+                for (size_t j = 0; j < 3; ++j) {
+                    dst->pos[j] = srcLast.pos[j] + (srcNext.pos[j] - srcLast.pos[j]) * flip;
+                    dst->nrm[j] = srcLast.nrm[j] + (srcNext.nrm[j] - srcLast.nrm[j]) * flip;
+                }
+                dst->pos[3] = 1.0f;
+                dst->env[0] = indextoenvirox[srcLast.normal] + (indextoenvirox[srcNext.normal] - indextoenvirox[srcLast.normal]) * flip;
+            }
+            dst->env[1] = 0.5f * (1.0f + dst->nrm[2]);
+        }
+    }
+
+    /// A frame with random positions and normals, stored both ways.
+    static void aFrame(std::mt19937& generator, size_t vertexCount, MD2_Frame& frame, std::vector<LegacyVertex>& legacy) {
+        std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+        std::uniform_int_distribution<size_t> normal(0, EGO_NORMAL_COUNT - 1);
+        frame.resize(vertexCount);
+        legacy.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            LegacyVertex& vertex = legacy[i];
+            vertex.pos = Vector3f(coordinate(generator), coordinate(generator), coordinate(generator));
+            vertex.normal = normal(generator);
+            vertex.nrm = Vector3f(MD2Model::getMD2Normal(vertex.normal, 0), MD2Model::getMD2Normal(vertex.normal, 1), MD2Model::getMD2Normal(vertex.normal, 2));
+            frame.setPosition(i, vertex.pos);
+            frame.setNormalIndex(i, vertex.normal);
+            frame.setNormal(i, vertex.nrm);
+        }
+    }
+
+    static bool equal(const Vertex& x, const Vertex& y) {
+        // All kernels should be exact, the tolerance allows for a compiler fusing the legacy multiply-add.
+        auto close = [](float a, float b) { return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::abs(a)); };
+        for (size_t j = 0; j < 4; ++j) {
+            if (!close(x.pos[j], y.pos[j])) return false;
+        }
+        for (size_t j = 0; j < 3; ++j) {
+            if (!close(x.nrm[j], y.nrm[j])) return false;
+        }
+        return close(x.env[0], y.env[0]) && close(x.env[1], y.env[1]);
+    }
+
+    EgoTest_Test(testKernelsMatchLegacy) {
+        static const size_t VERTICES = 101;
+        std::mt19937 generator(23);
+        MD2_Frame last, next;
+        std::vector<LegacyVertex> legacyLast, legacyNext;
+        aFrame(generator, VERTICES, last, legacyLast);
+        aFrame(generator, VERTICES, next, legacyNext);
+
+        std::uniform_real_distribution<float> flips(0.0f, 1.0f);
+        std::uniform_int_distribution<size_t> vertex(0, VERTICES - 1);
+        for (auto kernel : { MD2Interpolation::Kernel::Scalar, MD2Interpolation::Kernel::SSE2, MD2Interpolation::Kernel::AVX2 }) {
+            if (!MD2Interpolation::isSupported(kernel)) {
+                continue;
+            }
+            for (int i = 0; i < 100; ++i) {
+                const float flip = (0 == i) ? 0.0f : ((1 == i) ? 1.0f : flips(generator));
+                size_t vmin = vertex(generator), vmax = vertex(generator);
+                if (vmin > vmax) std::swap(vmin, vmax);
+
+                std::vector<Vertex> expected(VERTICES), actual(VERTICES);
+                legacyInterpolate(legacyLast, legacyNext, vmin, vmax, flip, expected);
+                MD2Interpolation::interpolate(kernel, last, next, vmin, vmax, flip, actual.data()->pos, sizeof(Vertex) / sizeof(float));
+                for (size_t j = vmin; j <= vmax; ++j) {
+                    EgoTest_Assert(equal(expected[j], actual[j]));
+                }
+
+                //Nothing else is written
+                EgoTest_Assert(vmin == 0 || 0.0f == actual[vmin - 1].env[1]);
+                EgoTest_Assert(vmax == VERTICES - 1 || 0.0f == actual[vmax + 1].pos[3]);
+                EgoTest_Assert(0.0f == actual[vmin].tex[0]);
+            }
+        }
+    }
+
+    EgoTest_Test(testEquallyLit) {
+        MD2_Frame frame;
+        frame.resize(1);
+        frame.setNormalIndex(0, 0);
+        EgoTest_Assert(MD2Model::getEnviroX(0) == frame.normals[3]);
+        frame.setNormalIndex(0, EGO_NORMAL_COUNT - 1);
+        EgoTest_Assert(0.0f == frame.normals[3]);
+        EgoTest_Assert(1.0f == frame.positions[3]);
+    }
+
+    EgoTest_Test(testSetKernel) {
+        const MD2Interpolation::Kernel kernel = MD2Interpolation::getKernel();
+        EgoTest_Assert(MD2Interpolation::isSupported(kernel));
+        EgoTest_Assert(MD2Interpolation::setKernel(MD2Interpolation::Kernel::Scalar));
+        EgoTest_Assert(MD2Interpolation::Kernel::Scalar == MD2Interpolation::getKernel());
+        EgoTest_Assert(MD2Interpolation::setKernel(kernel));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
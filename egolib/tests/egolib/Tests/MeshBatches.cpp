@@ -0,0 +1,226 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Mesh/Batches.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MeshBatchesTest) {
+    using Vertex = Ego::MeshBatches::Vertex;
+    using Element = Ego::MeshBatches::Element;
+
+    /// A triangle by the positions and colours of its vertices.
+    using Triangle = std::array<std::array<float, 4>, 3>;
+
+    /// A renderer recording the triangles of its draw calls instead of drawing them.
+    struct RecordingRenderer : public Ego::Null::Renderer {
+        /// The triangles of each draw call.
+        std::vector<std::vector<Triangle>> draws;
+
+        RecordingRenderer() : Ego::Null::Renderer() {}
+        virtual ~RecordingRenderer() {}
+
+        void render(VertexBuffer& vertexBuffer, IndexBuffer& indexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override {
+            EgoTest_Assert(PrimitiveType::Triangles == primitiveType);
+            EgoTest_Assert(0 == length % 3);
+            EgoTest_Assert(index + length <= indexBuffer.getNumberOfIndices());
+            EgoTest_Assert(vertexBuffer.getVertexDescriptor().getVertexSize() == sizeof(Vertex));
+            VertexBufferScopedLock vertexLock(vertexBuffer);
+            IndexBufferScopedLock indexLock(indexBuffer);
+            const Vertex *vertices = vertexLock.get<Vertex>();
+            const uint16_t *indices = indexLock.get<uint16_t>() + index;
+            std::vector<Triangle> triangles;
+            for (size_t i = 0; i < length; i += 3) {
+                Triangle triangle;
+                for (size_t j = 0; j < 3; ++j) {
+                    EgoTest_Assert(indices[i + j] < vertexBuffer.getNumberOfVertices());
+                    const Vertex& vertex = vertices[indices[i + j]];
+                    triangle[j] = {vertex.x, vertex.y, vertex.z, vertex.r};
+                }
+                triangles.push_back(triangle);
+            }
+            draws.push_back(triangles);
+            Ego::Null::Renderer::render(vertexBuffer, indexBuffer, primitiveType, index, length);
+        }
+    };
+
+    /// A tile of two triangle fans around its center: the corners 0 to 3 and the center 4.
+    static void setTile(Ego::MeshBatches& batches, int x, int y, float colour) {
+        static const uint8_t fanSizes[] = { 4, 4 };
+        static const uint16_t fanVertices[] = { 4, 0, 1, 2, 4, 2, 3, 0 };
+        const float z = static_cast<float>(x + y);
+        const Vertex vertices[] = {
+            { x + 0.0f, y + 0.0f, z, colour, colour, colour, 0.0f, 0.0f },
+            { x + 1.0f, y + 0.0f, z, colour, colour, colour, 1.0f, 0.0f },
+            { x + 1.0f, y + 1.0f, z, colour, colour, colour, 1.0f, 1.0f },
+            { x + 0.0f, y + 1.0f, z, colour, colour, colour, 0.0f, 1.0f },
+            { x + 0.5f, y + 0.5f, z, colour, colour, colour, 0.5f, 0.5f },
+        };
+        batches.setTile(x + y * batches.getWidth(), vertices, 5, fanSizes, 2, fanVertices);
+    }
+
+    /// The triangles of a tile set by setTile.
+    static std::vector<Triangle> tileTriangles(int x, int y, float colour) {
+        const float z = static_cast<float>(x + y);
+        const std::array<float, 4> corners[] = {
+            { x + 0.0f, y + 0.0f, z, colour }, { x + 1.0f, y + 0.0f, z, colour },
+            { x + 1.0f, y + 1.0f, z, colour }, { x + 0.0f, y + 1.0f, z, colour },
+        }, center = { x + 0.5f, y + 0.5f, z, colour };
+        return {
+            { center, corners[0], corners[1] }, { center, corners[1], corners[2] },
+            { center, corners[2], corners[3] }, { center, corners[3], corners[0] },
+        };
+    }
+
+    static void makeBatches(Ego::MeshBatches& batches, int width, int height) {
+        batches.resize(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                setTile(batches, x, y, 0.5f);
+            }
+        }
+    }
+
+    static std::vector<Triangle> sorted(std::vector<Triangle> triangles) {
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    EgoTest_Test(triangulate) {
+        static const uint8_t fanSizes[] = { 4, 3 };
+        static const uint16_t fanVertices[] = { 0, 1, 2, 3, 3, 4, 0 };
+        std::vector<uint16_t> triangles;
+        Ego::MeshBatches::triangulate(fanSizes, 2, fanVertices, 10, triangles);
+        const std::vector<uint16_t> expected = { 10, 11, 12, 10, 12, 13, 13, 14, 10 };
+        EgoTest_Assert(expected == triangles);
+    }
+
+    EgoTest_Test(oneDrawCallPerTexturePerChunk) {
+        // 16 x 16 tiles are 2 x 2 chunks.
+        Ego::MeshBatches batches;
+        makeBatches(batches, 16, 16);
+        EgoTest_Assert(4 == batches.getChunkCount());
+        std::vector<Element> elements;
+        for (size_t i = 0; i < batches.getTileCount(); ++i) {
+            elements.push_back(Element{i, static_cast<uint32_t>(i % 3)});
+        }
+        RecordingRenderer renderer;
+        std::vector<uint32_t> bound;
+        const size_t draws = batches.render(renderer, elements, [&bound](const Element& element) { bound.push_back(element.texture); });
+
+        // Tile by tile, this took two draw calls per tile.
+        EgoTest_Assert(12 == draws);
+        EgoTest_Assert(12 == renderer.draws.size());
+        EgoTest_Assert(12 == renderer.getStatistics().drawCalls);
+        // Four triangles per tile.
+        EgoTest_Assert(16 * 16 * 4 * 3 == renderer.getStatistics().vertices);
+        const std::vector<uint32_t> expectedBound = { 0, 1, 2 };
+        EgoTest_Assert(expectedBound == bound);
+        // The elements are ordered by texture.
+        for (size_t i = 1; i < elements.size(); ++i) {
+            EgoTest_Assert(elements[i - 1].texture <= elements[i].texture);
+        }
+    }
+
+    EgoTest_Test(rendersTheTrianglesOfTheTiles) {
+        Ego::MeshBatches batches;
+        makeBatches(batches, 20, 12);
+        // Some tiles in different chunks and with different textures.
+        std::vector<Element> elements;
+        std::vector<Triangle> expected;
+        for (int y = 0; y < 12; y += 3) {
+            for (int x = 0; x < 20; x += 2) {
+                elements.push_back(Element{static_cast<size_t>(x + y * 20), static_cast<uint32_t>((x + y) % 4)});
+                const auto triangles = tileTriangles(x, y, 0.5f);
+                expected.insert(expected.end(), triangles.begin(), triangles.end());
+            }
+        }
+        RecordingRenderer renderer;
+        batches.render(renderer, elements, [](const Element&) {});
+        std::vector<Triangle> triangles;
+        for (const auto& draw : renderer.draws) {
+            triangles.insert(triangles.end(), draw.begin(), draw.end());
+        }
+        EgoTest_Assert(sorted(expected) == sorted(triangles));
+
+        // Rendering again gives the same triangles.
+        renderer.draws.clear();
+        batches.render(renderer, elements, [](const Element&) {});
+        triangles.clear();
+        for (const auto& draw : renderer.draws) {
+            triangles.insert(triangles.end(), draw.begin(), draw.end());
+        }
+        EgoTest_Assert(sorted(expected) == sorted(triangles));
+    }
+
+    EgoTest_Test(updatesColours) {
+        Ego::MeshBatches batches;
+        makeBatches(batches, 8, 8);
+        std::vector<Element> elements = { Element{9, 0} };
+        RecordingRenderer renderer;
+        batches.render(renderer, elements, [](const Element&) {});
+        EgoTest_Assert(sorted(tileTriangles(1, 1, 0.5f)) == sorted(renderer.draws.back()));
+
+        // The colours of a tile are updated after the chunk was uploaded.
+        const float colours[5][3] = {
+            { 0.25f, 0.25f, 0.25f }, { 0.25f, 0.25f, 0.25f }, { 0.25f, 0.25f, 0.25f }, { 0.25f, 0.25f, 0.25f }, { 0.25f, 0.25f, 0.25f },
+        };
+        batches.setColours(9, colours);
+        batches.render(renderer, elements, [](const Element&) {});
+        EgoTest_Assert(sorted(tileTriangles(1, 1, 0.25f)) == sorted(renderer.draws.back()));
+
+        // Replacing the geometry of a tile keeps the colours of the replacement.
+        setTile(batches, 1, 1, 0.75f);
+        batches.render(renderer, elements, [](const Element&) {});
+        EgoTest_Assert(sorted(tileTriangles(1, 1, 0.75f)) == sorted(renderer.draws.back()));
+    }
+
+    EgoTest_Test(skipsTilesWithoutGeometry) {
+        Ego::MeshBatches batches;
+        batches.resize(8, 8);
+        setTile(batches, 2, 0, 0.5f);
+        std::vector<Element> elements = { Element{0, 0}, Element{2, 0}, Element{64, 0} };
+        RecordingRenderer renderer;
+        EgoTest_Assert(1 == batches.render(renderer, elements, [](const Element&) {}));
+        EgoTest_Assert(1 == elements.size() && 2 == elements[0].tile);
+        EgoTest_Assert(4 == renderer.draws[0].size());
+    }
+
+    EgoTest_Test(geometryOfAnotherSize) {
+        Ego::MeshBatches batches;
+        makeBatches(batches, 8, 8);
+        static const uint8_t fanSizes[] = { 4 };
+        static const uint16_t fanVertices[] = { 0, 1, 2, 3 };
+        const Vertex vertices[4] = {};
+        bool thrown = false;
+        try {
+            batches.setTile(0, vertices, 4, fanSizes, 1, fanVertices);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        EgoTest_Assert(thrown);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
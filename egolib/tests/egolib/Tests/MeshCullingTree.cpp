@@ -0,0 +1,141 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Mesh/CullingTree.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(MeshCullingTreeTest) {
+    static constexpr float TILE_SIZE = 128.0f;
+
+    /// A frustum for the view matrix of Egoboo's camera looking from an eye at a center.
+    struct TestFrustum : public Ego::Graphics::Frustum {
+        TestFrustum(const Vector3f& eye, const Vector3f& center) {
+            calculate(Ego::Math::Transform::perspective(Ego::Math::Degrees(60.0f), 4.0f / 3.0f, 1.0f, 1000000.0f),
+                      Ego::Math::Transform::lookAt(eye, center, Vector3f(0.0f, 0.0f, 1.0f)));
+        }
+    };
+
+    /// Make a tree for a hilly mesh.
+    static void makeTree(Ego::MeshCullingTree& tree, int width, int height) {
+        tree.resize(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const float z0 = 200.0f * std::sin(x * 0.3f) * std::cos(y * 0.2f);
+                const float z1 = z0 + 50.0f + 25.0f * ((x + y) % 3);
+                tree.setTileBounds(x + y * width, AxisAlignedBox3f(Point3f(x * TILE_SIZE, y * TILE_SIZE, z0),
+                                                                    Point3f((x + 1) * TILE_SIZE, (y + 1) * TILE_SIZE, z1)));
+            }
+        }
+        tree.update();
+    }
+
+    /// Cull every tile on its own.
+    static std::vector<size_t> cullTiles(const Ego::MeshCullingTree& tree, const Ego::Graphics::Frustum& frustum) {
+        std::vector<size_t> tiles;
+        for (size_t i = 0; i < tree.getTileCount(); ++i) {
+            if (Ego::Math::Relation::outside != frustum.intersects(tree.getTileBounds(i), false)) {
+                tiles.push_back(i);
+            }
+        }
+        return tiles;
+    }
+
+    static std::vector<size_t> cullSorted(const Ego::MeshCullingTree& tree, const Ego::Graphics::Frustum& frustum, const Vector3f& eye, size_t maximum) {
+        std::vector<size_t> tiles;
+        tree.cull(frustum, Point3f::toPoint(eye), maximum, tiles);
+        std::sort(tiles.begin(), tiles.end());
+        return tiles;
+    }
+
+    EgoTest_Test(emptyTree) {
+        Ego::MeshCullingTree tree;
+        tree.resize(0, 0);
+        TestFrustum frustum(Vector3f(0.0f, -500.0f, 1000.0f), Vector3f(0.0f, 0.0f, 0.0f));
+        std::vector<size_t> tiles(3, 0);
+        EgoTest_Assert(0 == tree.cull(frustum, Point3f(0.0f, -500.0f, 1000.0f), 1024, tiles));
+        EgoTest_Assert(tiles.empty());
+    }
+
+    EgoTest_Test(blocks) {
+        Ego::MeshCullingTree tree;
+        tree.resize(Ego::MeshCullingTree::BLOCK_SIZE, Ego::MeshCullingTree::BLOCK_SIZE);
+        EgoTest_Assert(1 == tree.getNodeCount());
+        // A mesh which is not a multiple of the block size.
+        tree.resize(37, 23);
+        EgoTest_Assert(37 * 23 == tree.getTileCount());
+        EgoTest_Assert(tree.getNodeCount() > (10 * 6));
+    }
+
+    EgoTest_Test(sameTilesAsEachTile) {
+        static const int sizes[][2] = { { 64, 64 }, { 37, 23 }, { 5, 130 } };
+        static const Vector3f views[][2] = {
+            // Egoboo's default camera, looking down at an angle.
+            { Vector3f(2048.0f, 1000.0f, 1500.0f), Vector3f(2048.0f, 2048.0f, 0.0f) },
+            // Looking along the mesh, close to the ground.
+            { Vector3f(-200.0f, -200.0f, 300.0f), Vector3f(4000.0f, 3000.0f, 0.0f) },
+            // Looking down from far above.
+            { Vector3f(2000.0f, 1990.0f, 20000.0f), Vector3f(2000.0f, 2000.0f, 0.0f) },
+            // Looking away from the mesh.
+            { Vector3f(-500.0f, -500.0f, 800.0f), Vector3f(-2000.0f, -1500.0f, 0.0f) },
+        };
+        for (const auto& size : sizes) {
+            Ego::MeshCullingTree tree;
+            makeTree(tree, size[0], size[1]);
+            for (const auto& view : views) {
+                TestFrustum frustum(view[0], view[1]);
+                EgoTest_Assert(cullTiles(tree, frustum) == cullSorted(tree, frustum, view[0], tree.getTileCount()));
+            }
+        }
+    }
+
+    EgoTest_Test(tilesBehindTheCameraAreCulled) {
+        Ego::MeshCullingTree tree;
+        makeTree(tree, 64, 64);
+        // The camera in the middle of the mesh looking along the y-axis.
+        const Vector3f eye(32 * TILE_SIZE, 32 * TILE_SIZE, 1000.0f);
+        TestFrustum frustum(eye, Vector3f(32 * TILE_SIZE, 40 * TILE_SIZE, 0.0f));
+        const auto tiles = cullSorted(tree, frustum, eye, tree.getTileCount());
+        EgoTest_Assert(!tiles.empty());
+        for (size_t tile : tiles) {
+            EgoTest_Assert(tree.getTileBounds(tile).getMax()[kY] > eye[kY] - TILE_SIZE);
+        }
+    }
+
+    EgoTest_Test(maximum) {
+        Ego::MeshCullingTree tree;
+        makeTree(tree, 64, 64);
+        const Vector3f eye(2000.0f, 1990.0f, 20000.0f);
+        TestFrustum frustum(eye, Vector3f(2000.0f, 2000.0f, 0.0f));
+        const auto all = cullTiles(tree, frustum);
+        EgoTest_Assert(all.size() > 100);
+        const auto some = cullSorted(tree, frustum, eye, 100);
+        EgoTest_Assert(100 == some.size());
+        EgoTest_Assert(std::includes(all.begin(), all.end(), some.begin(), some.end()));
+        // The nearest tile is kept.
+        const size_t nearest = static_cast<size_t>(eye[kX] / TILE_SIZE) + static_cast<size_t>(eye[kY] / TILE_SIZE) * 64;
+        EgoTest_Assert(std::binary_search(some.begin(), some.end(), nearest));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
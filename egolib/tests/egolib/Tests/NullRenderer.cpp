@@ -0,0 +1,149 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(NullRendererTest) {
+    using Statistics = Ego::Null::Statistics;
+
+    /// A null renderer on the stack rather than the singleton.
+    struct Renderer : public Ego::Null::Renderer {
+        Renderer() : Ego::Null::Renderer() {}
+        virtual ~Renderer() {}
+    };
+
+    EgoTest_Test(countsStateChanges) {
+        Renderer renderer;
+        renderer.setDepthTestEnabled(true);
+        renderer.setDepthTestEnabled(true);
+        renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+        renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+        renderer.setColour(Colour4f::white());
+        renderer.setViewportRectangle(0.0f, 0.0f, 640.0f, 480.0f);
+        renderer.setWorldMatrix(Matrix4f4f::identity());
+        renderer.multiplyMatrix(Matrix4f4f::identity());
+        const Statistics& statistics = renderer.getStatistics();
+        EgoTest_Assert(3 == statistics.stateChanges);
+        // The colour and the world matrix are the initial ones, multiplying with the identity changes nothing.
+        EgoTest_Assert(5 == statistics.redundantStateChanges);
+        EgoTest_Assert(0 == statistics.drawCalls);
+    }
+
+    EgoTest_Test(resetKeepsTheState) {
+        Renderer renderer;
+        renderer.setCullingMode(CullingMode::Back);
+        renderer.getColourBuffer().clear();
+        renderer.resetStatistics();
+        EgoTest_Assert(0 == renderer.getStatistics().stateChanges);
+        EgoTest_Assert(0 == renderer.getStatistics().clears);
+        renderer.setCullingMode(CullingMode::Back);
+        EgoTest_Assert(0 == renderer.getStatistics().stateChanges);
+        EgoTest_Assert(1 == renderer.getStatistics().redundantStateChanges);
+    }
+
+    EgoTest_Test(countsDrawCallsAndVertices) {
+        Renderer renderer;
+        VertexBuffer vertexBuffer(12, VertexFormatFactory::get<VertexFormat::P3F>());
+        IndexBuffer indexBuffer(30, IndexFormatFactory::get<IndexFormat::IU16>());
+        {
+            IndexBufferScopedLock lock(indexBuffer);
+            for (size_t i = 0; i < 30; ++i) {
+                lock.get<uint16_t>()[i] = static_cast<uint16_t>(i % 12);
+            }
+        }
+        renderer.render(vertexBuffer, PrimitiveType::Triangles, 0, 12);
+        renderer.render(vertexBuffer, PrimitiveType::TriangleFan, 8, 4);
+        renderer.render(vertexBuffer, indexBuffer, PrimitiveType::Triangles, 3, 27);
+        EgoTest_Assert(3 == renderer.getStatistics().drawCalls);
+        EgoTest_Assert(12 + 4 + 27 == renderer.getStatistics().vertices);
+        const auto& byPrimitiveType = renderer.getStatistics().drawCallsByPrimitiveType;
+        EgoTest_Assert(2 == byPrimitiveType[static_cast<size_t>(PrimitiveType::Triangles)]);
+        EgoTest_Assert(1 == byPrimitiveType[static_cast<size_t>(PrimitiveType::TriangleFan)]);
+        EgoTest_Assert(0 == byPrimitiveType[static_cast<size_t>(PrimitiveType::Lines)]);
+        bool thrown = false;
+        try {
+            renderer.render(vertexBuffer, PrimitiveType::Triangles, 3, 12);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        EgoTest_Assert(thrown);
+        thrown = false;
+        try {
+            renderer.render(vertexBuffer, indexBuffer, PrimitiveType::Triangles, 0, 33);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        EgoTest_Assert(thrown);
+        // An index of a vertex not in the vertex buffer.
+        {
+            IndexBufferScopedLock lock(indexBuffer);
+            lock.get<uint16_t>()[29] = 12;
+        }
+        thrown = false;
+        try {
+            renderer.render(vertexBuffer, indexBuffer, PrimitiveType::Triangles, 27, 3);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        EgoTest_Assert(thrown);
+        EgoTest_Assert(3 == renderer.getStatistics().drawCalls);
+    }
+
+    EgoTest_Test(countsTextureBinds) {
+        Renderer renderer;
+        auto a = renderer.createTexture(), b = renderer.createTexture();
+        EgoTest_Assert(a && b && a->isDefault());
+        auto& textureUnit = renderer.getTextureUnit();
+        textureUnit.setActivated(a.get());
+        textureUnit.setActivated(a.get());
+        textureUnit.setActivated(b.get());
+        textureUnit.setActivated(nullptr);
+        textureUnit.setActivated(a.get());
+        const Statistics& statistics = renderer.getStatistics();
+        EgoTest_Assert(2 == statistics.textures);
+        EgoTest_Assert(3 == statistics.textureBinds);
+        EgoTest_Assert(4 == statistics.stateChanges);
+        EgoTest_Assert(1 == statistics.redundantStateChanges);
+    }
+
+    EgoTest_Test(countsClears) {
+        Renderer renderer;
+        renderer.getColourBuffer().setClearValue(Colour4f::black());
+        renderer.getDepthBuffer().setClearValue(1.0f);
+        renderer.getColourBuffer().clear();
+        renderer.getDepthBuffer().clear();
+        EgoTest_Assert(2 == renderer.getStatistics().clears);
+        EgoTest_Assert(1 == renderer.getStatistics().stateChanges);
+        EgoTest_Assert(1 == renderer.getStatistics().redundantStateChanges);
+    }
+
+    EgoTest_Test(isABackEnd) {
+        Ego::Renderer::initialize("Null");
+        EgoTest_Assert(nullptr != dynamic_cast<Ego::Null::Renderer *>(&Ego::Renderer::get()));
+        Ego::Renderer::uninitialize();
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,394 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/OctBBKernels.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(OctBBKernelsTest) {
+    static constexpr float PLATTOLERANCE = 50.0f;
+    static constexpr int PHYS_PLATFORM_OBJ1 = 1 << 0, PHYS_PLATFORM_OBJ2 = 1 << 1;
+
+    static std::vector<OctBBKernels::Kernel> kernels() {
+        std::vector<OctBBKernels::Kernel> supported;
+        for (auto kernel : { OctBBKernels::Kernel::Scalar, OctBBKernels::Kernel::SSE2, OctBBKernels::Kernel::AVX }) {
+            if (OctBBKernels::isSupported(kernel)) {
+                supported.push_back(kernel);
+            }
+        }
+        return supported;
+    }
+
+    /// The former join, one axis at a time.
+    static void legacyJoin(const oct_bb_t& src1, const oct_bb_t& src2, oct_bb_t& dst) {
+        for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
+            dst._mins[i] = std::min(src1._mins[i], src2._mins[i]);
+            dst._maxs[i] = std::max(src1._maxs[i], src2._maxs[i]);
+        }
+        dst._empty = oct_bb_t::empty_raw(dst);
+    }
+
+    /// The former intersection, one axis at a time.
+    static oct_bb_t legacyIntersection(const oct_bb_t& src1, const oct_bb_t& src2) {
+        if (src1._empty && src2._empty) {
+            return oct_bb_t();
+        }
+        oct_bb_t dst;
+        for (size_t i = 0; i < (size_t)OCT_COUNT; ++i) {
+            dst._mins[i] = std::max(src1._mins[i], src2._mins[i]);
+            dst._maxs[i] = std::min(src1._maxs[i], src2._maxs[i]);
+        }
+        dst._empty = oct_bb_t::empty_raw(dst);
+        return dst;
+    }
+
+    /// The former phys_expand_oct_bb.
+    static void legacyExpand(const oct_bb_t& src, const Vector3f& vel, const float tmin, const float tmax, oct_bb_t& dst) {
+        if (0.0f == vel.length_abs()) {
+            dst = src;
+            return;
+        }
+        oct_bb_t tmp_min = (0.0f == tmin) ? src : oct_bb_t::translate(src, vel * tmin);
+        oct_bb_t tmp_max = (0.0f == tmax) ? src : oct_bb_t::translate(src, vel * tmax);
+        legacyJoin(tmp_min, tmp_max, dst);
+    }
+
+    /// The former phys_get_collision_depth.
+    static bool legacyDepth(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth) {
+        odepth = oct_vec_v2_t();
+        if (bb_a._empty || bb_b._empty) return false;
+        oct_bb_t otmp = legacyIntersection(bb_a, bb_b);
+        if (otmp.isEmpty()) return false;
+        oct_vec_v2_t opos_a = bb_a.getMid();
+        oct_vec_v2_t opos_b = bb_b.getMid();
+        bool retval = true;
+        for (size_t i = 0; i < OCT_COUNT; ++i) {
+            float fdiff = opos_b[i] - opos_a[i];
+            float fdepth = otmp._maxs[i] - otmp._mins[i];
+            if (fdepth <= 0.0f || 0.0f == fdiff) retval = false;
+            odepth[i] = (fdiff < 0.0f) ? -fdepth : fdepth;
+        }
+        odepth[OCT_XY] *= Ego::Math::invSqrtTwo<float>();
+        odepth[OCT_YX] *= Ego::Math::invSqrtTwo<float>();
+        return retval;
+    }
+
+    /// The former phys_intersect_oct_bb_close_index, for the horizontal axes only.
+    static bool legacyCloseIndex(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax) {
+        float vdiff = ovel2[index] - ovel1[index];
+        if (0.0f == vdiff) return false;
+        float src1_min = src1._mins[index], src1_max = src1._maxs[index], opos1 = (src1_min + src1_max) * 0.5f;
+        float src2_min = src2._mins[index], src2_max = src2._maxs[index], opos2 = (src2_min + src2_max) * 0.5f;
+        bool platform_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1);
+        bool platform_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2);
+        float time[4];
+        if (platform_1 && !platform_2) {
+            time[0] = (src1_min - opos2) / vdiff;
+            time[1] = (src1_max - opos2) / vdiff;
+            *tmin = std::min(time[0], time[1]);
+            *tmax = std::max(time[0], time[1]);
+        } else if (!platform_1 && platform_2) {
+            time[0] = (opos1 - src2_min) / vdiff;
+            time[1] = (opos1 - src2_max) / vdiff;
+            *tmin = std::min(time[0], time[1]);
+            *tmax = std::max(time[0], time[1]);
+        } else {
+            time[0] = (src1_min - opos2) / vdiff;
+            time[1] = (src1_max - opos2) / vdiff;
+            time[2] = (opos1 - src2_min) / vdiff;
+            time[3] = (opos1 - src2_max) / vdiff;
+            *tmin = std::min({ time[0], time[1], time[2], time[3] });
+            *tmax = std::max({ time[0], time[1], time[2], time[3] });
+        }
+        if (OCT_XY == index || OCT_YX == index) {
+            *tmin *= Ego::Math::invSqrtTwo<float>();
+            *tmax *= Ego::Math::invSqrtTwo<float>();
+        }
+        return !(*tmax < *tmin);
+    }
+
+    /// The former phys_intersect_oct_bb_index.
+    static bool legacyIndex(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax) {
+        float vdiff = ovel2[index] - ovel1[index];
+        if (0.0f == vdiff) return false;
+        float src1_min = src1._mins[index], src1_max = src1._maxs[index];
+        float src2_min = src2._mins[index], src2_max = src2._maxs[index];
+        if (OCT_Z != index) {
+            bool close_test_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1) && (src1._mins[OCT_Z] > src2._maxs[OCT_Z]);
+            bool close_test_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2) && (src2._mins[OCT_Z] > src1._maxs[OCT_Z]);
+            if (close_test_1 || close_test_2) {
+                return legacyCloseIndex(index, src1, ovel1, src2, ovel2, test_platform, tmin, tmax);
+            }
+            float time[4];
+            time[0] = (src1_min - src2_min) / vdiff;
+            time[1] = (src1_min - src2_max) / vdiff;
+            time[2] = (src1_max - src2_min) / vdiff;
+            time[3] = (src1_max - src2_max) / vdiff;
+            *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
+            *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
+        } else {
+            float tolerance_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1) ? PLATTOLERANCE : 0.0f;
+            float tolerance_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2) ? PLATTOLERANCE : 0.0f;
+            float time[8];
+            if (0.0f == tolerance_1 && 0.0f == tolerance_2) {
+                time[0] = (src1_min - src2_min) / vdiff;
+                time[1] = (src1_min - src2_max) / vdiff;
+                time[2] = (src1_max - src2_min) / vdiff;
+                time[3] = (src1_max - src2_max) / vdiff;
+                *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
+                *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
+            } else if (0.0f == tolerance_1) {
+                float plat_max = src2_max + tolerance_2;
+                time[0] = (src1_min - src2_min) / vdiff;
+                time[1] = (src1_min - plat_max) / vdiff;
+                time[2] = (src1_max - src2_min) / vdiff;
+                time[3] = (src1_max - plat_max) / vdiff;
+                *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
+                *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
+            } else if (0.0f == tolerance_2) {
+                // The tolerance of the second object is used, as before.
+                float plat_max = src1_max + tolerance_2;
+                time[0] = (src1_min - src2_min) / vdiff;
+                time[1] = (src1_min - src2_max) / vdiff;
+                time[2] = (plat_max - src2_min) / vdiff;
+                time[3] = (plat_max - src2_max) / vdiff;
+                *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
+                *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
+            } else {
+                float plat_max = src2_max + tolerance_2;
+                time[0] = (src1_min - src2_min) / vdiff;
+                time[1] = (src1_min - plat_max) / vdiff;
+                time[2] = (src1_max - src2_min) / vdiff;
+                time[3] = (src1_max - plat_max) / vdiff;
+                plat_max = src1_max + tolerance_2;
+                time[4] = (src1_min - src2_min) / vdiff;
+                time[5] = (src1_min - src2_max) / vdiff;
+                time[6] = (plat_max - src2_min) / vdiff;
+                time[7] = (plat_max - src2_max) / vdiff;
+                *tmin = std::min(std::min({ time[0], time[1], time[2], time[3] }), std::min({ time[4], time[5], time[6], time[7] }));
+                *tmax = std::max(std::max({ time[0], time[1], time[2], time[3] }), std::max({ time[4], time[5], time[6], time[7] }));
+            }
+        }
+        if (OCT_XY == index || OCT_YX == index) {
+            *tmin *= Ego::Math::invSqrtTwo<float>();
+            *tmax *= Ego::Math::invSqrtTwo<float>();
+        }
+        return !(*tmax <= *tmin);
+    }
+
+    /// A coordinate, often a small integer such that boxes touch and times tie.
+    static float aCoordinate(std::mt19937& generator) {
+        std::uniform_int_distribution<int> kind(0, 3), integer(-3, 3);
+        std::uniform_real_distribution<float> real(-100.0f, 100.0f);
+        return (0 == kind(generator)) ? real(generator) : static_cast<float>(integer(generator));
+    }
+
+    /// A bounding box, sometimes inverted along an axis or flagged empty.
+    static oct_bb_t aBox(std::mt19937& generator) {
+        std::uniform_int_distribution<int> percent(0, 99);
+        oct_bb_t box;
+        for (size_t i = 0; i < OCT_COUNT; ++i) {
+            float a = aCoordinate(generator), b = aCoordinate(generator);
+            if (a > b && percent(generator) < 95) std::swap(a, b);
+            box._mins[i] = a;
+            box._maxs[i] = b;
+        }
+        box._empty = oct_bb_t::empty_raw(box) || percent(generator) < 5;
+        return box;
+    }
+
+    static Vector3f aVelocity(std::mt19937& generator) {
+        std::uniform_int_distribution<int> kind(0, 2);
+        Vector3f velocity;
+        for (size_t i = 0; i < 3; ++i) {
+            const int k = kind(generator);
+            velocity[i] = (0 == k) ? 0.0f : ((1 == k) ? aCoordinate(generator) : aCoordinate(generator) * 0.01f);
+        }
+        return velocity;
+    }
+
+    static bool same(float x, float y) {
+        return x == y || (std::isnan(x) && std::isnan(y));
+    }
+
+    static bool same(const oct_vec_v2_t& x, const oct_vec_v2_t& y) {
+        for (size_t i = 0; i < OCT_COUNT; ++i) {
+            if (!same(x[i], y[i])) return false;
+        }
+        return true;
+    }
+
+    static bool same(const oct_bb_t& x, const oct_bb_t& y) {
+        return x._empty == y._empty && same(x._mins, y._mins) && same(x._maxs, y._maxs);
+    }
+
+    /// The padding of the vectors stays zero.
+    static bool padded(const oct_vec_v2_t& x) {
+        for (size_t i = OCT_COUNT; i < oct_vec_v2_t::LANES; ++i) {
+            if (0.0f != x._v[i]) return false;
+        }
+        return true;
+    }
+
+    static bool padded(const oct_bb_t& x) {
+        return padded(x._mins) && padded(x._maxs);
+    }
+
+    EgoTest_Test(testJoinAndIntersectionMatchLegacy) {
+        std::mt19937 generator(47);
+        for (auto kernel : kernels()) {
+            for (int i = 0; i < 20000; ++i) {
+                const oct_bb_t src1 = aBox(generator), src2 = aBox(generator);
+                oct_bb_t expected, actual;
+                legacyJoin(src1, src2, expected);
+                OctBBKernels::join(kernel, src1, src2, actual);
+                EgoTest_Assert(same(expected, actual));
+                EgoTest_Assert(padded(actual));
+
+                //The destination may be a source
+                actual = src1;
+                OctBBKernels::join(kernel, actual, src2, actual);
+                EgoTest_Assert(same(expected, actual));
+
+                expected = legacyIntersection(src1, src2);
+                actual = OctBBKernels::intersection(kernel, src1, src2);
+                EgoTest_Assert(same(expected, actual));
+                EgoTest_Assert(padded(actual));
+            }
+        }
+    }
+
+    EgoTest_Test(testExpandMatchesLegacy) {
+        std::mt19937 generator(53);
+        std::uniform_real_distribution<float> times(0.0f, 1.0f);
+        for (auto kernel : kernels()) {
+            for (int i = 0; i < 20000; ++i) {
+                const oct_bb_t src = aBox(generator);
+                const Vector3f vel = aVelocity(generator);
+                const float tmin = (0 == i % 3) ? 0.0f : times(generator), tmax = (0 == i % 5) ? 1.0f : times(generator);
+                oct_bb_t expected, actual;
+                legacyExpand(src, vel, tmin, tmax, expected);
+                OctBBKernels::expand(kernel, src, vel, tmin, tmax, actual);
+                EgoTest_Assert(same(expected, actual));
+                EgoTest_Assert(padded(actual));
+
+                //The destination may be the source
+                actual = src;
+                OctBBKernels::expand(kernel, actual, vel, tmin, tmax, actual);
+                EgoTest_Assert(same(expected, actual));
+            }
+        }
+    }
+
+    EgoTest_Test(testDepthMatchesLegacy) {
+        std::mt19937 generator(59);
+        for (auto kernel : kernels()) {
+            for (int i = 0; i < 20000; ++i) {
+                const oct_bb_t bb_a = aBox(generator), bb_b = aBox(generator);
+                oct_vec_v2_t expected, actual;
+                const bool expectedResult = legacyDepth(bb_a, bb_b, expected);
+                const bool actualResult = OctBBKernels::getCollisionDepth(kernel, bb_a, bb_b, actual);
+                EgoTest_Assert(expectedResult == actualResult);
+                EgoTest_Assert(same(expected, actual));
+                EgoTest_Assert(padded(actual));
+            }
+        }
+    }
+
+    EgoTest_Test(testSweepMatchesLegacy) {
+        std::mt19937 generator(61);
+        for (auto kernel : kernels()) {
+            for (int i = 0; i < 20000; ++i) {
+                const oct_bb_t src1 = aBox(generator), src2 = aBox(generator);
+                const oct_vec_v2_t ovel1(aVelocity(generator)), ovel2(aVelocity(generator));
+                for (int test_platform = 0; test_platform < 4; ++test_platform) {
+                    oct_vec_v2_t tmin, tmax;
+                    const unsigned axes = OctBBKernels::sweep(kernel, src1, ovel1, src2, ovel2,
+                                                              HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1), HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2),
+                                                              PLATTOLERANCE, tmin, tmax);
+                    EgoTest_Assert(padded(tmin) && padded(tmax));
+                    for (int index = 0; index < OCT_COUNT; ++index) {
+                        float expectedMin = 0.0f, expectedMax = 0.0f;
+                        const bool expected = legacyIndex(index, src1, ovel1, src2, ovel2, test_platform, &expectedMin, &expectedMax);
+                        EgoTest_Assert(expected == HAS_SOME_BITS(axes, 1u << index));
+                        if (expected) {
+                            EgoTest_Assert(same(expectedMin, tmin[index]));
+                            EgoTest_Assert(same(expectedMax, tmax[index]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    EgoTest_Test(testBatchesMatchSingleCalls) {
+        std::mt19937 generator(67);
+        std::vector<oct_bb_t> boxes;
+        std::vector<oct_vec_v2_t> ovels;
+        for (int i = 0; i < 257; ++i) {
+            boxes.push_back(aBox(generator));
+            ovels.push_back(oct_vec_v2_t(aVelocity(generator)));
+        }
+        for (auto kernel : kernels()) {
+            for (int i = 0; i < 20; ++i) {
+                const oct_bb_t box = aBox(generator);
+                const oct_vec_v2_t ovel(aVelocity(generator));
+
+                std::unique_ptr<bool[]> results(new bool[boxes.size()]);
+                size_t overlapping = 0;
+                for (size_t j = 0; j < boxes.size(); ++j) {
+                    overlapping += legacyIntersection(box, boxes[j]).isEmpty() ? 0 : 1;
+                }
+                EgoTest_Assert(overlapping == OctBBKernels::overlaps(kernel, box, boxes.data(), boxes.size(), results.get()));
+                for (size_t j = 0; j < boxes.size(); ++j) {
+                    EgoTest_Assert(results[j] == !legacyIntersection(box, boxes[j]).isEmpty());
+                }
+
+                const bool platform1 = 0 != (i & 1), platform2 = 0 != (i & 2);
+                std::vector<oct_vec_v2_t> tmins(boxes.size()), tmaxs(boxes.size());
+                std::vector<unsigned> axes(boxes.size());
+                OctBBKernels::sweep(kernel, box, ovel, boxes.data(), ovels.data(), boxes.size(), platform1, platform2, PLATTOLERANCE,
+                                    tmins.data(), tmaxs.data(), axes.data());
+                for (size_t j = 0; j < boxes.size(); ++j) {
+                    oct_vec_v2_t tmin, tmax;
+                    EgoTest_Assert(axes[j] == OctBBKernels::sweep(OctBBKernels::Kernel::Scalar, box, ovel, boxes[j], ovels[j], platform1, platform2, PLATTOLERANCE, tmin, tmax));
+                    for (int index = 0; index < OCT_COUNT; ++index) {
+                        if (HAS_SOME_BITS(axes[j], 1u << index)) {
+                            EgoTest_Assert(same(tmin[index], tmins[j][index]) && same(tmax[index], tmaxs[j][index]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    EgoTest_Test(testSetKernel) {
+        const OctBBKernels::Kernel kernel = OctBBKernels::getKernel();
+        EgoTest_Assert(OctBBKernels::isSupported(kernel));
+        EgoTest_Assert(OctBBKernels::setKernel(OctBBKernels::Kernel::Scalar));
+        EgoTest_Assert(OctBBKernels::Kernel::Scalar == OctBBKernels::getKernel());
+        EgoTest_Assert(OctBBKernels::setKernel(kernel));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
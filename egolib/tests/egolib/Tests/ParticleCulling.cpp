@@ -0,0 +1,174 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Graphics/ParticleCulling.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(ParticleCullingTest) {
+    /// A frustum looking from an eye at a center.
+    struct TestFrustum : public Ego::Graphics::Frustum {
+        TestFrustum(const Vector3f& eye, const Vector3f& center) {
+            calculate(Ego::Math::Transform::perspective(Ego::Math::Degrees(60.0f), 4.0f / 3.0f, 1.0f, 1000000.0f),
+                      Ego::Math::Transform::lookAt(eye, center, Vector3f(0.0f, 0.0f, 1.0f)));
+        }
+    };
+
+    struct TestParticle {
+        Sphere3f sphere, reflectedSphere;
+        bool lowPriority;
+    };
+
+    /// Particles spread over an area of 8192 x 8192, reflected at elevation 0.
+    static std::vector<TestParticle> someParticles(size_t count) {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<float> coordinate(0.0f, 8192.0f), elevation(0.0f, 512.0f), radius(1.0f, 64.0f);
+        std::vector<TestParticle> particles;
+        for (size_t i = 0; i < count; ++i) {
+            const Point3f center(coordinate(generator), coordinate(generator), elevation(generator));
+            const float r = radius(generator);
+            particles.push_back(TestParticle{Sphere3f(center, r), Sphere3f(Point3f(center[kX], center[kY], -center[kZ]), r), 0 == i % 2});
+        }
+        return particles;
+    }
+
+    static void addAll(Ego::Graphics::ParticleCulling& culling, const std::vector<TestParticle>& particles) {
+        culling.clear();
+        for (size_t i = 0; i < particles.size(); ++i) {
+            culling.add(i, particles[i].sphere, particles[i].reflectedSphere, particles[i].lowPriority);
+        }
+    }
+
+    EgoTest_Test(noParticles) {
+        Ego::Graphics::ParticleCulling culling;
+        TestFrustum frustum(Vector3f(0.0f, -500.0f, 1000.0f), Vector3f(0.0f, 0.0f, 0.0f));
+        std::vector<Ego::Graphics::ParticleCulling::Visible> visible(3);
+        culling.cull(frustum, Point3f(0.0f, -500.0f, 1000.0f), 1024, visible);
+        EgoTest_Assert(visible.empty());
+        EgoTest_Assert(0 == culling.getStatistics().particles);
+        EgoTest_Assert(0 == culling.getStatistics().submitted);
+    }
+
+    EgoTest_Test(sameParticlesAsEachParticle) {
+        static const Vector3f views[][2] = {
+            { Vector3f(4096.0f, 3000.0f, 1500.0f), Vector3f(4096.0f, 4096.0f, 0.0f) },
+            { Vector3f(-200.0f, -200.0f, 300.0f), Vector3f(8000.0f, 6000.0f, 0.0f) },
+            { Vector3f(4000.0f, 3990.0f, 20000.0f), Vector3f(4000.0f, 4000.0f, 0.0f) },
+            { Vector3f(-500.0f, -500.0f, 800.0f), Vector3f(-2000.0f, -1500.0f, 0.0f) },
+        };
+        const auto particles = someParticles(2000);
+        Ego::Graphics::ParticleCulling culling;
+        // Nothing is dropped.
+        culling.setDistances(1.0e6f, 1.0e6f);
+        for (const auto& view : views) {
+            TestFrustum frustum(view[0], view[1]);
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < particles.size(); ++i) {
+                if (Ego::Math::Relation::outside != frustum.intersects(particles[i].sphere, false) ||
+                    Ego::Math::Relation::outside != frustum.intersects(particles[i].reflectedSphere, false)) {
+                    expected.push_back(i);
+                }
+            }
+            addAll(culling, particles);
+            std::vector<Ego::Graphics::ParticleCulling::Visible> visible;
+            culling.cull(frustum, Point3f::toPoint(view[0]), particles.size(), visible);
+            std::vector<size_t> indices;
+            for (const auto& particle : visible) {
+                indices.push_back(particle.index);
+                EgoTest_Assert(1 == particle.updateInterval);
+            }
+            EgoTest_Assert(expected == indices);
+
+            const auto& statistics = culling.getStatistics();
+            EgoTest_Assert(particles.size() == statistics.particles);
+            EgoTest_Assert(expected.size() == statistics.submitted);
+            EgoTest_Assert(particles.size() - expected.size() == statistics.culled);
+            EgoTest_Assert(0 == statistics.dropped);
+        }
+    }
+
+    EgoTest_Test(levelOfDetail) {
+        const Point3f eye(0.0f, 0.0f, 20000.0f);
+        TestFrustum frustum(Vector3f(0.0f, 0.0f, 20000.0f), Vector3f(0.0f, 10.0f, 0.0f));
+        Ego::Graphics::ParticleCulling culling;
+        culling.setDistances(20100.0f, 20500.0f);
+        // Below the eye at distances 20000, 20200, 20600 and 20600 (low priority) and 40400.
+        culling.add(0, Sphere3f(Point3f(0.0f, 0.0f, 0.0f), 8.0f), Sphere3f(Point3f(0.0f, 0.0f, 0.0f), 8.0f), false);
+        culling.add(1, Sphere3f(Point3f(0.0f, 0.0f, -200.0f), 8.0f), Sphere3f(Point3f(0.0f, 0.0f, 200.0f), 8.0f), false);
+        culling.add(2, Sphere3f(Point3f(0.0f, 0.0f, -600.0f), 8.0f), Sphere3f(Point3f(0.0f, 0.0f, 600.0f), 8.0f), false);
+        culling.add(3, Sphere3f(Point3f(0.0f, 0.0f, -600.0f), 8.0f), Sphere3f(Point3f(0.0f, 0.0f, 600.0f), 8.0f), true);
+        culling.add(4, Sphere3f(Point3f(0.0f, 0.0f, -20400.0f), 8.0f), Sphere3f(Point3f(0.0f, 0.0f, 20400.0f), 8.0f), false);
+        std::vector<Ego::Graphics::ParticleCulling::Visible> visible;
+        culling.cull(frustum, eye, 1024, visible);
+        EgoTest_Assert(4 == visible.size());
+        EgoTest_Assert(0 == visible[0].index && 1 == visible[0].updateInterval);
+        EgoTest_Assert(1 == visible[1].index && 2 == visible[1].updateInterval);
+        EgoTest_Assert(2 == visible[2].index && 2 == visible[2].updateInterval);
+        EgoTest_Assert(4 == visible[3].index && 4 == visible[3].updateInterval);
+        EgoTest_Assert(1 == culling.getStatistics().dropped);
+        EgoTest_Assert(3 == culling.getStatistics().reduced);
+    }
+
+    EgoTest_Test(maximumKeepsTheNearest) {
+        const auto particles = someParticles(2000);
+        const Vector3f eye(4000.0f, 3990.0f, 20000.0f);
+        TestFrustum frustum(eye, Vector3f(4000.0f, 4000.0f, 0.0f));
+        Ego::Graphics::ParticleCulling culling;
+        culling.setDistances(1.0e6f, 1.0e6f);
+        addAll(culling, particles);
+        std::vector<Ego::Graphics::ParticleCulling::Visible> all, some;
+        culling.cull(frustum, Point3f::toPoint(eye), particles.size(), all);
+        EgoTest_Assert(all.size() > 100);
+        culling.cull(frustum, Point3f::toPoint(eye), 100, some);
+        EgoTest_Assert(100 == some.size());
+        EgoTest_Assert(all.size() - 100 == culling.getStatistics().dropped);
+        float farthest = 0.0f;
+        for (const auto& particle : some) {
+            farthest = std::max(farthest, particle.distance);
+        }
+        size_t nearer = 0;
+        for (const auto& particle : all) {
+            if (particle.distance <= farthest) {
+                nearer++;
+            }
+        }
+        EgoTest_Assert(100 == nearer);
+    }
+
+    EgoTest_Test(needsUpdate) {
+        EgoTest_Assert(Ego::Graphics::ParticleCulling::needsUpdate(1, 7, 3));
+        // Every particle is updated once within its interval, different particles in different updates.
+        for (size_t index = 0; index < 4; ++index) {
+            size_t updates = 0;
+            for (uint32_t update = 100; update < 104; ++update) {
+                if (Ego::Graphics::ParticleCulling::needsUpdate(4, update, index)) {
+                    updates++;
+                }
+            }
+            EgoTest_Assert(1 == updates);
+        }
+        EgoTest_Assert(Ego::Graphics::ParticleCulling::needsUpdate(2, 10, 0) != Ego::Graphics::ParticleCulling::needsUpdate(2, 10, 1));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,198 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/AI/PathFinder.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(PathFinding) {
+    using PathGraph = Ego::AI::PathGraph;
+    using PathFinder = Ego::AI::PathFinder;
+
+    /// A grid from rows of text, '#' is a wall.
+    static std::shared_ptr<PathGraph> aGraph(const std::vector<std::string>& rows) {
+        const int width = static_cast<int>(rows[0].size()), height = static_cast<int>(rows.size());
+        std::vector<uint8_t> passable(width * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                passable[y * width + x] = ('#' != rows[y][x]) ? 1 : 0;
+            }
+        }
+        return std::make_shared<PathGraph>(width, height, passable);
+    }
+
+    /// A large grid of rooms: walls every 10 tiles with a door at a random place.
+    static std::shared_ptr<PathGraph> aMaze(int size, unsigned seed) {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> door(1, 8);
+        std::vector<uint8_t> passable(size * size, 1);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (0 == x % 10 && 0 != y % 10 && door(generator) > 1) passable[y * size + x] = 0;
+                if (0 == y % 10 && 0 != x % 10 && door(generator) > 1) passable[y * size + x] = 0;
+            }
+        }
+        return std::make_shared<PathGraph>(size, size, passable);
+    }
+
+    /// A path is valid if every step is to a neighbouring passable tile and it ends at the target.
+    static bool isValid(const PathGraph& graph, int sourceX, int sourceY, int targetX, int targetY, const std::vector<int>& path) {
+        int x = sourceX, y = sourceY;
+        for (int tile : path) {
+            const int nx = tile % graph.getWidth(), ny = tile / graph.getWidth();
+            if (std::abs(nx - x) + std::abs(ny - y) != 1 || !graph.isPassable(nx, ny)) {
+                return false;
+            }
+            x = nx;
+            y = ny;
+        }
+        return x == targetX && y == targetY;
+    }
+
+    EgoTest_Test(runPathFindingTestOpen) {
+        auto graph = aGraph({
+            "........",
+            "........",
+            "........",
+        });
+        PathFinder finder;
+        std::vector<int> path;
+        EgoTest_Assert(finder.find(*graph, 0, 0, 7, 2, path));
+        EgoTest_Assert(9 == path.size());
+        EgoTest_Assert(isValid(*graph, 0, 0, 7, 2, path));
+    }
+
+    EgoTest_Test(runPathFindingTestWall) {
+        auto graph = aGraph({
+            "...#....",
+            "...#....",
+            "...#....",
+            "........",
+        });
+        PathFinder finder;
+        std::vector<int> path;
+        EgoTest_Assert(finder.find(*graph, 0, 0, 7, 0, path));
+        EgoTest_Assert(isValid(*graph, 0, 0, 7, 0, path));
+        EgoTest_Assert(13 == path.size());
+
+        //Walled off
+        auto closed = aGraph({
+            "...#....",
+            "...#....",
+            "...#....",
+            "...#....",
+        });
+        EgoTest_Assert(!finder.find(*closed, 0, 0, 7, 0, path));
+    }
+
+    EgoTest_Test(runPathFindingTestLongRange) {
+        //Paths across many regions are found through the portals, they are valid and close to the shortest
+        auto graph = aMaze(160, 3);
+        PathFinder finder, reference;
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int> coordinate(0, 159);
+        size_t found = 0;
+        for (size_t i = 0; i < 200; ++i) {
+            const int sx = coordinate(generator), sy = coordinate(generator);
+            const int tx = coordinate(generator), ty = coordinate(generator);
+            if (!graph->isPassable(sx, sy) || !graph->isPassable(tx, ty)) {
+                continue;
+            }
+            std::vector<int> path, shortest;
+            const bool reachable = reference.search(*graph, sy * 160 + sx, ty * 160 + tx, PathFinder::Bounds{ 0, 0, 160, 160 }, &shortest);
+            const bool result = finder.find(*graph, sx, sy, tx, ty, path);
+            EgoTest_Assert(reachable == result);
+            if (result) {
+                found++;
+                EgoTest_Assert(isValid(*graph, sx, sy, tx, ty, path));
+                EgoTest_Assert(path.size() <= shortest.size() * 3 / 2 + 2 * PathGraph::REGION_SIZE);
+            }
+        }
+        EgoTest_Assert(found > 100);
+    }
+
+    EgoTest_Test(runPathFindingTestNeighbourFallback) {
+        //Regions next to each other: a detour out of the two regions is found on the whole mesh ...
+        const int size = 128;
+        std::vector<std::string> rows(size, std::string(size, '.'));
+        for (int y = 0; y < 40; ++y) {
+            rows[y][16] = '#';
+        }
+        PathFinder finder;
+        std::vector<int> path;
+        EgoTest_Assert(finder.find(*aGraph(rows), 8, 0, 24, 0, path));
+        EgoTest_Assert(isValid(*aGraph(rows), 8, 0, 24, 0, path));
+        EgoTest_Assert(16 + 2 * 40 == path.size());
+
+        //... but a target which can not be reached does not search the whole mesh
+        for (int x = 20; x < 29; ++x) {
+            rows[20][x] = rows[28][x] = '#';
+        }
+        for (int y = 20; y < 29; ++y) {
+            rows[y][20] = rows[y][28] = '#';
+        }
+        const size_t before = finder.getExpandedCount();
+        EgoTest_Assert(!finder.find(*aGraph(rows), 8, 24, 24, 24, path));
+        EgoTest_Assert(path.empty());
+        EgoTest_Assert(finder.getExpandedCount() - before <= 4 * PathGraph::REGION_SIZE * PathGraph::REGION_SIZE + PathFinder::MAX_FALLBACK_EXPANDED);
+        EgoTest_Assert(finder.getExpandedCount() - before < size * size / 2);
+    }
+
+    EgoTest_Test(runPathFindingTestCache) {
+        //The second query between the same regions starts from the cached path and expands fewer tiles
+        auto graph = aMaze(160, 5);
+        PathFinder finder;
+        std::vector<int> path;
+        //Rooms in opposite corners which are connected
+        int sx = 5, sy = 5, tx = 155, ty = 155;
+        while (!finder.search(*graph, sy * 160 + sx, ty * 160 + tx, PathFinder::Bounds{ 0, 0, 160, 160 }, nullptr)) {
+            sx += 10;
+        }
+        const size_t before = finder.getExpandedCount();
+        EgoTest_Assert(finder.find(*graph, sx, sy, tx, ty, path));
+        const size_t first = finder.getExpandedCount() - before;
+        EgoTest_Assert(finder.find(*graph, sx, sy, tx, ty, path));
+        const size_t second = finder.getExpandedCount() - before - first;
+        EgoTest_Assert(isValid(*graph, sx, sy, tx, ty, path));
+        EgoTest_Assert(second < first);
+    }
+
+    EgoTest_Test(runPathFindingTestGraphCache) {
+        Ego::AI::PathGraphCache cache;
+        size_t calls = 0;
+        auto passable = [&calls](int, int, uint32_t) { calls++; return true; };
+        auto first = cache.get(32, 32, 1, passable);
+        EgoTest_Assert(32 * 32 == calls);
+        EgoTest_Assert(first == cache.get(32, 32, 1, passable));
+        EgoTest_Assert(32 * 32 == calls);
+        //Another set of blocking FX has its own graph
+        EgoTest_Assert(first != cache.get(32, 32, 2, passable));
+        EgoTest_Assert(2 * 32 * 32 == calls);
+        //Invalidated graphs are rebuilt
+        cache.invalidate();
+        EgoTest_Assert(first != cache.get(32, 32, 1, passable));
+        EgoTest_Assert(3 * 32 * 32 == calls);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
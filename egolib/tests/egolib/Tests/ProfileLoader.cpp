@@ -0,0 +1,163 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Profiles/ProfileLoader.hpp"
+
+namespace Ego {
+namespace Test {
+
+namespace {
+
+/// A module's objects folder: the slot in each data.txt and which objects fail to read
+struct TestObjects {
+    std::map<std::string, int> slots;
+    std::set<std::string> broken;
+    std::set<std::string> throwing;
+};
+
+/// Records what ends up in the slots and in which order it was stored
+struct TestSource {
+    TestSource(const TestObjects& objects, const std::set<int>& preloaded) : objects(objects), loaded(), order() {
+        for (int slot : preloaded) {
+            loaded[slot] = std::make_shared<std::string>("preloaded");
+        }
+    }
+    const TestObjects& objects;
+    std::map<int, std::shared_ptr<std::string>> loaded;
+    std::vector<std::string> order;
+
+    int getSlot(const std::string& folderPath) {
+        if (objects.throwing.count(folderPath)) {
+            throw std::runtime_error(folderPath);
+        }
+        auto it = objects.slots.find(folderPath);
+        return it == objects.slots.end() ? -1 : it->second;
+    }
+    std::shared_ptr<std::string> read(const std::string& folderPath, int slot) {
+        if (objects.broken.count(folderPath)) {
+            return nullptr;
+        }
+        return std::make_shared<std::string>(folderPath);
+    }
+    bool isLoaded(int slot) const {
+        return loaded.find(slot) != loaded.end();
+    }
+    void store(int slot, const std::shared_ptr<std::string>& profile) {
+        loaded[slot] = profile;
+        order.push_back(*profile);
+    }
+    void failed(const std::string& folderPath, int slot) {
+        order.push_back("failed " + folderPath);
+    }
+    /// Load one object, like ProfileSystem::loadOneProfile()
+    bool loadOne(const std::string& folderPath) {
+        int slot = getSlot(folderPath);
+        if (slot < 0 || slot >= 64 || isLoaded(slot)) {
+            return false;
+        }
+        std::shared_ptr<std::string> profile = read(folderPath, slot);
+        if (!profile) {
+            failed(folderPath, slot);
+            return false;
+        }
+        store(slot, profile);
+        return true;
+    }
+};
+
+TestObjects makeTestObjects(std::vector<std::string>& folderPaths) {
+    TestObjects objects;
+    for (size_t i = 0; i < 200; ++i) {
+        std::string folderPath = "mp_objects/object" + std::to_string(i) + ".obj";
+        folderPaths.push_back(folderPath);
+        if (i % 13 == 0) continue;                          // no data.txt
+        objects.slots[folderPath] = (i * 7) % 70;           // some slots twice, some out of range
+        if (i % 5 == 0) objects.broken.insert(folderPath);
+    }
+    return objects;
+}
+
+} // namespace
+
+EgoTest_TestCase(ProfileLoader) {
+    EgoTest_Test(runProfileLoaderTestSequentialParallel) {
+        std::vector<std::string> folderPaths;
+        TestObjects objects = makeTestObjects(folderPaths);
+        const std::set<int> preloaded = { 3, 17 };
+
+        //Reference: one object after another
+        TestSource expected(objects, preloaded);
+        size_t expectedCount = 0;
+        for (const std::string& folderPath : folderPaths) {
+            if (expected.loadOne(folderPath)) {
+                expectedCount++;
+            }
+        }
+
+        for (size_t workers : { 0, 1, 3 }) {
+            Ego::Core::JobSystem jobSystem(workers);
+            TestSource parallel(objects, preloaded);
+            EgoTest_Assert(expectedCount == Ego::loadProfiles(&jobSystem, parallel, folderPaths, 64));
+            EgoTest_Assert(expected.order == parallel.order);
+            EgoTest_Assert(expected.loaded.size() == parallel.loaded.size());
+            for (const auto& slot : expected.loaded) {
+                EgoTest_Assert(parallel.loaded.count(slot.first) && *slot.second == *parallel.loaded[slot.first]);
+            }
+        }
+
+        //Without a job system
+        TestSource sequential(objects, preloaded);
+        EgoTest_Assert(expectedCount == Ego::loadProfiles(nullptr, sequential, folderPaths, 64));
+        EgoTest_Assert(expected.order == sequential.order);
+    }
+
+    EgoTest_Test(runProfileLoaderTestException) {
+        std::vector<std::string> folderPaths;
+        TestObjects objects = makeTestObjects(folderPaths);
+        objects.throwing.insert(folderPaths[100]);
+
+        //The objects before the failing folder are stored, none after it
+        TestSource expected(objects, {});
+        bool expectedThrown = false;
+        try {
+            for (const std::string& folderPath : folderPaths) {
+                expected.loadOne(folderPath);
+            }
+        } catch (const std::runtime_error&) {
+            expectedThrown = true;
+        }
+
+        Ego::Core::JobSystem jobSystem(3);
+        TestSource parallel(objects, {});
+        bool thrown = false;
+        try {
+            Ego::loadProfiles(&jobSystem, parallel, folderPaths, 64);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        EgoTest_Assert(expectedThrown && thrown);
+        EgoTest_Assert(expected.order == parallel.order);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,274 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Tests/ScriptCompilation.cpp
+/// @brief  A script compiled ahead of time must behave like the interpreted script.
+/// @remark ScriptCompilation.inl is the output of CodeGenerator for aList(), runScriptCompilationTestGenerate
+///         fails if it is not. If the generator changes, regenerate it from the output of that test.
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Script/script.h"
+#include "egolib/Script/Interpreter/CodeGenerator.hpp"
+
+namespace Ego {
+namespace Test {
+namespace ScriptCompilationFixture {
+
+using Function = Ego::Script::NativeInterface::Function;
+using Program = Ego::Script::Interpreter::Program<Function>;
+
+inline uint8_t scr_IfAlertA(script_state_t& state, ai_state_t& self) { self.x[0] = self.x[0] * 10 + 1; return 0 != (self.alert & 1); }
+inline uint8_t scr_IfAlertB(script_state_t& state, ai_state_t& self) { self.x[0] = self.x[0] * 10 + 2; return 0 != (self.alert & 2); }
+inline uint8_t scr_Count(script_state_t& state, ai_state_t& self) { self.x[0] = self.x[0] * 10 + 3; self.content += state.x + state.y; return true; }
+inline uint8_t scr_Terminate(script_state_t& state, ai_state_t& self) { self.x[0] = self.x[0] * 10 + 4; self.terminate = true; return true; }
+
+/// Stands in for Ego::Script::ScriptOperands, which needs the game's objects. The arithmetic is the interpreter's.
+struct Operands {
+    bool _exists;
+    explicit Operands(ai_state_t& aiState) : _exists(0 == (aiState.alert & 4)) {}
+    explicit operator bool() const { return _exists; }
+    int32_t load(script_state_t& state, ai_state_t& aiState, uint8_t variable) const {
+        switch (variable) {
+            case Ego::Script::VARTMPX: return state.x;
+            case Ego::Script::VARTMPY: return state.y;
+            case Ego::Script::VARTMPDISTANCE: return state.distance;
+            case Ego::Script::VARTMPTURN: return state.turn;
+            case Ego::Script::VARTMPARGUMENT: return state.argument;
+            case Ego::Script::VARSELFSTATE: return aiState.state;
+            default: return 0;
+        }
+    }
+    static void apply(script_state_t& state, uint8_t operation, int32_t value) {
+        script_state_t::run_operator(state, operation, value);
+    }
+    static void store(script_state_t& state, uint8_t variable) {
+        script_state_t::set_operand(state, variable);
+    }
+    static bool call(script_state_t& state, ai_state_t& aiState, script_info_t& script, uint32_t value) {
+        aiState.x[0] = aiState.x[0] * 10 + 5;
+        return 0 != (value & 1);
+    }
+    static bool invoke(script_state_t& state, ai_state_t& aiState, script_info_t& script, const script_state_t::Instruction& instruction) {
+        return 0 != instruction.function(state, aiState);
+    }
+    static void traceAssignment(const script_info_t& script, uint8_t variable) {}
+    static void traceOperand(const script_state_t::Operand& operand, int32_t value) {}
+    static void traceResult(const script_state_t& state) {}
+};
+
+namespace Compiled {
+#include "egolib/Tests/ScriptCompilation.inl"
+} // namespace Compiled
+
+} // namespace ScriptCompilationFixture
+
+EgoTest_TestCase(ScriptCompilation) {
+    using Function = ScriptCompilationFixture::Function;
+    using Program = ScriptCompilationFixture::Program;
+    using Operands = ScriptCompilationFixture::Operands;
+
+    static std::array<Function *, 4> getFunctions() {
+        using namespace ScriptCompilationFixture;
+        return std::array<Function *, 4>{ { &scr_IfAlertA, &scr_IfAlertB, &scr_Count, &scr_Terminate } };
+    }
+
+    static std::vector<std::string> getFunctionNames() {
+        return { "IfAlertA", "IfAlertB", "Count", "Terminate" };
+    }
+
+    static Instruction aCall(uint32_t function, uint32_t indent) {
+        return Instruction(Instruction::FUNCTIONBITS | ((indent & 0x0f) << 27) | function);
+    }
+
+    static Instruction anOperand(uint32_t operation, uint32_t value, bool isConstant) {
+        return Instruction((isConstant ? Instruction::FUNCTIONBITS : 0) | (operation << 27) | value);
+    }
+
+    static InstructionList aList() {
+        using namespace Ego::Script;
+        InstructionList list;
+        // IfAlertA
+        list.append(aCall(0, 0));
+        const size_t endA = list.getLength();
+        list.append(Instruction(0));
+        //   Count
+        list.append(aCall(2, 1));
+        list.append(Instruction(list.getLength() + 1));
+        //   tmpy = 7 - tmpturn + tmpy
+        list.append(Instruction((1 << 27) | VARTMPY));
+        list.append(Instruction(3));
+        list.append(anOperand(OPADD, 7, true));
+        list.append(anOperand(OPSUB, VARTMPTURN, false));
+        list.append(anOperand(OPADD, VARTMPY, false));
+        //   IfAlertB
+        list.append(aCall(1, 1));
+        const size_t endB = list.getLength();
+        list.append(Instruction(0));
+        //     Terminate
+        list.append(aCall(3, 2));
+        list.append(Instruction(list.getLength() + 1));
+        list[endB] = Instruction(list.getLength());
+        //   Count
+        list.append(aCall(2, 1));
+        list.append(Instruction(list.getLength() + 1));
+        list[endA] = Instruction(list.getLength());
+        // IfAlertB
+        list.append(aCall(1, 0));
+        const size_t endC = list.getLength();
+        list.append(Instruction(0));
+        //   tmpx = tmpturn + 1
+        list.append(Instruction((1 << 27) | VARTMPX));
+        list.append(Instruction(2));
+        list.append(anOperand(OPADD, VARTMPTURN, false));
+        list.append(anOperand(OPADD, 1, true));
+        list[endC] = Instruction(list.getLength());
+        // An unknown function, fails
+        list.append(aCall(4, 0));
+        const size_t endD = list.getLength();
+        list.append(Instruction(0));
+        //   tmpargument = selfstate * 3 / tmpx % 0 / 0, stored in selfstate
+        list.append(Instruction((1 << 27) | VARSELFSTATE));
+        list.append(Instruction(5));
+        list.append(anOperand(OPADD, VARSELFSTATE, false));
+        list.append(anOperand(OPMUL, 3, true));
+        list.append(anOperand(OPDIV, VARTMPX, false));
+        list.append(anOperand(OPMOD, 0, true));
+        list.append(anOperand(OPDIV, 0, true));
+        list[endD] = Instruction(list.getLength());
+        // tmpx = tmpx + tmpy
+        list.append(Instruction(VARTMPX));
+        list.append(Instruction(2));
+        list.append(anOperand(OPADD, VARTMPX, false));
+        list.append(anOperand(OPADD, VARTMPY, false));
+        // Count
+        list.append(aCall(2, 0));
+        list.append(Instruction(list.getLength() + 1));
+        return list;
+    }
+
+    static Program aProgram() {
+        const auto functions = getFunctions();
+        Program program;
+        program.decode(aList(), functions.data(), functions.size());
+        return program;
+    }
+
+    static void aState(uint32_t alert, script_state_t& state, ai_state_t& aiState) {
+        aiState.alert = alert;
+        aiState.state = 5;
+        state.x = 1;
+        state.y = 2;
+        state.distance = 3;
+        state.turn = 4;
+        state.argument = 6;
+    }
+
+    /// The contents of ScriptCompilation.inl, which is next to this file.
+    static std::string theCompiledCode() {
+        std::string path = __FILE__;
+        path = path.substr(0, path.find_last_of("/\\") + 1) + "ScriptCompilation.inl";
+        std::ifstream file(path, std::ios::binary);
+        std::string code;
+        for (std::istreambuf_iterator<char> it(file), end; it != end; ++it) {
+            // Line endings may have been converted on checkout.
+            if ('\r' != *it) {
+                code.push_back(*it);
+            }
+        }
+        return code;
+    }
+
+    EgoTest_Test(runScriptCompilationTestGenerate) {
+        Ego::Script::Interpreter::CodeGenerator generator(getFunctionNames(), "scr_");
+        const std::string code = generator.generate(aProgram());
+
+        // The compiled code under test is what the generator emits
+        if (theCompiledCode() != code) {
+            std::cout << "ScriptCompilation.inl is out of date, the generator emits:" << std::endl << code;
+        }
+        EgoTest_Assert(theCompiledCode() == code);
+
+        // Labels only where a failing call jumps to
+        EgoTest_Assert(std::string::npos != code.find("i5:"));
+        EgoTest_Assert(std::string::npos != code.find("i6:"));
+        EgoTest_Assert(std::string::npos != code.find("i8:"));
+        EgoTest_Assert(std::string::npos != code.find("i10:"));
+        EgoTest_Assert(std::string::npos == code.find("i2:"));
+        EgoTest_Assert(std::string::npos == code.find("i9:"));
+
+        // Direct calls, inlined constants and registers
+        EgoTest_Assert(std::string::npos != code.find("if (!scr_IfAlertA(state, aiState)) goto i6;"));
+        EgoTest_Assert(std::string::npos != code.find("    scr_Count(state, aiState);"));
+        EgoTest_Assert(std::string::npos != code.find("if (!Operands::call(state, aiState, script, 4u)) goto i10;"));
+        EgoTest_Assert(std::string::npos != code.find("state.operationsum = int(state.operationsum) + 7;"));
+        EgoTest_Assert(std::string::npos != code.find("state.operationsum = int(state.operationsum) - state.turn;"));
+        EgoTest_Assert(std::string::npos != code.find("state.y = state.operationsum;"));
+        EgoTest_Assert(std::string::npos != code.find("operands.load(state, aiState, " + std::to_string(Ego::Script::VARSELFSTATE) + ")"));
+        EgoTest_Assert(std::string::npos != code.find("Operands::store(state, " + std::to_string(Ego::Script::VARSELFSTATE) + ")"));
+        EgoTest_Assert(std::string::npos == code.find("instructions["));
+    }
+
+    EgoTest_Test(runScriptCompilationTestEquivalence) {
+        const Program program = aProgram();
+        for (uint32_t alert = 0; alert < 8; ++alert) {
+            script_state_t interpretedState, compiledState;
+            ai_state_t interpretedAiState, compiledAiState;
+            script_info_t interpretedScript, compiledScript;
+            aState(alert, interpretedState, interpretedAiState);
+            aState(alert, compiledState, compiledAiState);
+
+            Ego::Script::ScriptMachine<Operands> interpreter(interpretedState, interpretedAiState, interpretedScript);
+            program.run(interpreter);
+            ScriptCompilationFixture::Compiled::run<Operands>(compiledState, compiledAiState, compiledScript);
+
+            EgoTest_Assert(interpretedAiState.x[0] == compiledAiState.x[0]);
+            EgoTest_Assert(interpretedAiState.terminate == compiledAiState.terminate);
+            EgoTest_Assert(interpretedAiState.content == compiledAiState.content);
+            EgoTest_Assert(interpretedState.x == compiledState.x);
+            EgoTest_Assert(interpretedState.y == compiledState.y);
+            EgoTest_Assert(interpretedState.distance == compiledState.distance);
+            EgoTest_Assert(interpretedState.turn == compiledState.turn);
+            EgoTest_Assert(interpretedState.argument == compiledState.argument);
+            EgoTest_Assert(static_cast<float>(interpretedState.operationsum) == static_cast<float>(compiledState.operationsum));
+            EgoTest_Assert(interpretedScript.indent == compiledScript.indent);
+            EgoTest_Assert(interpretedScript.indent_last == compiledScript.indent_last);
+        }
+    }
+
+    EgoTest_Test(runScriptCompilationTestQuote) {
+        using CodeGenerator = Ego::Script::Interpreter::CodeGenerator;
+        EgoTest_Assert("\"basicdat/script.txt\"" == CodeGenerator::quote("basicdat/script.txt"));
+        EgoTest_Assert("\"a\\\\b\\\"c\\\"\"" == CodeGenerator::quote("a\\b\"c\""));
+        EgoTest_Assert("\"a\\0121\"" == CodeGenerator::quote("a\n1"));
+    }
+
+    EgoTest_Test(runScriptCompilationTestHash) {
+        const InstructionList list = aList();
+        EgoTest_Assert(Program::hash(list) == Program::hash(aList()));
+
+        InstructionList other = aList();
+        other[0] = aCall(1, 0);
+        EgoTest_Assert(Program::hash(list) != Program::hash(other));
+        EgoTest_Assert(Program::hash(list) != Program::hash(InstructionList()));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
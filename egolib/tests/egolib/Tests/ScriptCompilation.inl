@@ -0,0 +1,78 @@
+template <typename Operands>
+void run(script_state_t& state, ai_state_t& aiState, script_info_t& script) {
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 0;
+    if (!scr_IfAlertA(state, aiState)) goto i6;
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 1;
+    scr_Count(state, aiState);
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 1;
+    {
+        const Operands operands(aiState);
+        state.operationsum = 0;
+        if (operands) {
+            state.operationsum = int(state.operationsum) + 7;
+            state.operationsum = int(state.operationsum) - state.turn;
+            state.operationsum = int(state.operationsum) + state.y;
+        }
+        state.y = state.operationsum;
+    }
+    script.indent_last = script.indent; script.indent = 1;
+    if (!scr_IfAlertB(state, aiState)) goto i5;
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 2;
+    scr_Terminate(state, aiState);
+i5:
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 1;
+    scr_Count(state, aiState);
+i6:
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 0;
+    if (!scr_IfAlertB(state, aiState)) goto i8;
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 1;
+    {
+        const Operands operands(aiState);
+        state.operationsum = 0;
+        if (operands) {
+            state.operationsum = int(state.operationsum) + state.turn;
+            state.operationsum = int(state.operationsum) + 1;
+        }
+        state.x = state.operationsum;
+    }
+i8:
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 0;
+    if (!Operands::call(state, aiState, script, 4u)) goto i10;
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 1;
+    {
+        const Operands operands(aiState);
+        state.operationsum = 0;
+        if (operands) {
+            state.operationsum = int(state.operationsum) + operands.load(state, aiState, 43);
+            state.operationsum = int(state.operationsum) * 3;
+            Operands::apply(state, 6, state.x);
+            Operands::apply(state, 7, 0);
+            Operands::apply(state, 6, 0);
+        }
+        Operands::store(state, 43);
+    }
+i10:
+    if (aiState.terminate) return;
+    script.indent_last = script.indent; script.indent = 0;
+    {
+        const Operands operands(aiState);
+        state.operationsum = 0;
+        if (operands) {
+            state.operationsum = int(state.operationsum) + state.x;
+            state.operationsum = int(state.operationsum) + state.y;
+        }
+        state.x = state.operationsum;
+    }
+    script.indent_last = script.indent; script.indent = 0;
+    scr_Count(state, aiState);
+    return;
+}
@@ -0,0 +1,129 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Script/script.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(ScriptProgram) {
+    struct State {
+        std::vector<uint32_t> called;
+        std::vector<int32_t> assigned;
+    };
+    using Function = uint8_t(State&);
+    using Program = Ego::Script::Interpreter::Program<Function>;
+
+    static uint8_t fail(State& state) { state.called.push_back(0); return false; }
+    static uint8_t pass(State& state) { state.called.push_back(1); return true; }
+    static uint8_t other(State& state) { state.called.push_back(2); return true; }
+
+    struct Machine {
+        State& state;
+        bool isTerminated() const { return false; }
+        void enter(const Program::Instruction&) {}
+        bool call(const Program::Instruction& instruction) { return instruction.function(state); }
+        void assign(const Program::Instruction& instruction, const Program::Operand *operands) {
+            int32_t sum = 0;
+            for (uint32_t i = 0; i < instruction.operandCount; ++i) {
+                sum += operands[i].isConstant ? operands[i].value : -operands[i].value;
+            }
+            state.assigned.push_back(sum);
+        }
+    };
+
+    static Instruction aCall(uint32_t function, uint32_t indent) {
+        return Instruction(Instruction::FUNCTIONBITS | ((indent & 0x0f) << 27) | function);
+    }
+
+    static Instruction anOperand(bool constant, uint32_t value) {
+        return Instruction((constant ? Instruction::FUNCTIONBITS : 0) | value);
+    }
+
+    static InstructionList aList(uint32_t failingFunction) {
+        InstructionList list;
+        list.append(aCall(failingFunction, 0));     //0: if ...
+        list.append(Instruction(8));                //1: ... else jump to 8
+        list.append(aCall(1, 1));                   //2:   pass
+        list.append(Instruction(4));                //3:   jump to 4
+        list.append(Instruction(7 | (1 << 27)));    //4:   x =
+        list.append(Instruction(2));                //5:   two operands
+        list.append(anOperand(true, 5));            //6:     5
+        list.append(anOperand(false, 3));           //7:     - variable 3
+        list.append(aCall(2, 0));                   //8: other
+        list.append(Instruction(10));               //9: jump to the end
+        return list;
+    }
+
+    EgoTest_Test(runScriptProgramTestDecode) {
+        Function *functions[] = { &fail, &pass, &other };
+        Program program;
+        program.decode(aList(0), functions, 3);
+
+        const auto& instructions = program.getInstructions();
+        EgoTest_Assert(4 == instructions.size());
+        EgoTest_Assert(instructions[0].isCall && &fail == instructions[0].function && 0 == instructions[0].indent);
+        EgoTest_Assert(3 == instructions[0].jump);
+        EgoTest_Assert(instructions[1].isCall && 1 == instructions[1].indent && 2 == instructions[1].jump);
+        EgoTest_Assert(!instructions[2].isCall && 7 == instructions[2].value && 2 == instructions[2].operandCount);
+        EgoTest_Assert(instructions[3].isCall && &other == instructions[3].function && 4 == instructions[3].jump);
+
+        const auto& operands = program.getOperands();
+        EgoTest_Assert(2 == operands.size());
+        EgoTest_Assert(operands[0].isConstant && 5 == operands[0].value);
+        EgoTest_Assert(!operands[1].isConstant && 3 == operands[1].value);
+    }
+
+    EgoTest_Test(runScriptProgramTestRun) {
+        Function *functions[] = { &fail, &pass, &other };
+
+        //The first function fails, the indented block is skipped
+        {
+            Program program;
+            program.decode(aList(0), functions, 3);
+            State state;
+            Machine machine{ state };
+            EgoTest_Assert(2 == program.run(machine));
+            EgoTest_Assert((std::vector<uint32_t>{ 0, 2 }) == state.called);
+            EgoTest_Assert(state.assigned.empty());
+        }
+        //The first function passes, the indented block is run
+        {
+            Program program;
+            program.decode(aList(1), functions, 3);
+            State state;
+            Machine machine{ state };
+            EgoTest_Assert(4 == program.run(machine));
+            EgoTest_Assert((std::vector<uint32_t>{ 1, 1, 2 }) == state.called);
+            EgoTest_Assert((std::vector<int32_t>{ 2 }) == state.assigned);
+        }
+    }
+
+    EgoTest_Test(runScriptProgramTestUnknownFunction) {
+        Function *functions[] = { &fail, &pass, &other };
+        Program program;
+        program.decode(aList(100), functions, 3);
+        EgoTest_Assert(nullptr == program.getInstructions()[0].function);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
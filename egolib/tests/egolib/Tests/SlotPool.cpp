@@ -0,0 +1,97 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Core/SlotPool.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SlotPool) {
+    EgoTest_Test(runSlotPoolTestRespawn) {
+        Ego::SlotPool pool;
+
+        //Spawn three
+        std::vector<size_t> references;
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t slot = pool.addSlot();
+            EgoTest_Assert(i == slot);
+            references.push_back(pool.makeReference(slot));
+            EgoTest_Assert(pool.isCurrent(references.back()));
+            EgoTest_Assert(slot == Ego::SlotPool::getSlot(references.back()));
+        }
+        EgoTest_Assert(!pool.hasFreeSlot());
+
+        //Terminate the middle one
+        pool.release(references[1]);
+        EgoTest_Assert(!pool.isCurrent(references[1]));
+        EgoTest_Assert(pool.hasFreeSlot());
+
+        //Respawn: the slot is reused with a new generation
+        const size_t slot = pool.takeFreeSlot();
+        EgoTest_Assert(1 == slot);
+        const size_t respawned = pool.makeReference(slot);
+        EgoTest_Assert(respawned != references[1]);
+        EgoTest_Assert((respawned >> Ego::SlotPool::SLOT_BITS) == (references[1] >> Ego::SlotPool::SLOT_BITS) + 1);
+        EgoTest_Assert(pool.isCurrent(respawned));
+        EgoTest_Assert(!pool.isCurrent(references[1]));
+        EgoTest_Assert(pool.isCurrent(references[0]) && pool.isCurrent(references[2]));
+        EgoTest_Assert(!pool.hasFreeSlot());
+        EgoTest_Assert(3 == pool.getSlotCount());
+    }
+
+    EgoTest_Test(runSlotPoolTestManyGenerations) {
+        Ego::SlotPool pool;
+        const size_t first = pool.makeReference(pool.addSlot());
+        size_t reference = first;
+        for (size_t i = 0; i < 1000; ++i) {
+            pool.release(reference);
+            const size_t slot = pool.takeFreeSlot();
+            EgoTest_Assert(0 == slot);
+            const size_t next = pool.makeReference(slot);
+            EgoTest_Assert(next > reference);
+            reference = next;
+        }
+        EgoTest_Assert(1 == pool.getSlotCount());
+        EgoTest_Assert(!pool.isCurrent(first));
+    }
+
+    EgoTest_Test(runSlotPoolTestInvalidRelease) {
+        Ego::SlotPool pool;
+        const size_t reference = pool.makeReference(pool.addSlot());
+        pool.release(reference);
+
+        //Twice, a stale reference and an invalid reference are all rejected
+        for (size_t bad : { reference, size_t(0), std::numeric_limits<size_t>::max() }) {
+            bool thrown = false;
+            try {
+                pool.release(bad);
+            } catch (const Id::InvalidArgumentException&) {
+                thrown = true;
+            }
+            EgoTest_Assert(thrown);
+        }
+        EgoTest_Assert(1 == pool.getSlotCount());
+    }
+};
+
+} // namespace Test
+} // namespace Ego
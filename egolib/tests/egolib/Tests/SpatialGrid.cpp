@@ -0,0 +1,174 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SpatialGrid) {
+    static AxisAlignedBox2f anAABFromARect(float centerX, float centerY, float size) {
+        return AxisAlignedBox2f(Point2f(centerX - size, centerY - size), Point2f(centerX + size, centerY + size));
+    }
+
+    static std::vector<Ego::SpatialGrid::Index> findSorted(const Ego::SpatialGrid &grid, const AxisAlignedBox2f &searchArea) {
+        std::vector<Ego::SpatialGrid::Index> result;
+        grid.find(searchArea, result);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    EgoTest_Test(runSpatialGridTestStatic) {
+        Ego::SpatialGrid grid(32.0f);
+        grid.reset(0, 0, 256, 256);
+
+        //Put a fat element in the middle, spanning several cells
+        grid.update(0, anAABFromARect(128, 128, 20));
+
+        //Put one element in each corner
+        grid.update(1, anAABFromARect(0, 0, 5));
+        grid.update(2, anAABFromARect(256, 0, 5));
+        grid.update(3, anAABFromARect(0, 256, 5));
+        grid.update(4, anAABFromARect(256, 256, 5));
+        EgoTest_Assert(grid.size() == 5);
+
+        //Searching outside the grid should produce no results
+        EgoTest_Assert(findSorted(grid, anAABFromARect(-50, -50, 20)).empty());
+
+        //Searching around each corner should find one element
+        EgoTest_Assert(findSorted(grid, anAABFromARect(0, 0, 50)) == std::vector<Ego::SpatialGrid::Index>({1}));
+        EgoTest_Assert(findSorted(grid, anAABFromARect(256, 0, 50)) == std::vector<Ego::SpatialGrid::Index>({2}));
+        EgoTest_Assert(findSorted(grid, anAABFromARect(0, 256, 50)) == std::vector<Ego::SpatialGrid::Index>({3}));
+        EgoTest_Assert(findSorted(grid, anAABFromARect(256, 256, 50)) == std::vector<Ego::SpatialGrid::Index>({4}));
+
+        //Searching in the middle should find the fat element exactly once
+        EgoTest_Assert(findSorted(grid, anAABFromARect(128, 128, 50)) == std::vector<Ego::SpatialGrid::Index>({0}));
+
+        //Searching whole grid should find all elements
+        EgoTest_Assert(findSorted(grid, anAABFromARect(128, 128, 128)).size() == 5);
+
+        //Searching with infinite bounds should find all elements as well
+        EgoTest_Assert(findSorted(grid, AxisAlignedBox2f(Point2f(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()),
+                                                         Point2f(std::numeric_limits<float>::max(), std::numeric_limits<float>::max()))).size() == 5);
+    }
+
+    EgoTest_Test(runSpatialGridTestRelocate) {
+        Ego::SpatialGrid grid(32.0f);
+        grid.reset(0, 0, 256, 256);
+
+        for (Ego::SpatialGrid::Index i = 0; i < 5; ++i) {
+            grid.update(i, anAABFromARect(16.0f + i * 4.0f, 16.0f, 2));
+        }
+        EgoTest_Assert(findSorted(grid, AxisAlignedBox2f(Point2f(128, 128), Point2f(256, 256))).empty());
+
+        //Now move all elements in bottom right corner
+        for (Ego::SpatialGrid::Index i = 0; i < 5; ++i) {
+            grid.update(i, AxisAlignedBox2f(Point2f(130.0f + i * 20.0f, 140.0f), Point2f(140.0f + i * 20.0f, 150.0f)));
+        }
+        EgoTest_Assert(grid.size() == 5);
+
+        //All elements should be found in bottom right now
+        EgoTest_Assert(findSorted(grid, AxisAlignedBox2f(Point2f(128, 128), Point2f(256, 256))).size() == 5);
+
+        //If we look top half, we should find nothing now
+        EgoTest_Assert(findSorted(grid, AxisAlignedBox2f(Point2f(0, 0), Point2f(256, 127))).empty());
+
+        //Removed elements are not found anymore
+        EgoTest_Assert(grid.remove(2));
+        EgoTest_Assert(!grid.remove(2));
+        EgoTest_Assert(!grid.contains(2));
+        EgoTest_Assert(findSorted(grid, AxisAlignedBox2f(Point2f(128, 128), Point2f(256, 256))) == std::vector<Ego::SpatialGrid::Index>({0, 1, 3, 4}));
+    }
+
+    EgoTest_Test(runSpatialGridTestRandomized) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> position(-100.0f, 1124.0f);
+        std::uniform_real_distribution<float> size(0.0f, 80.0f);
+        std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+
+        Ego::SpatialGrid grid(64.0f);
+        grid.reset(0, 0, 1024, 1024);
+        std::vector<AxisAlignedBox2f> boxes;
+        std::vector<bool> present;
+        for (size_t i = 0; i < 500; ++i) {
+            const float x = position(generator), y = position(generator), s = size(generator);
+            boxes.push_back(AxisAlignedBox2f(Point2f(x, y), Point2f(x + s, y + s)));
+            present.push_back(true);
+            grid.update(i, boxes.back());
+        }
+
+        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
+        for (size_t frame = 0; frame < 20; ++frame) {
+            //Move, remove and re-add some elements
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                if (i % 17 == frame % 17) {
+                    present[i] = !present[i];
+                    if (!present[i]) {
+                        grid.remove(i);
+                        continue;
+                    }
+                }
+                if (!present[i]) continue;
+                const Vector2f delta(step(generator), step(generator));
+                boxes[i] = AxisAlignedBox2f(boxes[i].getMin() + delta, boxes[i].getMax() + delta);
+                grid.update(i, boxes[i]);
+            }
+
+            //Compare against brute force
+            for (size_t query = 0; query < 20; ++query) {
+                const float x = position(generator), y = position(generator), s = 4.0f * size(generator);
+                const AxisAlignedBox2f searchArea(Point2f(x, y), Point2f(x + s, y + s));
+                std::vector<Ego::SpatialGrid::Index> expected;
+                for (size_t i = 0; i < boxes.size(); ++i) {
+                    if (present[i] && intersects(boxes[i], searchArea)) {
+                        expected.push_back(i);
+                    }
+                }
+                EgoTest_Assert(findSorted(grid, searchArea) == expected);
+            }
+        }
+    }
+
+    EgoTest_Test(runSpatialGridTestSparseIndices) {
+        //Object references grow for the whole game, the grid must not grow with them
+        Ego::SpatialGrid grid(32.0f);
+        grid.reset(0, 0, 256, 256);
+        const Ego::SpatialGrid::Index base = Ego::SpatialGrid::Index(1) << 31;
+        const size_t alive = 8;
+        for (size_t i = 0; i < 10000; ++i) {
+            grid.update(base + i, anAABFromARect(float(i % 256), 128, 2));
+            if (i >= alive) {
+                EgoTest_Assert(grid.remove(base + i - alive));
+            }
+        }
+        EgoTest_Assert(grid.size() == alive);
+        EgoTest_Assert(!grid.contains(base));
+        EgoTest_Assert(grid.contains(base + 9999));
+
+        std::vector<Ego::SpatialGrid::Index> expected;
+        for (size_t i = 10000 - alive; i < 10000; ++i) {
+            expected.push_back(base + i);
+        }
+        EgoTest_Assert(findSorted(grid, anAABFromARect(128, 128, 256)) == expected);
+    }
+};
+
+} // namespace Test
+} // namespace Ego
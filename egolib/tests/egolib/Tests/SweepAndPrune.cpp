@@ -0,0 +1,147 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SweepAndPrune) {
+    static AxisAlignedBox2f anAABFromARect(float centerX, float centerY, float size) {
+        return AxisAlignedBox2f(Point2f(centerX - size, centerY - size), Point2f(centerX + size, centerY + size));
+    }
+
+    EgoTest_Test(runSweepAndPruneTestStatic) {
+        Ego::SweepAndPrune broadPhase;
+        std::vector<Ego::SweepAndPrune::Pair> pairs;
+
+        broadPhase.begin();
+        broadPhase.add(7, anAABFromARect(0, 0, 10));    //slot 0
+        broadPhase.add(3, anAABFromARect(15, 0, 10));   //slot 1, overlaps 0
+        broadPhase.add(9, anAABFromARect(15, 50, 10));  //slot 2, same x range as 1 but no y overlap
+        broadPhase.add(1, anAABFromARect(-5, 5, 1));    //slot 3, inside 0
+        broadPhase.findPairs(pairs);
+
+        //Each pair exactly once, in slot order
+        EgoTest_Assert(pairs.size() == 2);
+        EgoTest_Assert(pairs[0].first == 0 && pairs[0].second == 1);
+        EgoTest_Assert(pairs[1].first == 0 && pairs[1].second == 3);
+    }
+
+    EgoTest_Test(runSweepAndPruneTestRandomized) {
+        std::mt19937 generator(1337);
+        std::uniform_real_distribution<float> position(0.0f, 2048.0f);
+        std::uniform_real_distribution<float> size(5.0f, 60.0f);
+        std::uniform_real_distribution<float> step(-30.0f, 30.0f);
+
+        std::vector<AxisAlignedBox2f> boxes;
+        for (size_t i = 0; i < 300; ++i) {
+            const float x = position(generator), y = position(generator), s = size(generator);
+            boxes.push_back(AxisAlignedBox2f(Point2f(x, y), Point2f(x + s, y + s)));
+        }
+
+        Ego::SweepAndPrune broadPhase;
+        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
+        std::vector<Ego::SweepAndPrune::Pair> pairs;
+        for (size_t frame = 0; frame < 30; ++frame) {
+            //Move everything and add a changing subset in a shuffled order
+            std::vector<size_t> keys;
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                const Vector2f delta(step(generator), step(generator));
+                boxes[i] = AxisAlignedBox2f(boxes[i].getMin() + delta, boxes[i].getMax() + delta);
+                if ((i + frame) % 11 != 0) {
+                    keys.push_back(i);
+                }
+            }
+            std::shuffle(keys.begin(), keys.end(), generator);
+
+            broadPhase.begin();
+            for (size_t key : keys) {
+                broadPhase.add(key, boxes[key]);
+            }
+            broadPhase.findPairs(pairs);
+
+            //Compare against brute force
+            std::vector<Ego::SweepAndPrune::Pair> expected;
+            for (uint32_t a = 0; a < keys.size(); ++a) {
+                for (uint32_t b = a + 1; b < keys.size(); ++b) {
+                    if (intersects(boxes[keys[a]], boxes[keys[b]])) {
+                        Ego::SweepAndPrune::Pair pair;
+                        pair.first = a;
+                        pair.second = b;
+                        expected.push_back(pair);
+                    }
+                }
+            }
+            EgoTest_Assert(pairs == expected);
+        }
+    }
+
+    EgoTest_Test(runSweepAndPruneTestSparseKeys) {
+        //Object references grow for the whole game: respawned proxies come back with new, large keys
+        std::mt19937 generator(4711);
+        std::uniform_real_distribution<float> position(0.0f, 512.0f);
+        std::uniform_int_distribution<int> respawn(0, 9);
+
+        const size_t base = size_t(1) << 31;
+        std::vector<size_t> keys;
+        for (size_t i = 0; i < 100; ++i) {
+            keys.push_back(base + i);
+        }
+        size_t nextKey = base + keys.size();
+
+        Ego::SweepAndPrune broadPhase;
+        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
+        std::vector<Ego::SweepAndPrune::Pair> pairs;
+        for (size_t frame = 0; frame < 200; ++frame) {
+            std::vector<AxisAlignedBox2f> boxes;
+            broadPhase.begin();
+            for (size_t i = 0; i < keys.size(); ++i) {
+                if (0 == respawn(generator)) {
+                    keys[i] = nextKey++;
+                }
+                boxes.push_back(anAABFromARect(position(generator), position(generator), 20));
+                broadPhase.add(keys[i], boxes.back());
+            }
+
+            //Now and then a frame without pairs
+            if (frame % 17 == 16) {
+                continue;
+            }
+            broadPhase.findPairs(pairs);
+
+            std::vector<Ego::SweepAndPrune::Pair> expected;
+            for (uint32_t a = 0; a < boxes.size(); ++a) {
+                for (uint32_t b = a + 1; b < boxes.size(); ++b) {
+                    if (intersects(boxes[a], boxes[b])) {
+                        Ego::SweepAndPrune::Pair pair;
+                        pair.first = a;
+                        pair.second = b;
+                        expected.push_back(pair);
+                    }
+                }
+            }
+            EgoTest_Assert(pairs == expected);
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
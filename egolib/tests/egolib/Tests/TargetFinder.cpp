@@ -0,0 +1,196 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/AI/TargetFinder.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(TargetFinder) {
+    static constexpr float RADIUS = 6 * 128.0f; //< WIDE
+
+    struct Scene {
+        std::vector<Vector3f> positions;
+        std::vector<bool> targetable;
+        std::vector<size_t> order;  //< The indices of the present objects in the order of iteration
+    };
+
+    /// The linear search over all objects prt_find_target() used to do.
+    static bool aBruteForceSearch(const Scene& scene, const Ego::AI::TargetFinder::Query& query, size_t& target, Facing& targetAngle) {
+        const float max_dist2 = query.radius * query.radius;
+        float longdist2 = max_dist2;
+        bool found = false;
+        for (const size_t index : scene.order) {
+            if (!scene.targetable[index]) continue;
+            const Vector3f& position = scene.positions[index];
+            Facing angle = Facing(FACING_T(-query.facing + vec_to_facing(position[kX] - query.position[kX], position[kY] - query.position[kY])));
+            if (angle < Facing(query.coneAngle) || angle > Facing(0xFFFF - query.coneAngle)) {
+                float dist2 = (position - query.position).length_2();
+                if (dist2 < longdist2 && dist2 <= max_dist2) {
+                    targetAngle = angle;
+                    target = index;
+                    longdist2 = dist2;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    static void assertSameResults(const Scene& scene, const Ego::AI::TargetFinder& finder, const Ego::AI::TargetFinder::Query& query) {
+        size_t expectedTarget = 0, target = 0;
+        Facing expectedAngle, angle;
+        const bool expected = aBruteForceSearch(scene, query, expectedTarget, expectedAngle);
+        const bool found = finder.find(query, [&scene](size_t index) { return scene.targetable[index]; }, target, angle);
+        EgoTest_Assert(expected == found);
+        if (expected && found) {
+            EgoTest_Assert(expectedTarget == target);
+            EgoTest_Assert(expectedAngle == angle);
+        }
+    }
+
+    EgoTest_Test(runTargetFinderTestTies) {
+        //Objects at the same distance: the one inserted first wins, like in a linear search
+        Ego::AI::TargetFinder finder(128.0f);
+        finder.reset(0.0f, 0.0f, 1024.0f, 1024.0f);
+        finder.insert(3, Vector3f(600.0f, 500.0f, 0.0f));
+        finder.insert(1, Vector3f(400.0f, 500.0f, 0.0f));
+        finder.insert(2, Vector3f(500.0f, 600.0f, 0.0f));
+
+        Ego::AI::TargetFinder::Query query;
+        query.position = Vector3f(500.0f, 500.0f, 0.0f);
+        query.facing = Facing(FACING_T(0));
+        query.coneAngle = 0xFFFF;
+        query.radius = RADIUS;
+        size_t target = 0;
+        Facing angle;
+        const auto all = [](size_t) { return true; };
+        EgoTest_Assert(finder.find(query, all, target, angle));
+        EgoTest_Assert(3 == target);
+
+        //Re-inserting keeps the order, removing and inserting again puts an object last
+        finder.insert(3, Vector3f(600.0f, 500.0f, 0.0f));
+        EgoTest_Assert(finder.find(query, all, target, angle) && 3 == target);
+        finder.remove(3);
+        finder.insert(3, Vector3f(600.0f, 500.0f, 0.0f));
+        EgoTest_Assert(finder.find(query, all, target, angle) && 1 == target);
+
+        //Moving closer wins, new bounds do not change the order
+        finder.move(2, Vector3f(500.0f, 550.0f, 0.0f));
+        EgoTest_Assert(finder.find(query, all, target, angle) && 2 == target);
+        finder.reset(0.0f, 0.0f, 2048.0f, 2048.0f);
+        finder.move(2, Vector3f(500.0f, 600.0f, 0.0f));
+        EgoTest_Assert(3 == finder.size());
+        EgoTest_Assert(finder.find(query, all, target, angle) && 1 == target);
+
+        //Nothing is found in an empty cone or out of range
+        query.coneAngle = 0;
+        EgoTest_Assert(!finder.find(query, all, target, angle));
+        query.coneAngle = 0xFFFF;
+        query.radius = 50.0f;
+        EgoTest_Assert(!finder.find(query, all, target, angle));
+    }
+
+    EgoTest_Test(runTargetFinderTestSparseIndices) {
+        //Large, sparse indices are found and reported as they were inserted
+        Ego::AI::TargetFinder finder(128.0f);
+        finder.reset(0.0f, 0.0f, 1024.0f, 1024.0f);
+        finder.insert(5000000, Vector3f(600.0f, 500.0f, 0.0f));
+        finder.insert(7000000, Vector3f(450.0f, 500.0f, 0.0f));
+        EgoTest_Assert(2 == finder.size());
+        EgoTest_Assert(finder.contains(5000000) && !finder.contains(6000000));
+
+        Ego::AI::TargetFinder::Query query;
+        query.position = Vector3f(500.0f, 500.0f, 0.0f);
+        query.facing = Facing(FACING_T(0));
+        query.coneAngle = 0xFFFF;
+        query.radius = RADIUS;
+        size_t target = 0;
+        Facing angle;
+        EgoTest_Assert(finder.find(query, [](size_t index) { return 5000000 == index; }, target, angle) && 5000000 == target);
+        EgoTest_Assert(finder.find(query, [](size_t) { return true; }, target, angle) && 7000000 == target);
+
+        //A removed target is gone, a new target reuses its slot
+        finder.remove(7000000);
+        EgoTest_Assert(!finder.contains(7000000));
+        finder.insert(9000000, Vector3f(500.0f, 560.0f, 0.0f));
+        EgoTest_Assert(2 == finder.size());
+        EgoTest_Assert(finder.find(query, [](size_t) { return true; }, target, angle) && 9000000 == target);
+        finder.reset(0.0f, 0.0f, 2048.0f, 2048.0f);
+        EgoTest_Assert(finder.find(query, [](size_t) { return true; }, target, angle) && 9000000 == target);
+    }
+
+    EgoTest_Test(runTargetFinderTestRandomized) {
+        std::mt19937 generator(42);
+        //Positions on a coarse lattice, many objects are at the same distance from a query
+        std::uniform_int_distribution<int> lattice(-2, 66);
+        std::uniform_int_distribution<int> height(0, 4);
+        std::uniform_int_distribution<int> step(-3, 3);
+        std::uniform_int_distribution<int> facing(0, 0xFFFF);
+        std::uniform_int_distribution<int> cone(0, 0x9000);
+        std::bernoulli_distribution coin(0.5);
+
+        Ego::AI::TargetFinder finder(128.0f);
+        finder.reset(0.0f, 0.0f, 64 * 32.0f, 64 * 32.0f);
+        Scene scene;
+        for (size_t i = 0; i < 400; ++i) {
+            scene.positions.push_back(Vector3f(lattice(generator) * 32.0f, lattice(generator) * 32.0f, height(generator) * 32.0f));
+            scene.targetable.push_back(coin(generator));
+            scene.order.push_back(i);
+            finder.insert(i, scene.positions[i]);
+        }
+
+        for (size_t frame = 0; frame < 20; ++frame) {
+            //Move, remove and re-add some objects
+            for (size_t i = 0; i < scene.positions.size(); ++i) {
+                if (i % 13 == frame % 13) {
+                    const auto it = std::find(scene.order.begin(), scene.order.end(), i);
+                    if (it != scene.order.end()) {
+                        scene.order.erase(it);
+                        finder.remove(i);
+                    } else {
+                        scene.order.push_back(i);
+                        finder.insert(i, scene.positions[i]);
+                    }
+                }
+                scene.positions[i] += Vector3f(step(generator) * 32.0f, step(generator) * 32.0f, 0.0f);
+                finder.move(i, scene.positions[i]);
+                scene.targetable[i] = coin(generator);
+            }
+
+            //Compare against brute force, queries from on and off the lattice
+            for (size_t i = 0; i < 100; ++i) {
+                Ego::AI::TargetFinder::Query query;
+                query.position = Vector3f(lattice(generator) * 32.0f, lattice(generator) * 32.0f, height(generator) * 32.0f);
+                if (coin(generator)) {
+                    query.position += Vector3f(float(step(generator)), float(step(generator)), 0.0f);
+                }
+                query.facing = Facing(FACING_T(facing(generator)));
+                query.coneAngle = static_cast<FACING_T>(cone(generator));
+                query.radius = RADIUS;
+                assertSameResults(scene, finder, query);
+            }
+        }
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,160 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Script/ThinkScheduler.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(ThinkScheduler) {
+    static const uint32_t WAKE = 1 << 5;
+    static const uint32_t OTHER = 1 << 20;
+
+    /// Schedule and run scripts at the given distances for a number of updates, count the runs of each.
+    static std::vector<size_t> aRun(Ego::Script::ThinkScheduler& scheduler, const std::vector<float>& distances, bool idle, uint32_t updates) {
+        std::vector<size_t> runs(distances.size(), 0);
+        for (uint32_t frame = 1; frame <= updates; ++frame) {
+            scheduler.beginFrame(frame);
+            for (size_t i = 0; i < distances.size(); ++i) {
+                scheduler.schedule(i, distances[i], idle ? 0 : OTHER, idle);
+            }
+            scheduler.run([&runs](size_t index) { runs[index]++; });
+        }
+        return runs;
+    }
+
+    EgoTest_Test(runThinkSchedulerTestIntervals) {
+        Ego::Script::ThinkScheduler scheduler(WAKE);
+        scheduler.setDistances(10.0f, 20.0f);
+
+        EgoTest_Assert(1 == scheduler.getInterval(5.0f, false));
+        EgoTest_Assert(2 == scheduler.getInterval(15.0f, false));
+        EgoTest_Assert(4 == scheduler.getInterval(25.0f, false));
+        EgoTest_Assert(2 == scheduler.getInterval(5.0f, true));
+        EgoTest_Assert(8 == scheduler.getInterval(25.0f, true));
+        EgoTest_Assert(Ego::Script::ThinkScheduler::MAX_INTERVAL >= scheduler.getInterval(std::numeric_limits<float>::infinity(), true));
+
+        //Near scripts run every update, far scripts every fourth
+        const auto runs = aRun(scheduler, { 5.0f, 15.0f, 25.0f }, false, 64);
+        EgoTest_Assert(64 == runs[0]);
+        EgoTest_Assert(32 == runs[1]);
+        EgoTest_Assert(16 == runs[2]);
+    }
+
+    EgoTest_Test(runThinkSchedulerTestStagger) {
+        //Far scripts with the same interval are spread over the updates
+        Ego::Script::ThinkScheduler scheduler(WAKE);
+        scheduler.setDistances(10.0f, 20.0f);
+        for (uint32_t frame = 1; frame <= 64; ++frame) {
+            scheduler.beginFrame(frame);
+            for (size_t i = 0; i < 64; ++i) {
+                scheduler.schedule(i, 100.0f, 0, true);
+            }
+            scheduler.run([](size_t) {});
+            EgoTest_Assert(8 == scheduler.getCounters().run);
+            EgoTest_Assert(56 == scheduler.getCounters().skipped);
+        }
+    }
+
+    EgoTest_Test(runThinkSchedulerTestWake) {
+        Ego::Script::ThinkScheduler scheduler(WAKE);
+        scheduler.setDistances(10.0f, 20.0f);
+        scheduler.setBudget(0.0);
+
+        //A far away idle script which has just run is woken by an alert, even without budget
+        std::vector<size_t> order;
+        scheduler.beginFrame(1);
+        scheduler.schedule(0, 100.0f, 0, true);
+        scheduler.schedule(1, 100.0f, 0, true);
+        scheduler.schedule(7, 100.0f, 0, true);
+        scheduler.run([&order](size_t index) { order.push_back(index); });
+        EgoTest_Assert((std::vector<size_t>{ 7 }) == order);
+
+        order.clear();
+        scheduler.beginFrame(2);
+        scheduler.schedule(7, 100.0f, WAKE | OTHER, false);
+        scheduler.schedule(0, 100.0f, OTHER, false);
+        scheduler.run([&order](size_t index) { order.push_back(index); });
+        EgoTest_Assert((std::vector<size_t>{ 7 }) == order);
+        EgoTest_Assert(1 == scheduler.getCounters().woken);
+        EgoTest_Assert(1 == scheduler.getCounters().skipped);
+        EgoTest_Assert(0 == scheduler.getCounters().run);
+    }
+
+    EgoTest_Test(runThinkSchedulerTestBudget) {
+        //Without budget one due script runs per update, in round-robin order
+        Ego::Script::ThinkScheduler scheduler(WAKE);
+        scheduler.setDistances(10.0f, 20.0f);
+        scheduler.setBudget(0.0);
+
+        std::vector<size_t> order;
+        for (uint32_t frame = 1; frame <= 8; ++frame) {
+            scheduler.beginFrame(frame);
+            for (size_t i = 0; i < 4; ++i) {
+                scheduler.schedule(i, 0.0f, OTHER, false);
+            }
+            scheduler.run([&order](size_t index) { order.push_back(index); });
+            EgoTest_Assert(1 == scheduler.getCounters().run);
+            EgoTest_Assert(3 == scheduler.getCounters().deferred);
+        }
+        EgoTest_Assert((std::vector<size_t>{ 0, 1, 2, 3, 0, 1, 2, 3 }) == order);
+        EgoTest_Assert(8 == scheduler.getTotals().run);
+        EgoTest_Assert(24 == scheduler.getTotals().deferred);
+
+        //With budget all due scripts run
+        scheduler.setBudget(std::numeric_limits<double>::infinity());
+        scheduler.beginFrame(9);
+        for (size_t i = 0; i < 4; ++i) {
+            scheduler.schedule(i, 0.0f, OTHER, false);
+        }
+        scheduler.run([](size_t) {});
+        EgoTest_Assert(4 == scheduler.getCounters().run);
+        EgoTest_Assert(0 == scheduler.getCounters().deferred);
+    }
+
+    EgoTest_Test(runThinkSchedulerTestSparseIndices) {
+        //Sparse indices take one slot each, scripts no longer scheduled are forgotten
+        Ego::Script::ThinkScheduler scheduler(WAKE);
+        scheduler.setDistances(10.0f, 20.0f);
+        std::vector<size_t> runs;
+        for (uint32_t frame = 1; frame <= 16; ++frame) {
+            scheduler.beginFrame(frame);
+            const size_t count = frame <= 8 ? 4 : 2;
+            for (size_t i = 0; i < count; ++i) {
+                scheduler.schedule(1000000 * (i + 1), 0.0f, OTHER, false);
+            }
+            scheduler.run([&runs](size_t index) { runs.push_back(index); });
+            EgoTest_Assert(frame <= 9 ? 4 == scheduler.getScriptCount() : 2 == scheduler.getScriptCount());
+        }
+        EgoTest_Assert(8 * 4 + 8 * 2 == runs.size());
+
+        //A forgotten script starts over
+        scheduler.beginFrame(17);
+        scheduler.schedule(4000000, 0.0f, OTHER, false);
+        runs.clear();
+        scheduler.run([&runs](size_t index) { runs.push_back(index); });
+        EgoTest_Assert((std::vector<size_t>{ 4000000 }) == runs);
+        EgoTest_Assert(3 == scheduler.getScriptCount());
+    }
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,95 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/VFS/VfsDirectoryIndex.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(VfsDirectoryIndexTest) {
+    EgoTest_Test(testIndexedDirectory) {
+        VfsDirectoryIndex index;
+        index.add("mp_modules/town.mod/objects/sword.obj", { "data.txt", "part0.txt", "part2.txt", "sound1.wav", "tris0.bmp", "icon0.png" });
+        EgoTest_Assert(1 == index.getDirectoryCount());
+        EgoTest_Assert(index.isIndexed("mp_modules/town.mod/objects/sword.obj"));
+
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/part0.txt"));
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/part2.txt"));
+        EgoTest_Assert(!index.mayExist("mp_modules/town.mod/objects/sword.obj/part1.txt"));
+        EgoTest_Assert(!index.mayExist("mp_modules/town.mod/objects/sword.obj/enchant.txt"));
+
+        EgoTest_Assert(index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/sound1"));
+        EgoTest_Assert(!index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/sound0"));
+        EgoTest_Assert(index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/tris0"));
+        EgoTest_Assert(!index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/tris1"));
+        EgoTest_Assert(!index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/part"));
+    }
+
+    EgoTest_Test(testUnindexedDirectory) {
+        VfsDirectoryIndex index;
+        // Nothing is known about a directory which is not indexed.
+        EgoTest_Assert(index.mayExist("mp_objects/sword.obj/part0.txt"));
+        EgoTest_Assert(index.mayExistWithAnyExtension("mp_objects/sword.obj/tris0"));
+
+        index.add("mp_modules/town.mod/objects/sword.obj", { "data.txt" });
+        EgoTest_Assert(!index.isIndexed("mp_objects/sword.obj"));
+        EgoTest_Assert(index.mayExist("mp_objects/sword.obj/part0.txt"));
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/shield.obj/part0.txt"));
+        // Subdirectories of an indexed directory are not indexed.
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/inner.obj/part0.txt"));
+
+        index.clear();
+        EgoTest_Assert(0 == index.getDirectoryCount());
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/part0.txt"));
+    }
+
+    EgoTest_Test(testNormalization) {
+        VfsDirectoryIndex index;
+        index.add("/mp_modules//town.mod\\objects/sword.obj/", { "part0.txt", ".hidden" });
+        EgoTest_Assert(index.isIndexed("mp_modules/town.mod/objects/sword.obj"));
+        EgoTest_Assert(index.mayExist("mp_modules\\town.mod\\objects\\sword.obj\\part0.txt"));
+        EgoTest_Assert(index.mayExist("/mp_modules/town.mod/objects/sword.obj//part0.txt"));
+        EgoTest_Assert(!index.mayExist("/mp_modules/town.mod/objects/sword.obj/part1.txt"));
+        // A leading period does not start an extension.
+        EgoTest_Assert(index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/.hidden"));
+
+        // Adding a directory again replaces its entries.
+        index.add("mp_modules/town.mod/objects/sword.obj", { "part1.txt" });
+        EgoTest_Assert(1 == index.getDirectoryCount());
+        EgoTest_Assert(!index.mayExist("mp_modules/town.mod/objects/sword.obj/part0.txt"));
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/part1.txt"));
+    }
+
+    EgoTest_Test(testCase) {
+        // The case of names is ignored on every platform, a file is only ruled out if no case of its name exists.
+        VfsDirectoryIndex index;
+        index.add("mp_modules/Town.mod/objects/Sword.obj", { "Data.txt", "TRIS0.BMP" });
+        EgoTest_Assert(index.isIndexed("mp_modules/town.mod/objects/sword.obj"));
+        EgoTest_Assert(index.mayExist("mp_modules/town.mod/objects/sword.obj/data.txt"));
+        EgoTest_Assert(index.mayExist("MP_MODULES/TOWN.MOD/OBJECTS/SWORD.OBJ/DATA.TXT"));
+        EgoTest_Assert(index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/tris0"));
+        EgoTest_Assert(!index.mayExist("mp_modules/town.mod/objects/sword.obj/part0.txt"));
+        EgoTest_Assert(!index.mayExistWithAnyExtension("mp_modules/town.mod/objects/sword.obj/Tris1"));
+    }
+};
+
+} // namespace Test
+} // namespace Ego
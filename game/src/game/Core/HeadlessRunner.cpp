@@ -0,0 +1,279 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   game/Core/HeadlessRunner.cpp
+/// @brief  Runs the simulation of a module without a window, an OpenGL context or an audio device.
+
+#include "game/Core/HeadlessRunner.hpp"
+#include "egolib/Profiles/_Include.hpp"
+#include "game/Core/GameEngine.hpp"
+#include "game/GUI/UIManager.hpp"
+#include "game/Graphics/CameraSystem.hpp"
+#include "game/Module/Module.hpp"
+#include "game/Physics/CollisionSystem.hpp"
+#include "game/Entities/_Include.hpp"
+#include "game/graphic_billboard.h"
+#include "game/game.h"
+
+namespace {
+
+using Timer = Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>;
+
+/// The sections of update_game() reported, nested sections follow the section they are part of.
+const std::array<std::pair<Timer *, const char *>, 6> TIMERS =
+{
+    std::make_pair(&update_ai_timer, "AI"),
+    std::make_pair(&update_all_objects_timer, "update_all_objects"),
+    std::make_pair(&update_all_particles_timer, "    particles"),
+    std::make_pair(&move_all_objects_timer, "move_all_objects"),
+    std::make_pair(&move_all_particles_timer, "    particles"),
+    std::make_pair(&update_collisions_timer, "CollisionSystem::update"),
+};
+
+void hashPosition(uint64_t& checksum, const Vector3f& position)
+{
+    // FNV-1a over the bits of the coordinates.
+    for (size_t i = 0; i < 3; ++i)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &position[i], sizeof(bits));
+        for (size_t j = 0; j < sizeof(bits); ++j)
+        {
+            checksum ^= (bits >> (j * 8)) & 0xFF;
+            checksum *= UINT64_C(1099511628211);
+        }
+    }
+}
+
+} // namespace
+
+HeadlessRunner::HeadlessRunner() :
+    _timings()
+{
+    // Nobody is listening.
+    egoboo_config_t::get().sound_effects_enable.setValue(false);
+    egoboo_config_t::get().sound_music_enable.setValue(false);
+
+    Ego::Input::InputSystem::initialize();
+    CameraSystem::Singleton::initialize();
+    AudioSystem::initialize();
+    ParticleHandler::initialize();
+    BillboardSystem::initialize();
+    Ego::Perks::PerkHandler::initialize();
+    ProfileSystem::initialize();
+    Ego::Physics::CollisionSystem::initialize();
+
+    // update_game() asks the engine for the number of the current update, it is never started.
+    _gameEngine = std::make_unique<GameEngine>();
+
+    for (const auto& timer : TIMERS)
+    {
+        _timings.push_back(Timing{ timer.second, 0.0, 0.0 });
+    }
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    if (_currentModule)
+    {
+        game_quit_module();
+    }
+    _gameEngine.reset(nullptr);
+
+    Ego::Physics::CollisionSystem::uninitialize();
+    scripting_system_end();
+    ProfileSystem::uninitialize();
+    BillboardSystem::uninitialize();
+    ParticleHandler::uninitialize();
+    AudioSystem::uninitialize();
+    CameraSystem::Singleton::uninitialize();
+    Ego::Input::InputSystem::uninitialize();
+}
+
+void HeadlessRunner::load(const std::string& folderName, const uint32_t seed)
+{
+    ProfileSystem::get().loadModuleProfiles();
+
+    std::shared_ptr<ModuleProfile> module;
+    for (const std::shared_ptr<ModuleProfile>& profile : ProfileSystem::get().getModuleProfiles())
+    {
+        if (profile->getFolderName() == folderName)
+        {
+            module = profile;
+            break;
+        }
+    }
+    if (!module)
+    {
+        throw Id::RuntimeErrorException(__FILE__, __LINE__, "module `" + folderName + "` not found");
+    }
+
+    // The same as LoadingState::loadModuleData() minus the graphics and the players.
+    ProfileSystem::get().reset();
+    if (!game_begin_module(module, seed))
+    {
+        throw Id::RuntimeErrorException(__FILE__, __LINE__, "unable to load module `" + folderName + "`");
+    }
+    update_wld = 0;
+    clock_chr_stat = 0;
+}
+
+double HeadlessRunner::run(const uint32_t updates)
+{
+    Ego::Time::Stopwatch stopwatch;
+    stopwatch.start();
+    for (uint32_t i = 0; i < updates; ++i)
+    {
+        // Clear the clocks so that a section which did not run in this update reports no time.
+        for (const auto& timer : TIMERS)
+        {
+            timer.first->reinit();
+        }
+        update_game();
+        for (size_t j = 0; j < TIMERS.size(); ++j)
+        {
+            const double seconds = TIMERS[j].first->lst();
+            _timings[j].total += seconds;
+            _timings[j].maximum = std::max(_timings[j].maximum, seconds);
+        }
+    }
+    stopwatch.stop();
+    return stopwatch.elapsed();
+}
+
+uint64_t HeadlessRunner::getChecksum() const
+{
+    uint64_t checksum = UINT64_C(14695981039346656037);
+    for (const std::shared_ptr<Object>& object : _currentModule->getObjectHandler().iterator())
+    {
+        if (object->isTerminated())
+        {
+            continue;
+        }
+        hashPosition(checksum, object->getPosition());
+    }
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        if (particle->isTerminated())
+        {
+            continue;
+        }
+        hashPosition(checksum, particle->getPosition());
+    }
+    return checksum;
+}
+
+void HeadlessRunner::report(std::ostream& os, const uint32_t updates, const double seconds) const
+{
+    os << _currentModule->getName() << ": " << updates << " updates in " << seconds << " s";
+    if (seconds > 0.0)
+    {
+        os << " (" << updates / seconds << " updates/s)";
+    }
+    os << std::endl;
+    os << std::left << std::setw(28) << "section" << std::right << std::setw(12) << "total ms"
+       << std::setw(12) << "avg ms" << std::setw(12) << "max ms" << std::endl;
+    for (const Timing& timing : _timings)
+    {
+        os << std::left << std::setw(28) << timing.name << std::right << std::fixed << std::setprecision(3)
+           << std::setw(12) << timing.total * 1000.0
+           << std::setw(12) << (updates > 0 ? timing.total * 1000.0 / updates : 0.0)
+           << std::setw(12) << timing.maximum * 1000.0 << std::endl;
+    }
+    os.unsetf(std::ios_base::floatfield);
+    os << "objects: " << _currentModule->getObjectHandler().getObjectCount()
+       << ", particles: " << ParticleHandler::get().getCount()
+       << ", checksum: " << std::hex << getChecksum() << std::dec << std::endl;
+}
+
+int Headless_main(int argc, char **argv)
+{
+    // Options come first, they override the setup file.
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    int parallelCollisions = -1;
+    bool validOptions = true;
+    while (validOptions && !arguments.empty() && 0 == arguments.front().compare(0, 2, "--"))
+    {
+        if ("--serial-collisions" == arguments.front())
+        {
+            parallelCollisions = 0;
+        }
+        else if ("--parallel-collisions" == arguments.front())
+        {
+            parallelCollisions = 1;
+        }
+        else
+        {
+            validOptions = false;
+        }
+        arguments.erase(arguments.begin());
+    }
+    if (!validOptions || arguments.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " [--serial-collisions|--parallel-collisions] module [updates [seed]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string module = arguments[0];
+    const uint32_t updates = arguments.size() > 1 ? static_cast<uint32_t>(std::stoul(arguments[1])) : 1000;
+    const uint32_t seed = arguments.size() > 2 ? static_cast<uint32_t>(std::stoul(arguments[2])) : 0;
+
+    // Neither a window nor an audio device is ever opened.
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+    try
+    {
+        Ego::Core::System::initialize(std::string(argv[0]));
+        if (parallelCollisions >= 0)
+        {
+            egoboo_config_t::get().game_parallelCollisions_enable.setValue(1 == parallelCollisions);
+        }
+        try
+        {
+            HeadlessRunner runner;
+            runner.load(module, seed);
+            const double seconds = runner.run(updates);
+            runner.report(std::cout, updates, seconds);
+        }
+        catch (...)
+        {
+            Ego::Core::System::uninitialize();
+            std::rethrow_exception(std::current_exception());
+        }
+        Ego::Core::System::uninitialize();
+    }
+    catch (const Id::Exception& ex)
+    {
+        std::cerr << "unhandled exception: " << std::endl
+                  << (std::string)ex << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "unhandled exception: " << std::endl
+                  << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        std::cerr << "unhandled exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
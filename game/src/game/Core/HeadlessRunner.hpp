@@ -0,0 +1,106 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   game/Core/HeadlessRunner.hpp
+/// @brief  Runs the simulation of a module without a window, an OpenGL context or an audio device.
+
+#pragma once
+
+#include "egolib/egolib.h"
+
+/**
+ * @brief
+ *  Loads a module and runs update_game() for a fixed number of updates as fast as possible.
+ * @remark
+ *  No window, OpenGL context or audio device is created: SDL is given its dummy video and audio
+ *  drivers, sound is disabled and only the systems the simulation needs are initialized. There
+ *  is neither a UIManager nor a playing state, so messages and text billboards are dropped.
+ * @remark
+ *  The random number generators are seeded with a fixed seed and there are no players, so two
+ *  runs with the same module, number of updates and seed play out the same. The checksum over
+ *  the positions of all objects and particles printed at the end can be compared to verify that.
+ */
+class HeadlessRunner : public Id::NonCopyable
+{
+public:
+    /// @brief The timings of a section of update_game().
+    struct Timing
+    {
+        std::string name;
+        double total;   ///< seconds spent in all updates
+        double maximum; ///< seconds spent in the slowest update
+    };
+
+    /**
+     * @brief
+     *  Initialize the systems the simulation needs.
+     * @remark
+     *  Ego::Core::System must have been initialized.
+     */
+    HeadlessRunner();
+
+    /// @brief Uninitialize the systems initialized by the constructor.
+    ~HeadlessRunner();
+
+    /**
+     * @brief
+     *  Load a module.
+     * @param folderName
+     *  the folder name of the module e.g. "adventurer.mod"
+     * @param seed
+     *  the random seed
+     * @throw Id::RuntimeErrorException
+     *  if the module does not exist or can not be loaded
+     */
+    void load(const std::string& folderName, const uint32_t seed);
+
+    /**
+     * @brief
+     *  Run update_game() for a number of updates.
+     * @return
+     *  the number of seconds spent
+     */
+    double run(const uint32_t updates);
+
+    /// @brief Get the timings of the sections of update_game() accumulated by run().
+    const std::vector<Timing>& getTimings() const {
+        return _timings;
+    }
+
+    /// @brief Get a checksum over the positions of all objects and particles.
+    uint64_t getChecksum() const;
+
+    /// @brief Print the timings and the checksum.
+    void report(std::ostream& os, const uint32_t updates, const double seconds) const;
+
+private:
+    std::vector<Timing> _timings;
+};
+
+/**
+ * @brief
+ *  The entry point of the headless runner.
+ * @remark
+ *  Usage: <tt>egoboo-headless [--serial-collisions|--parallel-collisions] module [updates [seed]]</tt>.
+ *  The options override game.parallelCollisions.enable from the setup file, so the checksums
+ *  of both collision detection modes can be compared (see <tt>make headless-test</tt>).
+ * @return
+ *  EXIT_SUCCESS upon regular termination, EXIT_FAILURE otherwise
+ */
+int Headless_main(int argc, char **argv);
@@ -132,8 +132,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
 
     _currentLife(0.0f),
     _currentMana(0.0f),
-    _baseAttribute(),
-    _tempAttribute(),
+    _attributes(),
 
     _inventory(),
     _money(0),
@@ -163,9 +162,6 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     // Grip info
     holdingwhich.fill(ObjectRef::Invalid);
 
-    //Clear initial base attributes
-    _baseAttribute.fill(0.0f);
-
     // pack/inventory info
     equipment.fill(ObjectRef::Invalid);
 
@@ -176,7 +172,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     //Initialize primary attributes
     for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
         const Ego::Math::Interval<float>& baseRange = _profile->getAttributeBase(static_cast<Ego::Attribute::AttributeType>(i));
-        _baseAttribute[i] = Random::next(baseRange);
+        _attributes.setBase(static_cast<Ego::Attribute::AttributeType>(i), Random::next(baseRange));
     }
 
     //Initialize timer to a random value
@@ -223,15 +219,15 @@ bool Object::setSkin(const size_t skinNumber)
 
     //Damage resistance and modifiers from Armour
     for(size_t i = 0; i < DAMAGE_COUNT; ++i) {
-        _baseAttribute[Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i))] = newSkin.damageResistance[i];
-        _baseAttribute[Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i))] = newSkin.damageModifier[i];
+        _attributes.setBase(Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i)), newSkin.damageResistance[i]);
+        _attributes.setBase(Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i)), newSkin.damageModifier[i]);
     }
 
     //Armour movement speed
-    _baseAttribute[Ego::Attribute::ACCELERATION] = newSkin.maxAccel;
+    _attributes.setBase(Ego::Attribute::ACCELERATION, newSkin.maxAccel);
 
     //Defence from Armour
-    _baseAttribute[Ego::Attribute::DEFENCE] = newSkin.defence;
+    _attributes.setBase(Ego::Attribute::DEFENCE, newSkin.defence);
 
     //Set new skin
     this->skin = skinNumber;
@@ -264,6 +260,12 @@ bool Object::isSubmerged() const
 void Object::movePosition(const float x, const float y, const float z)
 {
     _position += Vector3f(x, y, z);
+    onPositionChanged();
+}
+
+void Object::onPositionChanged()
+{
+    _currentModule->getObjectHandler().moveTarget(getObjRef(), getPosition());
 }
 
 void Object::setAlpha(const int alpha)
@@ -1134,6 +1136,7 @@ bool Object::detatchFromHolder(const bool ignoreKurse, const bool doShop)
 	if (pholder->holdingwhich[SLOT_RIGHT] == getObjRef()) {
 		pholder->holdingwhich[SLOT_RIGHT] = ObjectRef::Invalid;
 	}
+	pholder->invalidateAttributes();
 
     if ( isAlive() )
     {
@@ -1352,7 +1355,8 @@ void Object::checkLevelUp()
 
             //Primary Attribute increase
             for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
-                _baseAttribute[i] += Random::next(getProfile()->getAttributeGain(static_cast<Ego::Attribute::AttributeType>(i)));
+                const Ego::Attribute::AttributeType type = static_cast<Ego::Attribute::AttributeType>(i);
+                _attributes.setBase(type, _attributes.getBase(type) + Random::next(getProfile()->getAttributeGain(type)));
             }
 
             //Grab random Perk? (ZF> just uncomment if we want to do this for AI characters as well)
@@ -1880,7 +1884,7 @@ void Object::respawn()
 
     platform        = profile->isPlatform();
     canuseplatforms = profile->canUsePlatforms();
-    _baseAttribute[Ego::Attribute::FLY_TO_HEIGHT] = profile->getFlyHeight();
+    _attributes.setBase(Ego::Attribute::FLY_TO_HEIGHT, profile->getFlyHeight());
     phys.bumpdampen = profile->getBumpDampen();
 
     ai.alert = ALERTIF_CLEANEDUP;
@@ -2002,92 +2006,39 @@ float Object::getDamageReduction(const DamageType type, const bool includeArmor)
 
 float Object::getBaseAttribute(const Ego::Attribute::AttributeType type) const
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    return _baseAttribute[type];
+    return _attributes.getBase(type);
 }
 
 void Object::setBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = value;
+    _attributes.setBase(type, value);
 }
 
 float Object::getAttribute(const Ego::Attribute::AttributeType type) const 
 { 
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-
-    float attributeValue = _baseAttribute[type];
-
-    //Try to find temp value in map, but don't create it if it doesn't already exist
-    const auto& result = _tempAttribute.find(type);
-    if(result != _tempAttribute.end()) {
-
-        //Is this a SET type attribute or a cumulative ADD type attribute?
-        if(isOverrideSetAttribute(type)) {
-            return (*result).second;
-        }
-        else {
-            //Total value is base plus temp bonuses from enchants
-            attributeValue += (*result).second;
-        }
-    }
-
-    switch(type) {
+    return _attributes.get(type, [this]() {
+        Ego::AttributeSet::Context context;
 
         //Wolverine perk gives +0.25 Life Regeneration while holding a Claw weapon
-        case Ego::Attribute::LIFE_REGEN:
-            if(hasPerk(Ego::Perks::WOLVERINE)) {
-                if( (getLeftHandItem() && getLeftHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W'))
-                 || (getRightHandItem() && getRightHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W')))
-                 {
-                    attributeValue += 0.25f;
-                 }                
-            }
-        break;
-
-        case Ego::Attribute::JUMP_POWER:
-            //Special value for flying Objects
-            if(getAttribute(Ego::Attribute::FLY_TO_HEIGHT) > 0.0f) {
-                return Object::JUMPINFINITE;
-            }
-
-            //Athletics Perks gives +25% jump power
-            if(hasPerk(Ego::Perks::ATHLETICS)) {
-                attributeValue *= 1.25f;
-            }
-
-            //Every point of Might increases jump power by 1%
-            attributeValue *= 1.0f + (getAttribute(Ego::Attribute::MIGHT) / 100.0f);
-        break;
-
-        //Limit lowest acceleration to zero
-        case Ego::Attribute::ACCELERATION:
-        {
-            if(attributeValue < 0.0f) return 0.0f;
-        }
-        break;
+        context.wolverine = hasPerk(Ego::Perks::WOLVERINE) &&
+            ((getLeftHandItem() && getLeftHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W'))
+          || (getRightHandItem() && getRightHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W')));
 
-        //Limit lowest base attribute to 1
-        case Ego::Attribute::MIGHT:
-        case Ego::Attribute::AGILITY:
-        case Ego::Attribute::INTELLECT:
-        {
-            if(attributeValue < 1.0f) return 1.0f;
-        }
-        break;
+        //Athletics Perks gives +25% jump power
+        context.athletics = hasPerk(Ego::Perks::ATHLETICS);
 
-        default:
-            //nothing, keep default case to quench GCC warnings
-        break;
-    }
+        return context;
+    });
+}
 
-    return attributeValue; 
+void Object::invalidateAttributes()
+{
+    _attributes.invalidate();
 }
 
 void Object::increaseBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = Ego::Math::constrain(_baseAttribute[type] + value, 0.0f, 255.0f);
+    _attributes.setBase(type, Ego::Math::constrain(_attributes.getBase(type) + value, 0.0f, 255.0f));
 
     //Handle current life and mana increase as well
     if(type == Ego::Attribute::MAX_LIFE) {
@@ -2144,6 +2095,7 @@ void Object::addPerk(Ego::Perks::PerkID perk)
 {
     if(perk == Ego::Perks::NR_OF_PERKS) return;
     _perks[perk] = true;
+    invalidateAttributes();
 }
 
 float Object::getLife() const
@@ -2214,9 +2166,9 @@ bool Object::disenchant()
     return oneRemoved;
 }
 
-std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& Object::getTempAttributes()
+Ego::AttributeSet& Object::getAttributes()
 {
-    return _tempAttribute;
+    return _attributes;
 }
 
 bool Object::isFlying() const
@@ -2271,6 +2223,13 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
     _profileID = profileID;
     _profile = ProfileSystem::get().getProfile(_profileID);
 
+    //Perks come with the profile and the holder looks at the IDSZ of held items
+    invalidateAttributes();
+    const std::shared_ptr<Object> &holder = _currentModule->getObjectHandler()[attachedto];
+    if(holder) {
+        holder->invalidateAttributes();
+    }
+
     //Exit stealth if we change form
     deactivateStealth();
 
@@ -28,6 +28,7 @@
 
 #include "egolib/Script/script.h"
 #include "egolib/Logic/Team.hpp"
+#include "egolib/Logic/AttributeSet.hpp"
 #include "egolib/InputControl/InputDevice.hpp"
 
 #include "game/egoboo.h"
@@ -596,6 +597,13 @@ public:
     **/
     void setBaseAttribute(const Ego::Attribute::AttributeType type, float value);
 
+    /**
+    * @brief
+    *   Recompute the attributes of this Object on the next getAttribute(). Must be called
+    *   whenever the perks or the profile of this Object or the items it holds change.
+    **/
+    void invalidateAttributes();
+
     /**
     * @return
     *   The Inventory of this Object
@@ -681,7 +689,11 @@ public:
     **/
     bool setSkin(const size_t skinNumber);
 
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& getTempAttributes();
+    /**
+    * @brief
+    *   Get the attributes of this Object. Enchants add and remove their modifiers here.
+    **/
+    Ego::AttributeSet& getAttributes();
 
     std::shared_ptr<Ego::Enchantment> getLastEnchantmentSpawned() const;
 
@@ -823,6 +835,13 @@ public:
 
     inline bool isAnyLatchButtonPressed() { return _inputLatchesPressed.any(); }
 
+protected:
+    /**
+    * @brief
+    *   Keeps the position of this Object in the target index of the ObjectHandler up to date
+    **/
+    void onPositionChanged() override;
+
 private:
 
     /**
@@ -986,8 +1005,7 @@ private:
     //Attributes
     float _currentLife;
     float _currentMana;
-    std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _baseAttribute; ///< Character attributes
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>> _tempAttribute; ///< Character attributes with enchants
+    Ego::AttributeSet _attributes;                       ///< Character attributes with enchants
 
     Inventory _inventory;
     uint16_t  _money;                                    ///< Money
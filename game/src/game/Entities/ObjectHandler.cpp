@@ -41,9 +41,10 @@ ObjectHandler::ObjectHandler() :
     _semaphore(0),
     _deletedCharacters(0),
     _totalCharactersSpawned(0),
-    _dynamicObjects(),
-    _staticObjects(),
-    _updateStaticTreeClock(0)
+    _dynamicObjects(Info<float>::Grid::Size()),
+    _staticObjects(Info<float>::Grid::Size()),
+    _searchBuffer(),
+    _targets(Info<float>::Grid::Size())
 {
     _iteratorList.reserve(OBJECTS_MAX);
 }
@@ -65,6 +66,9 @@ bool ObjectHandler::remove(ObjectRef ref) {
 	_internalCharacterList[ref]->_terminateRequested = true; //bad: private access
 	_deletedCharacters++;
 
+	// Terminated objects can not be targeted.
+	_targets.remove(ref.get());
+
 	// We can safely modify the map, it is not iterable from the outside.
 	_internalCharacterList.erase(ref);
 
@@ -168,7 +172,9 @@ void ObjectHandler::clear()
 {
 	_internalCharacterList.clear();
 	_iteratorList.clear();
-    _dynamicObjects.clear(0, 0, 0, 0);
+    _dynamicObjects.reset(0, 0, 0, 0);
+    _staticObjects.reset(0, 0, 0, 0);
+    _targets.clear();
     _deletedCharacters = 0;
     _totalCharactersSpawned = 0;
 }
@@ -224,6 +230,10 @@ void ObjectHandler::maybeRunDeferred()
         {
             EGOBOO_ASSERT(nullptr != object);
             _iteratorList.push_back(object);
+            if (!object->isTerminated())
+            {
+                _targets.insert(object->getObjRef().get(), object->getPosition());
+            }
         }
         _allocateList.clear();        
     }
@@ -242,6 +252,11 @@ void ObjectHandler::maybeRunDeferred()
                     //Delete this character
                     _deletedCharacters--;
 
+                    //Remove it from the spatial index
+                    _dynamicObjects.remove(element->getObjRef().get());
+                    _staticObjects.remove(element->getObjRef().get());
+                    _targets.remove(element->getObjRef().get());
+
                     // Make sure everyone knows it died
                     for (const std::shared_ptr<Object>& chr : _iteratorList)
                     {
@@ -299,48 +314,67 @@ size_t ObjectHandler::getObjectCount() const
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
 }
 
-void ObjectHandler::updateQuadTree(float minX, float minY, float maxX, float maxY)
+void ObjectHandler::updateSpatialIndex(float minX, float minY, float maxX, float maxY)
 {
-    //Reset quad-tree
-    _dynamicObjects.clear(minX, minY, maxX, maxY);
-
-    //Rebuild the static quad tree only once per second
-    bool updateStaticQuadTree = false;
-    if(_updateStaticTreeClock <= 0) {
-        _updateStaticTreeClock = ONESECOND;
-        updateStaticQuadTree = true;
-        _staticObjects.clear(minX, minY, maxX, maxY);
-    }
-    else {
-        _updateStaticTreeClock--;
+    //Level size changed? Start over
+    if(!_dynamicObjects.hasBounds(minX, minY, maxX, maxY)) {
+        _dynamicObjects.reset(minX, minY, maxX, maxY);
+        _staticObjects.reset(minX, minY, maxX, maxY);
+        _targets.reset(minX, minY, maxX, maxY);
     }
 
-    //Rebuild quad-tree
+    //Relocate all objects (cheap if they stay within the same cells)
     for(const std::shared_ptr<Object> &object : _iteratorList) {
-        //Do not add objects that cannot interact with the rest of the world
-        if(object->isTerminated() || object->isHidden()) continue;
+        const Ego::SpatialGrid::Index index = object->getObjRef().get();
+
+        //Do not keep objects that cannot interact with the rest of the world
+        if(object->isTerminated() || object->isHidden()) {
+            _dynamicObjects.remove(index);
+            _staticObjects.remove(index);
+            continue;
+        }
 
         if(object->isScenery()) {
-            if(updateStaticQuadTree) {
-                _staticObjects.insert(object);
-            }
+            _dynamicObjects.remove(index);
+            _staticObjects.update(index, object->getAxisAlignedBox2D());
         }
         else {
-            _dynamicObjects.insert(object);
+            _staticObjects.remove(index);
+            _dynamicObjects.update(index, object->getAxisAlignedBox2D());
         }
     }
 }
 
+void ObjectHandler::moveTarget(ObjectRef ref, const Vector3f& position)
+{
+    _targets.move(ref.get(), position);
+}
+
+void ObjectHandler::resolveSearchBuffer(std::vector<std::shared_ptr<Object>> &result) const
+{
+    for(const Ego::SpatialGrid::Index index : _searchBuffer) {
+        const auto it = _internalCharacterList.find(ObjectRef(index));
+
+        //Removed since the last update of the spatial index?
+        if(it == _internalCharacterList.end()) continue;
+
+        result.push_back(it->second);
+    }
+    _searchBuffer.clear();
+}
+
 std::vector<std::shared_ptr<Object>> ObjectHandler::findObjects(const float x, const float y, const float distance, bool includeSceneryObjects) const { 
     std::vector<std::shared_ptr<Object>> result;
 	AxisAlignedBox2f searchArea = AxisAlignedBox2f(Point2f(x-distance, y-distance), Point2f(x+distance, y+distance));
-    _dynamicObjects.find(searchArea, result);
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
+    _dynamicObjects.find(searchArea, _searchBuffer);
+    if(includeSceneryObjects) _staticObjects.find(searchArea, _searchBuffer);
+    resolveSearchBuffer(result);
     return result;
 }
 
 void ObjectHandler::findObjects(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<Object>> &result, bool includeSceneryObjects) const
 {
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
-    return _dynamicObjects.find(searchArea, result);
+    if(includeSceneryObjects) _staticObjects.find(searchArea, _searchBuffer);
+    _dynamicObjects.find(searchArea, _searchBuffer);
+    resolveSearchBuffer(result);
 }
@@ -27,7 +27,8 @@
 #endif
 
 #include "game/egoboo.h"
-#include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/SpatialGrid.hpp"
+#include "egolib/AI/TargetFinder.hpp"
 
 //Forward declarations
 class Object;
@@ -153,8 +154,7 @@ public:
 
 	/**
 	* @brief
-	*	Find all elements that are within range of a specified point in this QuadTree's
-	*	bounding box
+	*	Find all elements that are within range of a specified point in the spatial index
 	* @param x
 	*	x position of point to search from
 	* @param y
@@ -182,12 +182,27 @@ public:
 
 	/**
 	* @brief
-	* 	Clear and rebuild the quad tree for this update frame
+	* 	Update the spatial index for this update frame. Objects that moved are relocated,
+	*	objects that were hidden or terminated are removed. The index is only rebuilt
+	*	from scratch if the bounds change.
 	*	This function is NOT thread-safe
 	* @param minX, minY, maxX, maxY
-	*	Sets the bounds of this quad tree (size of the entire current level)
+	*	Sets the bounds of the spatial index (size of the entire current level)
 	**/
-	void updateQuadTree(float minX, float minY, float maxX, float maxY);
+	void updateSpatialIndex(float minX, float minY, float maxX, float maxY);
+
+	/**
+	* @brief
+	*	Get the target index. Unlike the spatial index it contains every object in the order of
+	*	iteration, hidden objects included, and it is kept up to date whenever an object moves.
+	**/
+	const Ego::AI::TargetFinder& getTargetFinder() const { return _targets; }
+
+	/**
+	* @brief
+	*	Update the position of an object in the target index
+	**/
+	void moveTarget(ObjectRef ref, const Vector3f& position);
 
 	/**
 	* @return
@@ -222,10 +237,17 @@ private:
 	void dumpAllocateList();
 #endif
 
+	/**
+	 * @brief
+	 *	Append the objects for the indices in _searchBuffer to the result.
+	 */
+	void resolveSearchBuffer(std::vector<std::shared_ptr<Object>> &result) const;
+
 private:
-	Ego::QuadTree<Object> _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
-	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
-	int _updateStaticTreeClock;
+	Ego::SpatialGrid _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
+	Ego::SpatialGrid _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
+	mutable std::vector<Ego::SpatialGrid::Index> _searchBuffer;	//Scratch buffer for spatial index queries
+	Ego::AI::TargetFinder _targets;				//All objects in the order of iteration, see getTargetFinder()
 
 	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
 	std::vector<std::shared_ptr<Object>> _iteratorList;					///< For iterating, contains only valid objects (unsorted)
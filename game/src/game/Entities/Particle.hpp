@@ -118,8 +118,8 @@ public:
     /**
      * @brief
      *  Get the unique particle reference of this particle. When this
-     *  particle is removed from the game the particle reference will
-     *  not be re-used and is forever invalid.
+     *  particle is removed from the game the particle reference is
+     *  invalid, even if the particle is spawned again.
      * @return
      *  an unique particle reference of this particle
      */
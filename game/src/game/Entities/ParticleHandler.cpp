@@ -42,22 +42,22 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnLocalParticle(const Vector3
 
 const std::shared_ptr<Ego::Particle>& ParticleHandler::operator[] (const ParticleRef index)
 {
-    auto result = _particleMap.find(index);
-    
+    const size_t slot = Ego::SlotPool::getSlot(index.get());
+
     // If the referenced particle does not exist ...
-    if(result == _particleMap.end()) {
+    if(index == ParticleRef::Invalid || slot >= _particles.size()) {
         // ... return the null pointer.
         return Ego::Particle::INVALID_PARTICLE;
     }
 
-    // Check if particle was marked as terminated
-    if((*result).second->isTerminated() || (*result).second->getParticleID() != index) {
-        _particleMap.erase(index);
+    // Check if particle was marked as terminated or the slot has been reused since
+    const std::shared_ptr<Ego::Particle> &particle = _particles[slot];
+    if(particle->isTerminated() || particle->getParticleID() != index) {
         return Ego::Particle::INVALID_PARTICLE;        
     }
 
     // All good!
-    return (*result).second;
+    return particle;
 }
 
 std::shared_ptr<Ego::Particle> ParticleHandler::spawnGlobalParticle(const Vector3f& spawnPos, const Facing& spawnFacing,
@@ -78,12 +78,16 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
 
     if (!ppip)
     {
-        const std::string spawnOriginName = _currentModule->getObjectHandler().exists(spawnOrigin) ? _currentModule->getObjectHandler()[spawnOrigin]->getName() : "INVALID";
-        const std::string spawnProfileName = ProfileSystem::get().isValidProfileID(spawnProfile) ? ProfileSystem::get().getProfile(spawnProfile)->getPathname() : "INVALID";
-		Log::get().debug("spawn_one_particle() - cannot spawn particle with invalid particle profile == %d, spawn origin == %" PRIuZ " (\"%s\"), spawn profile == %d (\"%s\"))\n",
-                         REF_TO_INT(particleProfile), 
-                         spawnOrigin.get(), spawnOriginName.c_str(),
-                         REF_TO_INT(spawnProfile), spawnProfileName.c_str());
+        // Only build the names if they are logged.
+        if (Log::get().isEnabled(Log::Level::Debug))
+        {
+            const std::string spawnOriginName = _currentModule->getObjectHandler().exists(spawnOrigin) ? _currentModule->getObjectHandler()[spawnOrigin]->getName() : "INVALID";
+            const std::string spawnProfileName = ProfileSystem::get().isValidProfileID(spawnProfile) ? ProfileSystem::get().getProfile(spawnProfile)->getPathname() : "INVALID";
+            Log::get().debug("spawn_one_particle() - cannot spawn particle with invalid particle profile == %d, spawn origin == %" PRIuZ " (\"%s\"), spawn profile == %d (\"%s\"))\n",
+                             REF_TO_INT(particleProfile), 
+                             spawnOrigin.get(), spawnOriginName.c_str(),
+                             REF_TO_INT(spawnProfile), spawnProfileName.c_str());
+        }
 
         return Ego::Particle::INVALID_PARTICLE;
     }
@@ -92,22 +96,25 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     ppip->_spawnRequestCount++;
 
     //Try to get a free particle
-    std::shared_ptr<Ego::Particle> particle = getFreeParticle(ppip->force);
-    if(particle) {
+    std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
+    const size_t slot = getFreeSlot(ppip->force);
+    if(NO_SLOT != slot) {
+        particle = _particles[slot];
+
         //Initialize particle and add it into the game
-        if(particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
+        const ParticleRef particleID = ParticleRef(_slots.makeReference(slot));
+        if(particle->initialize(particleID, spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
                                 spawnTeam, spawnOrigin, ParticleRef(spawnParticleOrigin), multispawn, spawnTarget, onlyOverWater)) 
         {
             _pendingParticles.push_back(particle);
-            _particleMap[particle->getParticleID()] = particle;
         }
         else {
             //If we failed to spawn somehow, put it back to the unused pool
-            _unusedPool.push_back(particle);
+            _slots.release(particleID.get());
         }        
     }
 
-    if(!particle) {
+    if(!particle && Log::get().isEnabled(Log::Level::Debug)) {
         const std::string spawnOriginName = _currentModule->getObjectHandler().exists(spawnOrigin) ? _currentModule->getObjectHandler().get(spawnOrigin)->getName() : "INVALID";
         const std::string particleProfileName = LOADED_PIP(particleProfile) ? ProfileSystem::get().ParticleProfileSystem.get_ptr(particleProfile)->_name : "INVALID";
         const std::string spawnProfileName = ProfileSystem::get().isValidProfileID(spawnProfile) ? ProfileSystem::get().getProfile(spawnProfile)->getPathname().c_str() : "INVALID";
@@ -120,13 +127,11 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     return particle;
 }
 
-std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
+size_t ParticleHandler::getFreeSlot(bool force)
 {
-    std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
-
     //Reserve last 25% of free particle for FORCE spawn particles
     if(!force && getFreeCount() < _maxParticles/4) {
-        return particle;
+        return NO_SLOT;
     }
 
     //Is this a high priority particle? If so, replace a less important particle
@@ -169,19 +174,16 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
     }
 
     //If we have no free particles in the memory pool but we are allowed to allocate new memory
-    if(_unusedPool.empty() && getCount() < _maxParticles) {
-        return std::make_shared<Ego::Particle>();
+    if(!_slots.hasFreeSlot() && getCount() < _maxParticles) {
+        _particles.push_back(std::make_shared<Ego::Particle>());
+        return _slots.addSlot();
     }
 
     //Get a free, unused particle from the particle pool
-    if (!_unusedPool.empty())
-    {
-        //Retrieve particle from the pool
-        particle = _unusedPool.back();
-        _unusedPool.pop_back();
+    if (!_slots.hasFreeSlot()) {
+        return NO_SLOT;
     }
-
-    return particle;
+    return _slots.takeFreeSlot();
 }
 
 void ParticleHandler::download(egoboo_config_t& cfg) {
@@ -222,12 +224,14 @@ void ParticleHandler::unlock()
                 return false;
             }
 
+            //destroy() invalidates the reference, so remember it first
+            const ParticleRef particleID = particle->getParticleID();
+
             //Play end sound, trigger end spawn, etc.
             particle->destroy();
 
             //Free to be used by another instance again
-            _unusedPool.push_back(particle);
-            _particleMap.erase(particle->getParticleID());
+            _slots.release(particleID.get());
 
             return true;
         };
@@ -262,9 +266,8 @@ void ParticleHandler::clear()
 
     _pendingParticles.clear();
     _activeParticles.clear();
-    _unusedPool.clear();
-    _particleMap.clear();
-    _totalParticlesSpawned = 0;
+    _particles.clear();
+    _slots.clear();
 }
 
 std::shared_ptr<const Ego::Texture> ParticleHandler::getLightParticleTexture()
@@ -182,9 +182,6 @@ void LoadingState::loadModuleData()
         // Reset all loaded "profiles" in the "profile system".
         ProfileSystem::get().reset();
 
-        // do some graphics initialization
-        gfx_system_make_enviro();
-
         //Load players if needed
         if(!_playersToLoad.empty()) {
             setProgressText("Loading players...", 50);
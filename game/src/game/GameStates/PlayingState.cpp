@@ -33,6 +33,7 @@
 #include "game/game.h"
 #include "game/graphic.h"
 #include "game/Logic/Player.hpp"
+#include "egolib/Script/ThinkScheduler.hpp"
 
 //For cheats
 #include "game/Entities/_Include.hpp"
@@ -55,6 +56,16 @@ PlayingState::PlayingState() :
         debugWindow->addWatchVariable("Name", []{return _currentModule->getName();} );
         debugWindow->addWatchVariable("Path", []{return _currentModule->getPath();} );
         addComponent(debugWindow);        
+
+        if (egoboo_config_t::get().game_aiScheduler_enable.getValue())
+        {
+            auto aiWindow = std::make_shared<Ego::GUI::InternalDebugWindow>("AI Scheduler");
+            aiWindow->addWatchVariable("Run", []{return std::to_string(get_think_scheduler().getCounters().run);} );
+            aiWindow->addWatchVariable("Skipped", []{return std::to_string(get_think_scheduler().getCounters().skipped);} );
+            aiWindow->addWatchVariable("Deferred", []{return std::to_string(get_think_scheduler().getCounters().deferred);} );
+            aiWindow->addWatchVariable("Woken", []{return std::to_string(get_think_scheduler().getCounters().woken);} );
+            addComponent(aiWindow);
+        }
     }
 
     //Add minimap to the list of GUI components to render
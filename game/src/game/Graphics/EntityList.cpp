@@ -7,7 +7,7 @@ namespace Ego {
 namespace Graphics {
 
 EntityList::EntityList()
-    : list(), set() {}
+    : list(), set(), particleCulling(), particleCandidates(), visibleParticles() {}
 
 void EntityList::clear() {
     if (list.empty()) {
@@ -58,18 +58,39 @@ size_t EntityList::add(::Camera& camera, Object& object) {
     return count;
 }
 
-size_t EntityList::add(::Camera& camera, Ego::Particle& particle) {
-    size_t count = 0;
-    if (!test(camera, particle)) {
-        particle.inst.indolist = false;
-        return count;
-    }
-    particle.inst.indolist = true;
+size_t EntityList::addParticles(::Camera& camera) {
+    particleCulling.clear();
+    particleCandidates.clear();
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator()) {
+        particle->inst.indolist = false;
 
-    list.emplace_back(ObjectRef::Invalid, particle.getParticleID());
-    set.emplace((void *)(&particle));
-    count++;
+        // The particle is not a candidate if it is not displayed.
+        if (particle->isTerminated() || particle->isHidden() || 0 == particle->size) {
+            continue;
+        }
+
+        // Particles which neither deal damage, nor light the scene nor are attached to an object are only effects.
+        const bool lowPriority = !particle->isAttached() && 0 == particle->damage.base && 0 == particle->damage.rand
+                              && 0 == particle->dynalight.on;
+        particleCulling.add(particleCandidates.size(),
+                            Sphere3f(Point3f::toPoint(particle->getPosition()), particle->bump_real.size_big),
+                            Sphere3f(Point3f::toPoint(particle->inst.ref_pos), particle->bump_real.size_big),
+                            lowPriority);
+        particleCandidates.push_back(particle.get());
+    }
+    particleCulling.cull(camera.getFrustum(), Point3f::toPoint(camera.getPosition()), CAPACITY - list.size(), visibleParticles);
 
+    size_t count = 0;
+    for (const auto& visible : visibleParticles) {
+        Ego::Particle& particle = *particleCandidates[visible.index];
+        if (!set.emplace((void *)(&particle)).second) {
+            continue;
+        }
+        particle.inst.indolist = true;
+        particle.inst.update_interval = visible.updateInterval;
+        list.emplace_back(ObjectRef::Invalid, particle.getParticleID());
+        count++;
+    }
     return count;
 }
 
@@ -150,35 +171,5 @@ bool EntityList::test(::Camera& camera, const Object& object) {
     return set.find((void *)(&object)) == set.cend();
 }
 
-bool EntityList::test(::Camera& camera, const Ego::Particle& particle) {
-    // The particle is not a candidate if the list is full.
-    if (list.size() == CAPACITY) {
-        return false;
-    }
-
-    // The particle is not a candidate if it is not displayed.
-    if (particle.isTerminated()) {
-        return false;
-    }
-
-    // The particle is not a candidate if it is explicitly or implicitly hidden.
-    if (particle.isHidden() || 0 == particle.size) {
-        return false;
-    }
-
-    // The particle is not a candidate if
-    // both its bounding sphere and its reflected bounding sphere
-    // are outside of the frustum.
-    const auto& frustum = camera.getFrustum();
-    const Sphere3f sphere(Point3f::toPoint(particle.getPosition()), particle.bump_real.size_big);
-    const Sphere3f reflectedSphere(Point3f::toPoint(particle.inst.ref_pos), particle.bump_real.size_big);
-    if (Ego::Math::Relation::outside == frustum.intersects(sphere, false) &&
-        Ego::Math::Relation::outside == frustum.intersects(reflectedSphere, false)) {
-        return false;
-    }
-
-    return set.find((void *)(&particle)) == set.cend();
-}
-
 } // namespace Graphics
 } // namespace Ego
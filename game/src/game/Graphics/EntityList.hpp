@@ -26,6 +26,7 @@
 #include "game/egoboo.h"
 #include "game/mesh.h"
 #include "game/Graphics/CameraSystem.hpp"
+#include "egolib/Graphics/ParticleCulling.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -67,6 +68,11 @@ private:
     std::vector<Element> list;
     /** For checking in amortized constant time if an object is already in this entity list. */
     std::unordered_set<void *> set;
+    /** Culls the particles against the frustum of the camera and selects their level of detail. */
+    ParticleCulling particleCulling;
+    /** The particles added to the culling, scratch buffers of addParticles(). */
+    std::vector<Ego::Particle *> particleCandidates;
+    std::vector<ParticleCulling::Visible> visibleParticles;
 
 private:
     /**
@@ -75,13 +81,6 @@ private:
      */
     bool test(::Camera& camera, const Object& object);
 
-    /**
-     * @brief Test if the specified particle entity is eligible for addition.
-     * @return @a true if the specified particle entity is eligible for addition, @a false otherwise
-     * @todo Should be a reference to a particle.
-     */
-    bool test(::Camera& camera, const Ego::Particle& particle);
-
 public:
     EntityList();
 
@@ -118,14 +117,20 @@ public:
     size_t add(::Camera& camera, Object& object);
 
     /**
-     * @brief Add a particle entity if it is eligible for addition.
-     * @param obj the particle entity to add
+     * @brief Add all particle entities which are visible from a camera.
      * @return the total number of entities added
-     * @remark A (legacy) occlusion test is performed. If the particle is occluded,
-     * then particle.getInstance().isOccluded() is set to @a true, otherwise it is
-     * set to @a false.
+     * @remark The particles are culled in bins against the frustum of the camera.
+     * Distant particles update their instances less often, distant low priority
+     * particles are not added at all.
      */
-    size_t add(::Camera& camera, Ego::Particle& particle);
+    size_t addParticles(::Camera& camera);
+
+    /**
+     * @brief Get what happened to the particles in the last call to addParticles().
+     */
+    const ParticleCulling::Statistics& getParticleStatistics() const {
+        return particleCulling.getStatistics();
+    }
 };
 
 } // namespace Graphics
@@ -1,6 +1,7 @@
 #include "ObjectGraphics.hpp"
 #include "game/Entities/_Include.hpp"
 #include "game/game.h" //only for character_swipe()
+#include "egolib/Graphics/MD2Interpolation.hpp"
 
 namespace Ego
 {
@@ -170,76 +171,17 @@ gfx_rv ObjectGraphics::needs_update(int vmin, int vmax, bool *verts_match, bool
     return (!(*verts_match) || !( *frames_match )) ? gfx_success : gfx_fail;
 }
 
-void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip )
+void ObjectGraphics::interpolateVerticesRaw(const MD2_Frame &lastFrame, const MD2_Frame &nextFrame, int vmin, int vmax, float flip )
 {
     /// raw indicates no bounds checking, so be careful
 
-    if ( 0.0f == flip )
-    {
-        for (size_t i = vmin; i <= vmax; i++)
-        {
-            GLvertex* dst = &_vertexList[i];
-            const MD2_Vertex &srcLast = lst_ary[i];
-
-			dst->pos[XX] = srcLast.pos[kX];
-			dst->pos[YY] = srcLast.pos[kY];
-			dst->pos[ZZ] = srcLast.pos[kZ];
-            dst->pos[WW] = 1.0f;
-
-			dst->nrm[XX] = srcLast.nrm[kX];
-			dst->nrm[YY] = srcLast.nrm[kY];
-			dst->nrm[ZZ] = srcLast.nrm[kZ];
-
-            dst->env[XX] = indextoenvirox[srcLast.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
-    }
-    else if ( 1.0f == flip )
-    {
-        for (size_t i = vmin; i <= vmax; i++ )
-        {
-            GLvertex* dst = &_vertexList[i];
-            const MD2_Vertex &srcNext = nxt_ary[i];
+    // MD2Interpolation writes the position, the normal and the environment map coordinates in this order
+    static_assert(offsetof(GLvertex, nrm) == offsetof(GLvertex, pos) + 4 * sizeof(float), "unexpected GLvertex layout");
+    static_assert(offsetof(GLvertex, env) == offsetof(GLvertex, nrm) + 3 * sizeof(float), "unexpected GLvertex layout");
+    static_assert(sizeof(GLvertex) % sizeof(float) == 0, "unexpected GLvertex layout");
 
-			dst->pos[XX] = srcNext.pos[kX];
-			dst->pos[YY] = srcNext.pos[kY];
-			dst->pos[ZZ] = srcNext.pos[kZ];
-            dst->pos[WW] = 1.0f;
-
-            dst->nrm[XX] = srcNext.nrm[kX];
-            dst->nrm[YY] = srcNext.nrm[kY];
-            dst->nrm[ZZ] = srcNext.nrm[kZ];
-
-            dst->env[XX] = indextoenvirox[srcNext.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
-    }
-    else
-    {
-        uint16_t vrta_lst, vrta_nxt;
-
-        for (size_t i = vmin; i <= vmax; i++)
-        {
-            GLvertex* dst = &_vertexList[i];
-            const MD2_Vertex &srcLast = lst_ary[i];
-            const MD2_Vertex &srcNext = nxt_ary[i];
-
-            dst->pos[XX] = srcLast.pos[kX] + ( srcNext.pos[kX] - srcLast.pos[kX] ) * flip;
-            dst->pos[YY] = srcLast.pos[kY] + ( srcNext.pos[kY] - srcLast.pos[kY] ) * flip;
-            dst->pos[ZZ] = srcLast.pos[kZ] + ( srcNext.pos[kZ] - srcLast.pos[kZ] ) * flip;
-            dst->pos[WW] = 1.0f;
-
-            dst->nrm[XX] = srcLast.nrm[kX] + ( srcNext.nrm[kX] - srcLast.nrm[kX] ) * flip;
-            dst->nrm[YY] = srcLast.nrm[kY] + ( srcNext.nrm[kY] - srcLast.nrm[kY] ) * flip;
-            dst->nrm[ZZ] = srcLast.nrm[kZ] + ( srcNext.nrm[kZ] - srcLast.nrm[kZ] ) * flip;
-
-            vrta_lst = srcLast.normal;
-            vrta_nxt = srcNext.normal;
-
-            dst->env[XX] = indextoenvirox[vrta_lst] + ( indextoenvirox[vrta_nxt] - indextoenvirox[vrta_lst] ) * flip;
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
-    }
+    MD2Interpolation::interpolate(lastFrame, nextFrame, vmin, vmax, flip,
+                                  _vertexList.data()->pos, sizeof(GLvertex) / sizeof(float));
 }
 
 gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
@@ -340,13 +282,13 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     // interpolate the 1st dirty region
     if ( vdirty1_min >= 0 && vdirty1_max >= 0 )
     {
-		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty1_min, vdirty1_max, loc_flip);
+		interpolateVerticesRaw(lastFrame, nextFrame, vdirty1_min, vdirty1_max, loc_flip);
     }
 
     // interpolate the 2nd dirty region
     if ( vdirty2_min >= 0 && vdirty2_max >= 0 )
     {
-		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty2_min, vdirty2_max, loc_flip);
+		interpolateVerticesRaw(lastFrame, nextFrame, vdirty2_min, vdirty2_max, loc_flip);
     }
 
     // update the saved parameters
@@ -287,7 +287,7 @@ private:
     **/
 	void clearCache();
 
-	void interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip);
+	void interpolateVerticesRaw(const MD2_Frame &lastFrame, const MD2_Frame &nextFrame, int vmin, int vmax, float flip);
 
     /**
     * @brief
@@ -132,14 +132,22 @@ void TileListV2::render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t
 	// restart the mesh texture code
 	TileRenderer::invalidate();
 
-	for (size_t i = 0; i < rlst.size; ++i)
+	// The batches have a colour for every vertex and no normals, draw the fans without Gouraud shading or with normals.
+	if (gfx.gouraudShading_enable && !egoboo_config_t::get().debug_mesh_renderNormals.getValue())
 	{
-		Index1D tmp_itile = lst_vals[i].getTileIndex();
-
-		gfx_rv render_rv = render_fan(mesh, tmp_itile);
-		if (egoboo_config_t::get().debug_developerMode_enable.getValue() && gfx_error == render_rv)
+		render_batches(mesh, lst_vals);
+	}
+	else
+	{
+		for (size_t i = 0; i < rlst.size; ++i)
 		{
-			Log::get().warn("%s - error rendering tile %d.\n", __FUNCTION__, tmp_itile.i());
+			Index1D tmp_itile = lst_vals[i].getTileIndex();
+
+			gfx_rv render_rv = render_fan(mesh, tmp_itile);
+			if (egoboo_config_t::get().debug_developerMode_enable.getValue() && gfx_error == render_rv)
+			{
+				Log::get().warn("%s - error rendering tile %d.\n", __FUNCTION__, tmp_itile.i());
+			}
 		}
 	}
 
@@ -147,10 +155,33 @@ void TileListV2::render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t
 	TileRenderer::invalidate();
 }
 
+void TileListV2::render_batches(const ego_mesh_t& mesh, const std::vector<ElementV2>& elements)
+{
+	static std::vector<MeshBatches::Element> batchElements;
+	batchElements.clear();
+	for (const auto& element : elements)
+	{
+		// do not render tiles outside of the mesh or with an invalid image
+		if (std::numeric_limits<uint32_t>::max() == element.getTextureIndex() ||
+			mesh.getTileInfo(element.getTileIndex()).isFanOff())
+		{
+			continue;
+		}
+		batchElements.push_back(MeshBatches::Element{static_cast<size_t>(element.getTileIndex().i()), element.getTextureIndex()});
+	}
+
+	auto& renderer = Renderer::get();
+	// Per-vertex coloring.
+	renderer.setGouraudShadingEnabled(true);
+	// bind the texture of the first tile of each texture
+	mesh._batches.render(renderer, batchElements, [&mesh](const MeshBatches::Element& element) {
+		TileRenderer::bind(mesh.getTileInfo(Index1D(static_cast<int>(element.tile))));
+	});
+}
+
 gfx_rv TileListV2::render_fan(const ego_mesh_t& mesh, const Index1D& i) {
     /// @author ZZ
     /// @details This function draws a mesh itile
-    /// Optimized to use gl*Pointer() and glArrayElement() for vertex presentation
 
     // grab a pointer to the tile
     const ego_tile_info_t& ptile = mesh.getTileInfo(i);
@@ -166,57 +197,73 @@ gfx_rv TileListV2::render_fan(const ego_mesh_t& mesh, const Index1D& i) {
     // bind the correct texture
     TileRenderer::bind(ptile);
 
-    {
-        Ego::OpenGL::PushClientAttrib pca(GL_CLIENT_VERTEX_ARRAY_BIT);
-        {
-            // Per-vertex coloring.
-            Ego::Renderer::get().setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
-
-                                                                                      /// @note claforte@> Put this in an initialization function.
-            GL_DEBUG(glEnableClientState)(GL_VERTEX_ARRAY);
-            GL_DEBUG(glVertexPointer)(3, GL_FLOAT, 0, &(ptmem._plst[ptile._vrtstart]));
+    auto& renderer = Renderer::get();
+    // Per-vertex coloring.
+    renderer.setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
 
-            GL_DEBUG(glEnableClientState)(GL_TEXTURE_COORD_ARRAY);
-            GL_DEBUG(glTexCoordPointer)(2, GL_FLOAT, 0, &(ptmem._tlst[ptile._vrtstart]));
-
-            if (gfx.gouraudShading_enable) {
-                GL_DEBUG(glEnableClientState)(GL_COLOR_ARRAY);
-                GL_DEBUG(glColorPointer)(3, GL_FLOAT, 0, &(ptmem._clst[ptile._vrtstart]));
-            } else {
-                GL_DEBUG(glDisableClientState)(GL_COLOR_ARRAY);
-            }
-            // grab some model info
-            uint16_t commands = pdef->command_count;
+    // Copy the vertices of the tile, without their colours if per-vertex coloring is disabled.
+    struct ColouredVertex {
+        float x, y, z;
+        float r, g, b;
+        float s, t;
+    };
+    struct Vertex {
+        float x, y, z;
+        float s, t;
+    };
+    static VertexBuffer colouredVertexBuffer(MAP_FAN_VERTICES_MAX, VertexFormatFactory::get<VertexFormat::P3FC3FT2F>());
+    static VertexBuffer vertexBuffer(MAP_FAN_VERTICES_MAX, VertexFormatFactory::get<VertexFormat::P3FT2F>());
+    if (gfx.gouraudShading_enable) {
+        ColouredVertex *v = static_cast<ColouredVertex *>(colouredVertexBuffer.lock());
+        for (size_t j = 0, k = ptile._vrtstart; j < pdef->numvertices; ++j, ++k) {
+            v[j] = {ptmem._plst[k][XX], ptmem._plst[k][YY], ptmem._plst[k][ZZ],
+                    ptmem._clst[k][RR], ptmem._clst[k][GG], ptmem._clst[k][BB],
+                    ptmem._tlst[k][SS], ptmem._tlst[k][TT]};
+        }
+        colouredVertexBuffer.unlock();
+    } else {
+        Vertex *v = static_cast<Vertex *>(vertexBuffer.lock());
+        for (size_t j = 0, k = ptile._vrtstart; j < pdef->numvertices; ++j, ++k) {
+            v[j] = {ptmem._plst[k][XX], ptmem._plst[k][YY], ptmem._plst[k][ZZ],
+                    ptmem._tlst[k][SS], ptmem._tlst[k][TT]};
+        }
+        vertexBuffer.unlock();
+    }
 
-            // Render each command
-            for (size_t cnt = 0, entry = 0; cnt < commands; cnt++) {
-                uint8_t numEntries = pdef->command_entries[cnt];
+    // Copy the vertices of the fans of the tile.
+    static IndexBuffer indexBuffer(MAP_FAN_ENTRIES_MAX, IndexFormatFactory::get<IndexFormat::IU16>());
+    {
+        uint16_t *indices = static_cast<uint16_t *>(indexBuffer.lock());
+        std::copy(pdef->command_verts, pdef->command_verts + MAP_FAN_ENTRIES_MAX, indices);
+        indexBuffer.unlock();
+    }
 
-                GL_DEBUG(glDrawElements)(GL_TRIANGLE_FAN, numEntries, GL_UNSIGNED_SHORT, &(pdef->command_verts[entry]));
-                entry += numEntries;
-            }
-        }
+    // Render each command
+    for (size_t cnt = 0, entry = 0; cnt < pdef->command_count; cnt++) {
+        uint8_t numEntries = pdef->command_entries[cnt];
+        renderer.render(gfx.gouraudShading_enable ? colouredVertexBuffer : vertexBuffer, indexBuffer,
+                        PrimitiveType::TriangleFan, entry, numEntries);
+        entry += numEntries;
     }
 
     if (egoboo_config_t::get().debug_mesh_renderNormals.getValue()) {
         TileRenderer::invalidate();
-        auto& renderer = Ego::Renderer::get();
         renderer.getTextureUnit().setActivated(nullptr);
         renderer.setColour(Ego::Colour4f::white());
+        // A line from each corner of the tile along its normal.
+        struct NormalVertex {
+            float x, y, z;
+        };
+        static VertexBuffer normalVertexBuffer(8, VertexFormatFactory::get<VertexFormat::P3F>());
+        NormalVertex *v = static_cast<NormalVertex *>(normalVertexBuffer.lock());
         for (size_t i = ptile._vrtstart, j = 0; j < 4; ++i, ++j) {
-            glBegin(GL_LINES);
-            {
-                glVertex3fv(ptmem._plst[i]);
-                glVertex3f
-                    (
-                        ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
-                        ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
-                        ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])
-                        );
-
-            }
-            glEnd();
+            v[2 * j + 0] = {ptmem._plst[i][XX], ptmem._plst[i][YY], ptmem._plst[i][ZZ]};
+            v[2 * j + 1] = {ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
+                            ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
+                            ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])};
         }
+        normalVertexBuffer.unlock();
+        renderer.render(normalVertexBuffer, PrimitiveType::Lines, 0, 8);
     }
 
     return gfx_success;
@@ -225,9 +272,12 @@ gfx_rv TileListV2::render_fan(const ego_mesh_t& mesh, const Index1D& i) {
 gfx_rv TileListV2::render_hmap_fan(const ego_mesh_t * mesh, const Index1D& tileIndex) {
     /// @author ZZ
     /// @details This function draws a mesh itile
-    GLvertex v[4];
+    struct Vertex {
+        float x, y, z;
+        float r, g, b, a;
+    };
 
-    int cnt, vertex;
+    int cnt;
     size_t badvertex;
     int ix_off[4] = {0, 1, 1, 0}, iy_off[4] = {0, 0, 1, 1};
 
@@ -250,40 +300,39 @@ gfx_rv TileListV2::render_hmap_fan(const ego_mesh_t * mesh, const Index1D& tileI
 
     const uint8_t twist = ptile._twist;
 
+    static VertexBuffer vertexBuffer(4, VertexFormatFactory::get<VertexFormat::P3FC4F>());
+    Vertex *v = static_cast<Vertex *>(vertexBuffer.lock());
+
     // Original points
     badvertex = ptile._vrtstart;          // Get big reference value
     for (cnt = 0; cnt < 4; cnt++) {
         float tmp;
-        v[cnt].pos[XX] = (i2.x() + ix_off[cnt]) * Info<float>::Grid::Size();
-        v[cnt].pos[YY] = (i2.y() + iy_off[cnt]) * Info<float>::Grid::Size();
-        v[cnt].pos[ZZ] = ptmem._plst[badvertex][ZZ];
+        v[cnt].x = (i2.x() + ix_off[cnt]) * Info<float>::Grid::Size();
+        v[cnt].y = (i2.y() + iy_off[cnt]) * Info<float>::Grid::Size();
+        v[cnt].z = ptmem._plst[badvertex][ZZ];
 
         tmp = g_meshLookupTables.twist_nrm[twist][kZ];
         tmp *= tmp;
 
-        v[cnt].col[RR] = tmp * (tmp + (1.0f - tmp) * g_meshLookupTables.twist_nrm[twist][kX] * g_meshLookupTables.twist_nrm[twist][kX]);
-        v[cnt].col[GG] = tmp * (tmp + (1.0f - tmp) * g_meshLookupTables.twist_nrm[twist][kY] * g_meshLookupTables.twist_nrm[twist][kY]);
-        v[cnt].col[BB] = tmp;
-        v[cnt].col[AA] = 1.0f;
+        v[cnt].r = tmp * (tmp + (1.0f - tmp) * g_meshLookupTables.twist_nrm[twist][kX] * g_meshLookupTables.twist_nrm[twist][kX]);
+        v[cnt].g = tmp * (tmp + (1.0f - tmp) * g_meshLookupTables.twist_nrm[twist][kY] * g_meshLookupTables.twist_nrm[twist][kY]);
+        v[cnt].b = tmp;
+        v[cnt].a = 1.0f;
 
-        v[cnt].col[RR] = Ego::Math::constrain(v[cnt].col[RR], 0.0f, 1.0f);
-        v[cnt].col[GG] = Ego::Math::constrain(v[cnt].col[GG], 0.0f, 1.0f);
-        v[cnt].col[BB] = Ego::Math::constrain(v[cnt].col[BB], 0.0f, 1.0f);
+        v[cnt].r = Ego::Math::constrain(v[cnt].r, 0.0f, 1.0f);
+        v[cnt].g = Ego::Math::constrain(v[cnt].g, 0.0f, 1.0f);
+        v[cnt].b = Ego::Math::constrain(v[cnt].b, 0.0f, 1.0f);
 
         badvertex++;
     }
 
-    Ego::Renderer::get().getTextureUnit().setActivated(nullptr);
+    vertexBuffer.unlock();
+
+    auto& renderer = Renderer::get();
+    renderer.getTextureUnit().setActivated(nullptr);
 
     // Render each command
-    GL_DEBUG(glBegin)(GL_TRIANGLE_FAN);
-    {
-        for (vertex = 0; vertex < 4; vertex++) {
-            GL_DEBUG(glColor3fv)(v[vertex].col);
-            GL_DEBUG(glVertex3fv)(v[vertex].pos);
-        }
-    }
-    GL_DEBUG_END();
+    renderer.render(vertexBuffer, PrimitiveType::TriangleFan, 0, 4);
 
     return gfx_success;
 }
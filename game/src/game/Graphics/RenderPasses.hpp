@@ -52,6 +52,10 @@ public:
 
 struct TileListV2 {
     static void render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t& rlst);
+    /// @brief Draw the tiles of each texture in each chunk of the mesh at once.
+    /// @param mesh the mesh
+    /// @param elements the tiles sorted by texture
+    static void render_batches(const ego_mesh_t& mesh, const std::vector<ElementV2>& elements);
     /// @brief Draw a fan.
     /// @param mesh the mesh
     /// @param tileIndex the tile index
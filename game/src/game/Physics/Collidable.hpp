@@ -103,6 +103,7 @@ public:
         //Change our new position
         _oldPosition = _position;
         _position = pos;
+        onPositionChanged();
 
         _tile = _currentModule->getMeshPointer()->getTileIndex(Vector2f(getPosX(), getPosY()));
 
@@ -206,6 +207,12 @@ public:
 	virtual BIT_FIELD test_wall(const Vector3f& pos) = 0;
 
 protected:
+    /**
+    * @brief
+    *   Called whenever the position of this entity has changed.
+    **/
+    virtual void onPositionChanged() {}
+
     /**
     * @brief
     *  Current position in the world
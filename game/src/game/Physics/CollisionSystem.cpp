@@ -30,7 +30,15 @@ namespace Physics
 static bool do_chr_chr_collision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, float tmax, float tmin);
 static void get_recoil_factors( float wta, float wtb, float * recoil_a, float * recoil_b );
 
-CollisionSystem::CollisionSystem()
+CollisionSystem::CollisionSystem() :
+    _objectBroadPhase(),
+    _objectProxies(),
+    _objectPairs(),
+    _objectHits(),
+    _particleProxies(),
+    _particleCandidates(),
+    _possibleCollisions(),
+    _jobSystem(nullptr)
 {
 
 }
@@ -257,18 +265,65 @@ void CollisionSystem::update()
 
 void CollisionSystem::updateObjectCollisions()
 {
-    std::unordered_set<std::shared_ptr<Object>> handledObjects;
+    //Keep the object list locked while we hold on to the proxies
+    ObjectHandler::ObjectIterator objects = _currentModule->getObjectHandler().iterator();
 
-    //Detect character -> character collisions
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
+    //Broad phase: one proxy for every object that can collide
+    _objectBroadPhase.begin();
+    for(const std::shared_ptr<Object> &object : objects) {
 
         //Can we collide?
         if (!object->canCollide()) {
             continue;
         }
-        handledObjects.insert(object);
 
-        //First check if this object is still attached to it's Platform
+        //TODO: Remove this messy block and replace it with something better
+        // use the object velocity to figure out where the volume that the object will occupy during this update
+        // convert the oct_bb_t to a correct BSP_aabb_t
+        oct_bb_t tmp_oct;
+        phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
+        const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+
+        _objectBroadPhase.add(object->getObjRef().get(), aabb2d);
+        _objectProxies.push_back(object);
+    }
+    _objectBroadPhase.findPairs(_objectPairs);
+
+    //Narrow phase detection: read-only per pair, so it may run in parallel
+    _objectHits.resize(_objectPairs.size());
+    forEach(_objectPairs.size(), [this](size_t first, size_t last) {
+        for(size_t i = first; i < last; ++i) {
+            const std::shared_ptr<Object> &object = _objectProxies[_objectPairs[i].first];
+            const std::shared_ptr<Object> &other = _objectProxies[_objectPairs[i].second];
+            CollisionHit &hit = _objectHits[i];
+
+            //Do not collide scenery with other scenery objects - unless they can use platforms,
+            //for example boxes stacked on top of other boxes
+            bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
+            if(other->isScenery() && !canCollideWithScenery) {
+                hit.detected = false;
+                continue;
+            }
+
+            hit.detected = detectCollision(object, other, &hit.tmin, &hit.tmax);
+        }
+    });
+
+    //Resolution: object by object in the order they were iterated, the pairs are sorted by their first slot
+    size_t i = 0;
+    for(size_t slot = 0; slot < _objectProxies.size(); ++slot) {
+        const std::shared_ptr<Object> &object = _objectProxies[slot];
+        const size_t firstPair = i;
+        while(i < _objectPairs.size() && _objectPairs[i].first == slot) {
+            ++i;
+        }
+
+        //Earlier collisions this update might have changed this (e.g. mounting)
+        if(!object->canCollide()) {
+            continue;
+        }
+
+        //First check if this object is still attached to it's Platform, after the collisions of the objects before it
         const std::shared_ptr<Object> &platform = _currentModule->getObjectHandler()[object->onwhichplatform_ref];
         if(platform)
         {
@@ -280,44 +335,29 @@ void CollisionSystem::updateObjectCollisions()
             }
         }
 
-        //TODO: Remove this messy block and replace it with something better
-        // use the object velocity to figure out where the volume that the object will occupy during this update
-        // convert the oct_bb_t to a correct BSP_aabb_t
-        oct_bb_t tmp_oct;
-        phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
-        const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
-
-        //Do not collide scenery with other scenery objects - unless they can use platforms,
-        //for example boxes stacked on top of other boxes
-        bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
-
-        // Check collisions to nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-        _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, canCollideWithScenery);
-        for (const std::shared_ptr<Object> &other : possibleCollisions)
-        {
-            //Skip possible interactions that have already been handled earlier this iteration
-            if(handledObjects.find(other) != handledObjects.end()) {
+        for(size_t j = firstPair; j < i; ++j) {
+            const CollisionHit &hit = _objectHits[j];
+            if(!hit.detected) {
                 continue;
             }
+            const std::shared_ptr<Object> &other = _objectProxies[_objectPairs[j].second];
 
-            //Can it collide?
-            if(!other->canCollide()) {
+            //Earlier collisions this update might have changed this (e.g. mounting)
+            if(!object->canCollide() || !other->canCollide()) {
                 continue;
             }
 
-            //Detect any collisions and handle it if needed
-            float tmin, tmax;
-            if(detectCollision(object, other, &tmin, &tmax)) {
-                handleCollision(object, other, tmin, tmax);
-            }
+            handleCollision(object, other, hit.tmin, hit.tmax);
         }
     }
+
+    //Do not keep objects alive
+    _objectProxies.clear();
 }
 
 void CollisionSystem::updateParticleCollisions()
 {
-    //Check collisions with particles
+    //Gather candidates for all particles (the object spatial index is not thread-safe)
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
         if(!particle->canCollide()) {
@@ -335,24 +375,76 @@ void CollisionSystem::updateParticleCollisions()
         phys_expand_prt_bb(particle.get(), 0.0f, 1.0f, tmp_oct);
         const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
 
-        //Detect collisions with nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-         _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
-        for (const std::shared_ptr<Object> &object : possibleCollisions)
+        //Find nearby Objects
+        _possibleCollisions.clear();
+        _currentModule->getObjectHandler().findObjects(aabb2d, _possibleCollisions, true);
+        if(_possibleCollisions.empty()) {
+            continue;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(_particleProxies.size());
+        _particleProxies.push_back(particle);
+        for (std::shared_ptr<Object> &object : _possibleCollisions)
         {
+            ParticleCandidate candidate;
+            candidate.particle = slot;
+            candidate.object = std::move(object);
+            _particleCandidates.push_back(std::move(candidate));
+        }
+    }
+
+    //Narrow phase detection: read-only per candidate, so it may run in parallel
+    forEach(_particleCandidates.size(), [this](size_t first, size_t last) {
+        for(size_t i = first; i < last; ++i) {
+            ParticleCandidate &candidate = _particleCandidates[i];
+
             //Is it a valid collision?
-            if(!object->canCollide()) {
+            if(!candidate.object->canCollide()) {
+                candidate.hit.detected = false;
                 continue;
             }
 
-            //Detect any collisions and handle it if needed
-            float tmin, tmax;
-            if(detectCollision(particle, object, &tmin, &tmax)) {
-                do_prt_platform_detection(object->getObjRef(), particle->getParticleID());
-                do_chr_prt_collision(object, particle, tmin, tmax);
-            }
+            candidate.hit.detected = detectCollision(_particleProxies[candidate.particle], candidate.object, &candidate.hit.tmin, &candidate.hit.tmax);
+        }
+    });
+
+    //Resolution: each hit in the order the particles were iterated
+    for(const ParticleCandidate &candidate : _particleCandidates) {
+        if(!candidate.hit.detected) {
+            continue;
         }
-    }    
+        const std::shared_ptr<Ego::Particle> &particle = _particleProxies[candidate.particle];
+
+        //Earlier collisions this update might have removed the object
+        if(!candidate.object->canCollide()) {
+            continue;
+        }
+
+        do_prt_platform_detection(candidate.object->getObjRef(), particle->getParticleID());
+        do_chr_prt_collision(candidate.object, particle, candidate.hit.tmin, candidate.hit.tmax);
+    }
+
+    //Do not keep particles or objects alive
+    _particleProxies.clear();
+    _particleCandidates.clear();
+}
+
+template <typename Function>
+void CollisionSystem::forEach(const size_t count, const Function &function)
+{
+    //Not worth the synchronization for a handful of pairs
+    static const size_t GRAIN_SIZE = 64;
+    if(!egoboo_config_t::get().game_parallelCollisions_enable.getValue() || count <= GRAIN_SIZE) {
+        function(0, count);
+        return;
+    }
+
+    if(!_jobSystem) {
+        //The calling thread helps out while waiting
+        const size_t cores = std::thread::hardware_concurrency();
+        _jobSystem = std::make_unique<Core::JobSystem>(cores > 1 ? cores - 1 : 1);
+    }
+    _jobSystem->parallelFor(0, count, GRAIN_SIZE, function);
 }
 
 bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &particle, const std::shared_ptr<Object> &object, float *tmin, float *tmax) const
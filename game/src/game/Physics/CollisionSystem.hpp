@@ -20,6 +20,7 @@
 
 #include "IdLib/IdLib.hpp"
 #include "egolib/egolib.h"
+#include "egolib/Core/JobSystem.hpp"
 
 //Forward declarations
 namespace Ego { class Particle; }
@@ -34,16 +35,38 @@ class CollisionSystem : public Core::Singleton<CollisionSystem>
 public:
     /**
     * @brief
-    *   Detect and handle all Object to Object collisions
+    *   Detect and handle all Object to Object collisions.
+    *   A sweep-and-prune broad phase emits every candidate pair once, the narrow phase
+    *   then runs detectCollision() and handleCollision() over that pair list.
+    * @remark
+    *   All pairs are detected before the first one is handled. Earlier versions detected and
+    *   handled each pair in turn, so a collision handled earlier in the update could change
+    *   what a later pair detected. Detection now always sees the state from the start of the
+    *   collision update, with and without worker threads.
+    * @remark
+    *   Whether an object is still on its platform is checked right before its own pairs are
+    *   handled, after the pairs of the objects iterated before it.
     **/
     void updateObjectCollisions();
 
     /**
     * @brief
     *   Detect and handle all Particle to Object collisions
+    * @remark
+    *   As for objects, the candidates of all particles are gathered and detected before the
+    *   first hit is handled, in the order the particles were iterated.
     **/
     void updateParticleCollisions();
 
+    /**
+    * @brief
+    *   Detect and handle all collisions for this update.
+    * @remark
+    *   Detection only reads the bounding boxes of both participants and may run in parallel
+    *   (see egoboo_config_t::game_parallelCollisions_enable). The detected collisions are
+    *   always resolved on the calling thread in a fixed pair order, so the parallel and the
+    *   single-threaded path produce identical physics state.
+    **/
     void update();
 
 private:
@@ -99,6 +122,42 @@ private:
     **/
     bool handleMountingCollision(const std::shared_ptr<Object> &character, const std::shared_ptr<Object> &mount);
 
+    /**
+    * @brief
+    *   Run function(first, last) over the index range [0, count). The range is split
+    *   across worker threads if parallel collision detection is enabled, otherwise
+    *   it runs on the calling thread.
+    **/
+    template <typename Function>
+    void forEach(const size_t count, const Function &function);
+
+private:
+    /// The result of the narrow phase detection for one candidate pair
+    struct CollisionHit
+    {
+        bool detected;
+        float tmin, tmax;
+    };
+
+    /// A Particle to Object candidate pair
+    struct ParticleCandidate
+    {
+        uint32_t particle;                  //< Index into _particleProxies
+        std::shared_ptr<Object> object;
+        CollisionHit hit;
+    };
+
+    Ego::SweepAndPrune _objectBroadPhase;                   //< Object to Object broad phase, kept coherent between updates
+    std::vector<std::shared_ptr<Object>> _objectProxies;    //< Objects added to the broad phase this update, indexed by slot
+    std::vector<Ego::SweepAndPrune::Pair> _objectPairs;     //< Candidate pairs found by the broad phase this update
+    std::vector<CollisionHit> _objectHits;                  //< Detection result for each entry of _objectPairs
+
+    std::vector<std::shared_ptr<Ego::Particle>> _particleProxies;   //< Particles with candidates this update
+    std::vector<ParticleCandidate> _particleCandidates;             //< Particle to Object candidates this update
+    std::vector<std::shared_ptr<Object>> _possibleCollisions;       //< Scratch buffer for spatial queries
+
+    std::unique_ptr<Core::JobSystem> _jobSystem;            //< Workers for parallel detection, created on demand
+
 private:
     friend Core::Singleton<CollisionSystem>::CreateFunctorType;
     friend Core::Singleton<CollisionSystem>::DestroyFunctorType;
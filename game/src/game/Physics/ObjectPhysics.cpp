@@ -841,6 +841,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
     _object.inwhich_slot       = slot;
     _object.attachedto         = holder->getObjRef();
     holder->holdingwhich[slot] = _object.getObjRef();
+    holder->invalidateAttributes();
 
     // set the grip vertices for the irider
     set_weapongrip(_object.getObjRef(), holder->getObjRef(), grip_off);
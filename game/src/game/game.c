@@ -25,6 +25,7 @@
 
 #include "egolib/egolib.h"
 #include "egolib/FileFormats/Globals.hpp"
+#include "egolib/Script/ThinkScheduler.hpp"
 
 #include "game/GUI/MiniMap.hpp"
 #include "game/GameStates/PlayingState.hpp"
@@ -68,6 +69,27 @@ uint32_t update_wld       = 0;
 int chr_stoppedby_tests = 0;
 int chr_pressure_tests = 0;
 
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_ai_timer("update.ai", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_objects_timer("update.all.objects", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_particles_timer("update.all.particles", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_objects_timer("move.all.objects", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_particles_timer("move.all.particles", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_collisions_timer("update.collisions", 512);
+
+/// Alerts which make a script run immediately, even if the character is far away or idle.
+static const uint32_t AI_WAKE_ALERTS = ALERTIF_SPAWNED | ALERTIF_HITVULNERABLE | ALERTIF_ATWAYPOINT | ALERTIF_ATLASTWAYPOINT |
+                                       ALERTIF_ATTACKED | ALERTIF_BUMPED | ALERTIF_ORDERED | ALERTIF_CALLEDFORHELP |
+                                       ALERTIF_KILLED | ALERTIF_TARGETKILLED | ALERTIF_DROPPED | ALERTIF_GRABBED |
+                                       ALERTIF_LEADERKILLED | ALERTIF_USED | ALERTIF_CLEANEDUP | ALERTIF_SCOREDAHIT |
+                                       ALERTIF_HEALED | ALERTIF_CHANGED | ALERTIF_LEVELUP | ALERTIF_CONFUSED |
+                                       ALERTIF_THROWN | ALERTIF_CRUSHED | ALERTIF_NOTPUTAWAY | ALERTIF_TAKENOUT;
+
+/// Characters closer than this to a player think in every update, farther than AI_FAR_DISTANCE every fourth update.
+static const float AI_NEAR_DISTANCE = 12.0f * Info<float>::Grid::Size();
+static const float AI_FAR_DISTANCE = 24.0f * Info<float>::Grid::Size();
+
+static Ego::Script::ThinkScheduler g_thinkScheduler(AI_WAKE_ALERTS);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -273,26 +295,36 @@ egolib_rv export_all_players( bool require_local )
 //--------------------------------------------------------------------------------------------
 void update_all_objects()
 {
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_all_objects_timer);
+
     chr_stoppedby_tests = 0;
     chr_pressure_tests  = 0;
 
     _currentModule->updateAllObjects();
-    ParticleHandler::get().updateAllParticles();
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> particlesScope(update_all_particles_timer);
+        ParticleHandler::get().updateAllParticles();
+    }
 }
 
 //--------------------------------------------------------------------------------------------
 void move_all_objects()
 {
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(move_all_objects_timer);
+
 	g_meshStats.mpdfxTests = 0;
     chr_stoppedby_tests = 0;
 
     // move every particle
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
-        if(particle->isTerminated()) {
-            continue;
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> particlesScope(move_all_particles_timer);
+        for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+        {
+            if(particle->isTerminated()) {
+                continue;
+            }
+            particle->getParticlePhysics().updatePhysics();
         }
-        particle->getParticlePhysics().updatePhysics();
     }
 
     // Move every character
@@ -392,8 +424,8 @@ int update_game()
     // Get immediate mode state for the rest of the game
     Ego::Input::InputSystem::get().update();
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+    //Update the spatial index for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialIndex(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
 		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
     //---- begin the code for updating misc. game stuff
@@ -412,14 +444,20 @@ int update_game()
     //---- Run AI (but not on first update frame)
     if(_gameEngine->getCurrentUpdateFrame() > 0)
     {
-        let_all_characters_think();           //sets the non-player latches
+        {
+            Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_ai_timer);
+            let_all_characters_think();           //sets the non-player latches
+        }
         readPlayerInput();                    //sets latches generated by players
     }
 
     //---- begin the code for updating in-game objects
     update_all_objects();
     move_all_objects();                            //movement
-    Ego::Physics::CollisionSystem::get().update(); //collisions
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_collisions_timer);
+        Ego::Physics::CollisionSystem::get().update(); //collisions
+    }
     //---- end the code for updating in-game objects
 
     // put the camera movement inside here
@@ -447,63 +485,55 @@ ObjectRef prt_find_target( const Vector3f& pos, Facing facing,
 {
     /// @author ZF
     /// @details This is the new improved targeting system for particles. Also includes distance in the Z direction.
-
-    const float max_dist2 = WIDE * WIDE;
-
-    std::shared_ptr<ParticleProfile> ppip;
-
-    ObjectRef besttarget = ObjectRef::Invalid;
-    float  longdist2 = max_dist2;
-
-    facing = Facing(FACING_T(facing));
+    /// Only the objects within WIDE of the particle are considered, see ObjectHandler::getTargetFinder().
 
     if ( !LOADED_PIP( particletype ) ) return ObjectRef::Invalid;
-    ppip = ProfileSystem::get().ParticleProfileSystem.get_ptr( particletype );
+    const std::shared_ptr<ParticleProfile> &ppip = ProfileSystem::get().ParticleProfileSystem.get_ptr( particletype );
+
+    const ObjectHandler &objects = _currentModule->getObjectHandler();
+    Team &particleTeam = _currentModule->getTeamList()[team];
 
-    for(const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
+    auto accept = [&objects, &ppip, &particleTeam, donttarget, oldtarget](Ego::AI::TargetFinder::Index index)
     {
-        if ( !pchr->isAlive() || pchr->isitem || _currentModule->getObjectHandler().exists( pchr->inwhich_inventory ) ) continue;
+        const Object *pchr = objects.get(ObjectRef(index));
+        if ( nullptr == pchr ) return false;
+
+        if ( !pchr->isAlive() || pchr->isitem || objects.exists( pchr->inwhich_inventory ) ) return false;
 
         // prefer targeting riders over the mount itself
-        if ( pchr->isMount() && ( _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_LEFT] ) || _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) continue;
+        if ( pchr->isMount() && ( objects.exists( pchr->holdingwhich[SLOT_LEFT] ) || objects.exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) return false;
 
         // ignore invictus
-        if ( pchr->invictus ) continue;
+        if ( pchr->invictus ) return false;
 
         // we are going to give the player a break and not target things that
         // can't be damaged, unless the particle is homing. If it homes in,
         // the he damage_timer could drop off en route.
-        if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) continue;
+        if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) return false;
 
         // Don't retarget someone we already had or not supposed to target
-        if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) continue;
-
-        Team &particleTeam = _currentModule->getTeamList()[team];
+        if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) return false;
 
         bool target_friend = ppip->onlydamagefriendly && particleTeam == pchr->getTeam();
         bool target_enemy  = !ppip->onlydamagefriendly && particleTeam.hatesTeam(pchr->getTeam() );
 
-        if ( target_friend || target_enemy )
-        {
-            Facing angle = Facing(FACING_T(-facing + vec_to_facing( pchr->getPosX() - pos[kX] , pchr->getPosY() - pos[kY] )));
+        return target_friend || target_enemy;
+    };
 
-            // Only proceed if we are facing the target
-            if ( angle < Facing(ppip->targetangle) || angle > Facing( 0xFFFF - ppip->targetangle ))
-            {
-                float dist2 = (pchr->getPosition() - pos).length_2();
+    Ego::AI::TargetFinder::Query query;
+    query.position = pos;
+    query.facing = Facing(FACING_T(facing));
+    query.coneAngle = ppip->targetangle;
+    query.radius = WIDE;
 
-                if ( dist2 < longdist2 && dist2 <= max_dist2 )
-                {
-                    (*targetAngle) = angle;
-                    besttarget = pchr->getObjRef();
-                    longdist2 = dist2;
-                }
-            }
-        }
+    Ego::AI::TargetFinder::Index besttarget;
+    if ( !objects.getTargetFinder().find( query, accept, besttarget, *targetAngle ) )
+    {
+        return ObjectRef::Invalid;
     }
 
     // All done
-    return besttarget;
+    return ObjectRef(besttarget);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -995,13 +1025,17 @@ void game_load_module_profiles( const std::string& modname )
     SearchContext* ctxt = new SearchContext(Ego::VfsPath(folderPath), Ego::Extension("obj"), VFS_SEARCH_DIR);
     if (!ctxt) return;
 
+    std::vector<std::string> folderPaths;
     while (ctxt->hasData()) {
         auto searchResult = ctxt->getData();
-        ProfileSystem::get().loadOneProfile(searchResult.string());
+        folderPaths.push_back(searchResult.string());
         ctxt->nextData();
     }
     delete ctxt;
     ctxt = nullptr;
+
+    // read the objects in parallel, they get their slots in search order
+    ProfileSystem::get().loadProfiles(folderPaths);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1085,17 +1119,25 @@ void game_quit_module()
 
 //--------------------------------------------------------------------------------------------
 bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
+{
+    return game_begin_module(module, time(NULL));
+}
+
+bool game_begin_module(const std::shared_ptr<ModuleProfile> &module, const uint32_t seed)
 {
     /// @author BB
     /// @details all of the initialization code before the module actually starts
 
     // start the module
-    _currentModule = std::make_unique<GameModule>(module, time(NULL));
+    _currentModule = std::make_unique<GameModule>(module, seed);
 
     //After loading, spawn all the data and initialize everything (spawn.txt)
     //Due to dependency on the global _currentModule, we cannot do this in the constructor above
     _currentModule->spawnAllObjects();
 
+    // The scheduler must not mix up the objects of the old and the new module
+    g_thinkScheduler.clear();
+
     return true;
 }
 
@@ -1130,6 +1172,25 @@ void let_all_characters_think()
 {
     /// @author ZZ
     /// @details This function funst the ai scripts for all eligible objects
+    const bool useScheduler = egoboo_config_t::get().game_aiScheduler_enable.getValue();
+    if (useScheduler) {
+        const int budget = egoboo_config_t::get().game_aiScheduler_budget.getValue();
+        g_thinkScheduler.setBudget(budget > 0 ? budget * 1e-6 : std::numeric_limits<double>::infinity());
+        g_thinkScheduler.setDistances(AI_NEAR_DISTANCE, AI_FAR_DISTANCE);
+        g_thinkScheduler.beginFrame(update_wld);
+    }
+
+    // The positions of the players, to find how far away a character is from the action
+    std::vector<Vector2f> playerPositions;
+    if (useScheduler) {
+        for (const std::shared_ptr<Ego::Player> &player : _currentModule->getPlayerList()) {
+            const std::shared_ptr<Object> &object = player->getObject();
+            if (object && !object->isTerminated()) {
+                playerPositions.push_back(Vector2f(object->getPosX(), object->getPosY()));
+            }
+        }
+    }
+
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
     {
         if(object->isTerminated()) {
@@ -1163,9 +1224,36 @@ void let_all_characters_think()
                 object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
             }
 
-            scr_run_chr_script(object.get());
+            if (!useScheduler) {
+                scr_run_chr_script(object.get());
+                continue;
+            }
+
+            // Players always think, everything else depends on how close it is to a player
+            float distance = 0.0f;
+            if (!object->isPlayer()) {
+                distance = std::numeric_limits<float>::infinity();
+                for (const Vector2f& playerPosition : playerPositions) {
+                    distance = std::min(distance, (Vector2f(object->getPosX(), object->getPosY()) - playerPosition).length());
+                }
+            }
+            // Idle: nothing happened and the timer has not run out
+            const bool idle = (0 == object->ai.alert) && (update_wld <= object->ai.timer);
+            g_thinkScheduler.schedule(object->getObjRef().get(), distance, object->ai.alert, idle);
         }
     }
+
+    if (useScheduler) {
+        g_thinkScheduler.run([](size_t index) {
+            scr_run_chr_script(ObjectRef(index));
+        });
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+const Ego::Script::ThinkScheduler& get_think_scheduler()
+{
+    return g_thinkScheduler;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1899,12 +1987,16 @@ float get_chr_level( ego_mesh_t *mesh, Object *object )
     {
         int cnt;
         float fval;
+        bool waterwalk = object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0;
 
         // scan through the vertices that we know will interact with the object
-        zmax = get_mesh_max_vertex_1( mesh, Index2D(grid_vert_x[0], grid_vert_y[0]), bump, object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0 );
+        zmax = get_mesh_max_vertex_1( mesh, Index2D(grid_vert_x[0], grid_vert_y[0]), bump, waterwalk );
         for ( cnt = 1; cnt < grid_vert_count; cnt ++ )
         {
-            fval = get_mesh_max_vertex_1( mesh, Index2D(grid_vert_x[cnt], grid_vert_y[cnt]), bump, object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0 );
+            // a tile whose highest corner is not above the level found so far can not raise it
+            if ( !waterwalk && mesh->get_max_vertex_0( Index2D(grid_vert_x[cnt], grid_vert_y[cnt]) ) <= zmax ) continue;
+
+            fval = get_mesh_max_vertex_1( mesh, Index2D(grid_vert_x[cnt], grid_vert_y[cnt]), bump, waterwalk );
             zmax = std::max( zmax, fval );
         }
     }
@@ -2819,5 +2911,10 @@ int DisplayMsg_printf( const char *format, ... )
 
 void DisplayMsg_print(const std::string &text)
 {
-    _gameEngine->getActivePlayingState()->getMessageLog()->addMessage(text);
+    // Without a playing state (e.g. when running headless) there is no message log.
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if (!playingState) {
+        return;
+    }
+    playingState->getMessageLog()->addMessage(text);
 }
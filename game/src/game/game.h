@@ -31,6 +31,7 @@
 //--------------------------------------------------------------------------------------------
 
 struct prt_bundle_t;
+namespace Ego { namespace Script { class ThinkScheduler; } }
 
 
 //--------------------------------------------------------------------------------------------
@@ -225,6 +226,14 @@ extern Uint32          update_wld;            ///< The number of times the game
 extern int chr_stoppedby_tests;
 extern int chr_pressure_tests;
 
+// profiling timers for the sections of update_game()
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_ai_timer;            ///< let_all_characters_think()
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_objects_timer;   ///< update_all_objects(), including the particles
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_particles_timer; ///< the particles in update_all_objects()
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_objects_timer;     ///< move_all_objects(), including the particles
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_particles_timer;   ///< the particles in move_all_objects()
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_collisions_timer;    ///< CollisionSystem::update()
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -234,6 +243,8 @@ void game_quit_module();
 /// the hook for exporting all the current players and reloading them
 bool game_finish_module();
 bool game_begin_module(const std::shared_ptr<ModuleProfile> &module);
+/// the same, but with a fixed random seed so that the module plays out the same every time
+bool game_begin_module(const std::shared_ptr<ModuleProfile> &module, const uint32_t seed);
 void game_load_module_profiles(const std::string& modname);
 
 /// Exporting stuff
@@ -252,6 +263,10 @@ void show_magic_status( int statindex );
 /// End Text
 void reset_end_text();
 
+/// AI
+/// @brief Get the scheduler deciding which AI scripts run in an update.
+const Ego::Script::ThinkScheduler& get_think_scheduler();
+
 /// Particles
 /// @brief Get the number of particles attached to an object.
 int number_of_attached_particles(ObjectRef objectRef);
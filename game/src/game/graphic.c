@@ -77,8 +77,6 @@ Clock<ClockPolicy::NonRecursive>  update_all_prt_instance_timer("update.all.prt.
 
 gfx_config_t     gfx;
 
-float            indextoenvirox[EGO_NORMAL_COUNT];
-
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -170,7 +168,7 @@ GFX::GFX() {
                                   // otherwise, it will not update until the frame count reaches whatever
                                   // left over or random value is in this counter
     _dynalist.frame = -1;
-    _dynalist.size = 0;
+    _dynalist.lst.clear();
 
     // Initialize the billboard system.
     try {
@@ -385,21 +383,6 @@ void gfx_system_release_all_graphics()
     Ego::TextureManager::get().release_all();
 }
 
-//--------------------------------------------------------------------------------------------
-void gfx_system_make_enviro()
-{
-    /// @author ZZ
-    /// @details This function sets up the environment mapping table
-
-    // Find the environment map positions
-    for (size_t i = 0; i < EGO_NORMAL_COUNT; ++i)
-    {
-        float x = MD2Model::getMD2Normal(i, 0);
-        float y = MD2Model::getMD2Normal(i, 1);
-        indextoenvirox[i] = std::atan2(y, x) * Ego::Math::invTwoPi<float>();
-    }
-}
-
 //--------------------------------------------------------------------------------------------
 void gfx_system_reload_all_textures()
 {
@@ -654,6 +637,11 @@ float draw_debug(float y)
         os.str(std::string()); os << "~~FREEPRT: " << ParticleHandler::get().getFreeCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0, 1.0f);
         
+        const auto& particleStatistics = CameraSystem::get().getMainCamera()->getEntityList()->getParticleStatistics();
+        os.str(std::string()); os << "~~PRTCULL: " << particleStatistics.submitted << " DRAWN " << particleStatistics.culled << " CULLED "
+                                  << particleStatistics.dropped << " DROPPED " << particleStatistics.reduced << " REDUCED";
+        y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0, 1.0f);
+
         os.str(std::string()); os << "~~FREECHR: " << OBJECTS_MAX - _currentModule->getObjectHandler().getObjectCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0, 1.0f);
 
@@ -662,6 +650,22 @@ float draw_debug(float y)
 
         os.str(std::string()); os << "~~PASS:    " << _currentModule->getPassageCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0, 1.0f);
+
+        // Text caches of all UI fonts
+        size_t hits = 0, misses = 0, bytes = 0;
+        for (int i = 0; i < Ego::GUI::UIManager::NR_OF_UI_FONTS; ++i)
+        {
+            std::shared_ptr<Ego::Font> font = _gameEngine->getUIManager()->getFont(static_cast<Ego::GUI::UIManager::UIFontType>(i));
+            if (!font) continue;
+            for (const Ego::LRUCacheStatistics *statistics : { &font->getRenderedCacheStatistics(), &font->getSizedCacheStatistics() })
+            {
+                hits += statistics->hits;
+                misses += statistics->misses;
+                bytes += statistics->bytes;
+            }
+        }
+        os.str(std::string()); os << "~~FONTCACHE: " << hits << " HIT " << misses << " MISS " << bytes / 1024 << " KB";
+        y = _gameEngine->getUIManager()->drawBitmapFontString(Vector2f(0, y), os.str(), 0, 1.0f);
     }
 
     if (Ego::Input::InputSystem::get().isKeyDown(SDLK_F7))
@@ -1079,7 +1083,7 @@ void gfx_config_t::download(gfx_config_t& self, egoboo_config_t& cfg)
     self.draw_background = cfg.graphic_background_enable.getValue();
     self.draw_overlay = cfg.graphic_overlay_enable.getValue();
 
-    self.dynalist_max = Ego::Math::constrain(cfg.graphic_simultaneousDynamicLights_max.getValue(), (uint16_t)0, (uint16_t)TOTAL_MAX_DYNA);
+    self.dynalist_max = cfg.graphic_simultaneousDynamicLights_max.getValue();
 }
 
 void gfx_config_t::init(gfx_config_t& self)
@@ -1721,6 +1725,9 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
 				= INV_FF<float>() * Ego::Math::constrain(light, 0.0f, 255.0f);
         }
 
+        // only the colours of the tile change in the batches of the mesh
+        mesh->_batches.setColours(fan.i(), &ptmem._clst[ptile._vrtstart]);
+
         // clear out the deltas
         ptile._vertexLightingCache._d1_cache.fill(0.0f);
         ptile._vertexLightingCache._d2_cache.fill(0.0f);
@@ -1804,7 +1811,7 @@ bool sum_global_lighting(std::array<float, LIGHTING_VEC_SIZE> &lighting)
 // SEMI OBSOLETE FUNCTIONS
 //--------------------------------------------------------------------------------------------
 void dynalist_t::init(dynalist_t& self) {
-    self.size = 0;
+    self.lst.clear();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1814,15 +1821,6 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     /// @details This function figures out which particles are visible, and it sets up dynamic
     ///    lighting
 
-    size_t    tnc;
-	Vector3f  vdist;
-
-    float         distance = 0.0f;
-    dynalight_data_t * plight = NULL;
-
-    float         distance_max = 0.0f;
-    dynalight_data_t * plight_max = NULL;
-
     // HACK: if dynalist is ahead of the game by 30 frames or more, reset and force an update
     if ((Uint32)(dyl.frame + 30) >= _gameEngine->getNumberOfFramesRendered())
         dyl.frame = -1;
@@ -1836,6 +1834,7 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     // Don't really make a list, just set to visible or not
     dynalist_t::init(dyl);
 
+    // collect the lights of all lit particles
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
         if(particle->isTerminated()) continue;
@@ -1845,60 +1844,17 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
         // is the light on?
         if (!pprt_dyna.on || 0.0f == pprt_dyna.level) continue;
 
-        // reset the dynalight pointer
-        plight = NULL;
-
-        // find the distance to the camera
-        vdist = particle->getPosition() - cam.getTrackPosition();
-        distance = vdist.length_2();
-
-        // insert the dynalight
-        if (dyl.size < gfx.dynalist_max && dyl.size < TOTAL_MAX_DYNA)
-        {
-            if (0 == dyl.size)
-            {
-                distance_max = distance;
-            }
-            else
-            {
-                distance_max = std::max(distance_max, distance);
-            }
-
-            // grab a new light from the list
-            plight = dyl.lst + dyl.size;
-            dyl.size++;
-
-            if (distance_max == distance)
-            {
-                plight_max = plight;
-            }
-        }
-        else if (distance < distance_max)
-        {
-            plight = plight_max;
-
-            // find the new maximum distance
-            distance_max = dyl.lst[0].distance;
-            plight_max = dyl.lst + 0;
-            for (tnc = 1; tnc < gfx.dynalist_max; tnc++)
-            {
-                if (dyl.lst[tnc].distance > distance_max)
-                {
-                    plight_max = dyl.lst + tnc;
-                    distance_max = plight_max->distance;
-                }
-            }
-        }
-
-        if (NULL != plight)
-        {
-            plight->distance = distance;
-            plight->pos = particle->getPosition();
-            plight->level = pprt_dyna.level;
-            plight->falloff = pprt_dyna.falloff;
-        }
+        dynalight_data_t light;
+        light.distance = (particle->getPosition() - cam.getTrackPosition()).length_2();
+        light.pos = particle->getPosition();
+        light.level = pprt_dyna.level;
+        light.falloff = pprt_dyna.falloff;
+        dyl.lst.push_back(light);
     }
 
+    // keep the lights closest to the camera
+    Ego::Graphics::select_dynalights(dyl.lst, gfx.dynalist_max);
+
     // the list is updated, so update the frame count
     dyl.frame = _gameEngine->getNumberOfFramesRendered();
 
@@ -1911,20 +1867,13 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     /// @author ZZ
     /// @details Do all tile lighting, dynamic and global
 
-    size_t cnt;
-
     int    tnc;
 
-    float x0, y0, local_keep;
-    bool needs_dynalight;
+    float local_keep;
 
     std::array<float, LIGHTING_VEC_SIZE> global_lighting = {0};
 
-    size_t               reg_count = 0;
-    dynalight_registry_t reg[TOTAL_MAX_DYNA];
-
-    ego_frect_t mesh_bound, light_bound;
-    dynalight_data_t fake_dynalight;
+    ego_frect_t mesh_bound;
 
 	auto mesh = tl.getMesh();
     if (!mesh)
@@ -1957,74 +1906,26 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     if (mesh_bound.xmin >= mesh_bound.xmax || mesh_bound.ymin >= mesh_bound.ymax)
         return gfx_success;
 
-    // clear out the dynalight registry
-    reg_count = 0;
-
     // refresh the dynamic light list
     gfx_make_dynalist(dyl, cam);
 
-    // assume no dynamic lighting
-    needs_dynalight = false;
-
-    // assume no "extra help" for systems with only flat lighting
-    dynalight_data_t::init(fake_dynalight);
-
-    // initialize the light_bound
-    light_bound.xmin = tmem._edge_x;
-    light_bound.xmax = 0;
-    light_bound.ymin = tmem._edge_y;
-    light_bound.ymax = 0;
-
-    // make bounding boxes for each dynamic light
+    // bin the dynamic lights reaching the "frustum"
     if (gfx.gouraudShading_enable)
     {
-        for (cnt = 0; cnt < dyl.size; cnt++)
-        {
-            float radius;
-            ego_frect_t ftmp;
-
-            dynalight_data_t& pdyna = dyl.lst[cnt];
-
-            if (pdyna.falloff <= 0.0f || 0.0f == pdyna.level) continue;
-
-            radius = std::sqrt(pdyna.falloff * 765.0f * 0.5f);
-
-            // find the intersection with the frustum boundary
-            ftmp.xmin = std::max(pdyna.pos[kX] - radius, mesh_bound.xmin);
-            ftmp.xmax = std::min(pdyna.pos[kX] + radius, mesh_bound.xmax);
-            ftmp.ymin = std::max(pdyna.pos[kY] - radius, mesh_bound.ymin);
-            ftmp.ymax = std::min(pdyna.pos[kY] + radius, mesh_bound.ymax);
-
-            // check to see if it intersects the "frustum"
-            if (ftmp.xmin >= ftmp.xmax || ftmp.ymin >= ftmp.ymax) continue;
-
-            reg[reg_count].bound = ftmp;
-            reg[reg_count].reference = cnt;
-            reg_count++;
-
-            // determine the maxumum bounding box that encloses all valid lights
-            light_bound.xmin = std::min(light_bound.xmin, ftmp.xmin);
-            light_bound.xmax = std::max(light_bound.xmax, ftmp.xmax);
-            light_bound.ymin = std::min(light_bound.ymin, ftmp.ymin);
-            light_bound.ymax = std::max(light_bound.ymax, ftmp.ymax);
-        }
-
-        // are there any dynalights visible?
-        if (reg_count > 0 && light_bound.xmax >= light_bound.xmin && light_bound.ymax >= light_bound.ymin)
-        {
-            needs_dynalight = true;
-        }
+        dyl.grid.reset(mesh_bound, dyl.lst);
     }
     else
     {
+        // assume no "extra help" for systems with only flat lighting
+        dynalight_data_t fake_dynalight;
+        dynalight_data_t::init(fake_dynalight);
+
         float dyna_weight = 0.0f;
         float dyna_weight_sum = 0.0f;
 
         // evaluate all the lights at the camera position
-        for (cnt = 0; cnt < dyl.size; cnt++)
+        for (const dynalight_data_t& pdyna : dyl.lst)
         {
-			dynalight_data_t& pdyna = dyl.lst[cnt];
-
             // evaluate the intensity at the camera
 			Vector3f diff = pdyna.pos - cam.getCenter() - Vector3f(0.0f, 0.0f, 90.0f); // evaluate at the "head height" of a character
 
@@ -2039,35 +1940,17 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         }
 
         // use a single dynalight to represent the sum of all dynalights
+        std::vector<dynalight_data_t> fake_dynalist;
         if (dyna_weight_sum > 0.0f)
         {
-            float radius;
-            ego_frect_t ftmp;
-
             fake_dynalight.distance /= dyna_weight_sum;
             fake_dynalight.falloff /= dyna_weight_sum;
             fake_dynalight.level /= dyna_weight_sum;
             fake_dynalight.pos = (fake_dynalight.pos * (1.0/dyna_weight_sum)) + cam.getCenter();
 
-            radius = std::sqrt(fake_dynalight.falloff * 765.0f * 0.5f);
-
-            // find the intersection with the frustum boundary
-            ftmp.xmin = std::max(fake_dynalight.pos[kX] - radius, mesh_bound.xmin);
-            ftmp.xmax = std::min(fake_dynalight.pos[kX] + radius, mesh_bound.xmax);
-            ftmp.ymin = std::max(fake_dynalight.pos[kY] - radius, mesh_bound.ymin);
-            ftmp.ymax = std::min(fake_dynalight.pos[kY] + radius, mesh_bound.ymax);
-
-            // make a fake light bound
-            light_bound = ftmp;
-
-            // register the fake dynalight
-            reg[reg_count].bound = ftmp;
-            reg[reg_count].reference = -1;
-            reg_count++;
-
-            // let the downstream calc know we are coming
-            needs_dynalight = true;
+            fake_dynalist.push_back(fake_dynalight);
         }
+        dyl.grid.reset(mesh_bound, fake_dynalist);
     }
 
     // sum up the lighting from global sources
@@ -2110,63 +1993,10 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
             cache_new.hgh._lighting[tnc] = global_lighting[tnc];
         };
 
-        // do we need any dynamic lighting at all?
-        if (needs_dynalight)
-        {
-            // calculate the local lighting
-
-            ego_frect_t fgrid_rect;
-
-            x0 = i2.x() * Info<float>::Grid::Size();
-            y0 = i2.y() * Info<float>::Grid::Size();
-
-            // check this grid vertex relative to the measured light_bound
-            fgrid_rect.xmin = x0 - Info<float>::Grid::Size() * 0.5f;
-            fgrid_rect.xmax = x0 + Info<float>::Grid::Size() * 0.5f;
-            fgrid_rect.ymin = y0 - Info<float>::Grid::Size() * 0.5f;
-            fgrid_rect.ymax = y0 + Info<float>::Grid::Size() * 0.5f;
-
-            // check the bounding box of this grid vs. the bounding box of the lighting
-            if (fgrid_rect.xmin <= light_bound.xmax && fgrid_rect.xmax >= light_bound.xmin)
-            {
-                if (fgrid_rect.ymin <= light_bound.ymax && fgrid_rect.ymax >= light_bound.ymin)
-                {
-                    // this grid has dynamic lighting. add it.
-                    for (cnt = 0; cnt < reg_count; cnt++)
-                    {
-						Vector3f nrm;
-                        dynalight_data_t *pdyna;
-
-                        // does this dynamic light intersects this grid?
-                        if (fgrid_rect.xmin > reg[cnt].bound.xmax || fgrid_rect.xmax < reg[cnt].bound.xmin) continue;
-                        if (fgrid_rect.ymin > reg[cnt].bound.ymax || fgrid_rect.ymax < reg[cnt].bound.ymin) continue;
-
-                        // this should be a valid intersection, so proceed
-                        tnc = reg[cnt].reference;
-                        if (tnc < 0)
-                        {
-                            pdyna = &fake_dynalight;
-                        }
-                        else
-                        {
-                            pdyna = dyl.lst + tnc;
-                        }
-
-                        nrm[kX] = pdyna->pos[kX] - x0;
-                        nrm[kY] = pdyna->pos[kY] - y0;
-                        nrm[kZ] = pdyna->pos[kZ] - tmem._bbox.getMin()[ZZ];
-                        sum_dyna_lighting(pdyna, cache_new.low._lighting, nrm);
-
-                        nrm[kZ] = pdyna->pos[kZ] - tmem._bbox.getMax()[ZZ];
-                        sum_dyna_lighting(pdyna, cache_new.hgh._lighting, nrm);
-                    }
-                }
-            }
-        }
-        else if (!gfx.gouraudShading_enable)
-        {
-            // evaluate the intensity at the camera
-        }
+        // add the dynamic lighting of the lights reaching this grid vertex
+        dyl.grid.illuminate(i2.x() * Info<float>::Grid::Size(), i2.y() * Info<float>::Grid::Size(),
+                            tmem._bbox.getMin()[ZZ], tmem._bbox.getMax()[ZZ],
+                            cache_new.low._lighting, cache_new.hgh._lighting);
 
         // blend in the global lighting every single time
         // average this in with the existing lighting
@@ -2185,14 +2015,8 @@ gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 {
 	// @a true if clipping is enabled, @a false otherwise.
 	static const bool clippingEnabled = true;
-
-    // Because the main loop of the program will always flip the
-    // page before rendering the 1st frame of the actual game,
-    // _gameEngine->getNumberOfFramesRendered() will always start at 1
-    if (1 != (_gameEngine->getNumberOfFramesRendered() & 3))
-    {
-        return gfx_success;
-    }
+	// The indices of the visible tiles, kept to avoid allocations in every frame.
+	static std::vector<size_t> visibleTiles;
 
     // reset the renderlist
     if (gfx_error == tl.reset())
@@ -2200,31 +2024,25 @@ gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
         return gfx_error;
     }
 
-    // get the tiles in the center of the view (TODO: calculate actual tile view from camera frustrum)
-	int startX, startY, endX, endY;
-	if (clippingEnabled)
-	{
-		static const float offset = 10;
-		float centerX = cam.getTrackPosition()[kX] / Info<float>::Grid::Size();
-		float centerY = cam.getTrackPosition()[kY] / Info<float>::Grid::Size();
-		startX = Ego::Math::constrain<int>(centerX - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		startY = Ego::Math::constrain<int>(centerY - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-		endX = Ego::Math::constrain<int>(centerX + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		endY = Ego::Math::constrain<int>(centerY + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-	}
-	else
-	{
-		startX = 0;
-		startY = 0;
-		endX = _currentModule->getMeshPointer()->_info.getTileCountX();
-		endY = _currentModule->getMeshPointer()->_info.getTileCountY();
-	}
-    for(size_t x = startX; x < endX; ++x) {
-        for(size_t y = startY; y < endY; ++y) {
-            if (gfx_error == tl.add(x + y * _currentModule->getMeshPointer()->_info.getTileCountX(), cam))
-            {
-                return gfx_error;
-            }        
+    auto mesh = _currentModule->getMeshPointer();
+    if (clippingEnabled)
+    {
+        // get the tiles in the view frustum, nearest first if there are more than fit in the renderlist
+        mesh->_cullingTree.cull(cam.getFrustum(), Point3f::toPoint(cam.getPosition()), Ego::Graphics::renderlist_lst_t::CAPACITY, visibleTiles);
+    }
+    else
+    {
+        visibleTiles.clear();
+        for (size_t tile = 0; tile < mesh->_info.getTileCount(); ++tile)
+        {
+            visibleTiles.push_back(tile);
+        }
+    }
+    for (size_t tile : visibleTiles)
+    {
+        if (gfx_error == tl.add(tile, cam))
+        {
+            return gfx_error;
         }
     }
 
@@ -2249,9 +2067,8 @@ gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
         el.add(cam, *object.get());
     }
 
-    for(const std::shared_ptr<Ego::Particle> particle : ParticleHandler::get().iterator()) {
-        el.add(cam, *particle.get());
-    }
+    // cull the particles with the frustum
+    el.addParticles(cam);
 
     return gfx_success;
 }
@@ -152,8 +152,6 @@ struct gfx_config_t
 //--------------------------------------------------------------------------------------------
 extern gfx_config_t gfx;
 
-extern float           indextoenvirox[EGO_NORMAL_COUNT];                    ///< Environment map
-
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 // Function prototypes
@@ -208,7 +206,6 @@ void gfx_system_main();
 /// the stored state of the texture and its surface, the backing OpenGL texture needs to be
 /// reconstructed.
 void gfx_system_reload_all_textures();
-void gfx_system_make_enviro();
 void gfx_system_init_all_graphics();
 void gfx_system_release_all_graphics();
 void gfx_system_load_assets();
@@ -232,20 +229,14 @@ void draw_passages(Camera& cam);
 struct dynalist_t
 {
 	int frame; ///< The last frame in shich the list was updated. @a -1 if there was no update yet.
-	size_t size; ///< The size of the list.
-	dynalight_data_t lst[TOTAL_MAX_DYNA];  ///< The list.
+	std::vector<dynalight_data_t> lst;  ///< The list, the closest light to the camera first.
+	Ego::Graphics::DynamicLightGrid grid;  ///< The lights reaching the visible tiles.
 	static void init(dynalist_t& self);
     dynalist_t()
-        : frame(-1), size(0), lst{}
+        : frame(-1), lst(), grid(Info<float>::Block::Size(), Info<float>::Grid::Size())
     {}
 };
 
-/// Structure for keeping track of which dynalights are visible
-struct dynalight_registry_t {
-    int reference;
-    ego_frect_t bound;
-};
-
 /// Illuminate the "grid".
 struct GridIllumination {
 private:
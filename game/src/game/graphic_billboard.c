@@ -287,6 +287,11 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(ObjectRef obj_ref, con
         return nullptr;
     }
 
+    // Without a user interface (e.g. when running headless) there is nothing to render the text with.
+    if (!_gameEngine->getUIManager()) {
+        return nullptr;
+    }
+
     // Pre-render the text.
     std::shared_ptr<Ego::Texture> tex;
     try {
@@ -30,51 +30,52 @@
 #include "game/Graphics/CameraSystem.hpp"
 #include "game/Entities/_Include.hpp"
 
+/// A vertex of a MD2 model, in the layout of Ego::VertexFormat::P3FC4FT2FN3F.
 struct Md2Vertex {
     struct {
         float x, y, z;
     } position;
-    struct {
-        float x, y, z;
-    } normal;
     struct {
         float r, g, b, a;
     } colour;
     struct {
         float s, t;
     } texture;
+    struct {
+        float x, y, z;
+    } normal;
 };
 
 struct Md2VertexBuffer {
-    std::vector<Md2Vertex> vertices;
-    Md2VertexBuffer(size_t size) : vertices() {
-        vertices.resize(size);
-        // Intentionally empty.
-    }
-    Md2VertexBuffer() : Md2VertexBuffer(0) {
+    Ego::VertexBuffer vertexBuffer;
+    Md2VertexBuffer(size_t size) : vertexBuffer(size, Ego::VertexFormatFactory::get<Ego::VertexFormat::P3FC4FT2FN3F>()) {
         // Intentionally empty.
     }
     ~Md2VertexBuffer() {
         //dtor
     }
 
-    void ensureSize(size_t requiredSize) {
-        if (requiredSize > vertices.size()) {
-            vertices.resize(requiredSize);
-        }
+    Md2Vertex *lock() {
+        return static_cast<Md2Vertex *>(vertexBuffer.lock());
+    }
+
+    void unlock() {
+        vertexBuffer.unlock();
     }
 
     void render(GLenum mode, size_t start, size_t length) {
-        glBegin(mode); {
-            for (size_t vertexIndex = start; vertexIndex < start + length; ++vertexIndex) {
-                const auto& v = vertices[vertexIndex];
-                glColor4f(v.colour.r, v.colour.g, v.colour.b, v.colour.a);
-                glNormal3f(v.normal.x, v.normal.y, v.normal.z);
-                glTexCoord2f(v.texture.s, v.texture.t);
-                glVertex3f(v.position.x, v.position.y, v.position.z);
-            }
-        }
-        glEnd();
+        Ego::PrimitiveType primitiveType;
+        switch (mode) {
+            case GL_TRIANGLE_STRIP:
+                primitiveType = Ego::PrimitiveType::TriangleStrip;
+                break;
+            case GL_TRIANGLE_FAN:
+                primitiveType = Ego::PrimitiveType::TriangleFan;
+                break;
+            default:
+                throw Id::UnhandledSwitchCaseException(__FILE__, __LINE__);
+        };
+        Ego::Renderer::get().render(vertexBuffer, primitiveType, start, length);
     }
 };
 
@@ -131,11 +132,12 @@ gfx_rv MadRenderer::render_enviro( Camera& cam, const std::shared_ptr<Object>& p
             for (const MD2_GLCommand &glcommand : pmd2->getGLCommands()) {
                 // Pre-render this command.
                 size_t vertexBufferSize = 0;
+                Md2Vertex *vertices = vertexBuffer.lock();
                 for (const id_glcmd_packed_t& cmd : glcommand.data) {
                     uint16_t vertexIndex = cmd.index;
                     if (vertexIndex >= pchr->inst.getVertexCount()) continue;
                     const GLvertex& pvrt = pchr->inst.getVertex(vertexIndex);
-                    auto& v = vertexBuffer.vertices[vertexBufferSize++];
+                    auto& v = vertices[vertexBufferSize++];
                     v.position.x = pvrt.pos[XX];
                     v.position.y = pvrt.pos[YY];
                     v.position.z = pvrt.pos[ZZ];
@@ -173,6 +175,7 @@ gfx_rv MadRenderer::render_enviro( Camera& cam, const std::shared_ptr<Object>& p
                     }
                 }
                 // Render this command.
+                vertexBuffer.unlock();
                 vertexBuffer.render(glcommand.glMode, 0, vertexBufferSize);
             }
         }
@@ -277,13 +280,14 @@ gfx_rv MadRenderer::render_tex(Camera& camera, const std::shared_ptr<Object>& pc
             for (const MD2_GLCommand& glcommand : pmd2->getGLCommands()) {
                 // Pre-render this command.
                 size_t vertexBufferSize = 0;
+                Md2Vertex *vertices = vertexBuffer.lock();
                 for (const id_glcmd_packed_t &cmd : glcommand.data) {
                     Uint16 vertexIndex = cmd.index;
                     if (vertexIndex >= pchr->inst.getVertexCount()) {
                         continue;
                     }
                     const GLvertex& pvrt = pchr->inst.getVertex(vertexIndex);
-                    auto& v = vertexBuffer.vertices[vertexBufferSize++];
+                    auto& v = vertices[vertexBufferSize++];
                     v.position.x = pvrt.pos[XX];
                     v.position.y = pvrt.pos[YY];
                     v.position.z = pvrt.pos[ZZ];
@@ -335,6 +339,7 @@ gfx_rv MadRenderer::render_tex(Camera& camera, const std::shared_ptr<Object>& pc
                     }
                 }
                 // Render this command.
+                vertexBuffer.unlock();
                 vertexBuffer.render(glcommand.glMode, 0, vertexBufferSize);
             }
         }
@@ -23,6 +23,7 @@
 
 #include "egolib/bbox.h"
 #include "game/graphic_prt.h"
+#include "egolib/Graphics/ParticleCulling.hpp"
 #include "game/renderer_3d.h"
 #include "game/game.h"
 #include "game/lighting.h"
@@ -77,7 +78,7 @@ void prt_set_texture_params(const std::shared_ptr<const Ego::Texture>& texture,
 }
 
 //--------------------------------------------------------------------------------------------
-static gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting);
+static gfx_rv prt_instance_update(Camera& camera, Ego::Particle& particle, Uint8 trans, bool do_lighting);
 static void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& pinst, float size, bool do_reflect);
 static void draw_one_attachment_point(Ego::Graphics::ObjectGraphics& inst, int vrt_offset);
 static void prt_draw_attached_point(const std::shared_ptr<Ego::Particle> &bdl_prt);
@@ -524,10 +525,10 @@ gfx_rv update_all_prt_instance(Camera& camera)
             pinst->valid = false;
             pinst->ref_valid = false;
         }
-        else
+        else if (!pinst->valid || Ego::Graphics::ParticleCulling::needsUpdate(pinst->update_interval, update_wld, particle->getParticleID().get()))
         {
-            // calculate the "billboard" for this particle
-            if (gfx_error == prt_instance_update(camera, particle->getParticleID(), 255, true))
+            // calculate the "billboard" for this particle, distant particles skip some updates
+            if (gfx_error == prt_instance_update(camera, *particle, 255, true))
             {
                 retval = gfx_error;
             }
@@ -891,27 +892,21 @@ gfx_rv prt_instance_t::update_lighting(prt_instance_t& pinst, Ego::Particle *ppr
     return gfx_success;
 }
 
-gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting)
+gfx_rv prt_instance_update(Camera& camera, Ego::Particle& particle, Uint8 trans, bool do_lighting)
 {
-    const std::shared_ptr<Ego::Particle> &pprt = ParticleHandler::get()[particle];
-    if(!pprt) {
-        gfx_error_add(__FILE__, __FUNCTION__, __LINE__, particle.get(), "invalid particle");
-        return gfx_error;
-    }
-
-    prt_instance_t& pinst = pprt->inst;
+    prt_instance_t& pinst = particle.inst;
 
     // assume the best
     gfx_rv retval = gfx_success;
 
     // make sure that the vertices are interpolated
-    if (gfx_error == prt_instance_t::update_vertices(pinst, camera, pprt.get()))
+    if (gfx_error == prt_instance_t::update_vertices(pinst, camera, &particle))
     {
         retval = gfx_error;
     }
 
     // do the lighting
-    if (gfx_error == prt_instance_t::update_lighting(pinst, pprt.get(), trans, do_lighting))
+    if (gfx_error == prt_instance_t::update_lighting(pinst, &particle, trans, do_lighting))
     {
         retval = gfx_error;
     }
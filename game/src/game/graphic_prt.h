@@ -51,6 +51,7 @@ struct prt_instance_t
 
     // graphical optimizations
     bool         indolist;     ///< Has it been added yet?
+    unsigned     update_interval; ///< The number of updates between two updates of this instance, by its distance from the camera.
 
     // basic info
     uint8_t  type;               ///< particle type
@@ -85,6 +86,7 @@ struct prt_instance_t
     prt_instance_t() :
         valid(false),
         indolist(false),
+        update_interval(1),
 
         // basic info
         type(0),
@@ -125,6 +127,7 @@ struct prt_instance_t
 
         // graphical optimizations
         indolist = false;
+        update_interval = 1;
 
         // basic info
         type = 0;
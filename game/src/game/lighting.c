@@ -38,77 +38,6 @@ static bool lighting_sum_project( lighting_cache_t& dst, const lighting_cache_t&
 
 //--------------------------------------------------------------------------------------------
 
-void lighting_vector_evaluate(const LightingVector& lvec, const Vector3f& nrm, float& dir, float& amb)
-{
-    dir = 0.0f;
-    amb = 0.0f;
-
-    if ( nrm[kX] > 0.0f )
-    {
-        dir += nrm[kX] * lvec[LVEC_PX];
-    }
-    else if ( nrm[kX] < 0.0f )
-    {
-        dir -= nrm[kX] * lvec[LVEC_MX];
-    }
-
-    if ( nrm[kY] > 0.0f )
-    {
-        dir += nrm[kY] * lvec[LVEC_PY];
-    }
-    else if ( nrm[kY] < 0.0f )
-    {
-        dir -= nrm[kY] * lvec[LVEC_MY];
-    }
-
-    if ( nrm[kZ] > 0.0f )
-    {
-        dir += nrm[kZ] * lvec[LVEC_PZ];
-    }
-    else if ( nrm[kZ] < 0.0f )
-    {
-        dir -= nrm[kZ] * lvec[LVEC_MZ];
-    }
-
-    // the ambient is not summed
-    amb += lvec[LVEC_AMB];
-}
-
-void lighting_vector_sum(LightingVector& lvec, const Vector3f& nrm, const float direct, const float ambient)
-{
-    if ( nrm.x() > 0.0f )
-    {
-        lvec[LVEC_PX] += nrm.x() * direct;
-    }
-    else if ( nrm.x() < 0.0f )
-    {
-        lvec[LVEC_MX] -= nrm.x() * direct;
-    }
-
-    if ( nrm.y() > 0.0f )
-    {
-        lvec[LVEC_PY] += nrm.y() * direct;
-    }
-    else if ( nrm.y() < 0.0f )
-    {
-        lvec[LVEC_MY] -= nrm.y() * direct;
-    }
-
-    if ( nrm.z() > 0.0f )
-    {
-        lvec[LVEC_PZ] += nrm.z() * direct;
-    }
-    else if ( nrm.z() < 0.0f )
-    {
-        lvec[LVEC_MZ] -= nrm.z() * direct;
-    }
-
-    // the ambient is not summed
-    lvec[LVEC_AMB] += ambient;
-}
-
-//--------------------------------------------------------------------------------------------
-
 void lighting_cache_base_t::init()
 {
 	_max_delta = 0.0f;
@@ -483,59 +412,3 @@ float lighting_cache_t::lighting_evaluate_cache( const lighting_cache_t& src, co
 
     return light_tot;
 }
-
-//--------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------
-float dyna_lighting_intensity( const dynalight_data_t * pdyna, const Vector3f& diff )
-{
-    if ( NULL == pdyna || 0.0f == pdyna->level ) return 0.0f;
-
-    float rho_sqr  = diff[kX] * diff[kX] + diff[kY] * diff[kY];
-    float y2 = rho_sqr * 2.0f / 765.0f / pdyna->falloff;
-
-    if ( y2 > 1.0f ) return false;
-
-    float level = 1.0f - 0.5f * y2 * ( 3.0f - y2 * y2 );
-    level *= pdyna->level;
-
-    return level;
-}
-
-//--------------------------------------------------------------------------------------------
-bool sum_dyna_lighting( const dynalight_data_t * pdyna, LightingVector& lighting, const Vector3f& nrm )
-{
-    if ( NULL == pdyna ) return false;
-
-    float level = 255.0f * dyna_lighting_intensity( pdyna, nrm );
-    if ( 0.0f == level ) return true;
-
-    // allow negative lighting, or blind spots will not work properly
-	float rad_sqr = nrm.length_2();
-
-    // make a local copy of the normal so we do not normalize the data in the calling function
-	Vector3f local_nrm = nrm;
-
-    // do the normalization
-    if ( 1.0f != rad_sqr && 0.0f != rad_sqr )
-    {
-        float rad = std::sqrt( rad_sqr );
-        local_nrm.x() /= rad;
-        local_nrm.y() /= rad;
-        local_nrm.z() /= rad;
-    }
-
-    // sum the lighting
-    lighting_vector_sum(lighting, local_nrm, level, 0.0f);
-
-    return true;
-}
-
-//--------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------
-void dynalight_data_t::init(dynalight_data_t& self)
-{
-	self.distance = 1000.0f;
-	self.falloff = 255.0f;
-	self.level = 0.0f;
-	self.pos = Vector3f::zero();
-}
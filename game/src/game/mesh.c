@@ -272,6 +272,75 @@ void ego_mesh_t::make_bbox()
     }
 }
 
+//--------------------------------------------------------------------------------------------
+void ego_mesh_t::make_collision_layer()
+{
+	const size_t vertexCount = _info.getVertexCount();
+	for (Index1D i = 0; i < _info.getTileCount(); ++i)
+	{
+		const ego_tile_info_t& tile = _tmem.get(i);
+		_collisionLayer.setFX(i.i(), tile.getFX());
+		_collisionLayer.setTwist(i.i(), tile._twist);
+		_collisionLayer.setFanOff(i.i(), tile.isFanOff());
+
+		// The first four vertices of a fan are its corners.
+		std::array<float, 4> corners = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+		for (size_t j = 0; j < 4 && tile._vrtstart + j < vertexCount; ++j)
+		{
+			corners[j] = _tmem._plst[tile._vrtstart + j][ZZ];
+		}
+		_collisionLayer.setCorners(i.i(), corners);
+	}
+}
+
+//--------------------------------------------------------------------------------------------
+void ego_mesh_t::make_culling_tree()
+{
+	for (Index1D i = 0; i < _info.getTileCount(); ++i)
+	{
+		const ego_tile_info_t& tile = _tmem.get(i);
+		if (!tile._oct._empty)
+		{
+			_cullingTree.setTileBounds(i.i(), tile._oct.toAxisAlignedBox());
+		}
+		else
+		{
+			// A tile without a definition has no vertices, use its grid square at elevation 0.
+			auto i2 = _info.map(i);
+			Point3f min(i2.x() * Info<float>::Grid::Size(), i2.y() * Info<float>::Grid::Size(), 0.0f);
+			_cullingTree.setTileBounds(i.i(), AxisAlignedBox3f(min, min + Vector3f(Info<float>::Grid::Size(), Info<float>::Grid::Size(), 0.0f)));
+		}
+	}
+	_cullingTree.update();
+}
+
+//--------------------------------------------------------------------------------------------
+void ego_mesh_t::make_batches()
+{
+	for (Index1D i = 0; i < _info.getTileCount(); ++i)
+	{
+		make_batch(i);
+	}
+}
+
+void ego_mesh_t::make_batch(const Index1D& i)
+{
+	const ego_tile_info_t& tile = _tmem.get(i);
+	const tile_definition_t *pdef = tile_dict.get(tile._type);
+	// A tile without a definition has no vertices.
+	if (nullptr == pdef) return;
+
+	Ego::MeshBatches::Vertex vertices[MAP_FAN_VERTICES_MAX];
+	for (size_t j = 0, vertex = tile._vrtstart; j < pdef->numvertices; ++j, ++vertex)
+	{
+		const GLXvector3f& position = _tmem._plst[vertex];
+		const GLXvector3f& colour = _tmem._clst[vertex];
+		const GLXvector2f& texture = _tmem._tlst[vertex];
+		vertices[j] = { position[XX], position[YY], position[ZZ], colour[RR], colour[GG], colour[BB], texture[SS], texture[TT] };
+	}
+	_batches.setTile(i.i(), vertices, pdef->numvertices, pdef->command_entries, pdef->command_count, pdef->command_verts);
+}
+
 //--------------------------------------------------------------------------------------------
 void ego_mesh_t::make_normals()
 {
@@ -440,8 +509,8 @@ BIT_FIELD ego_mesh_t::test_wall(const BIT_FIELD bits, const mesh_wall_data_t& da
 
 	for (int iy = data._i.min().y(); iy <= data._i.max().y(); ++iy) {
 		for (int ix = data._i.min().x(); ix <= data._i.max().x(); ++ix) {
-			Index1D tileIndex(ix + iy * data._mesh->_tmem.getInfo().getTileCountX());
-			BIT_FIELD pass = data._mesh->getTileInfo(tileIndex).testFX(bits);
+			size_t tileIndex = ix + iy * data._mesh->_collisionLayer.getWidth();
+			BIT_FIELD pass = data._mesh->_collisionLayer.getFX(tileIndex) & bits;
 			if (EMPTY_BIT_FIELD != pass) {
 				return pass;
 			}
@@ -531,7 +600,7 @@ float ego_mesh_t::get_pressure(const Vector3f& pos, float radius, const BIT_FIEL
                 }
                 else
                 {
-                    is_blocked = 0 != _tmem.get(itile).testFX(bits);
+                    is_blocked = 0 != (_collisionLayer.getFX(itile.i()) & bits);
                 }
             }
 
@@ -850,7 +919,7 @@ bool ego_mesh_t::tile_has_bits( const Index2D& i, const BIT_FIELD bits ) const
     }
 
     // Since we KNOW that this is in range, allow raw access to the data structure.
-    GRID_FX_BITS fx = _tmem.get(j).getFX();
+    GRID_FX_BITS fx = _collisionLayer.getFX(j.i());
 
     return HAS_SOME_BITS(fx, bits);
 }
@@ -872,22 +941,8 @@ float ego_mesh_t::getElevation(const Vector2f& p) const
 		return 0;
 	}
 
-    // Get the height of each fan corner.
-    float z0 = _tmem._plst[_tmem.get(i1)._vrtstart + 0][ZZ];
-    float z1 = _tmem._plst[_tmem.get(i1)._vrtstart + 1][ZZ];
-    float z2 = _tmem._plst[_tmem.get(i1)._vrtstart + 2][ZZ];
-    float z3 = _tmem._plst[_tmem.get(i1)._vrtstart + 3][ZZ];
-
-    //Calculate where on the tile we are relative to top left corner of the tile (0,0)
-    Vector2f posOnTile = Vector2f(static_cast<float>(static_cast<int>(p.x()) % Info<int>::Grid::Size()), 
-                                  static_cast<float>(static_cast<int>(p.y()) % Info<int>::Grid::Size()));
-
-    // Get the weighted height of each side.
-    float zleft = (z0 * (Info<float>::Grid::Size() - posOnTile.y()) + z3 * posOnTile.y()) / Info<float>::Grid::Size();
-    float zright = (z1 * (Info<float>::Grid::Size() - posOnTile.y()) + z2 * posOnTile.y()) / Info<float>::Grid::Size();
-    float zdone = (zleft * (Info<float>::Grid::Size() - posOnTile.x()) + zright * posOnTile.x()) / Info<float>::Grid::Size();
-
-    return zdone;
+    // Interpolate between the heights of the fan corners.
+    return _collisionLayer.getElevation(i1.i(), p.x(), p.y());
 }
 
 Index1D ego_mesh_t::getTileIndex(const Vector2f& p) const
@@ -924,7 +979,9 @@ bool ego_mesh_t::clear_fx( const Index1D& i, const BIT_FIELD flags )
 	g_meshStats.mpdfxTests++;
 
     if (_tmem.get(i).removeFX(flags)) {
+        _collisionLayer.setFX(i.i(), _tmem.get(i).getFX());
         _fxlists.dirty = true;
+        _pathGraphs.invalidate();
         return true;
     } else {
         return false;
@@ -945,7 +1002,9 @@ bool ego_mesh_t::add_fx(const Index1D& i, const BIT_FIELD flags)
 
     if ( retval )
     {
+        _collisionLayer.setFX(i.i(), _tmem.get(i).getFX());
         _fxlists.dirty = true;
+        _pathGraphs.invalidate();
     }
 
     return retval;
@@ -963,13 +1022,13 @@ Uint32 ego_mesh_t::test_fx(const Index1D& i, const BIT_FIELD flags) const
     }
 
     // if the tile is actually labelled as MAP_FANOFF, ignore it completely
-    if (_tmem.get(i).isFanOff())
+    if (_collisionLayer.isFanOff(i.i()))
     {
         return 0;
     }
 
 	g_meshStats.mpdfxTests++;
-    return _tmem.get(i).testFX(flags);
+    return _collisionLayer.getFX(i.i()) & flags;
 }
 
 ego_tile_info_t& ego_mesh_t::getTileInfo(const Index1D& i) {
@@ -987,7 +1046,7 @@ uint8_t ego_mesh_t::get_twist(const Index1D& i) const
     if (!_info.isValid(i)) {
         return TWIST_FLAT;
     }
-    return _tmem.get(i)._twist;
+    return _collisionLayer.getTwist(i.i());
 }
 
 uint8_t ego_mesh_t::get_fan_twist(const Index1D& i) const
@@ -1021,20 +1080,7 @@ float ego_mesh_t::get_max_vertex_0(const Index2D& i) const
         return 0.0f;
     }
 
-    const ego_tile_info_t& tile = _tmem.get(j);
-
-	size_t vstart = tile._vrtstart;
-	size_t vcount = std::min(static_cast<size_t>(4), _tmem.getInfo().getVertexCount());
-
-	size_t cnt;
-	size_t ivrt = vstart;
-	float zmax = _tmem._plst[ivrt][ZZ];
-	for (ivrt++, cnt = 1; cnt < vcount; ivrt++, cnt++)
-	{
-		zmax = std::max(zmax, _tmem._plst[ivrt][ZZ]);
-	}
-
-	return zmax;
+	return _collisionLayer.getMaxElevation(j.i());
 }
 
 float ego_mesh_t::get_max_vertex_1(const Index2D& i, float xmin, float ymin, float xmax, float ymax) const
@@ -1048,21 +1094,28 @@ float ego_mesh_t::get_max_vertex_1(const Index2D& i, float xmin, float ymin, flo
         return 0.0f;
     }
 
-	size_t vstart = _tmem.get(j)._vrtstart;
+	// we are evaluating the height based on the grid, not the actual vertex positions
+	const float gx = i.x() * Info<float>::Grid::Size();
+	const float gy = i.y() * Info<float>::Grid::Size();
+
+	// all corners of the tile are in the box
+	if (gx >= xmin && gx + Info<float>::Grid::Size() <= xmax && gy >= ymin && gy + Info<float>::Grid::Size() <= ymax)
+	{
+		return _collisionLayer.getMaxElevation(j.i());
+	}
+
+	const auto& corners = _collisionLayer.getCorners(j.i());
 	size_t vcount = std::min((size_t)4, _tmem.getInfo().getVertexCount());
 
 	float zmax = -1e6;
-	for (size_t ivrt = vstart, cnt = 0; cnt < vcount; ivrt++, cnt++)
+	for (size_t cnt = 0; cnt < vcount; cnt++)
 	{
-		GLXvector3f& vert = _tmem._plst[ivrt];
-
-		// we are evaluating the height based on the grid, not the actual vertex positions
-		float fx = (i.x() + ix_off[cnt]) * Info<float>::Grid::Size();
-		float fy = (i.y() + iy_off[cnt]) * Info<float>::Grid::Size();
+		float fx = gx + ix_off[cnt] * Info<float>::Grid::Size();
+		float fy = gy + iy_off[cnt] * Info<float>::Grid::Size();
 
 		if (fx >= xmin && fx <= xmax && fy >= ymin && fy <= ymax)
 		{
-			zmax = std::max(zmax, vert[ZZ]);
+			zmax = std::max(zmax, corners[cnt]);
 		}
 	}
 
@@ -1207,7 +1260,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, float radius, const BIT_FIEL
 				Index1D itile = getTileIndex(Index2D(ix, iy));
 				if (grid_is_valid(itile))
 				{
-					BIT_FIELD mpdfx = data._mesh->getTileInfo(itile).getFX();
+					BIT_FIELD mpdfx = data._mesh->_collisionLayer.getFX(itile.i());
 					bool is_blocked = HAS_SOME_BITS(mpdfx, bits);
 
 					if (is_blocked)
@@ -1272,7 +1325,10 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, const float radius, const BI
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info), _pathGraphs(), _collisionLayer(), _cullingTree(), _batches() {
+	_collisionLayer.resize(mesh_info.getTileCountX(), mesh_info.getTileCountY());
+	_cullingTree.resize(mesh_info.getTileCountX(), mesh_info.getTileCountY());
+	_batches.resize(mesh_info.getTileCountX(), mesh_info.getTileCountY());
 }
 
 ego_mesh_t::~ego_mesh_t() {
@@ -1294,6 +1350,7 @@ void ego_mesh_t::recalc_twist() {
 	for (Index1D i = 0; i < _info.getTileCount(); ++i) {
 		uint8_t twist = get_fan_twist(i);
 		_tmem.get(i)._twist = twist;
+		_collisionLayer.setTwist(i.i(), twist);
 	}
 }
 
@@ -1310,9 +1367,14 @@ bool ego_mesh_t::set_texture(const Index1D& index1D, Uint16 image)
 
 	// Set the actual image.
 	_tmem.get(index1D)._img = tile_upper | tile_lower;
+	_collisionLayer.setFanOff(index1D.i(), _tmem.get(index1D).isFanOff());
 
 	// Update the pre-computed texture info.
-	return update_texture(index1D);
+	if (!update_texture(index1D)) {
+		return false;
+	}
+	make_batch(index1D);
+	return true;
 }
 
 bool ego_mesh_t::update_texture(const Index1D& i)
@@ -1351,6 +1413,9 @@ void ego_mesh_t::finalize()
 	make_normals();
 	make_bbox();
 	make_texture();
+	make_collision_layer();
+	make_culling_tree();
+	make_batches();
 
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
@@ -24,6 +24,10 @@
 #include "game/egoboo.h"
 #include "game/lighting.h"
 #include "egolib/Mesh/Info.hpp"
+#include "egolib/AI/PathGraph.hpp"
+#include "egolib/Mesh/CollisionLayer.hpp"
+#include "egolib/Mesh/CullingTree.hpp"
+#include "egolib/Mesh/Batches.hpp"
 
 //--------------------------------------------------------------------------------------------
 // external types
@@ -388,6 +392,14 @@ public:
     Ego::MeshInfo _info;
     tile_mem_t _tmem;
     mpdfx_lists_t _fxlists;
+    /// The path graphs of this mesh, invalidated whenever the FX of a tile change.
+    mutable Ego::AI::PathGraphCache _pathGraphs;
+    /// The FX, twists and corner heights of the tiles queried by the physics, kept in sync with the tile infos.
+    Ego::MeshCollisionLayer _collisionLayer;
+    /// The bounds of the tiles in blocks, for culling the tiles against the view frustum.
+    Ego::MeshCullingTree _cullingTree;
+    /// The triangulated vertices of the tiles in chunks, for rendering the tiles of a texture in a chunk at once.
+    mutable Ego::MeshBatches _batches;
 
     Vector3f get_diff(const Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Vector3f& pos, float radius, const BIT_FIELD bits) const;
@@ -479,6 +491,14 @@ private:
 	void make_normals();
 	/// Set the bounding box for each tile, and for the entire mesh
 	void make_bbox();
+	/// Copy the FX, twist and corner heights of each tile into the collision layer.
+	void make_collision_layer();
+	/// Copy the bounding box of each tile into the culling tree.
+	void make_culling_tree();
+	/// Copy the vertices and the triangle fans of each tile into the batches.
+	void make_batches();
+	/// Copy the vertices and the triangle fans of a tile into the batches.
+	void make_batch(const Index1D& i);
 
 };
 
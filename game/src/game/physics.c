@@ -24,15 +24,13 @@
 #include "game/mesh.h"
 #include "game/Entities/_Include.hpp"
 #include "egolib/Float.hpp"
+#include "egolib/OctBBKernels.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 Ego::Physics::Environment Ego::Physics::g_environment;
 
-static egolib_rv phys_intersect_oct_bb_index(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax);
-static egolib_rv phys_intersect_oct_bb_close_index(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax);
-
 /// @brief A test to determine whether two "fast moving" objects are interacting within a frame.
 ///        Designed to determine whether a bullet particle will interact with character.
 //static bool phys_intersect_oct_bb_close(const oct_bb_t& src1_orig, const Vector3f& pos1, const Vector3f& vel1, const oct_bb_t& src2_orig, const Vector3f& pos2, const Vector3f& vel2, int test_platform, oct_bb_t& dst, float *tmin, float *tmax);
@@ -48,38 +46,8 @@ const Facing orientation_t::MAP_TURN_OFFSET(0x8000);
 //--------------------------------------------------------------------------------------------
 bool phys_get_collision_depth(const oct_bb_t& bb_a, const oct_bb_t& bb_b, oct_vec_v2_t& odepth)
 {
-    odepth = oct_vec_v2_t();
-
-    // are the initial volumes any good?
-    if (bb_a._empty || bb_b._empty) return false;
-
-    // is there any overlap?
-    oct_bb_t otmp = oct_bb_t::intersection(bb_a, bb_b);
-    if (otmp.isEmpty()) {
-        return false;
-    }
-
-    // Estimate the "cm position" of the objects by the bounding volumes.
-    oct_vec_v2_t opos_a = bb_a.getMid();
-    oct_vec_v2_t opos_b = bb_b.getMid();
-
     // find the (signed) depth in each dimension
-    bool retval = true;
-    for (size_t i = 0; i < OCT_COUNT; ++i)
-    {
-        float fdiff = opos_b[i] - opos_a[i];
-        float fdepth = otmp._maxs[i] - otmp._mins[i];
-
-        // if the measured depth is less than zero, or the difference in positions
-        // is ambiguous, this algorithm fails
-        if (fdepth <= 0.0f || 0.0f == fdiff) retval = false;
-
-        odepth[i] = (fdiff < 0.0f) ? -fdepth : fdepth;
-    }
-    odepth[OCT_XY] *= Ego::Math::invSqrtTwo<float>();
-    odepth[OCT_YX] *= Ego::Math::invSqrtTwo<float>();
-
-    return retval;
+    return Ego::OctBBKernels::getCollisionDepth(bb_a, bb_b, odepth);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -315,161 +283,6 @@ bool phys_estimate_pressure_normal(const oct_bb_t& obb_a, const oct_bb_t& obb_b,
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
-egolib_rv phys_intersect_oct_bb_index(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax)
-{
-    if (!tmin)
-    {
-        throw std::invalid_argument("nullptr == tmin");
-    }
-    if (!tmax)
-    {
-        throw std::invalid_argument("nullptr == tmax");
-    }
-    if (index < 0)
-    {
-        throw std::invalid_argument("index < 0");
-    }
-    if (index >= OCT_COUNT)
-    {
-        throw std::invalid_argument("index >= OCT_COUNT");
-    }
-
-    float vdiff = ovel2[index] - ovel1[index];
-    if ( 0.0f == vdiff ) return rv_fail;
-
-    float src1_min = src1._mins[index];
-    float src1_max = src1._maxs[index];
-    float src2_min = src2._mins[index];
-    float src2_max = src2._maxs[index];
-
-    if (OCT_Z != index)
-    {
-        // Is there any possibility of the 2 objects acting as a platform pair.
-        bool close_test_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1);
-        bool close_test_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2);
-
-        // Only do a close test if the object's feet are above the platform.
-        close_test_1 = close_test_1 && (src1._mins[OCT_Z] > src2._maxs[OCT_Z]);
-        close_test_2 = close_test_2 && (src2._mins[OCT_Z] > src1._maxs[OCT_Z]);
-
-        if (!close_test_1 && !close_test_2)
-        {
-            // NEITHER is a platform.
-            float time[4];
-
-            time[0] = (src1_min - src2_min) / vdiff;
-            time[1] = (src1_min - src2_max) / vdiff;
-            time[2] = (src1_max - src2_min) / vdiff;
-            time[3] = (src1_max - src2_max) / vdiff;
-
-            *tmin = std::min( std::min( time[0], time[1] ), std::min( time[2], time[3] ) );
-            *tmax = std::max( std::max( time[0], time[1] ), std::max( time[2], time[3] ) );
-        }
-        else
-        {
-            return phys_intersect_oct_bb_close_index(index, src1, ovel1, src2, ovel2, test_platform, tmin, tmax);
-        }
-    }
-    else /* OCT_Z == index */
-    {
-        float plat_min, plat_max;
-
-        // Add in a tolerance into the vertical direction for platforms
-        float tolerance_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1) ? PLATTOLERANCE : 0.0f;
-        float tolerance_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2) ? PLATTOLERANCE : 0.0f;
-
-        if ( 0.0f == tolerance_1 && 0.0f == tolerance_2 )
-        {
-            // NEITHER is a platform.
-            float time[4];
-
-            time[0] = (src1_min - src2_min) / vdiff;
-            time[1] = (src1_min - src2_max) / vdiff;
-            time[2] = (src1_max - src2_min) / vdiff;
-            time[3] = (src1_max - src2_max) / vdiff;
-
-            *tmin = std::min( std::min( time[0], time[1] ), std::min( time[2], time[3] ) );
-            *tmax = std::max( std::max( time[0], time[1] ), std::max( time[2], time[3] ) );
-        }
-        else if (0.0f == tolerance_1)
-        {
-            float time[4];
-
-            // 2nd object is a platform.
-            plat_min = src2_min;
-            plat_max = src2_max + tolerance_2;
-
-            time[0] = (src1_min - plat_min) / vdiff;
-            time[1] = (src1_min - plat_max) / vdiff;
-            time[2] = (src1_max - plat_min) / vdiff;
-            time[3] = (src1_max - plat_max) / vdiff;
-
-            *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
-            *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
-        }
-        else if (0.0f == tolerance_2)
-        {
-            float time[4];
-
-            // 1st object is a platform.
-            plat_min = src1_min;
-            plat_max = src1_max + tolerance_2;
-
-            time[0] = (plat_min - src2_min) / vdiff;
-            time[1] = (plat_min - src2_max) / vdiff;
-            time[2] = (plat_max - src2_min) / vdiff;
-            time[3] = (plat_max - src2_max) / vdiff;
-
-            *tmin = std::min(std::min(time[0], time[1]), std::min(time[2], time[3]));
-            *tmax = std::max(std::max(time[0], time[1]), std::max(time[2], time[3]));
-        }
-        else if ( tolerance_1 > 0.0f && tolerance_2 > 0.0f )
-        {
-            // BOTH are platforms.
-            // They cannot both act as plaforms at the same time,
-            // so do 8 tests.
-
-            float time[8];
-
-            // Assume: 2nd object is platform.
-            plat_min = src2_min;
-            plat_max = src2_max + tolerance_2;
-
-            time[0] = (src1_min - plat_min) / vdiff;
-            time[1] = (src1_min - plat_max) / vdiff;
-            time[2] = (src1_max - plat_min) / vdiff;
-            time[3] = (src1_max - plat_max) / vdiff;
-            float tmp_min1 = std::min({time[0], time[1], time[2], time[3]});
-            float tmp_max1 = std::max({time[0], time[1], time[2], time[3]});
-
-            // Assume: 1st object is platform.
-            plat_min = src1_min;
-            plat_max = src1_max + tolerance_2;
-
-            time[4] = (plat_min - src2_min) / vdiff;
-            time[5] = (plat_min - src2_max) / vdiff;
-            time[6] = (plat_max - src2_min) / vdiff;
-            time[7] = (plat_max - src2_max) / vdiff;
-            float tmp_min2 = std::min({time[4], time[5], time[6], time[7]});
-            float tmp_max2 = std::max({time[4], time[5], time[6], time[7]});
-
-            *tmin = std::min(tmp_min1, tmp_min2);
-            *tmax = std::max(tmp_max1, tmp_max2);
-        }
-    }
-
-    // Normalize the results for the diagonal directions.
-    if (OCT_XY == index || OCT_YX == index)
-    {
-        *tmin *= Ego::Math::invSqrtTwo<float>();
-        *tmax *= Ego::Math::invSqrtTwo<float>();
-    }
-
-    if (*tmax <= *tmin) return rv_fail;
-
-    return rv_success;
-}
-
 //--------------------------------------------------------------------------------------------
 bool phys_intersect_oct_bb(const oct_bb_t& src1_orig, const Vector3f& pos1, const Vector3f& vel1, const oct_bb_t& src2_orig, const Vector3f& pos2, const Vector3f& vel2, int test_platform, oct_bb_t& dst, float *tmin, float *tmax)
 {
@@ -505,6 +318,12 @@ bool phys_intersect_oct_bb(const oct_bb_t& src1_orig, const Vector3f& pos1, cons
     }
     else
     {
+        // Determine when the two volumes might coincide along each of the coordinates at once.
+        oct_vec_v2_t axis_tmin, axis_tmax;
+        const unsigned axes = Ego::OctBBKernels::sweep(src1, ovel1, src2, ovel2,
+                                                       HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1), HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2),
+                                                       PLATTOLERANCE, axis_tmin, axis_tmax);
+
         // Cycle through the coordinates to see when the two volumes might coincide.
         for (size_t index = 0; index < OCT_COUNT; ++index)
         {
@@ -516,9 +335,9 @@ bool phys_intersect_oct_bb(const oct_bb_t& src1_orig, const Vector3f& pos1, cons
             }
             else
             {
-                float tmp_min = 0.0f, tmp_max = 0.0f;
+                float tmp_min = axis_tmin[index], tmp_max = axis_tmax[index];
 
-                retval = phys_intersect_oct_bb_index(index, src1, ovel1, src2, ovel2, test_platform, &tmp_min, &tmp_max);
+                retval = HAS_SOME_BITS(axes, 1u << index) ? rv_success : rv_fail;
 
                 // check for overflow
                 if (float_bad(tmp_min) || float_bad(tmp_max))
@@ -600,225 +419,11 @@ bool phys_intersect_oct_bb(const oct_bb_t& src1_orig, const Vector3f& pos1, cons
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
-egolib_rv phys_intersect_oct_bb_close_index(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax)
-{
-    if (!tmin)
-    {
-        throw std::invalid_argument("nullptr == tmin");
-    }
-    if (!tmax)
-    {
-        throw std::invalid_argument("nullptr == tmax");
-    }
-    if (index < 0)
-    {
-        throw std::invalid_argument("index < 0");
-    }
-    if (index >= OCT_COUNT)
-    {
-        throw std::invalid_argument("index >= OCT_COUNT");
-    }
-    float vdiff = ovel2[index] - ovel1[index];
-    if (0.0f == vdiff) return rv_fail;
-
-    /// @todo Use src1.getMin(index), src2.getMax(index) and src1.getMid(index).
-    float src1_min = src1._mins[index];
-    float src1_max = src1._maxs[index];
-    float opos1 = (src1_min + src1_max) * 0.5f;
-
-    /// @todo Use src2.getMin(index), src2.getMax(index) and src2.getMid(index).
-    float src2_min = src2._mins[index];
-    float src2_max = src2._maxs[index];
-    float opos2 = (src2_min + src2_max) * 0.5f;
-
-    if (OCT_Z != index)
-    {
-        bool platform_1 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1);
-        bool platform_2 = HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2);
-
-        if (!platform_1 && !platform_2)
-        {
-            // NEITHER is a platform.
-            // Use the eqn. from phys_intersect_oct_bb_index().
-
-            float time[4];
-
-            time[0] = (src1_min - src2_min) / vdiff;
-            time[1] = (src1_min - src2_max) / vdiff;
-            time[2] = (src1_max - src2_min) / vdiff;
-            time[3] = (src1_max - src2_max) / vdiff;
-
-			*tmin = std::min({ time[0], time[1], time[2], time[3] });
-			*tmax = std::max({ time[0], time[1], time[2], time[3] });
-        }
-        else if ( platform_1 && !platform_2 )
-        {
-            float time[2];
-
-            // 1st object is the platform.
-            time[0] = (src1_min - opos2) / vdiff;
-            time[1] = (src1_max - opos2) / vdiff;
-
-            *tmin = std::min(time[0], time[1]);
-            *tmax = std::max(time[0], time[1]);
-        }
-        else if (!platform_1 && platform_2)
-        {
-            float time[2];
-
-            // 2nd object is the platform.
-            time[0] = (opos1 - src2_min) / vdiff;
-            time[1] = (opos1 - src2_max) / vdiff;
-
-            *tmin = std::min(time[0], time[1]);
-            *tmax = std::max(time[0], time[1]);
-        }
-        else
-        {
-            // BOTH are platforms. must check all possibilities.
-            float time[4];
-
-            // 1st object is the platform.
-            time[0] = (src1_min - opos2) / vdiff;
-            time[1] = (src1_max - opos2) / vdiff;
-
-            // 2nd object 2 is the platform.
-            time[2] = (opos1 - src2_min) / vdiff;
-            time[3] = (opos1 - src2_max) / vdiff;
-
-            *tmin = std::min({time[0], time[1], time[2], time[3]});
-            *tmax = std::max({time[0], time[1], time[2], time[3]});
-        }
-    }
-    else /* OCT_Z == index */
-    {
-        float plat_min, plat_max;
-        float obj_pos;
-
-        float tolerance_1 =  HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ1)
-                          ? PLATTOLERANCE : 0.0f;
-        float tolerance_2 =  HAS_SOME_BITS(test_platform, PHYS_PLATFORM_OBJ2)
-                          ? PLATTOLERANCE : 0.0f;
-
-        if (0.0f == tolerance_1 && 0.0f == tolerance_2)
-        {
-            // NEITHER is a platform.
-            // Use the eqn. from phys_intersect_oct_bb_index().
-
-            float time[4];
-
-            time[0] = (src1_min - src2_min) / vdiff;
-            time[1] = (src1_min - src2_max) / vdiff;
-            time[2] = (src1_max - src2_min) / vdiff;
-            time[3] = (src1_max - src2_max) / vdiff;
-
-            *tmin = std::min({ time[0], time[1], time[2], time[3] });
-            *tmax = std::max({ time[0], time[1], time[2], time[3] });
-        }
-        else if (0.0f != tolerance_1 && 0.0f == tolerance_2)
-        {
-            float time[2];
-
-            // 1st object is the platform.
-            obj_pos  = src2_min;
-            plat_min = src1_min;
-            plat_max = src1_max + tolerance_1;
-
-            time[0] = (plat_min - obj_pos) / vdiff;
-            time[1] = (plat_max - obj_pos) / vdiff;
-
-            *tmin = std::min(time[0], time[1]);
-            *tmax = std::max(time[0], time[1]);
-        }
-        else if (0.0f == tolerance_1 && 0.0f != tolerance_2)
-        {
-            float time[2];
-
-            // 2nd object is the platform.
-            obj_pos  = src1_min;
-            plat_min = src2_min;
-            plat_max = src2_max + tolerance_2;
-
-            time[0] = (obj_pos - plat_min) / vdiff;
-            time[1] = (obj_pos - plat_max) / vdiff;
-
-            *tmin = std::min(time[0], time[1]);
-            *tmax = std::max(time[0], time[1]);
-        }
-        else
-        {
-            // BOTH are platforms.
-            float time[4];
-
-            // 2nd object is a platform.
-            obj_pos  = src1_min;
-            plat_min = src2_min;
-            plat_max = src2_max + tolerance_2;
-
-            time[0] = (obj_pos - plat_min) / vdiff;
-            time[1] = (obj_pos - plat_max) / vdiff;
-
-            // 1st object is a platform.
-            obj_pos  = src2_min;
-            plat_min = src1_min;
-            plat_max = src1_max + tolerance_1;
-
-            time[2] = (plat_min - obj_pos) / vdiff;
-            time[3] = (plat_max - obj_pos) / vdiff;
-
-            *tmin = std::min({ time[0], time[1], time[2], time[3] });
-            *tmax = std::max({ time[0], time[1], time[2], time[3] });
-        }
-    }
-
-    // Normalize the results for the diagonal directions.
-    if (OCT_XY == index || OCT_YX == index)
-    {
-        *tmin *= Ego::Math::invSqrtTwo<float>();
-        *tmax *= Ego::Math::invSqrtTwo<float>();
-    }
-
-    if (*tmax < *tmin) return rv_fail;
-
-    return rv_success;
-}
-
 //--------------------------------------------------------------------------------------------
 bool phys_expand_oct_bb(const oct_bb_t& src, const Vector3f& vel, const float tmin, const float tmax, oct_bb_t& dst)
 {
-    if (0.0f == vel.length_abs())
-    {
-        dst = src;
-        return true;
-    }
-
-    oct_bb_t tmp_min, tmp_max;
-    // Determine the bounding volume at t == tmin.
-    if (0.0f == tmin)
-    {
-        tmp_min = src;
-    }
-    else
-    {
-		Vector3f tmp_diff = vel * tmin;
-        // Adjust the bounding box to take in the position at the next step.
-        tmp_min = oct_bb_t::translate(src, tmp_diff);
-    }
-
-    // Determine the bounding volume at t == tmax.
-    if ( tmax == 0.0f )
-    {
-        tmp_max = src;
-    }
-    else
-    {
-		Vector3f tmp_diff = vel * tmax;
-        // Adjust the bounding box to take in the position at the next step.
-		tmp_max = oct_bb_t::translate(src, tmp_diff);
-	}
-
     // Determine bounding box for the range of times.
-	oct_bb_t::join(tmp_min, tmp_max, dst);
+    Ego::OctBBKernels::expand(src, vel, tmin, tmax, dst);
 
     return true;
 }
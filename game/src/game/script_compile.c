@@ -25,6 +25,7 @@
 #include "game/game.h"
 #include "game/egoboo.h"
 #include "egolib/Log/Entry.hpp"
+#include "egolib/Script/Interpreter/CodeGenerator.hpp"
 
 namespace Log {
 struct CompilerEntry : Entry {
@@ -1078,6 +1079,14 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 
         // determine the correct jumps
         parser_state_t::parse_jumps(script);
+
+        // decode for running
+        script.decode();
+
+        if (egoboo_config_t::get().debug_scriptExport_enable.getValue())
+        {
+            export_ai_script(script);
+        }
     } catch (...) {
         return rv_fail;
     }
@@ -1100,6 +1109,44 @@ egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, Ob
 	return rv_success;
 }
 
+//--------------------------------------------------------------------------------------------
+void export_ai_script(const script_info_t& script)
+{
+    const std::vector<std::string> functionNames(Ego::Script::_scriptFunctionNames.cbegin(), Ego::Script::_scriptFunctionNames.cend());
+    Ego::Script::Interpreter::CodeGenerator generator(functionNames, "scr_");
+
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016" PRIx64, script._hash);
+
+    vfs_mkdir("/debug/compiled_scripts");
+    vfs_FILE *file = vfs_openWrite(std::string("/debug/compiled_scripts/script_") + hash + ".cpp");
+    if (nullptr == file)
+    {
+        Log::get().warn("%s:%d:%s: unable to export script `%s`\n", __FILE__, __LINE__, __FUNCTION__, script.getName().c_str());
+        return;
+    }
+
+    std::ostringstream os;
+    os << "/// @file  script_" << hash << ".cpp" << std::endl
+       << "/// @brief " << Ego::Script::Interpreter::CodeGenerator::quote(script.getName()) << " compiled ahead of time. Generated by export_ai_script(), do not edit." << std::endl
+       << std::endl
+       << "#include \"egolib/Script/script.h\"" << std::endl
+       << "#include \"game/script_functions.h\"" << std::endl
+       << std::endl
+       << "namespace CompiledScript_" << hash << " {" << std::endl
+       << std::endl
+       << generator.generate(script._program) << std::endl
+       << "void entry(script_state_t& state, ai_state_t& aiState, script_info_t& script) {" << std::endl
+       << "    run<Ego::Script::ScriptOperands>(state, aiState, script);" << std::endl
+       << "}" << std::endl
+       << std::endl
+       << "const Ego::Script::CompiledScript compiledScript(0x" << hash << "ull, " << Ego::Script::Interpreter::CodeGenerator::quote(script.getName()) << ", &entry);" << std::endl
+       << std::endl
+       << "} // namespace CompiledScript_" << hash << std::endl;
+    vfs_printf(file, "%s", os.str().c_str());
+    vfs_close(file);
+}
+
 //--------------------------------------------------------------------------------------------
 
 void print_token(const Token& token) {
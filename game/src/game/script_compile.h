@@ -197,3 +197,15 @@ public:
  *			If this fails, then the call to this function fails.
  */
 egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script);
+
+/**
+ * @brief
+ *  Write a loaded AI script as C++ code to "/debug/compiled_scripts".
+ * @param script
+ *  the script
+ * @remark
+ *  Adding the written file to the game's sources compiles the script ahead of time.
+ *  As long as the script compiles to the same instructions, the compiled version is
+ *  used instead of the interpreter.
+ */
+void export_ai_script(const script_info_t& script);
@@ -248,10 +248,11 @@ bool FindPath( waypoint_list_t& wplst, Object * pchr, float dst_x, float dst_y,
 #ifdef DEBUG_ASTAR
         printf( "Finding a path from %d,%d to %d,%d: \n", src_ix, src_iy, dst_ix, dst_iy );
 #endif
-        //Try to find a path with the AStar algorithm
-        if ( g_astar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
+        //Try to find a path with the AStar algorithm, one per thread so that scripts can look for paths in parallel
+        static thread_local AStar astar;
+        if ( astar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
         {
-            returncode = g_astar.get_path( dst_x, dst_y, wplst);
+            returncode = astar.get_path( dst_x, dst_y, wplst);
         }
 
         if ( NULL != used_astar_ptr )
@@ -0,0 +1,6 @@
+int Headless_main(int argc, char *argv[]);
+
+int main(int argc, char *argv[])
+{
+    return Headless_main(argc, argv);
+}